@@ -40,6 +40,9 @@ list (APPEND TEST_DATA_FILES
 # originally generated with the command:
 # find tutorials examples -name '*.c*' -printf '\t%p\n' | sort
 list (APPEND EXAMPLE_SOURCE_FILES
+	examples/blackoilproperties_benchmark.cpp
+	examples/lineartables_benchmark.cpp
+	examples/tabulatedcomponents_benchmark.cpp
 	)
 
 # programs listed here will not only be compiled, but also marked for
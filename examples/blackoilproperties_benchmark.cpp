@@ -0,0 +1,775 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+
+  Consult the COPYING file in the top-level source directory of this
+  module for the precise wording of the license and the list of
+  copyright holders.
+*/
+/*!
+ * \file
+ *
+ * \brief Measures how the evaluation of the black-oil properties of all cells
+ *        scales with the number of threads.
+ *
+ * This mimics the update of the intensive quantities of a black-oil simulator:
+ * For each cell, the capillary pressures, the relative permeabilities, the
+ * PVT properties of all phases (with derivatives w.r.t. three primary
+ * variables) are calculated and the hysteresis parameters are updated. The
+ * fluid system and the EclMaterialLawManager are either initialized from a
+ * deck given on the command line or from a synthetic deck with two PVT and
+ * saturation regions which alternate every few cells.
+ *
+ * The cells are evaluated using 1 to P threads. For each number of threads,
+ * the throughput is reported for a fixed number of cells (strong scaling) and
+ * for a fixed number of cells per thread (weak scaling) together with the time
+ * spent in each kernel. Since all threads share the fluid system and the
+ * material law manager, the results of each run are compared with the ones of
+ * a serial run, i.e., the program also checks that these objects can safely
+ * be used concurrently.
+ *
+ * Finally, the fraction of the per-cell material law parameters which reside on
+ * a different NUMA node than the thread that evaluates the cell is estimated.
+ * After letting each thread re-create the parameters of its own cells (first
+ * touch placement), this fraction and the run time are measured again. The
+ * estimate is only available on Linux.
+ *
+ * Usage: blackoilproperties_benchmark [NUM_CELLS [MAX_THREADS [DECK_FILE]]]
+ */
+#include "config.h"
+
+#include <dune/common/parallel/mpihelper.hh>
+
+#include <iostream>
+
+#if HAVE_ECL_INPUT
+#include <opm/material/fluidsystems/BlackOilFluidSystem.hpp>
+#include <opm/material/fluidstates/BlackOilFluidState.hpp>
+#include <opm/material/fluidmatrixinteractions/EclMaterialLawManager.hpp>
+#include <opm/material/densead/Evaluation.hpp>
+
+#include <opm/parser/eclipse/Parser/Parser.hpp>
+#include <opm/parser/eclipse/Deck/Deck.hpp>
+#include <opm/parser/eclipse/EclipseState/EclipseState.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/EclipseGrid.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/Schedule.hpp>
+#include <opm/parser/eclipse/Python/Python.hpp>
+
+#include <chrono>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <array>
+#include <thread>
+#include <functional>
+#include <memory>
+#include <cstdlib>
+#include <cstdint>
+#include <cmath>
+#include <algorithm>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+typedef double Scalar;
+typedef Opm::BlackOilFluidSystem<Scalar> FluidSystem;
+
+enum {
+    numPhases = FluidSystem::numPhases,
+    waterPhaseIdx = FluidSystem::waterPhaseIdx,
+    oilPhaseIdx = FluidSystem::oilPhaseIdx,
+    gasPhaseIdx = FluidSystem::gasPhaseIdx
+};
+
+// the primary variables are the oil pressure, the water saturation and either the
+// gas saturation or the gas dissolution factor
+typedef Opm::DenseAd::Evaluation<Scalar, 3> Evaluation;
+typedef Opm::BlackOilFluidState<Evaluation, FluidSystem> FluidState;
+
+typedef Opm::ThreePhaseMaterialTraits<Scalar,
+                                      /*wettingPhaseIdx=*/waterPhaseIdx,
+                                      /*nonWettingPhaseIdx=*/oilPhaseIdx,
+                                      /*gasPhaseIdx=*/gasPhaseIdx> MaterialTraits;
+typedef Opm::EclMaterialLawManager<MaterialTraits> MaterialLawManager;
+typedef MaterialLawManager::MaterialLaw MaterialLaw;
+
+enum Kernel {
+    capillaryPressureKernel,
+    relpermKernel,
+    pvtKernel,
+    hysteresisKernel,
+    numKernels
+};
+
+static const char* kernelNames[numKernels] = {
+    "saturations+pc",
+    "relperm",
+    "PVT",
+    "hysteresis"
+};
+
+// the cells are processed in blocks. this amortizes the cost of the timers which
+// measure the time spent in the individual kernels
+static const size_t blockSize = 64;
+
+struct KernelTimes
+{
+    KernelTimes()
+    { std::fill(seconds, seconds + numKernels, 0.0); }
+
+    double seconds[numKernels];
+};
+
+// a reproducible pseudo random number in [0, 1) which only depends on the cell and
+// on the quantity, i.e., not on the number of threads
+Scalar cellRandom(size_t elemIdx, unsigned quantityIdx)
+{
+    uint64_t x = (elemIdx + 1)*0x9E3779B97F4A7C15ULL + quantityIdx*0xD1B54A32D192ED03ULL;
+    x ^= x >> 30;
+    x *= 0xBF58476D1CE4E5B9ULL;
+    x ^= x >> 27;
+    x *= 0x94D049BB133111EBULL;
+    x ^= x >> 31;
+    return static_cast<Scalar>(x >> 11)/9007199254740992.0;
+}
+
+////////////////////
+// synthetic deck
+////////////////////
+
+// SPE1 PVT data in field units, the tables of the second region are slightly modified
+void writePvtTables(std::ostream& deck, unsigned numRegions)
+{
+    static const Scalar pvtoRs[] = { 0.0010, 0.0905, 0.1800, 0.3710, 0.6360, 0.7750, 0.9300, 1.2700, 1.6180 };
+    static const Scalar pvtoP[] = { 14.7, 264.7, 514.7, 1014.7, 2014.7, 2514.7, 3014.7, 4014.7, 5014.7 };
+    static const Scalar pvtoB[] = { 1.0620, 1.1500, 1.2070, 1.2950, 1.4350, 1.5000, 1.5650, 1.6950, 1.8270 };
+    static const Scalar pvtoMu[] = { 1.0400, 0.9750, 0.9100, 0.8300, 0.6950, 0.6410, 0.5940, 0.5100, 0.4490 };
+    static const Scalar pvdg[][3] = {
+        { 14.7, 166.666, 0.0080 },
+        { 264.7, 12.0930, 0.0096 },
+        { 514.7, 6.2740, 0.0112 },
+        { 1014.7, 3.1970, 0.0140 },
+        { 2014.7, 1.6140, 0.0189 },
+        { 2514.7, 1.2940, 0.0208 },
+        { 3014.7, 1.0800, 0.0228 },
+        { 4014.7, 0.8110, 0.0268 },
+        { 5014.7, 0.6490, 0.0309 },
+        { 9014.7, 0.3860, 0.0470 }
+    };
+
+    deck << "PVTO\n";
+    for (unsigned regionIdx = 0; regionIdx < numRegions; ++regionIdx) {
+        Scalar bFactor = 1.0 + 0.02*regionIdx;
+        Scalar muFactor = 1.0 + 0.05*regionIdx;
+        for (unsigned i = 0; i < 9; ++i) {
+            deck << pvtoRs[i] << " " << pvtoP[i] << " " << pvtoB[i]*bFactor << " " << pvtoMu[i]*muFactor;
+            // undersaturated oil is only specified for the two largest Rs values
+            if (i >= 7)
+                deck << "\n    9014.7 " << pvtoB[i]*bFactor*0.93 << " " << pvtoMu[i]*muFactor*1.42;
+            deck << " /\n";
+        }
+        deck << "/\n";
+    }
+
+    deck << "PVDG\n";
+    for (unsigned regionIdx = 0; regionIdx < numRegions; ++regionIdx) {
+        for (unsigned i = 0; i < 10; ++i)
+            deck << pvdg[i][0] << " " << pvdg[i][1]*(1.0 + 0.02*regionIdx) << " " << pvdg[i][2] << "\n";
+        deck << "/\n";
+    }
+
+    deck << "PVTW\n";
+    for (unsigned regionIdx = 0; regionIdx < numRegions; ++regionIdx)
+        deck << "4014.7 " << 1.029 + 0.01*regionIdx << " 3.13E-6 0.31 0 /\n";
+
+    deck << "DENSITY\n";
+    for (unsigned regionIdx = 0; regionIdx < numRegions; ++regionIdx)
+        deck << 53.66 + regionIdx << " 64.49 0.0533 /\n";
+}
+
+// Corey type saturation functions whose connate water saturation differs between the
+// regions
+void writeSatTables(std::ostream& deck, unsigned numRegions)
+{
+    static const unsigned numRows = 11;
+
+    deck << "SWOF\n";
+    for (unsigned regionIdx = 0; regionIdx < numRegions; ++regionIdx) {
+        Scalar Swc = 0.12 + 0.04*regionIdx;
+        for (unsigned i = 0; i < numRows; ++i) {
+            Scalar Se = Scalar(i)/(numRows - 1);
+            deck << Swc + (1 - Swc)*Se << " " << Se*Se << " " << (1 - Se)*(1 - Se) << " " << 4.0*(1 - Se) << "\n";
+        }
+        deck << "/\n";
+    }
+
+    deck << "SGOF\n";
+    for (unsigned regionIdx = 0; regionIdx < numRegions; ++regionIdx) {
+        Scalar Swc = 0.12 + 0.04*regionIdx;
+        for (unsigned i = 0; i < numRows; ++i) {
+            Scalar Se = Scalar(i)/(numRows - 1);
+            deck << (1 - Swc)*Se << " " << Se*Se*0.9 << " " << (1 - Se)*(1 - Se) << " " << 1.0*Se << "\n";
+        }
+        deck << "/\n";
+    }
+}
+
+// the region of a cell changes every four cells
+void writeRegions(std::ostream& deck, const char* keyword, size_t numCells, unsigned numRegions)
+{
+    deck << keyword << "\n";
+    for (size_t cellIdx = 0; cellIdx < numCells; cellIdx += 4) {
+        size_t n = std::min<size_t>(4, numCells - cellIdx);
+        deck << n << "*" << (cellIdx/4) % numRegions + 1 << "\n";
+    }
+    deck << "/\n";
+}
+
+std::string syntheticDeck(size_t numCells)
+{
+    const unsigned numRegions = 2;
+
+    std::ostringstream deck;
+    deck << std::setprecision(10)
+         << "RUNSPEC\n"
+         << "DIMENS\n" << numCells << " 1 1 /\n"
+         << "TABDIMS\n" << numRegions << " " << numRegions << " /\n"
+         << "OIL\nGAS\nWATER\nDISGAS\nFIELD\n"
+         << "GRID\n"
+         << "DX\n" << numCells << "*100 /\n"
+         << "DY\n" << numCells << "*100 /\n"
+         << "DZ\n" << numCells << "*20 /\n"
+         << "TOPS\n" << numCells << "*8325 /\n"
+         << "PORO\n" << numCells << "*0.2 /\n"
+         << "EHYSTR\n0.1 0 0.1 1* KR /\n"
+         << "SATOPTS\nHYSTER /\n"
+         << "PROPS\n";
+    writePvtTables(deck, numRegions);
+    writeSatTables(deck, numRegions);
+    deck << "REGIONS\n";
+    writeRegions(deck, "SATNUM", numCells, numRegions);
+    writeRegions(deck, "PVTNUM", numCells, numRegions);
+
+    return deck.str();
+}
+
+////////////////////
+// the property evaluation loop
+////////////////////
+
+struct Problem
+{
+    MaterialLawManager materialLawManager;
+    std::vector<unsigned> pvtRegionIdx;
+    size_t numCells;
+};
+
+// the same as the serial results must be obtained for all numbers of threads. each
+// cell contributes the mass mobilities and their derivatives
+Scalar cellResult(const FluidState& fs, const std::array<Evaluation, numPhases>& mobility)
+{
+    Scalar result = 0.0;
+    for (unsigned phaseIdx = 0; phaseIdx < numPhases; ++phaseIdx) {
+        const Evaluation& massMobility = mobility[phaseIdx]*fs.density(phaseIdx);
+        result += massMobility.value();
+        for (int varIdx = 0; varIdx < massMobility.size(); ++varIdx)
+            result += massMobility.derivative(varIdx);
+    }
+
+    return result;
+}
+
+void evaluateCells(Problem& problem,
+                   size_t beginIdx,
+                   size_t endIdx,
+                   std::vector<Scalar>& results,
+                   KernelTimes& times)
+{
+    typedef std::chrono::high_resolution_clock Clock;
+
+    std::vector<FluidState> fluidStates(blockSize);
+    std::vector<std::array<Evaluation, numPhases> > mobilities(blockSize);
+    std::vector<char> isSaturated(blockSize);
+    Scalar T = FluidSystem::reservoirTemperature();
+
+    for (size_t blockBeginIdx = beginIdx; blockBeginIdx < endIdx; blockBeginIdx += blockSize) {
+        size_t n = std::min(blockSize, endIdx - blockBeginIdx);
+
+        auto t0 = Clock::now();
+        for (size_t i = 0; i < n; ++i) {
+            size_t elemIdx = blockBeginIdx + i;
+            FluidState& fs = fluidStates[i];
+
+            // primary variables
+            isSaturated[i] = cellRandom(elemIdx, 0) > 0.3;
+            const Evaluation& po = Evaluation::createVariable(1.0e7 + 2.0e7*cellRandom(elemIdx, 1), 0);
+            const Evaluation& Sw = Evaluation::createVariable(0.2 + 0.6*cellRandom(elemIdx, 2), 1);
+            Evaluation Sg = 0.0;
+            if (isSaturated[i])
+                Sg = Evaluation::createVariable((1.0 - Sw.value())*0.6*cellRandom(elemIdx, 3), 2);
+
+            fs.setPvtRegionIndex(problem.pvtRegionIdx[elemIdx]);
+            fs.setTemperature(T);
+            fs.setSaturation(waterPhaseIdx, Sw);
+            fs.setSaturation(gasPhaseIdx, Sg);
+            fs.setSaturation(oilPhaseIdx, 1.0 - Sw - Sg);
+
+            std::array<Evaluation, numPhases> pc;
+            MaterialLaw::capillaryPressures(pc, problem.materialLawManager.materialLawParams(elemIdx), fs);
+            for (unsigned phaseIdx = 0; phaseIdx < numPhases; ++phaseIdx)
+                fs.setPressure(phaseIdx, po + (pc[phaseIdx] - pc[oilPhaseIdx]));
+        }
+
+        auto t1 = Clock::now();
+        for (size_t i = 0; i < n; ++i) {
+            size_t elemIdx = blockBeginIdx + i;
+            MaterialLaw::relativePermeabilities(mobilities[i],
+                                                problem.materialLawManager.materialLawParams(elemIdx),
+                                                fluidStates[i]);
+        }
+
+        auto t2 = Clock::now();
+        for (size_t i = 0; i < n; ++i) {
+            FluidState& fs = fluidStates[i];
+            unsigned pvtRegionIdx = fs.pvtRegionIndex();
+
+            const Evaluation& RsSat = FluidSystem::saturatedDissolutionFactor(fs, oilPhaseIdx, pvtRegionIdx);
+            if (isSaturated[i])
+                fs.setRs(RsSat);
+            else
+                fs.setRs(Evaluation::createVariable(0.7*RsSat.value(), 2));
+            fs.setRv(0.0);
+
+            for (unsigned phaseIdx = 0; phaseIdx < numPhases; ++phaseIdx) {
+                const Evaluation& b = FluidSystem::inverseFormationVolumeFactor(fs, phaseIdx, pvtRegionIdx);
+                fs.setInvB(phaseIdx, b);
+                fs.setDensity(phaseIdx, FluidSystem::density(fs, phaseIdx, pvtRegionIdx));
+
+                const Evaluation& mu = FluidSystem::viscosity(fs, phaseIdx, pvtRegionIdx);
+                mobilities[i][phaseIdx] /= mu;
+            }
+        }
+
+        auto t3 = Clock::now();
+        for (size_t i = 0; i < n; ++i) {
+            size_t elemIdx = blockBeginIdx + i;
+            problem.materialLawManager.updateHysteresis(fluidStates[i], elemIdx);
+            results[elemIdx] = cellResult(fluidStates[i], mobilities[i]);
+        }
+        auto t4 = Clock::now();
+
+        times.seconds[capillaryPressureKernel] += std::chrono::duration<double>(t1 - t0).count();
+        times.seconds[relpermKernel] += std::chrono::duration<double>(t2 - t1).count();
+        times.seconds[pvtKernel] += std::chrono::duration<double>(t3 - t2).count();
+        times.seconds[hysteresisKernel] += std::chrono::duration<double>(t4 - t3).count();
+    }
+}
+
+////////////////////
+// NUMA placement
+////////////////////
+
+// bind the calling thread to a single CPU. this keeps the threads on the NUMA node
+// where they touched their memory first
+void pinThread(unsigned threadIdx)
+{
+#if defined(__linux__)
+    unsigned numCpus = std::max(1u, std::thread::hardware_concurrency());
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    CPU_SET(threadIdx % numCpus, &cpuSet);
+    pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet);
+#else
+    (void)threadIdx;
+#endif
+}
+
+// the NUMA node of the calling thread or -1 if it cannot be determined
+int currentNumaNode()
+{
+#if defined(__linux__) && defined(SYS_getcpu)
+    unsigned cpu = 0;
+    unsigned node = 0;
+    if (syscall(SYS_getcpu, &cpu, &node, nullptr) == 0)
+        return static_cast<int>(node);
+#endif
+    return -1;
+}
+
+// the NUMA node of the page which contains an address or -1 if it cannot be
+// determined
+int pageNumaNode(const void* addr)
+{
+#if defined(__linux__) && defined(SYS_move_pages)
+    // move_pages() only reports the node of the pages if no target nodes are given
+    long pageSize = sysconf(_SC_PAGESIZE);
+    void* page = reinterpret_cast<void*>(reinterpret_cast<uintptr_t>(addr) & ~static_cast<uintptr_t>(pageSize - 1));
+    int status = -1;
+    if (syscall(SYS_move_pages, 0, 1UL, &page, nullptr, &status, 0) == 0 && status >= 0)
+        return status;
+#else
+    (void)addr;
+#endif
+    return -1;
+}
+
+struct NodeCounts
+{
+    NodeCounts()
+        : numChecked(0)
+        , numRemote(0)
+    {}
+
+    size_t numChecked;
+    size_t numRemote;
+};
+
+void countRemoteParams(const Problem& problem,
+                       unsigned threadIdx,
+                       size_t beginIdx,
+                       size_t endIdx,
+                       NodeCounts& counts)
+{
+    pinThread(threadIdx);
+    int node = currentNumaNode();
+    if (node < 0)
+        return;
+
+    for (size_t elemIdx = beginIdx; elemIdx < endIdx; ++elemIdx) {
+        int paramsNode = pageNumaNode(&problem.materialLawManager.materialLawParams(static_cast<unsigned>(elemIdx)));
+        if (paramsNode < 0)
+            continue;
+
+        ++counts.numChecked;
+        if (paramsNode != node)
+            ++counts.numRemote;
+    }
+}
+
+// the fraction of the cells whose material law parameters do not reside on the NUMA
+// node of the thread which evaluates them or a negative value if this cannot be
+// determined. only the page of the parameter object itself is considered, i.e.,
+// this is an estimate of the remote accesses
+double remoteFraction(const Problem& problem, unsigned numThreads)
+{
+    std::vector<NodeCounts> threadCounts(numThreads);
+    std::vector<std::thread> threads;
+    for (unsigned threadIdx = 0; threadIdx < numThreads; ++threadIdx) {
+        size_t beginIdx = problem.numCells*threadIdx/numThreads;
+        size_t endIdx = problem.numCells*(threadIdx + 1)/numThreads;
+        threads.emplace_back(countRemoteParams,
+                             std::cref(problem),
+                             threadIdx,
+                             beginIdx,
+                             endIdx,
+                             std::ref(threadCounts[threadIdx]));
+    }
+    for (auto& thread : threads)
+        thread.join();
+
+    NodeCounts total;
+    for (const auto& counts : threadCounts) {
+        total.numChecked += counts.numChecked;
+        total.numRemote += counts.numRemote;
+    }
+    if (total.numChecked == 0)
+        return -1.0;
+
+    return static_cast<double>(total.numRemote)/total.numChecked;
+}
+
+void firstTouchParams(Problem& problem,
+                      const std::vector<unsigned>& elementOwner,
+                      unsigned threadIdx)
+{
+    pinThread(threadIdx);
+    problem.materialLawManager.firstTouchElementParams(elementOwner, threadIdx);
+}
+
+// let each thread re-create the parameters of the cells which it evaluates
+void placeParams(Problem& problem, unsigned numThreads)
+{
+    std::vector<unsigned> elementOwner(problem.numCells);
+    for (unsigned threadIdx = 0; threadIdx < numThreads; ++threadIdx) {
+        size_t beginIdx = problem.numCells*threadIdx/numThreads;
+        size_t endIdx = problem.numCells*(threadIdx + 1)/numThreads;
+        std::fill(elementOwner.begin() + beginIdx, elementOwner.begin() + endIdx, threadIdx);
+    }
+
+    std::vector<std::thread> threads;
+    for (unsigned threadIdx = 0; threadIdx < numThreads; ++threadIdx)
+        threads.emplace_back(firstTouchParams,
+                             std::ref(problem),
+                             std::cref(elementOwner),
+                             threadIdx);
+    for (auto& thread : threads)
+        thread.join();
+}
+
+void printRemoteFraction(const char* name, double fraction)
+{
+    std::cout << "    " << std::left << std::setw(24) << name << std::right;
+    if (fraction < 0.0)
+        std::cout << std::setw(10) << "n/a";
+    else
+        std::cout << std::setw(9) << std::fixed << std::setprecision(1) << fraction*100 << "%";
+}
+
+////////////////////
+// the benchmark
+////////////////////
+
+void evaluateThread(Problem& problem,
+                    unsigned threadIdx,
+                    size_t beginIdx,
+                    size_t endIdx,
+                    std::vector<Scalar>& results,
+                    KernelTimes& times)
+{
+    pinThread(threadIdx);
+    evaluateCells(problem, beginIdx, endIdx, results, times);
+}
+
+// evaluate the first numCells cells using numThreads threads. returns the wall clock
+// time and the time spent in the kernels summed over all threads
+double evaluateParallel(Problem& problem,
+                        size_t numCells,
+                        unsigned numThreads,
+                        std::vector<Scalar>& results,
+                        KernelTimes& totalTimes)
+{
+    std::vector<KernelTimes> threadTimes(numThreads);
+    std::vector<std::thread> threads;
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (unsigned threadIdx = 0; threadIdx < numThreads; ++threadIdx) {
+        size_t beginIdx = numCells*threadIdx/numThreads;
+        size_t endIdx = numCells*(threadIdx + 1)/numThreads;
+        threads.emplace_back(evaluateThread,
+                             std::ref(problem),
+                             threadIdx,
+                             beginIdx,
+                             endIdx,
+                             std::ref(results),
+                             std::ref(threadTimes[threadIdx]));
+    }
+    for (auto& thread : threads)
+        thread.join();
+    auto end = std::chrono::high_resolution_clock::now();
+
+    totalTimes = KernelTimes();
+    for (const auto& times : threadTimes)
+        for (unsigned kernelIdx = 0; kernelIdx < numKernels; ++kernelIdx)
+            totalTimes.seconds[kernelIdx] += times.seconds[kernelIdx];
+
+    return std::chrono::duration<double>(end - start).count();
+}
+
+// returns the fastest of several runs
+double timeParallel(Problem& problem,
+                    size_t numCells,
+                    unsigned numThreads,
+                    unsigned numRepetitions,
+                    std::vector<Scalar>& results,
+                    KernelTimes& bestTimes)
+{
+    double bestTime = 1e100;
+    for (unsigned repIdx = 0; repIdx < numRepetitions; ++repIdx) {
+        KernelTimes times;
+        double time = evaluateParallel(problem, numCells, numThreads, results, times);
+        if (time < bestTime) {
+            bestTime = time;
+            bestTimes = times;
+        }
+    }
+
+    return bestTime;
+}
+
+size_t countMismatches(const std::vector<Scalar>& results,
+                       const std::vector<Scalar>& reference,
+                       size_t numCells)
+{
+    size_t numMismatches = 0;
+    for (size_t elemIdx = 0; elemIdx < numCells; ++elemIdx)
+        if (results[elemIdx] != reference[elemIdx])
+            ++numMismatches;
+    return numMismatches;
+}
+
+int runBenchmark(size_t numCells, unsigned maxThreads, const char* deckFileName)
+{
+    Opm::Parser parser;
+    const auto& deck = deckFileName
+        ? parser.parseFile(deckFileName)
+        : parser.parseString(syntheticDeck(numCells));
+    auto python = std::make_shared<Opm::Python>();
+    Opm::EclipseState eclState(deck);
+    Opm::Schedule schedule(deck, eclState, python);
+
+    auto setupStart = std::chrono::high_resolution_clock::now();
+    FluidSystem::initFromState(eclState, schedule);
+
+    Problem problem;
+    problem.numCells = eclState.getInputGrid().getNumActive();
+    problem.materialLawManager.initFromState(eclState);
+    problem.materialLawManager.initParamsForElements(eclState, problem.numCells);
+
+    problem.pvtRegionIdx.assign(problem.numCells, 0);
+    if (eclState.fieldProps().has_int("PVTNUM")) {
+        const auto& pvtnum = eclState.fieldProps().get_int("PVTNUM");
+        for (size_t elemIdx = 0; elemIdx < problem.numCells; ++elemIdx)
+            problem.pvtRegionIdx[elemIdx] = static_cast<unsigned>(pvtnum[elemIdx] - 1);
+    }
+    auto setupEnd = std::chrono::high_resolution_clock::now();
+
+    numCells = problem.numCells;
+    size_t cellsPerThread = numCells/maxThreads;
+
+    std::cout << "cells: " << numCells
+              << ", PVT regions: " << FluidSystem::numRegions()
+              << ", hysteresis: " << (problem.materialLawManager.enableHysteresis() ? "yes" : "no")
+              << ", setup: " << std::chrono::duration<double>(setupEnd - setupStart).count() << " s\n";
+
+    // the first sweep moves the hysteresis state to the one which corresponds to the
+    // saturations of the cells. the second one yields the reference results.
+    std::vector<Scalar> reference(numCells);
+    std::vector<Scalar> results(numCells);
+    KernelTimes times;
+    evaluateParallel(problem, numCells, /*numThreads=*/1, reference, times);
+    evaluateParallel(problem, numCells, /*numThreads=*/1, reference, times);
+
+    std::vector<unsigned> threadCounts;
+    for (unsigned numThreads = 1; numThreads < maxThreads; numThreads *= 2)
+        threadCounts.push_back(numThreads);
+    threadCounts.push_back(maxThreads);
+
+    const unsigned numRepetitions = 3;
+    double strongSerialTime = 0.0;
+    double weakSerialTime = 0.0;
+    size_t numMismatches = 0;
+    std::vector<KernelTimes> strongKernelTimes;
+
+    std::cout << "\n"
+              << std::setw(8) << "threads"
+              << std::setw(14) << "strong[ms]" << std::setw(12) << "Mcells/s"
+              << std::setw(10) << "speedup" << std::setw(8) << "eff."
+              << std::setw(14) << "weak[ms]" << std::setw(12) << "Mcells/s"
+              << std::setw(8) << "eff."
+              << std::setw(12) << "mismatch" << "\n";
+    for (unsigned numThreads : threadCounts) {
+        KernelTimes strongTimes;
+        double strongTime = timeParallel(problem, numCells, numThreads, numRepetitions, results, strongTimes);
+        size_t strongMismatches = countMismatches(results, reference, numCells);
+        strongKernelTimes.push_back(strongTimes);
+
+        size_t numWeakCells = cellsPerThread*numThreads;
+        KernelTimes weakTimes;
+        double weakTime = timeParallel(problem, numWeakCells, numThreads, numRepetitions, results, weakTimes);
+        size_t weakMismatches = countMismatches(results, reference, numWeakCells);
+
+        if (numThreads == 1) {
+            strongSerialTime = strongTime;
+            weakSerialTime = weakTime;
+        }
+        numMismatches += strongMismatches + weakMismatches;
+
+        std::cout << std::setw(8) << numThreads << std::fixed << std::setprecision(2)
+                  << std::setw(14) << strongTime*1e3
+                  << std::setw(12) << numCells/strongTime*1e-6
+                  << std::setw(10) << strongSerialTime/strongTime
+                  << std::setw(8) << strongSerialTime/strongTime/numThreads
+                  << std::setw(14) << weakTime*1e3
+                  << std::setw(12) << numWeakCells/weakTime*1e-6
+                  << std::setw(8) << weakSerialTime/weakTime
+                  << std::setw(12) << strongMismatches + weakMismatches << "\n";
+    }
+
+    // the kernel times are summed over all threads, i.e., an increase indicates
+    // contention for shared resources like memory bandwidth
+    std::cout << "\nkernel time per cell [ns] (strong scaling, summed over threads)\n"
+              << std::setw(8) << "threads";
+    for (unsigned kernelIdx = 0; kernelIdx < numKernels; ++kernelIdx)
+        std::cout << std::setw(16) << kernelNames[kernelIdx];
+    std::cout << "\n";
+    for (size_t i = 0; i < threadCounts.size(); ++i) {
+        std::cout << std::setw(8) << threadCounts[i];
+        for (unsigned kernelIdx = 0; kernelIdx < numKernels; ++kernelIdx)
+            std::cout << std::setw(16) << strongKernelTimes[i].seconds[kernelIdx]/numCells*1e9;
+        std::cout << "\n";
+    }
+
+    // all parameters have been allocated by the main thread so far. let each thread
+    // allocate the ones of its cells and check how this affects the run time
+    std::cout << "\nNUMA placement of the per-cell parameters (" << maxThreads << " threads)\n"
+              << "    " << std::left << std::setw(24) << "placement" << std::right
+              << std::setw(10) << "remote" << std::setw(14) << "strong[ms]"
+              << std::setw(12) << "mismatch" << "\n";
+
+    double remoteBefore = remoteFraction(problem, maxThreads);
+    double timeBefore = timeParallel(problem, numCells, maxThreads, numRepetitions, results, times);
+    size_t mismatchesBefore = countMismatches(results, reference, numCells);
+    numMismatches += mismatchesBefore;
+    printRemoteFraction("initialization", remoteBefore);
+    std::cout << std::setw(14) << std::fixed << std::setprecision(2) << timeBefore*1e3
+              << std::setw(12) << mismatchesBefore << "\n";
+
+    placeParams(problem, maxThreads);
+    double remoteAfter = remoteFraction(problem, maxThreads);
+    double timeAfter = timeParallel(problem, numCells, maxThreads, numRepetitions, results, times);
+    size_t placementMismatches = countMismatches(results, reference, numCells);
+    numMismatches += placementMismatches;
+    printRemoteFraction("first touch", remoteAfter);
+    std::cout << std::setw(14) << std::fixed << std::setprecision(2) << timeAfter*1e3
+              << std::setw(12) << placementMismatches << "\n";
+
+    if (numMismatches > 0) {
+        std::cout << "\nERROR: " << numMismatches
+                  << " results of parallel runs differ from the serial ones\n";
+        return 1;
+    }
+
+    return 0;
+}
+#endif // HAVE_ECL_INPUT
+
+int main(int argc, char **argv)
+{
+    Dune::MPIHelper::instance(argc, argv);
+
+#if HAVE_ECL_INPUT
+    size_t numCells = 100000;
+    if (argc > 1)
+        numCells = static_cast<size_t>(std::atol(argv[1]));
+
+    unsigned maxThreads = std::max(1u, std::thread::hardware_concurrency());
+    if (argc > 2)
+        maxThreads = static_cast<unsigned>(std::max(1, std::atoi(argv[2])));
+
+    const char* deckFileName = (argc > 3) ? argv[3] : nullptr;
+
+    return runBenchmark(numCells, maxThreads, deckFileName);
+#else
+    std::cerr << "This benchmark requires eclipse input support in opm-common\n";
+    return 0;
+#endif
+}
@@ -0,0 +1,207 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+
+  Consult the COPYING file in the top-level source directory of this
+  module for the precise wording of the license and the list of
+  copyright holders.
+*/
+/*!
+ * \file
+ *
+ * \brief Measures the speedup of evaluating piecewise linear tables in their
+ *        compiled form.
+ *
+ * Two kinds of tables are considered: A pressure dependent PVT table in the form
+ * of a Tabulated1DFunction and the relative permeability and capillary pressure
+ * curves of a PiecewiseLinearTwoPhaseMaterial. For both, the time required for
+ * an evaluation is measured with and without precomputed slopes and intercepts
+ * of the segments, for scalars as well as for function evaluations with
+ * derivatives.
+ */
+#include "config.h"
+
+#include <opm/material/common/Tabulated1DFunction.hpp>
+#include <opm/material/fluidmatrixinteractions/PiecewiseLinearTwoPhaseMaterial.hpp>
+#include <opm/material/fluidmatrixinteractions/MaterialTraits.hpp>
+#include <opm/material/densead/Evaluation.hpp>
+
+#include <dune/common/parallel/mpihelper.hh>
+
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <cstdlib>
+#include <cmath>
+#include <algorithm>
+
+typedef Opm::TwoPhaseMaterialTraits<double, /*wettingPhaseIdx=*/0, /*nonWettingPhaseIdx=*/1> Traits;
+typedef Opm::PiecewiseLinearTwoPhaseMaterial<Traits> MaterialLaw;
+typedef MaterialLaw::Params MaterialLawParams;
+typedef Opm::Tabulated1DFunction<double> TabulatedFunction;
+
+// creates the primary variables for function evaluations and plain scalars
+template <class Evaluation>
+struct Variable
+{
+    static Evaluation create(double value, unsigned varIdx)
+    { return Evaluation::createVariable(value, varIdx); }
+};
+
+template <>
+struct Variable<double>
+{
+    static double create(double value, unsigned /*varIdx*/)
+    { return value; }
+};
+
+// returns the average time in nanoseconds required to evaluate the PVT table
+template <class Evaluation>
+double timePvt(const TabulatedFunction& table,
+               const std::vector<double>& pressures,
+               double& checksum)
+{
+    auto start = std::chrono::high_resolution_clock::now();
+    Evaluation sum = 0.0;
+    for (size_t i = 0; i < pressures.size(); ++i) {
+        const Evaluation& p = Variable<Evaluation>::create(pressures[i], 0);
+        sum += table.eval(p, /*extrapolate=*/true);
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+
+    // make sure that the compiler cannot optimize the evaluations away
+    checksum += Opm::scalarValue(sum);
+
+    return std::chrono::duration<double>(end - start).count()/pressures.size()*1e9;
+}
+
+// returns the average time in nanoseconds required to evaluate both relative
+// permeabilities and the capillary pressure
+template <class Evaluation>
+double timeRelperm(const MaterialLawParams& params,
+                   const std::vector<double>& saturations,
+                   double& checksum)
+{
+    auto start = std::chrono::high_resolution_clock::now();
+    Evaluation sum = 0.0;
+    for (size_t i = 0; i < saturations.size(); ++i) {
+        const Evaluation& Sw = Variable<Evaluation>::create(saturations[i], 0);
+        sum += MaterialLaw::twoPhaseSatKrw(params, Sw);
+        sum += MaterialLaw::twoPhaseSatKrn(params, Sw);
+        sum += 1e-5*MaterialLaw::twoPhaseSatPcnw(params, Sw);
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+
+    checksum += Opm::scalarValue(sum);
+
+    return std::chrono::duration<double>(end - start).count()/saturations.size()*1e9;
+}
+
+void printTimes(const char* name,
+                double time, double compiledTime,
+                double timeAd, double compiledTimeAd,
+                double maxError)
+{
+    std::cout << "    " << std::left << std::setw(16) << name << std::right
+              << std::setw(11) << std::setprecision(3) << time
+              << std::setw(11) << compiledTime
+              << std::setw(11) << timeAd
+              << std::setw(11) << compiledTimeAd
+              << std::setw(12) << maxError << "\n";
+}
+
+int main(int argc, char **argv)
+{
+    Dune::MPIHelper::instance(argc, argv);
+
+    size_t numSamples = 1000000;
+    if (argc > 1)
+        numSamples = static_cast<size_t>(std::atol(argv[1]));
+
+    typedef Opm::DenseAd::Evaluation<double, 3> Evaluation;
+
+    // a formation volume factor like curve with 50 pressure samples
+    std::vector<double> pSamples, invBSamples;
+    for (int i = 0; i < 50; ++i) {
+        double p = 1e5 + i*i*2e4;
+        pSamples.push_back(p);
+        invBSamples.push_back(1.0 + 0.1*std::log(p/1e5));
+    }
+    TabulatedFunction pvtTable(pSamples, invBSamples);
+    TabulatedFunction compiledPvtTable(pvtTable);
+    compiledPvtTable.compile();
+
+    // SWOF like curves with 20 saturation samples
+    std::vector<double> SwSamples, krwSamples, krnSamples, pcnwSamples;
+    for (int i = 0; i < 20; ++i) {
+        double Sw = 0.1 + 0.8*i/19;
+        double Se = (Sw - 0.1)/0.8;
+        SwSamples.push_back(Sw);
+        krwSamples.push_back(Se*Se);
+        krnSamples.push_back((1 - Se)*(1 - Se));
+        pcnwSamples.push_back(2e5*(1 - Se));
+    }
+    MaterialLawParams params;
+    params.setKrwSamples(SwSamples, krwSamples);
+    params.setKrnSamples(SwSamples, krnSamples);
+    params.setPcnwSamples(SwSamples, pcnwSamples);
+    params.finalize();
+    MaterialLawParams compiledParams(params);
+    compiledParams.compile();
+
+    std::vector<double> pressures(numSamples);
+    std::vector<double> saturations(numSamples);
+    std::srand(1234);
+    for (size_t i = 0; i < numSamples; ++i) {
+        pressures[i] = pSamples.front() + (pSamples.back() - pSamples.front())*double(std::rand())/RAND_MAX;
+        saturations[i] = double(std::rand())/RAND_MAX;
+    }
+
+    double pvtError = 0.0;
+    double relpermError = 0.0;
+    for (size_t i = 0; i < std::min<size_t>(numSamples, 10000); ++i) {
+        pvtError = std::max(pvtError, std::abs(compiledPvtTable.eval(pressures[i]) - pvtTable.eval(pressures[i])));
+        relpermError = std::max(relpermError,
+                                std::abs(MaterialLaw::twoPhaseSatKrw(compiledParams, saturations[i])
+                                         - MaterialLaw::twoPhaseSatKrw(params, saturations[i])));
+    }
+
+    double checksum = 0.0;
+    std::cout << "    " << std::left << std::setw(16) << "table" << std::right
+              << std::setw(11) << "plain[ns]"
+              << std::setw(11) << "comp[ns]"
+              << std::setw(11) << "AD[ns]"
+              << std::setw(11) << "compAD[ns]"
+              << std::setw(12) << "max.error" << "\n";
+    printTimes("PVT (50 points)",
+               timePvt<double>(pvtTable, pressures, checksum),
+               timePvt<double>(compiledPvtTable, pressures, checksum),
+               timePvt<Evaluation>(pvtTable, pressures, checksum),
+               timePvt<Evaluation>(compiledPvtTable, pressures, checksum),
+               pvtError);
+    printTimes("kr/pc (20 pts)",
+               timeRelperm<double>(params, saturations, checksum),
+               timeRelperm<double>(compiledParams, saturations, checksum),
+               timeRelperm<Evaluation>(params, saturations, checksum),
+               timeRelperm<Evaluation>(compiledParams, saturations, checksum),
+               relpermError);
+
+    std::cout << "checksum: " << checksum << "\n";
+
+    return 0;
+}
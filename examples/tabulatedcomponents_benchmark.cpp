@@ -0,0 +1,329 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+
+  Consult the COPYING file in the top-level source directory of this
+  module for the precise wording of the license and the list of
+  copyright holders.
+*/
+/*!
+ * \file
+ *
+ * \brief Measures the speedup of evaluating the properties of the components
+ *        used by the fluid systems using TabulatedComponent.
+ *
+ * For each component, the tables are created with the resolution required
+ * for a given tolerance (which can be specified as the first command line
+ * argument). Then, the time required for evaluating some quantities is
+ * measured for the raw and the tabulated component as well as for scalars
+ * and for function evaluations with derivatives.
+ *
+ * Finally, the H2O-air fluid system is benchmarked: The time for creating the
+ * tables of water for all quantities is compared to the one for the quantities
+ * which are used by the fluid system, and the evaluation of the fluid system
+ * is timed with the raw and with the tabulated water component.
+ */
+#include "config.h"
+
+#include <opm/material/components/Air.hpp>
+#include <opm/material/components/N2.hpp>
+#include <opm/material/components/H2O.hpp>
+#include <opm/material/components/Brine.hpp>
+#include <opm/material/components/SimpleHuDuanH2O.hpp>
+#include <opm/material/components/Mesitylene.hpp>
+#include <opm/material/components/Xylene.hpp>
+#include <opm/material/components/TabulatedComponent.hpp>
+#include <opm/material/fluidsystems/H2OAirFluidSystem.hpp>
+#include <opm/material/fluidstates/CompositionalFluidState.hpp>
+#include <opm/material/densead/Evaluation.hpp>
+
+#include <dune/common/parallel/mpihelper.hh>
+
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <cstdlib>
+#include <cmath>
+#include <algorithm>
+
+struct GasDensity
+{
+    static const char* name() { return "gasDensity"; }
+    template <class Component, class Evaluation>
+    static Evaluation eval(const Evaluation& T, const Evaluation& p)
+    { return Component::gasDensity(T, p); }
+};
+
+struct GasViscosity
+{
+    static const char* name() { return "gasViscosity"; }
+    template <class Component, class Evaluation>
+    static Evaluation eval(const Evaluation& T, const Evaluation& p)
+    { return Component::gasViscosity(T, p); }
+};
+
+struct GasEnthalpy
+{
+    static const char* name() { return "gasEnthalpy"; }
+    template <class Component, class Evaluation>
+    static Evaluation eval(const Evaluation& T, const Evaluation& p)
+    { return Component::gasEnthalpy(T, p); }
+};
+
+struct LiquidDensity
+{
+    static const char* name() { return "liquidDensity"; }
+    template <class Component, class Evaluation>
+    static Evaluation eval(const Evaluation& T, const Evaluation& p)
+    { return Component::liquidDensity(T, p); }
+};
+
+struct LiquidViscosity
+{
+    static const char* name() { return "liquidViscosity"; }
+    template <class Component, class Evaluation>
+    static Evaluation eval(const Evaluation& T, const Evaluation& p)
+    { return Component::liquidViscosity(T, p); }
+};
+
+struct LiquidEnthalpy
+{
+    static const char* name() { return "liquidEnthalpy"; }
+    template <class Component, class Evaluation>
+    static Evaluation eval(const Evaluation& T, const Evaluation& p)
+    { return Component::liquidEnthalpy(T, p); }
+};
+
+// creates the primary variables for function evaluations and plain scalars
+template <class Evaluation>
+struct Variable
+{
+    static Evaluation create(double value, unsigned varIdx)
+    { return Evaluation::createVariable(value, varIdx); }
+};
+
+template <>
+struct Variable<double>
+{
+    static double create(double value, unsigned /*varIdx*/)
+    { return value; }
+};
+
+// returns the average time in nanoseconds required to evaluate a quantity
+template <class Evaluation, class Quantity, class Component>
+double timeQuantity(const std::vector<double>& temperatures,
+                    const std::vector<double>& pressures,
+                    double& checksum)
+{
+    auto start = std::chrono::high_resolution_clock::now();
+    Evaluation sum = 0.0;
+    for (size_t i = 0; i < temperatures.size(); ++i) {
+        const Evaluation& T = Variable<Evaluation>::create(temperatures[i], 0);
+        const Evaluation& p = Variable<Evaluation>::create(pressures[i], 1);
+        sum += Quantity::template eval<Component>(T, p);
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+
+    // make sure that the compiler cannot optimize the evaluations away
+    checksum += Opm::scalarValue(sum);
+
+    return std::chrono::duration<double>(end - start).count()/temperatures.size()*1e9;
+}
+
+template <class Quantity, class RawComponent, class TabulatedComponent>
+void benchmarkQuantity(const std::vector<double>& temperatures,
+                       const std::vector<double>& pressures,
+                       double& checksum)
+{
+    typedef Opm::DenseAd::Evaluation<double, 2> Evaluation;
+
+    double maxError = 0.0;
+    for (size_t i = 0; i < temperatures.size(); ++i) {
+        double raw = Quantity::template eval<RawComponent>(temperatures[i], pressures[i]);
+        double tabulated = Quantity::template eval<TabulatedComponent>(temperatures[i], pressures[i]);
+        maxError = std::max(maxError, std::abs(tabulated - raw)/std::abs(raw));
+    }
+
+    double rawTime = timeQuantity<double, Quantity, RawComponent>(temperatures, pressures, checksum);
+    double tabTime = timeQuantity<double, Quantity, TabulatedComponent>(temperatures, pressures, checksum);
+    double rawTimeAd = timeQuantity<Evaluation, Quantity, RawComponent>(temperatures, pressures, checksum);
+    double tabTimeAd = timeQuantity<Evaluation, Quantity, TabulatedComponent>(temperatures, pressures, checksum);
+
+    std::cout << "    " << std::left << std::setw(16) << Quantity::name() << std::right
+              << std::setw(10) << std::setprecision(3) << rawTime
+              << std::setw(10) << tabTime
+              << std::setw(10) << rawTimeAd
+              << std::setw(10) << tabTimeAd
+              << std::setw(12) << maxError << "\n";
+}
+
+template <class RawComponent, bool gas, bool liquid>
+void benchmarkComponent(const char* fluidSystems,
+                        double tempMin, double tempMax,
+                        double pressMin, double pressMax,
+                        double tolerance,
+                        size_t numSamples,
+                        double& checksum)
+{
+    typedef Opm::TabulatedComponent<double, RawComponent, /*useVaporPressure=*/false> TabulatedComponent;
+
+    unsigned properties = 0;
+    if (gas)
+        properties |= TabulatedComponent::GasDensity | TabulatedComponent::GasViscosity | TabulatedComponent::GasEnthalpy;
+    if (liquid)
+        properties |= TabulatedComponent::LiquidDensity | TabulatedComponent::LiquidViscosity | TabulatedComponent::LiquidEnthalpy;
+
+    auto start = std::chrono::high_resolution_clock::now();
+    double error = TabulatedComponent::initWithTolerance(tempMin, tempMax, pressMin, pressMax, tolerance, properties);
+    auto end = std::chrono::high_resolution_clock::now();
+
+    std::cout << RawComponent::name() << " (used by " << fluidSystems << "): "
+              << "tabulation error " << error << ", "
+              << std::chrono::duration<double>(end - start).count() << " s for creating the tables\n"
+              << "    quantity        raw[ns]   tab[ns] rawAD[ns] tabAD[ns]  max.error\n";
+
+    // random temperatures and pressures within the tabulated range
+    std::vector<double> temperatures(numSamples);
+    std::vector<double> pressures(numSamples);
+    std::srand(1234);
+    for (size_t i = 0; i < numSamples; ++i) {
+        temperatures[i] = tempMin + (tempMax - tempMin)*double(std::rand())/RAND_MAX;
+        pressures[i] = pressMin + (pressMax - pressMin)*double(std::rand())/RAND_MAX;
+    }
+
+    if (gas) {
+        benchmarkQuantity<GasDensity, RawComponent, TabulatedComponent>(temperatures, pressures, checksum);
+        benchmarkQuantity<GasViscosity, RawComponent, TabulatedComponent>(temperatures, pressures, checksum);
+        benchmarkQuantity<GasEnthalpy, RawComponent, TabulatedComponent>(temperatures, pressures, checksum);
+    }
+    if (liquid) {
+        benchmarkQuantity<LiquidDensity, RawComponent, TabulatedComponent>(temperatures, pressures, checksum);
+        benchmarkQuantity<LiquidViscosity, RawComponent, TabulatedComponent>(temperatures, pressures, checksum);
+        benchmarkQuantity<LiquidEnthalpy, RawComponent, TabulatedComponent>(temperatures, pressures, checksum);
+    }
+}
+
+// returns the average time in nanoseconds required to evaluate the densities,
+// viscosities and enthalpies of all phases of a fluid system
+template <class FluidSystem>
+double timeFluidSystem(const std::vector<double>& temperatures,
+                       const std::vector<double>& pressures,
+                       double& checksum)
+{
+    Opm::CompositionalFluidState<double, FluidSystem> fs;
+    typename FluidSystem::template ParameterCache<double> paramCache;
+
+    auto start = std::chrono::high_resolution_clock::now();
+    double sum = 0.0;
+    for (size_t i = 0; i < temperatures.size(); ++i) {
+        fs.setTemperature(temperatures[i]);
+        for (unsigned phaseIdx = 0; phaseIdx < FluidSystem::numPhases; ++phaseIdx) {
+            fs.setPressure(phaseIdx, pressures[i]);
+            fs.setMoleFraction(phaseIdx, FluidSystem::H2OIdx, 0.5);
+            fs.setMoleFraction(phaseIdx, FluidSystem::AirIdx, 0.5);
+        }
+
+        for (unsigned phaseIdx = 0; phaseIdx < FluidSystem::numPhases; ++phaseIdx) {
+            sum += FluidSystem::density(fs, paramCache, phaseIdx);
+            sum += FluidSystem::viscosity(fs, paramCache, phaseIdx);
+            sum += FluidSystem::enthalpy(fs, paramCache, phaseIdx);
+        }
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+
+    checksum += sum;
+
+    return std::chrono::duration<double>(end - start).count()/temperatures.size()*1e9;
+}
+
+void benchmarkH2OAirFluidSystem(double tempMin, double tempMax,
+                                double pressMin, double pressMax,
+                                double tolerance,
+                                size_t numSamples,
+                                double& checksum)
+{
+    typedef Opm::TabulatedComponent<double, Opm::H2O<double> > TabulatedH2O;
+    typedef Opm::H2OAirFluidSystem<double, TabulatedH2O> FluidSystem;
+    typedef Opm::H2OAirFluidSystem<double, Opm::H2O<double> > RawFluidSystem;
+
+    auto start = std::chrono::high_resolution_clock::now();
+    TabulatedH2O::initWithTolerance(tempMin, tempMax, pressMin, pressMax, tolerance);
+    auto end = std::chrono::high_resolution_clock::now();
+    double allTime = std::chrono::duration<double>(end - start).count();
+
+    start = std::chrono::high_resolution_clock::now();
+    double error = FluidSystem::initWithTolerance(tempMin, tempMax, pressMin, pressMax, tolerance);
+    end = std::chrono::high_resolution_clock::now();
+    double selectiveTime = std::chrono::duration<double>(end - start).count();
+
+    std::vector<double> temperatures(numSamples);
+    std::vector<double> pressures(numSamples);
+    std::srand(1234);
+    for (size_t i = 0; i < numSamples; ++i) {
+        temperatures[i] = tempMin + (tempMax - tempMin)*double(std::rand())/RAND_MAX;
+        pressures[i] = pressMin + (pressMax - pressMin)*double(std::rand())/RAND_MAX;
+    }
+
+    double rawTime = timeFluidSystem<RawFluidSystem>(temperatures, pressures, checksum);
+    double tabTime = timeFluidSystem<FluidSystem>(temperatures, pressures, checksum);
+
+    std::cout << "H2OAirFluidSystem: tabulation error " << error << "\n"
+              << "    " << allTime << " s for creating the tables of all quantities of water, "
+              << selectiveTime << " s for the quantities used by the fluid system\n"
+              << "    raw[ns] " << std::setprecision(3) << rawTime
+              << ", tab[ns] " << tabTime << " for evaluating the fluid system\n";
+}
+
+int main(int argc, char **argv)
+{
+    Dune::MPIHelper::instance(argc, argv);
+
+    double tolerance = 1e-4;
+    if (argc > 1)
+        tolerance = std::atof(argv[1]);
+    const size_t numSamples = 200000;
+
+    typedef Opm::Brine<double, Opm::H2O<double> > Brine;
+    Brine::salinity = 0.1;
+
+    double checksum = 0.0;
+    benchmarkComponent<Opm::N2<double>, /*gas=*/true, /*liquid=*/false>
+        ("H2ON2FluidSystem, H2ON2LiquidPhaseFluidSystem",
+         280.0, 400.0, 1e5, 50e6, tolerance, numSamples, checksum);
+    benchmarkComponent<Opm::Air<double>, /*gas=*/true, /*liquid=*/false>
+        ("H2OAirFluidSystem, H2OAirMesityleneFluidSystem, H2OAirXyleneFluidSystem",
+         280.0, 400.0, 1e5, 50e6, tolerance, numSamples, checksum);
+    benchmarkComponent<Opm::Mesitylene<double>, /*gas=*/true, /*liquid=*/true>
+        ("H2OAirMesityleneFluidSystem",
+         280.0, 400.0, 1e5, 1e6, tolerance, numSamples, checksum);
+    benchmarkComponent<Opm::Xylene<double>, /*gas=*/true, /*liquid=*/true>
+        ("H2OAirXyleneFluidSystem",
+         280.0, 400.0, 1e5, 1e6, tolerance, numSamples, checksum);
+    benchmarkComponent<Brine, /*gas=*/false, /*liquid=*/true>
+        ("BrineCO2FluidSystem",
+         280.0, 400.0, 1e5, 50e6, tolerance, numSamples, checksum);
+    benchmarkComponent<Opm::SimpleHuDuanH2O<double>, /*gas=*/false, /*liquid=*/true>
+        ("BrineCo2Pvt",
+         280.0, 400.0, 1e5, 50e6, tolerance, numSamples, checksum);
+
+    benchmarkH2OAirFluidSystem(280.0, 400.0, 1e5, 10e6, tolerance, numSamples, checksum);
+
+    std::cout << "checksum: " << checksum << "\n";
+
+    return 0;
+}
@@ -0,0 +1,357 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+
+  Consult the COPYING file in the top-level source directory of this
+  module for the precise wording of the license and the list of
+  copyright holders.
+*/
+/*!
+ * \file
+ *
+ * \copydoc Opm::BinaryCoeff::Brine_CO2SolubilityTable
+ */
+#ifndef OPM_BINARY_COEFF_BRINE_CO2_SOLUBILITY_TABLE_HPP
+#define OPM_BINARY_COEFF_BRINE_CO2_SOLUBILITY_TABLE_HPP
+
+#include <opm/material/common/UniformTabulated2DFunction.hpp>
+#include <opm/material/common/MathToolbox.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <cassert>
+
+namespace Opm {
+namespace BinaryCoeff {
+
+/*!
+ * \ingroup Binarycoefficients
+ *
+ * \brief A tabulated surrogate for the mutual solubilities of brine and CO2.
+ *
+ * Evaluating the solubility model of Spycher and Pruess (2005) which is implemented
+ * by Opm::BinaryCoeff::Brine_CO2::calculateMoleFractions() is quite expensive
+ * because it requires fugacity coefficients, activity coefficients and
+ * equilibrium constants. Since the salinity is constant for a given brine, this
+ * class samples the mole fraction of CO2 in the liquid and the one of water in the
+ * gas phase on a grid which is uniform in temperature and in the logarithm of
+ * pressure. (The mole fraction of water in the gas phase roughly scales with the
+ * inverse of the pressure, so logarithmic pressure sampling is considerably more
+ * economic than linear one.) The grid is refined until the
+ * relative error of the bilinear interpolant at the midpoints of all grid edges is
+ * below a user specified tolerance (or the maximum number of sampling points has
+ * been reached). Since the correlation may cross zero for high temperatures and low
+ * pressures, the error is measured relative to the maximum of the local value and a
+ * thousandth of the largest sampled value.
+ *
+ * Since the interpolation is done on the full Evaluation, the derivatives which
+ * are returned are the exact derivatives of the interpolant. For temperatures and
+ * pressures outside of the tabulated range, the underlying correlation is used.
+ *
+ * \tparam Scalar The type used for scalar values
+ * \tparam BinaryCoeffBrineCO2 The binary coefficient class which is to be tabulated,
+ *                             i.e., an instance of Opm::BinaryCoeff::Brine_CO2
+ */
+template <class Scalar, class BinaryCoeffBrineCO2>
+class Brine_CO2SolubilityTable
+{
+    typedef Opm::UniformTabulated2DFunction<Scalar> TabulatedFunction;
+
+public:
+    Brine_CO2SolubilityTable()
+        : pressMin_(0.0)
+        , pressMax_(0.0)
+        , salinity_(0.0)
+        , tolerance_(0.0)
+        , maxError_(0.0)
+        , xlCO2Scale_(0.0)
+        , ygH2OScale_(0.0)
+        , isInitialized_(false)
+    { }
+
+    /*!
+     * \brief Sample the solubilities for a given salinity.
+     *
+     * \param salinity The salinity of the brine [kg NaCl / kg solution]
+     * \param tempMin The minimum of the temperature range [K]
+     * \param tempMax The maximum of the temperature range [K]
+     * \param pressMin The minimum of the pressure range [Pa]
+     * \param pressMax The maximum of the pressure range [Pa]
+     * \param tolerance The maximum relative error of the interpolated mole fractions
+     * \param maxSamples The maximum number of sampling points per axis
+     */
+    void init(Scalar salinity,
+              Scalar tempMin, Scalar tempMax,
+              Scalar pressMin, Scalar pressMax,
+              Scalar tolerance = 1e-3,
+              unsigned maxSamples = 512)
+    {
+        assert(tempMin < tempMax);
+        assert(pressMin < pressMax);
+        assert(tolerance > 0.0);
+
+        salinity_ = salinity;
+        tolerance_ = tolerance;
+
+        unsigned nTemp = 8;
+        unsigned nPress = 8;
+        while (true) {
+            sample_(tempMin, tempMax, nTemp, pressMin, pressMax, nPress);
+
+            Scalar errTemp = 0.0;
+            Scalar errPress = 0.0;
+            interpolationError_(errTemp, errPress);
+            maxError_ = std::max(errTemp, errPress);
+
+            bool refineTemp = errTemp > tolerance && nTemp < maxSamples;
+            bool refinePress = errPress > tolerance && nPress < maxSamples;
+            if (!refineTemp && !refinePress)
+                break;
+
+            // the nodes of the refined grid include those of the coarse one
+            if (refineTemp)
+                nTemp = std::min(maxSamples, 2*nTemp - 1);
+            if (refinePress)
+                nPress = std::min(maxSamples, 2*nPress - 1);
+        }
+
+        isInitialized_ = true;
+    }
+
+    /*!
+     * \brief Returns true iff the tables have been sampled.
+     */
+    bool isInitialized() const
+    { return isInitialized_; }
+
+    /*!
+     * \brief Returns the salinity [kg NaCl / kg solution] used to sample the tables.
+     */
+    Scalar salinity() const
+    { return salinity_; }
+
+    /*!
+     * \brief Returns the tolerance which was requested for the relative error.
+     */
+    Scalar tolerance() const
+    { return tolerance_; }
+
+    /*!
+     * \brief Returns the maximum relative error which was observed at the test points.
+     *
+     * This may be larger than tolerance() if the maximum number of sampling points
+     * was reached.
+     */
+    Scalar maxError() const
+    { return maxError_; }
+
+    /*!
+     * \brief Returns the number of sampling points on the temperature axis.
+     */
+    unsigned numTemperatureSamples() const
+    { return xlCO2_.numX(); }
+
+    /*!
+     * \brief Returns the number of sampling points on the pressure axis.
+     */
+    unsigned numPressureSamples() const
+    { return xlCO2_.numY(); }
+
+    /*!
+     * \brief Returns true iff a temperature-pressure pair lies in the tabulated range.
+     */
+    template <class Evaluation>
+    bool applies(const Evaluation& temperature, const Evaluation& pg) const
+    {
+        return
+            isInitialized_ &&
+            xlCO2_.xMin() <= temperature && temperature <= xlCO2_.xMax() &&
+            pressMin_ <= pg && pg <= pressMax_;
+    }
+
+    /*!
+     * \brief Returns the mole fractions of CO2 in the liquid and of water in the gas
+     *        phase if both phases are present.
+     *
+     * This is the tabulated equivalent of
+     * Brine_CO2::calculateMoleFractions(T, pg, salinity, -1, xlCO2, ygH2O).
+     *
+     * \param temperature the temperature [K]
+     * \param pg the gas phase pressure [Pa]
+     * \param xlCO2 mole fraction of CO2 in brine [mol/mol]
+     * \param ygH2O mole fraction of water in the gas phase [mol/mol]
+     */
+    template <class Evaluation>
+    void calculateMoleFractions(const Evaluation& temperature,
+                                const Evaluation& pg,
+                                Evaluation& xlCO2,
+                                Evaluation& ygH2O) const
+    {
+        if (!applies(temperature, pg)) {
+            BinaryCoeffBrineCO2::calculateMoleFractions(temperature,
+                                                        pg,
+                                                        salinity_,
+                                                        /*knownPhaseIdx=*/-1,
+                                                        xlCO2,
+                                                        ygH2O);
+            return;
+        }
+
+        // the logarithm of the pressure is clamped to the table range to guard
+        // against roundoff at the upper and lower ends of the pressure range
+        Evaluation lnPg = Opm::log(pg);
+        if (lnPg < xlCO2_.yMin())
+            lnPg = xlCO2_.yMin();
+        else if (lnPg > xlCO2_.yMax())
+            lnPg = xlCO2_.yMax();
+
+        xlCO2 = xlCO2_.eval(temperature, lnPg);
+        ygH2O = ygH2O_.eval(temperature, lnPg);
+    }
+
+    bool operator==(const Brine_CO2SolubilityTable<Scalar, BinaryCoeffBrineCO2>& data) const
+    {
+        return isInitialized_ == data.isInitialized_ &&
+               salinity_ == data.salinity_ &&
+               tolerance_ == data.tolerance_ &&
+               (!isInitialized_ || (xlCO2_ == data.xlCO2_ && ygH2O_ == data.ygH2O_));
+    }
+
+    template <class Serializer>
+    void serializeOp(Serializer& serializer)
+    {
+        serializer(xlCO2_);
+        serializer(ygH2O_);
+        serializer(pressMin_);
+        serializer(pressMax_);
+        serializer(salinity_);
+        serializer(tolerance_);
+        serializer(maxError_);
+        serializer(xlCO2Scale_);
+        serializer(ygH2OScale_);
+        serializer(isInitialized_);
+    }
+
+private:
+    void sample_(Scalar tempMin, Scalar tempMax, unsigned nTemp,
+                 Scalar pressMin, Scalar pressMax, unsigned nPress)
+    {
+        pressMin_ = pressMin;
+        pressMax_ = pressMax;
+
+        Scalar lnPressMin = std::log(pressMin);
+        Scalar lnPressMax = std::log(pressMax);
+        xlCO2_.resize(tempMin, tempMax, nTemp, lnPressMin, lnPressMax, nPress);
+        ygH2O_.resize(tempMin, tempMax, nTemp, lnPressMin, lnPressMax, nPress);
+
+        for (unsigned i = 0; i < nTemp; ++i) {
+            Scalar T = xlCO2_.iToX(i);
+            for (unsigned j = 0; j < nPress; ++j) {
+                Scalar pg = std::exp(xlCO2_.jToY(j));
+
+                Scalar xlCO2;
+                Scalar ygH2O;
+                exactMoleFractions_(T, pg, xlCO2, ygH2O);
+                xlCO2_.setSamplePoint(i, j, xlCO2);
+                ygH2O_.setSamplePoint(i, j, ygH2O);
+            }
+        }
+    }
+
+    // determine the maximum relative error of the interpolant at the midpoints of
+    // the grid edges. the error along the temperature axis and the one along the
+    // pressure axis are reported separately so that only the axis which needs it
+    // gets refined.
+    void interpolationError_(Scalar& errTemp, Scalar& errPress)
+    {
+        unsigned nTemp = xlCO2_.numX();
+        unsigned nPress = xlCO2_.numY();
+
+        Scalar xlCO2Max = 0.0;
+        Scalar ygH2OMax = 0.0;
+        for (unsigned i = 0; i < nTemp; ++i) {
+            for (unsigned j = 0; j < nPress; ++j) {
+                xlCO2Max = std::max(xlCO2Max, std::abs(xlCO2_.getSamplePoint(i, j)));
+                ygH2OMax = std::max(ygH2OMax, std::abs(ygH2O_.getSamplePoint(i, j)));
+            }
+        }
+        xlCO2Scale_ = std::max(Scalar(1e-3)*xlCO2Max, std::numeric_limits<Scalar>::min());
+        ygH2OScale_ = std::max(Scalar(1e-3)*ygH2OMax, std::numeric_limits<Scalar>::min());
+
+        errTemp = 0.0;
+        errPress = 0.0;
+        for (unsigned i = 0; i < nTemp; ++i) {
+            for (unsigned j = 0; j < nPress; ++j) {
+                Scalar T = xlCO2_.iToX(i);
+                Scalar lnPg = xlCO2_.jToY(j);
+
+                if (i + 1 < nTemp) {
+                    Scalar Tmid = (T + xlCO2_.iToX(i + 1))/2;
+                    errTemp = std::max(errTemp, relativeError_(Tmid, lnPg));
+                }
+
+                if (j + 1 < nPress) {
+                    Scalar lnPgMid = (lnPg + xlCO2_.jToY(j + 1))/2;
+                    errPress = std::max(errPress, relativeError_(T, lnPgMid));
+                }
+            }
+        }
+    }
+
+    Scalar relativeError_(Scalar T, Scalar lnPg) const
+    {
+        Scalar xlCO2;
+        Scalar ygH2O;
+        exactMoleFractions_(T, std::exp(lnPg), xlCO2, ygH2O);
+
+        Scalar errXl = std::abs(xlCO2_.eval(T, lnPg) - xlCO2)/std::max(std::abs(xlCO2), xlCO2Scale_);
+        Scalar errYg = std::abs(ygH2O_.eval(T, lnPg) - ygH2O)/std::max(std::abs(ygH2O), ygH2OScale_);
+        return std::max(errXl, errYg);
+    }
+
+    void exactMoleFractions_(Scalar T, Scalar pg, Scalar& xlCO2, Scalar& ygH2O) const
+    {
+        BinaryCoeffBrineCO2::calculateMoleFractions(T,
+                                                    pg,
+                                                    salinity_,
+                                                    /*knownPhaseIdx=*/-1,
+                                                    xlCO2,
+                                                    ygH2O);
+    }
+
+    // the tables use the temperature as x and the logarithm of the pressure as y axis
+    TabulatedFunction xlCO2_;
+    TabulatedFunction ygH2O_;
+
+    Scalar pressMin_;
+    Scalar pressMax_;
+
+    Scalar salinity_;
+    Scalar tolerance_;
+    Scalar maxError_;
+
+    // lower bounds for the magnitude used to compute the relative error
+    Scalar xlCO2Scale_;
+    Scalar ygH2OScale_;
+    bool isInitialized_;
+};
+
+} // namespace BinaryCoeff
+} // namespace Opm
+
+#endif
@@ -0,0 +1,260 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+
+  Consult the COPYING file in the top-level source directory of this
+  module for the precise wording of the license and the list of
+  copyright holders.
+*/
+/*!
+ * \file
+ * \copydoc Opm::BatchedLuSolver
+ */
+#ifndef OPM_BATCHED_LU_SOLVER_HPP
+#define OPM_BATCHED_LU_SOLVER_HPP
+
+#include <vector>
+#include <cmath>
+#include <cassert>
+#include <utility>
+
+namespace Opm {
+
+/*!
+ * \brief Solves a batch of small dense linear systems which all exhibit
+ *        the same number of rows using an LU decomposition.
+ *
+ * Like for BatchedTridiagonalSolver, the coefficients of the systems are
+ * stored interleaved, i.e., the entries (i, j) of all systems are adjacent
+ * in memory. The innermost loops of the decomposition run over the systems,
+ * so that the compiler can vectorize them.
+ *
+ * Rows are pivoted individually for each system. The decomposition is
+ * retained, so further right hand sides of a system can be solved for
+ * afterwards. These may be of any type which supports the arithmetic
+ * operations with scalars, e.g., function evaluations for automatic
+ * differentiation.
+ */
+template <class Scalar, unsigned numRows>
+class BatchedLuSolver
+{
+public:
+    explicit BatchedLuSolver(size_t numSystems = 0)
+    { resize(numSystems); }
+
+    /*!
+     * \brief Change the number of systems.
+     *
+     * All coefficients are reset to zero.
+     */
+    void resize(size_t numSystems)
+    {
+        numSystems_ = numSystems;
+
+        A_.assign(numRows*numRows*numSystems, 0.0);
+        b_.assign(numRows*numSystems, 0.0);
+        x_.assign(numRows*numSystems, 0.0);
+        pivot_.assign(numRows*numSystems, 0);
+        singular_.assign(numSystems, 0);
+    }
+
+    /*!
+     * \brief Return the number of systems of the batch.
+     */
+    size_t numSystems() const
+    { return numSystems_; }
+
+    /*!
+     * \brief An entry of the matrix of a system.
+     *
+     * After factorize() has been called, this is the entry of the
+     * decomposition.
+     */
+    Scalar& matrix(size_t sysIdx, unsigned rowIdx, unsigned colIdx)
+    { return A_[(rowIdx*numRows + colIdx)*numSystems_ + sysIdx]; }
+
+    Scalar matrix(size_t sysIdx, unsigned rowIdx, unsigned colIdx) const
+    { return A_[(rowIdx*numRows + colIdx)*numSystems_ + sysIdx]; }
+
+    /*!
+     * \brief An entry of the right hand side of a system.
+     */
+    Scalar& rhs(size_t sysIdx, unsigned rowIdx)
+    { return b_[rowIdx*numSystems_ + sysIdx]; }
+
+    Scalar rhs(size_t sysIdx, unsigned rowIdx) const
+    { return b_[rowIdx*numSystems_ + sysIdx]; }
+
+    /*!
+     * \brief An entry of the solution of a system after calling solve().
+     */
+    Scalar solution(size_t sysIdx, unsigned rowIdx) const
+    { return x_[rowIdx*numSystems_ + sysIdx]; }
+
+    /*!
+     * \brief Returns true if the matrix of a system was found to be
+     *        singular by factorize().
+     */
+    bool isSingular(size_t sysIdx) const
+    { return singular_[sysIdx] != 0; }
+
+    /*!
+     * \brief Compute the LU decomposition of all matrices using partial
+     *        pivoting.
+     *
+     * Returns false if at least one of the matrices is singular. The
+     * solutions of these systems are undefined.
+     */
+    bool factorize()
+    {
+        const size_t m = numSystems_;
+        bool allRegular = true;
+
+        for (size_t s = 0; s < m; ++s)
+            singular_[s] = 0;
+
+        for (unsigned k = 0; k < numRows; ++k) {
+            // find the pivot row for all systems
+            unsigned* piv = &pivot_[k*m];
+            for (size_t s = 0; s < m; ++s) {
+                unsigned p = k;
+                Scalar maxAbs = std::abs(A_[(k*numRows + k)*m + s]);
+                for (unsigned r = k + 1; r < numRows; ++r) {
+                    Scalar a = std::abs(A_[(r*numRows + k)*m + s]);
+                    if (a > maxAbs) {
+                        maxAbs = a;
+                        p = r;
+                    }
+                }
+                piv[s] = p;
+
+                if (!(maxAbs > 0.0)) {
+                    singular_[s] = 1;
+                    allRegular = false;
+                }
+            }
+
+            // swap the rows. for well conditioned matrices, this is rarely
+            // necessary
+            for (size_t s = 0; s < m; ++s) {
+                if (piv[s] == k)
+                    continue;
+                for (unsigned c = 0; c < numRows; ++c)
+                    std::swap(A_[(k*numRows + c)*m + s], A_[(piv[s]*numRows + c)*m + s]);
+            }
+
+            // eliminate the entries below the diagonal. the multipliers are
+            // stored in place of the eliminated entries
+            const Scalar* Akk = &A_[(k*numRows + k)*m];
+            for (unsigned r = k + 1; r < numRows; ++r) {
+                Scalar* Ark = &A_[(r*numRows + k)*m];
+                for (size_t s = 0; s < m; ++s)
+                    Ark[s] = singular_[s] ? Scalar(0.0) : Ark[s]/Akk[s];
+
+                for (unsigned c = k + 1; c < numRows; ++c) {
+                    Scalar* Arc = &A_[(r*numRows + c)*m];
+                    const Scalar* Akc = &A_[(k*numRows + c)*m];
+                    for (size_t s = 0; s < m; ++s)
+                        Arc[s] -= Ark[s]*Akc[s];
+                }
+            }
+        }
+
+        return allRegular;
+    }
+
+    /*!
+     * \brief Solve all systems for the right hand sides specified via
+     *        rhs().
+     *
+     * factorize() must have been called before.
+     */
+    void solve()
+    {
+        const size_t m = numSystems_;
+        x_ = b_;
+
+        // forward substitution
+        for (unsigned k = 0; k < numRows; ++k) {
+            const unsigned* piv = &pivot_[k*m];
+            for (size_t s = 0; s < m; ++s)
+                if (piv[s] != k)
+                    std::swap(x_[k*m + s], x_[piv[s]*m + s]);
+
+            for (unsigned r = k + 1; r < numRows; ++r) {
+                const Scalar* Ark = &A_[(r*numRows + k)*m];
+                for (size_t s = 0; s < m; ++s)
+                    x_[r*m + s] -= Ark[s]*x_[k*m + s];
+            }
+        }
+
+        // back substitution
+        for (int r = numRows - 1; r >= 0; --r) {
+            for (unsigned c = r + 1; c < numRows; ++c) {
+                const Scalar* Arc = &A_[(r*numRows + c)*m];
+                for (size_t s = 0; s < m; ++s)
+                    x_[r*m + s] -= Arc[s]*x_[c*m + s];
+            }
+
+            const Scalar* Arr = &A_[(r*numRows + r)*m];
+            for (size_t s = 0; s < m; ++s)
+                x_[r*m + s] = singular_[s] ? Scalar(0.0) : x_[r*m + s]/Arr[s];
+        }
+    }
+
+    /*!
+     * \brief Solve a single system of the batch for an arbitrary right
+     *        hand side.
+     *
+     * On entry, x contains the right hand side, on exit, the solution.
+     * factorize() must have been called before and the system must not
+     * be singular.
+     */
+    template <class Vector>
+    void solve(size_t sysIdx, Vector& x) const
+    {
+        assert(!isSingular(sysIdx));
+
+        for (unsigned k = 0; k < numRows; ++k) {
+            unsigned p = pivot_[k*numSystems_ + sysIdx];
+            if (p != k)
+                std::swap(x[k], x[p]);
+
+            for (unsigned r = k + 1; r < numRows; ++r)
+                x[r] -= matrix(sysIdx, r, k)*x[k];
+        }
+
+        for (int r = numRows - 1; r >= 0; --r) {
+            for (unsigned c = r + 1; c < numRows; ++c)
+                x[r] -= matrix(sysIdx, r, c)*x[c];
+            x[r] /= matrix(sysIdx, r, r);
+        }
+    }
+
+private:
+    size_t numSystems_;
+
+    std::vector<Scalar> A_;
+    std::vector<Scalar> b_;
+    std::vector<Scalar> x_;
+    std::vector<unsigned> pivot_;
+    std::vector<unsigned char> singular_;
+};
+
+} // namespace Opm
+
+#endif
@@ -0,0 +1,320 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+
+  Consult the COPYING file in the top-level source directory of this
+  module for the precise wording of the license and the list of
+  copyright holders.
+*/
+/*!
+ * \file
+ * \copydoc Opm::BatchedTridiagonalSolver
+ */
+#ifndef OPM_BATCHED_TRIDIAGONAL_SOLVER_HPP
+#define OPM_BATCHED_TRIDIAGONAL_SOLVER_HPP
+
+#include <opm/material/common/TridiagonalMatrix.hpp>
+
+#include <vector>
+#include <cassert>
+
+namespace Opm {
+
+/*!
+ * \brief Solves a batch of tridiagonal linear systems which all
+ *        exhibit the same number of rows.
+ *
+ * The coefficients of the systems are stored interleaved, i.e., the
+ * entries of row i of all systems are adjacent in memory. The Thomas
+ * algorithm thus sweeps over the rows once for the whole batch and
+ * the innermost loops run over the systems, which allows the
+ * compiler to vectorize them.
+ *
+ * For system s, lower(s, i) denotes the entry left of the diagonal
+ * of row i and upper(s, i) the one right of it. For solvePeriodic(),
+ * lower(s, 0) is the entry in the upper right corner and
+ * upper(s, n - 1) the one in the lower left corner of the
+ * matrix. These are ignored by solve().
+ *
+ * Like TridiagonalMatrix::solve(), no pivoting is done, so the
+ * matrices are expected to be diagonally dominant. This is the case
+ * for the systems which determine the moments of cubic splines.
+ */
+template <class Scalar>
+class BatchedTridiagonalSolver
+{
+public:
+    explicit BatchedTridiagonalSolver(size_t numSystems = 0, size_t numRows = 0)
+    { resize(numSystems, numRows); }
+
+    /*!
+     * \brief Change the number of systems and the number of rows per system.
+     *
+     * All coefficients are reset to zero.
+     */
+    void resize(size_t numSystems, size_t numRows)
+    {
+        numSystems_ = numSystems;
+        numRows_ = numRows;
+
+        size_t n = numSystems*numRows;
+        lower_.assign(n, 0.0);
+        diag_.assign(n, 0.0);
+        upper_.assign(n, 0.0);
+        rhs_.assign(n, 0.0);
+        x_.assign(n, 0.0);
+        cPrime_.resize(n);
+        z_.clear();
+    }
+
+    /*!
+     * \brief Return the number of systems of the batch.
+     */
+    size_t numSystems() const
+    { return numSystems_; }
+
+    /*!
+     * \brief Return the number of rows of each system.
+     */
+    size_t numRows() const
+    { return numRows_; }
+
+    /*!
+     * \brief The entry left of the diagonal in a row of a system.
+     */
+    Scalar& lower(size_t sysIdx, size_t rowIdx)
+    { return lower_[idx_(sysIdx, rowIdx)]; }
+
+    Scalar lower(size_t sysIdx, size_t rowIdx) const
+    { return lower_[idx_(sysIdx, rowIdx)]; }
+
+    /*!
+     * \brief The diagonal entry of a row of a system.
+     */
+    Scalar& diagonal(size_t sysIdx, size_t rowIdx)
+    { return diag_[idx_(sysIdx, rowIdx)]; }
+
+    Scalar diagonal(size_t sysIdx, size_t rowIdx) const
+    { return diag_[idx_(sysIdx, rowIdx)]; }
+
+    /*!
+     * \brief The entry right of the diagonal in a row of a system.
+     */
+    Scalar& upper(size_t sysIdx, size_t rowIdx)
+    { return upper_[idx_(sysIdx, rowIdx)]; }
+
+    Scalar upper(size_t sysIdx, size_t rowIdx) const
+    { return upper_[idx_(sysIdx, rowIdx)]; }
+
+    /*!
+     * \brief The right hand side of a row of a system.
+     */
+    Scalar& rhs(size_t sysIdx, size_t rowIdx)
+    { return rhs_[idx_(sysIdx, rowIdx)]; }
+
+    Scalar rhs(size_t sysIdx, size_t rowIdx) const
+    { return rhs_[idx_(sysIdx, rowIdx)]; }
+
+    /*!
+     * \brief The solution of a row of a system after calling solve()
+     *        or solvePeriodic().
+     */
+    Scalar solution(size_t sysIdx, size_t rowIdx) const
+    { return x_[idx_(sysIdx, rowIdx)]; }
+
+    /*!
+     * \brief Copy the solution of a system to an array-like object.
+     */
+    template <class Vector>
+    void solution(size_t sysIdx, Vector& x) const
+    {
+        for (size_t i = 0; i < numRows_; ++i)
+            x[i] = x_[idx_(sysIdx, i)];
+    }
+
+    /*!
+     * \brief Copy a linear system of equations into the batch.
+     *
+     * The entries in the corners of the matrix, if any, are taken as
+     * well.
+     */
+    template <class Vector>
+    void setSystem(size_t sysIdx, const TridiagonalMatrix<Scalar>& M, const Vector& b)
+    {
+        size_t n = numRows_;
+        assert(M.size() == n);
+
+        for (size_t i = 0; i < n; ++i) {
+            size_t k = idx_(sysIdx, i);
+            diag_[k] = M.at(i, i);
+            rhs_[k] = b[i];
+
+            if (i > 0)
+                lower_[k] = M.at(i, i - 1);
+            else
+                lower_[k] = (n > 2) ? M.at(0, n - 1) : Scalar(0.0);
+
+            if (i < n - 1)
+                upper_[k] = M.at(i, i + 1);
+            else
+                upper_[k] = (n > 2) ? M.at(n - 1, 0) : Scalar(0.0);
+        }
+    }
+
+    /*!
+     * \brief Solve all systems of the batch, disregarding the corner
+     *        entries.
+     */
+    void solve()
+    {
+        if (numRows_ == 0)
+            return;
+
+        thomas_(diag_.data(), rhs_.data(), x_.data());
+    }
+
+    /*!
+     * \brief Solve all systems of the batch including the entries in
+     *        the upper right and the lower left corners.
+     *
+     * For more than two rows, the corners are treated as a rank-one
+     * update of a tridiagonal matrix using the Sherman-Morrison
+     * formula, which requires a second right hand side for the
+     * Thomas algorithm. For one or two rows, the corner entries
+     * coincide with the regular ones and are simply added to them.
+     */
+    void solvePeriodic()
+    {
+        size_t n = numRows_;
+        size_t m = numSystems_;
+        if (n == 0)
+            return;
+
+        if (n < 3) {
+            std::vector<Scalar> savedLower(lower_), savedUpper(upper_), savedDiag(diag_);
+            for (size_t s = 0; s < m; ++s) {
+                if (n == 1)
+                    diag_[s] += lower_[s] + upper_[s];
+                else {
+                    upper_[s] += lower_[s];
+                    lower_[m + s] += upper_[m + s];
+                }
+            }
+            thomas_(diag_.data(), rhs_.data(), x_.data());
+            lower_.swap(savedLower);
+            upper_.swap(savedUpper);
+            diag_.swap(savedDiag);
+            return;
+        }
+
+        // the modified diagonal and the right hand side of the
+        // auxiliary system
+        std::vector<Scalar> modDiag(diag_);
+        z_.assign(n*m, 0.0);
+        const Scalar* beta = &lower_[0];
+        const Scalar* alpha = &upper_[(n - 1)*m];
+        for (size_t s = 0; s < m; ++s) {
+            Scalar gamma = -diag_[s];
+            modDiag[s] -= gamma;
+            modDiag[(n - 1)*m + s] -= alpha[s]*beta[s]/gamma;
+
+            z_[s] = gamma;
+            z_[(n - 1)*m + s] = alpha[s];
+        }
+
+        thomas_(modDiag.data(), rhs_.data(), x_.data());
+        thomas_(modDiag.data(), z_.data(), z_.data());
+
+        Scalar* x0 = &x_[0];
+        Scalar* xn = &x_[(n - 1)*m];
+        const Scalar* z0 = &z_[0];
+        const Scalar* zn = &z_[(n - 1)*m];
+        std::vector<Scalar> fact(m);
+        for (size_t s = 0; s < m; ++s) {
+            Scalar gamma = -diag_[s];
+            fact[s] =
+                (x0[s] + beta[s]*xn[s]/gamma)
+                / (Scalar(1.0) + z0[s] + beta[s]*zn[s]/gamma);
+        }
+
+        for (size_t i = 0; i < n; ++i) {
+            Scalar* xi = &x_[i*m];
+            const Scalar* zi = &z_[i*m];
+            for (size_t s = 0; s < m; ++s)
+                xi[s] -= fact[s]*zi[s];
+        }
+    }
+
+private:
+    size_t idx_(size_t sysIdx, size_t rowIdx) const
+    {
+        assert(sysIdx < numSystems_ && rowIdx < numRows_);
+        return rowIdx*numSystems_ + sysIdx;
+    }
+
+    // Thomas algorithm for all systems of the batch using a given
+    // diagonal and right hand side. 'b' and 'x' may be the same
+    // array.
+    void thomas_(const Scalar* d, const Scalar* b, Scalar* x)
+    {
+        size_t n = numRows_;
+        size_t m = numSystems_;
+        const Scalar* a = lower_.data();
+        const Scalar* c = upper_.data();
+        Scalar* cp = cPrime_.data();
+
+        // forward sweep. x temporarily holds the modified right hand side
+        for (size_t s = 0; s < m; ++s) {
+            cp[s] = c[s]/d[s];
+            x[s] = b[s]/d[s];
+        }
+        for (size_t i = 1; i < n; ++i) {
+            size_t k = i*m;
+            size_t kPrev = k - m;
+            for (size_t s = 0; s < m; ++s) {
+                Scalar denom = Scalar(1.0)/(d[k + s] - a[k + s]*cp[kPrev + s]);
+                cp[k + s] = c[k + s]*denom;
+                x[k + s] = (b[k + s] - a[k + s]*x[kPrev + s])*denom;
+            }
+        }
+
+        // back substitution
+        for (size_t i = n - 1; i > 0; --i) {
+            size_t k = (i - 1)*m;
+            size_t kNext = k + m;
+            for (size_t s = 0; s < m; ++s)
+                x[k + s] -= cp[k + s]*x[kNext + s];
+        }
+    }
+
+    size_t numSystems_;
+    size_t numRows_;
+
+    std::vector<Scalar> lower_;
+    std::vector<Scalar> diag_;
+    std::vector<Scalar> upper_;
+    std::vector<Scalar> rhs_;
+    std::vector<Scalar> x_;
+
+    // scratch space for the solvers
+    std::vector<Scalar> cPrime_;
+    std::vector<Scalar> z_;
+};
+
+} // namespace Opm
+
+#endif
@@ -0,0 +1,421 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+
+  Consult the COPYING file in the top-level source directory of this
+  module for the precise wording of the license and the list of
+  copyright holders.
+*/
+/*!
+ * \file
+ * \copydoc Opm::BinarySerializer
+ */
+#ifndef OPM_BINARY_SERIALIZER_HPP
+#define OPM_BINARY_SERIALIZER_HPP
+
+#include <vector>
+#include <array>
+#include <map>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <typeinfo>
+#include <type_traits>
+#include <stdexcept>
+#include <fstream>
+#include <cstring>
+#include <cstdint>
+
+namespace Opm {
+
+/*!
+ * \brief Writes objects to or reads them from a flat binary buffer.
+ *
+ * Classes take part in serialization by providing a method
+ *
+ * \code
+ * template <class Serializer>
+ * void serializeOp(Serializer& serializer)
+ * {
+ *     serializer(member1_);
+ *     serializer(member2_);
+ * }
+ * \endcode
+ *
+ * which is used for both directions; serializer.isLoading() tells which one is
+ * active. Arithmetic values, enums, strings, pairs, tuples, arrays, vectors and smart
+ * pointers are handled by the serializer itself. Vectors of trivially copyable
+ * objects are copied as a whole, so loading the tabulated functions of the PVT and
+ * saturation function objects boils down to a few memcpy() calls per table. Objects
+ * which are referenced by several std::shared_ptr objects are only stored once and
+ * are shared again after loading.
+ *
+ * The raw representation of the values is used, i.e., the data can only be read on
+ * platforms with the same byte order and the same type sizes. Use
+ * serializeToBuffer() and deserializeFromBuffer() to get a header which ensures
+ * this.
+ */
+class BinarySerializer
+{
+public:
+    /*!
+     * \brief Create a serializer which appends to a buffer.
+     */
+    explicit BinarySerializer(std::vector<char>& buffer)
+        : outBuffer_(&buffer)
+        , inData_(nullptr)
+        , inSize_(0)
+        , inPos_(0)
+    {}
+
+    /*!
+     * \brief Create a serializer which reads from a memory range.
+     *
+     * The memory may, e.g., be a memory mapped file. It must stay valid while the
+     * serializer is used.
+     */
+    BinarySerializer(const void* data, size_t size)
+        : outBuffer_(nullptr)
+        , inData_(static_cast<const char*>(data))
+        , inSize_(size)
+        , inPos_(0)
+    {}
+
+    /*!
+     * \brief Returns true if the objects are read from the buffer.
+     */
+    bool isLoading() const
+    { return outBuffer_ == nullptr; }
+
+    /*!
+     * \brief The number of bytes which have been read or written so far.
+     */
+    size_t position() const
+    { return isLoading() ? inPos_ : outBuffer_->size(); }
+
+    /*!
+     * \brief Write or read an object.
+     */
+    template <class T>
+    void operator()(T& value)
+    { apply_(value, Tag_<T>()); }
+
+    template <class T>
+    void operator()(std::vector<T>& values)
+    {
+        uint64_t n = values.size();
+        raw_(&n, sizeof(n));
+        if (isLoading()) {
+            // the elements are constructed in place, some parameter classes cannot
+            // be copied safely
+            values.clear();
+            values.resize(n);
+        }
+        vector_(values, std::integral_constant<bool, std::is_trivially_copyable<T>::value>());
+    }
+
+    void operator()(std::vector<bool>& values)
+    {
+        uint64_t n = values.size();
+        raw_(&n, sizeof(n));
+        if (isLoading())
+            values.resize(n);
+        for (uint64_t i = 0; i < n; ++i) {
+            bool tmp = values[i];
+            raw_(&tmp, sizeof(tmp));
+            values[i] = tmp;
+        }
+    }
+
+    template <class T, size_t n>
+    void operator()(std::array<T, n>& values)
+    {
+        for (auto& value : values)
+            (*this)(value);
+    }
+
+    template <class T1, class T2>
+    void operator()(std::pair<T1, T2>& value)
+    {
+        (*this)(value.first);
+        (*this)(value.second);
+    }
+
+    template <class... Ts>
+    void operator()(std::tuple<Ts...>& value)
+    { tuple_<0>(value); }
+
+    void operator()(std::string& value)
+    {
+        uint64_t n = value.size();
+        raw_(&n, sizeof(n));
+        if (isLoading())
+            value.resize(n);
+        if (n > 0)
+            raw_(&value[0], n);
+    }
+
+    template <class T>
+    void operator()(std::unique_ptr<T>& ptr)
+    {
+        bool present = static_cast<bool>(ptr);
+        raw_(&present, sizeof(present));
+        if (isLoading())
+            ptr.reset(present ? new T : nullptr);
+        if (present)
+            (*this)(*ptr);
+    }
+
+    template <class T>
+    void operator()(std::shared_ptr<T>& ptr)
+    {
+        // objects are numbered in the order in which they are encountered. a new
+        // object is stored right after its number, references to already known
+        // objects only consist of the number. -1 stands for null pointers.
+        int64_t objIdx = -1;
+        if (!isLoading()) {
+            if (ptr) {
+                auto it = sharedIndices_.find(ptr.get());
+                if (it == sharedIndices_.end()) {
+                    objIdx = static_cast<int64_t>(sharedIndices_.size());
+                    sharedIndices_[ptr.get()] = objIdx;
+                    raw_(&objIdx, sizeof(objIdx));
+                    (*this)(*ptr);
+                    return;
+                }
+                objIdx = it->second;
+            }
+            raw_(&objIdx, sizeof(objIdx));
+            return;
+        }
+
+        raw_(&objIdx, sizeof(objIdx));
+        if (objIdx < 0)
+            ptr.reset();
+        else if (static_cast<size_t>(objIdx) < sharedObjects_.size())
+            ptr = std::static_pointer_cast<T>(sharedObjects_[objIdx]);
+        else if (static_cast<size_t>(objIdx) == sharedObjects_.size()) {
+            ptr = std::make_shared<T>();
+            sharedObjects_.push_back(ptr);
+            (*this)(*ptr);
+        }
+        else
+            throw std::runtime_error("Invalid object reference in serialized data");
+    }
+
+    template <class T>
+    void operator()(std::shared_ptr<const T>& ptr)
+    {
+        // the object is only modified while it is loaded, i.e., before anybody else
+        // can see it
+        std::shared_ptr<T> tmp = std::const_pointer_cast<T>(ptr);
+        (*this)(tmp);
+        ptr = tmp;
+    }
+
+private:
+    template <class T>
+    struct Tag_
+        : public std::integral_constant<bool, std::is_arithmetic<T>::value || std::is_enum<T>::value>
+    {};
+
+    // arithmetic values and enums
+    template <class T>
+    void apply_(T& value, std::true_type)
+    { raw_(&value, sizeof(value)); }
+
+    // objects which provide a serializeOp() method
+    template <class T>
+    void apply_(T& value, std::false_type)
+    { value.serializeOp(*this); }
+
+    template <class T>
+    void vector_(std::vector<T>& values, std::true_type)
+    {
+        if (!values.empty())
+            raw_(values.data(), values.size()*sizeof(T));
+    }
+
+    template <class T>
+    void vector_(std::vector<T>& values, std::false_type)
+    {
+        for (auto& value : values)
+            (*this)(value);
+    }
+
+    template <size_t i, class Tuple>
+    typename std::enable_if<(i < std::tuple_size<Tuple>::value)>::type tuple_(Tuple& value)
+    {
+        (*this)(std::get<i>(value));
+        tuple_<i + 1>(value);
+    }
+
+    template <size_t i, class Tuple>
+    typename std::enable_if<(i >= std::tuple_size<Tuple>::value)>::type tuple_(Tuple&)
+    {}
+
+    void raw_(void* data, size_t numBytes)
+    {
+        if (isLoading()) {
+            if (numBytes > inSize_ - inPos_)
+                throw std::runtime_error("Serialized data is truncated");
+            std::memcpy(data, inData_ + inPos_, numBytes);
+            inPos_ += numBytes;
+        }
+        else {
+            const char* bytes = static_cast<const char*>(data);
+            outBuffer_->insert(outBuffer_->end(), bytes, bytes + numBytes);
+        }
+    }
+
+    std::vector<char>* outBuffer_;
+
+    const char* inData_;
+    size_t inSize_;
+    size_t inPos_;
+
+    std::map<const void*, int64_t> sharedIndices_;
+    std::vector<std::shared_ptr<void> > sharedObjects_;
+};
+
+namespace BinarySerializerDetail {
+static const uint64_t magic = 0x4E49425F4D54504FULL; // "OPTM_BIN"
+static const uint32_t byteOrderMark = 0x01020304;
+
+// bump this whenever the serializeOp() method of any class changes
+static const uint32_t formatVersion = 8;
+
+struct Header
+{
+    uint64_t magic;
+    uint32_t byteOrderMark;
+    uint32_t formatVersion;
+    uint32_t pointerSize;
+    uint32_t typeNameSize;
+    uint64_t payloadSize;
+};
+} // namespace BinarySerializerDetail
+
+/*!
+ * \brief Serialize an object into a versioned binary buffer.
+ *
+ * The header records the format version, the byte order and the type of the object,
+ * so an attempt to load the data into an incompatible object is detected.
+ */
+template <class T>
+std::vector<char> serializeToBuffer(const T& object)
+{
+    const std::string typeName = typeid(T).name();
+
+    BinarySerializerDetail::Header header;
+    std::memset(&header, 0, sizeof(header));
+    header.magic = BinarySerializerDetail::magic;
+    header.byteOrderMark = BinarySerializerDetail::byteOrderMark;
+    header.formatVersion = BinarySerializerDetail::formatVersion;
+    header.pointerSize = sizeof(void*);
+    header.typeNameSize = static_cast<uint32_t>(typeName.size());
+
+    std::vector<char> buffer(sizeof(header) + typeName.size());
+    std::memcpy(buffer.data() + sizeof(header), typeName.data(), typeName.size());
+
+    // serializeOp() is used for both directions, so it cannot be const
+    BinarySerializer serializer(buffer);
+    serializer(const_cast<T&>(object));
+
+    header.payloadSize = buffer.size() - sizeof(header) - typeName.size();
+    std::memcpy(buffer.data(), &header, sizeof(header));
+
+    return buffer;
+}
+
+/*!
+ * \brief Load an object from a buffer created by serializeToBuffer().
+ *
+ * An exception is thrown if the buffer was written by an incompatible version or
+ * for a different type.
+ */
+template <class T>
+void deserializeFromBuffer(T& object, const void* data, size_t size)
+{
+    const char* bytes = static_cast<const char*>(data);
+    const std::string typeName = typeid(T).name();
+
+    BinarySerializerDetail::Header header;
+    if (size < sizeof(header))
+        throw std::runtime_error("Serialized data is truncated");
+    std::memcpy(&header, bytes, sizeof(header));
+
+    if (header.magic != BinarySerializerDetail::magic)
+        throw std::runtime_error("Buffer does not contain serialized data");
+    if (header.byteOrderMark != BinarySerializerDetail::byteOrderMark
+        || header.pointerSize != sizeof(void*))
+        throw std::runtime_error("Serialized data was written on an incompatible platform");
+    if (header.formatVersion != BinarySerializerDetail::formatVersion)
+        throw std::runtime_error("Unsupported version of serialized data: "
+                                 +std::to_string(header.formatVersion));
+    if (header.typeNameSize != typeName.size()
+        || size < sizeof(header) + header.typeNameSize
+        || std::memcmp(bytes + sizeof(header), typeName.data(), typeName.size()) != 0)
+        throw std::runtime_error("Serialized data was written for a different type");
+
+    size_t offset = sizeof(header) + header.typeNameSize;
+    if (size - offset < header.payloadSize)
+        throw std::runtime_error("Serialized data is truncated");
+
+    BinarySerializer serializer(bytes + offset, header.payloadSize);
+    serializer(object);
+    if (serializer.position() != header.payloadSize)
+        throw std::runtime_error("Serialized data does not match the object");
+}
+
+/*!
+ * \brief Serialize an object into a file.
+ */
+template <class T>
+void saveBinary(const T& object, const std::string& fileName)
+{
+    const auto& buffer = serializeToBuffer(object);
+
+    std::ofstream os(fileName, std::ios::binary);
+    os.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    if (!os)
+        throw std::runtime_error("Could not write file '"+fileName+"'");
+}
+
+/*!
+ * \brief Load an object from a file written by saveBinary().
+ */
+template <class T>
+void loadBinary(T& object, const std::string& fileName)
+{
+    std::ifstream is(fileName, std::ios::binary | std::ios::ate);
+    if (!is)
+        throw std::runtime_error("Could not open file '"+fileName+"'");
+
+    std::vector<char> buffer(static_cast<size_t>(is.tellg()));
+    is.seekg(0);
+    is.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    if (!is)
+        throw std::runtime_error("Could not read file '"+fileName+"'");
+
+    deserializeFromBuffer(object, buffer.data(), buffer.size());
+}
+
+} // namespace Opm
+
+#endif
@@ -0,0 +1,194 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+
+  Consult the COPYING file in the top-level source directory of this
+  module for the precise wording of the license and the list of
+  copyright holders.
+*/
+/*!
+ * \file
+ * \copydoc Opm::EvaluationStatus
+ */
+#ifndef OPM_MATERIAL_EVALUATION_STATUS_HPP
+#define OPM_MATERIAL_EVALUATION_STATUS_HPP
+
+#include <opm/material/common/Exceptions.hpp>
+
+#include <cstddef>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace Opm {
+
+/*!
+ * \brief Collects the range violations of property evaluations which must not throw.
+ *
+ * The non-throwing evaluation methods of the tables and of some PVT classes take an
+ * object of this class. Instead of throwing a NumericalIssue for arguments outside of
+ * the valid range, they record the violation and either extrapolate or clamp the
+ * arguments to the valid range. The caller checks the status once after a whole batch
+ * of evaluations and reports the errors, e.g., using throwIfFailed().
+ *
+ * The object is not thread safe, each thread must use its own one. The first few
+ * violations are stored together with the index of the element which was evaluated at
+ * that time, the remaining ones are only counted.
+ */
+template <class Scalar>
+class EvaluationStatus
+{
+public:
+    /*!
+     * \brief Specifies how the arguments outside of the valid range are treated.
+     */
+    enum class OutOfRangePolicy {
+        Extrapolate, //!< Evaluate the function beyond its range
+        Clamp //!< Move the arguments to the closest point of the valid range
+    };
+
+    /*!
+     * \brief A single recorded range violation.
+     */
+    struct Violation
+    {
+        size_t elementIdx;
+        unsigned tableId;
+        Scalar x;
+        Scalar y;
+    };
+
+    explicit EvaluationStatus(OutOfRangePolicy policy = OutOfRangePolicy::Extrapolate,
+                              size_t maxRecorded = 16)
+        : policy_(policy)
+        , maxRecorded_(maxRecorded)
+        , elementIdx_(0)
+        , numViolations_(0)
+    {
+        // avoid allocating memory within the evaluation loops
+        violations_.reserve(maxRecorded_);
+    }
+
+    /*!
+     * \brief Returns how the arguments outside of the valid range are treated.
+     */
+    OutOfRangePolicy policy() const
+    { return policy_; }
+
+    /*!
+     * \brief Returns true if the arguments are moved to the valid range.
+     */
+    bool clamp() const
+    { return policy_ == OutOfRangePolicy::Clamp; }
+
+    /*!
+     * \brief Set the index of the element which is currently evaluated.
+     *
+     * This index is stored for all violations which are recorded until the next
+     * call of this method.
+     */
+    void setElementIndex(size_t elementIdx)
+    { elementIdx_ = elementIdx; }
+
+    /*!
+     * \brief Returns the index of the element which is currently evaluated.
+     */
+    size_t elementIndex() const
+    { return elementIdx_; }
+
+    /*!
+     * \brief Record that the argument(s) of an evaluation were outside of the valid
+     *        range.
+     *
+     * \param tableId An identifier of the evaluated table chosen by the caller, e.g.,
+     *                the PVT region index.
+     * \param x The first argument of the evaluation
+     * \param y The second argument of the evaluation, zero for functions of a single
+     *          variable
+     */
+    void record(unsigned tableId, Scalar x, Scalar y = 0.0)
+    {
+        if (violations_.size() < maxRecorded_)
+            violations_.push_back(Violation{elementIdx_, tableId, x, y});
+        ++numViolations_;
+    }
+
+    /*!
+     * \brief Returns true if no violation has been recorded.
+     */
+    bool ok() const
+    { return numViolations_ == 0; }
+
+    /*!
+     * \brief Returns the total number of recorded violations.
+     */
+    size_t numViolations() const
+    { return numViolations_; }
+
+    /*!
+     * \brief Returns the stored violations.
+     *
+     * At most maxRecorded violations are stored, i.e., this may be less than
+     * numViolations().
+     */
+    const std::vector<Violation>& violations() const
+    { return violations_; }
+
+    /*!
+     * \brief Forget all recorded violations.
+     */
+    void clear()
+    {
+        violations_.clear();
+        numViolations_ = 0;
+        elementIdx_ = 0;
+    }
+
+    /*!
+     * \brief Throw a NumericalIssue which describes the recorded violations if there
+     *        are any.
+     *
+     * \param what A description of the evaluated quantity which is used for the
+     *             message of the exception.
+     */
+    void throwIfFailed(const std::string& what) const
+    {
+        if (ok())
+            return;
+
+        std::ostringstream oss;
+        oss << what << ": " << numViolations_ << " evaluation(s) outside of the valid range";
+        for (const auto& violation : violations_)
+            oss << "\n    element " << violation.elementIdx
+                << ", table " << violation.tableId
+                << ": (" << violation.x << ", " << violation.y << ")";
+        if (numViolations_ > violations_.size())
+            oss << "\n    ...";
+        throw NumericalIssue(oss.str());
+    }
+
+private:
+    OutOfRangePolicy policy_;
+    size_t maxRecorded_;
+    size_t elementIdx_;
+    size_t numViolations_;
+    std::vector<Violation> violations_;
+};
+
+} // namespace Opm
+
+#endif
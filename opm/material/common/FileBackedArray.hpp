@@ -0,0 +1,359 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+
+  Consult the COPYING file in the top-level source directory of this
+  module for the precise wording of the license and the list of
+  copyright holders.
+*/
+/*!
+ * \file
+ * \copydoc Opm::FileBackedArray
+ */
+#ifndef OPM_FILE_BACKED_ARRAY_HPP
+#define OPM_FILE_BACKED_ARRAY_HPP
+
+#include <algorithm>
+#include <string>
+#include <stdexcept>
+#include <type_traits>
+#include <cstring>
+#include <cerrno>
+#include <cassert>
+
+// the macro is only used within this header and is undefined at its end
+#if defined(__unix__) || defined(__APPLE__)
+#define OPM_FILE_BACKED_ARRAY_USE_MMAP_ 1
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace Opm {
+
+/*!
+ * \brief An array of trivially copyable objects which is stored in a memory mapped
+ *        file.
+ *
+ * Only the pages of the file which are accessed are held in memory, and the
+ * operating system may write them back and drop them at any time. This allows to
+ * keep per-element data of grids which are too large for the main memory. To
+ * bound the resident memory, the array should be processed in blocks: sweep()
+ * calls a functor for consecutive blocks of elements, asks the operating system to
+ * read the next block ahead while the current one is processed and evicts the
+ * processed blocks from the address space of the process afterwards. The same can
+ * be done manually using prefetch() and evict() if the simulator visits the
+ * elements in a different order.
+ *
+ * The file has no header, i.e., it contains the raw objects, and it can only be
+ * read on the platform where it was written. The object is not copyable. All
+ * errors are reported by throwing std::runtime_error.
+ */
+template <class T>
+class FileBackedArray
+{
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "Only trivially copyable objects can be stored in a file");
+
+public:
+    FileBackedArray()
+        : data_(nullptr)
+        , size_(0)
+        , writable_(false)
+    {}
+
+    FileBackedArray(const FileBackedArray&) = delete;
+    FileBackedArray& operator=(const FileBackedArray&) = delete;
+
+    ~FileBackedArray()
+    { close(); }
+
+    /*!
+     * \brief Returns true if memory mapped files are supported on the platform.
+     */
+    static bool isSupported()
+    {
+#if OPM_FILE_BACKED_ARRAY_USE_MMAP_
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    /*!
+     * \brief Create a file for a given number of objects and map it for reading and
+     *        writing.
+     *
+     * An existing file is overwritten. The objects are initialized to all zero bytes.
+     */
+    void create(const std::string& fileName, size_t numElements)
+    {
+        close();
+#if OPM_FILE_BACKED_ARRAY_USE_MMAP_
+        int fd = ::open(fileName.c_str(), O_CREAT | O_TRUNC | O_RDWR, S_IRUSR | S_IWUSR);
+        if (fd < 0)
+            throwError_("Could not create file '"+fileName+"'");
+
+        if (ftruncate(fd, static_cast<off_t>(numElements*sizeof(T))) != 0) {
+            int err = errno;
+            ::close(fd);
+            errno = err;
+            throwError_("Could not resize file '"+fileName+"'");
+        }
+
+        map_(fd, numElements, /*writable=*/true, fileName);
+#else
+        static_cast<void>(fileName);
+        static_cast<void>(numElements);
+        throw std::runtime_error("Memory mapped files are not supported on this platform");
+#endif
+    }
+
+    /*!
+     * \brief Map an existing file.
+     */
+    void open(const std::string& fileName, bool writable = false)
+    {
+        close();
+#if OPM_FILE_BACKED_ARRAY_USE_MMAP_
+        int fd = ::open(fileName.c_str(), writable ? O_RDWR : O_RDONLY);
+        if (fd < 0)
+            throwError_("Could not open file '"+fileName+"'");
+
+        struct stat st;
+        if (fstat(fd, &st) != 0) {
+            int err = errno;
+            ::close(fd);
+            errno = err;
+            throwError_("Could not determine the size of file '"+fileName+"'");
+        }
+
+        size_t numBytes = static_cast<size_t>(st.st_size);
+        if (numBytes % sizeof(T) != 0) {
+            ::close(fd);
+            throw std::runtime_error("The size of file '"+fileName+"' is not a multiple of the "
+                                     "size of the stored objects");
+        }
+
+        map_(fd, numBytes/sizeof(T), writable, fileName);
+#else
+        static_cast<void>(fileName);
+        static_cast<void>(writable);
+        throw std::runtime_error("Memory mapped files are not supported on this platform");
+#endif
+    }
+
+    /*!
+     * \brief Unmap the file.
+     *
+     * The modified objects are written back to the file by the operating system.
+     */
+    void close()
+    {
+#if OPM_FILE_BACKED_ARRAY_USE_MMAP_
+        if (data_ && size_ > 0)
+            munmap(data_, size_*sizeof(T));
+#endif
+        data_ = nullptr;
+        size_ = 0;
+        writable_ = false;
+    }
+
+    /*!
+     * \brief Write the modified objects back to the file and wait until this is done.
+     */
+    void flush()
+    {
+#if OPM_FILE_BACKED_ARRAY_USE_MMAP_
+        if (writable_ && size_ > 0 && msync(data_, size_*sizeof(T), MS_SYNC) != 0)
+            throwError_("Could not write back the mapped file");
+#endif
+    }
+
+    /*!
+     * \brief Returns true iff a file is mapped.
+     */
+    bool isOpen() const
+    { return data_ != nullptr; }
+
+    /*!
+     * \brief Returns true iff the objects may be modified.
+     */
+    bool isWritable() const
+    { return writable_; }
+
+    /*!
+     * \brief The number of objects in the array.
+     */
+    size_t size() const
+    { return size_; }
+
+    const T& operator[](size_t idx) const
+    {
+        assert(idx < size_);
+        return data_[idx];
+    }
+
+    const T* data() const
+    { return data_; }
+
+    /*!
+     * \brief The beginning of the array for writing.
+     *
+     * This may only be called if the file was mapped for writing.
+     */
+    T* writableData()
+    {
+        if (!writable_)
+            throw std::logic_error("The file is mapped read-only");
+        return data_;
+    }
+
+    /*!
+     * \brief Ask the operating system to read the objects of an index range ahead.
+     *
+     * This is only a hint and does not block.
+     */
+    void prefetch(size_t beginIdx, size_t endIdx) const
+    {
+#if OPM_FILE_BACKED_ARRAY_USE_MMAP_
+        size_t beginPage, endPage;
+        pageRange_(beginIdx, endIdx, /*outward=*/true, beginPage, endPage);
+        if (beginPage < endPage)
+            madvise(pageAddress_(beginPage), (endPage - beginPage)*pageSize_(), MADV_WILLNEED);
+#else
+        static_cast<void>(beginIdx);
+        static_cast<void>(endIdx);
+#endif
+    }
+
+    /*!
+     * \brief Remove the pages of an index range from the address space of the process.
+     *
+     * Modified objects are not lost: They are still written back to the file, and
+     * subsequent accesses read them from there. Pages which are only partially covered
+     * by the range are kept.
+     */
+    void evict(size_t beginIdx, size_t endIdx) const
+    {
+#if OPM_FILE_BACKED_ARRAY_USE_MMAP_
+        size_t beginPage, endPage;
+        pageRange_(beginIdx, endIdx, /*outward=*/false, beginPage, endPage);
+        if (beginPage < endPage)
+            madvise(pageAddress_(beginPage), (endPage - beginPage)*pageSize_(), MADV_DONTNEED);
+#else
+        static_cast<void>(beginIdx);
+        static_cast<void>(endIdx);
+#endif
+    }
+
+    /*!
+     * \brief Call a functor for consecutive blocks of the array.
+     *
+     * The functor is called as functor(beginIdx, endIdx) for each block. While a block
+     * is processed, the next one is prefetched; afterwards, the block is evicted. The
+     * resident memory is thus bounded by a few blocks.
+     */
+    template <class Functor>
+    void sweep(size_t blockSize, Functor&& functor) const
+    {
+        if (blockSize == 0)
+            throw std::logic_error("The block size must be positive");
+
+        if (size_ > 0)
+            prefetch(0, std::min(blockSize, size_));
+        for (size_t beginIdx = 0; beginIdx < size_; beginIdx += blockSize) {
+            size_t endIdx = std::min(beginIdx + blockSize, size_);
+            if (endIdx < size_)
+                prefetch(endIdx, std::min(endIdx + blockSize, size_));
+
+            functor(beginIdx, endIdx);
+            evict(beginIdx, endIdx);
+        }
+    }
+
+private:
+#if OPM_FILE_BACKED_ARRAY_USE_MMAP_
+    static size_t pageSize_()
+    { return static_cast<size_t>(sysconf(_SC_PAGESIZE)); }
+
+    void* pageAddress_(size_t pageIdx) const
+    { return reinterpret_cast<char*>(data_) + pageIdx*pageSize_(); }
+
+    // the pages which contain (outward) or are contained by (inward) an index range
+    void pageRange_(size_t beginIdx, size_t endIdx, bool outward, size_t& beginPage, size_t& endPage) const
+    {
+        endIdx = std::min(endIdx, size_);
+        if (beginIdx >= endIdx) {
+            beginPage = endPage = 0;
+            return;
+        }
+
+        size_t pageSize = pageSize_();
+        size_t beginByte = beginIdx*sizeof(T);
+        size_t endByte = endIdx*sizeof(T);
+        if (outward) {
+            beginPage = beginByte/pageSize;
+            endPage = (endByte + pageSize - 1)/pageSize;
+        }
+        else {
+            beginPage = (beginByte + pageSize - 1)/pageSize;
+            // the last page of the mapping also counts as covered if the range ends
+            // with the array
+            endPage = (endIdx == size_) ? (endByte + pageSize - 1)/pageSize : endByte/pageSize;
+        }
+    }
+
+    void map_(int fd, size_t numElements, bool writable, const std::string& fileName)
+    {
+        void* addr = nullptr;
+        // mmap() does not accept empty mappings
+        if (numElements > 0) {
+            addr = mmap(nullptr, numElements*sizeof(T),
+                        writable ? (PROT_READ | PROT_WRITE) : PROT_READ,
+                        MAP_SHARED, fd, 0);
+            if (addr == MAP_FAILED) {
+                int err = errno;
+                ::close(fd);
+                errno = err;
+                throwError_("Could not map file '"+fileName+"'");
+            }
+        }
+
+        // the mapping stays valid after the file descriptor has been closed
+        ::close(fd);
+
+        data_ = static_cast<T*>(addr);
+        size_ = numElements;
+        writable_ = writable;
+    }
+#endif
+
+    static void throwError_(const std::string& msg)
+    { throw std::runtime_error(msg+": "+std::strerror(errno)); }
+
+    T* data_;
+    size_t size_;
+    bool writable_;
+};
+
+} // namespace Opm
+
+#undef OPM_FILE_BACKED_ARRAY_USE_MMAP_
+
+#endif
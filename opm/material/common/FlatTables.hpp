@@ -0,0 +1,654 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+
+  Consult the COPYING file in the top-level source directory of this
+  module for the precise wording of the license and the list of
+  copyright holders.
+*/
+/*!
+ * \file
+ *
+ * \brief Position independent representation of tabulated functions which can be
+ *        placed in memory that is shared between processes.
+ */
+#ifndef OPM_FLAT_TABLES_HPP
+#define OPM_FLAT_TABLES_HPP
+
+#include <opm/material/common/Tabulated1DFunction.hpp>
+#include <opm/material/common/UniformXTabulated2DFunction.hpp>
+#include <opm/material/common/MathToolbox.hpp>
+#include <opm/material/common/Exceptions.hpp>
+
+#include <vector>
+#include <stdexcept>
+#include <cstring>
+#include <cstdint>
+#include <cassert>
+
+namespace Opm {
+
+/*!
+ * \brief A read-only piecewise linear function of one variable whose sampling points
+ *        are stored externally.
+ *
+ * The results are the same as the ones of the Tabulated1DFunction which the data was
+ * taken from.
+ */
+template <class Scalar>
+class Tabulated1DFunctionView
+{
+public:
+    Tabulated1DFunctionView()
+        : xValues_(nullptr)
+        , yValues_(nullptr)
+        , numSamples_(0)
+    {}
+
+    Tabulated1DFunctionView(const Scalar* xValues, const Scalar* yValues, size_t numSamples)
+        : xValues_(xValues)
+        , yValues_(yValues)
+        , numSamples_(numSamples)
+    {}
+
+    size_t numSamples() const
+    { return numSamples_; }
+
+    Scalar xMin() const
+    { return xValues_[0]; }
+
+    Scalar xMax() const
+    { return xValues_[numSamples_ - 1]; }
+
+    Scalar xAt(size_t i) const
+    { return xValues_[i]; }
+
+    Scalar valueAt(size_t i) const
+    { return yValues_[i]; }
+
+    /*!
+     * \copydoc Tabulated1DFunction::applies
+     */
+    template <class Evaluation>
+    bool applies(const Evaluation& x) const
+    { return xValues_[0] <= x && x <= xValues_[numSamples_ - 1]; }
+
+    /*!
+     * \copydoc Tabulated1DFunction::eval
+     */
+    template <class Evaluation>
+    Evaluation eval(const Evaluation& x, bool extrapolate = false) const
+    { return evalInSegment(x, findSegmentIndex(x, extrapolate)); }
+
+    /*!
+     * \copydoc Tabulated1DFunction::findSegmentIndex
+     */
+    template <class Evaluation>
+    size_t findSegmentIndex(const Evaluation& x, bool extrapolate = false) const
+    { return findSegmentIndex_(x, extrapolate); }
+
+    /*!
+     * \copydoc Tabulated1DFunction::evalInSegment
+     */
+    template <class Evaluation>
+    Evaluation evalInSegment(const Evaluation& x, size_t segIdx) const
+    {
+        Scalar x0 = xValues_[segIdx];
+        Scalar x1 = xValues_[segIdx + 1];
+
+        Scalar y0 = yValues_[segIdx];
+        Scalar y1 = yValues_[segIdx + 1];
+
+        return y0 + (y1 - y0)*(x - x0)/(x1 - x0);
+    }
+
+    /*!
+     * \copydoc Tabulated1DFunction::evalDerivative
+     */
+    template <class Evaluation>
+    Evaluation evalDerivative(const Evaluation& x, bool extrapolate = false) const
+    {
+        size_t segIdx = findSegmentIndex_(x, extrapolate);
+
+        Scalar x0 = xValues_[segIdx];
+        Scalar x1 = xValues_[segIdx + 1];
+
+        Scalar y0 = yValues_[segIdx];
+        Scalar y1 = yValues_[segIdx + 1];
+
+        Evaluation ret = blank(x);
+        ret = (y1 - y0)/(x1 - x0);
+        return ret;
+    }
+
+private:
+    template <class Evaluation>
+    size_t findSegmentIndex_(const Evaluation& x, bool extrapolate) const
+    {
+        if (!extrapolate && !applies(x))
+            throw Opm::NumericalIssue("Tried to evaluate a tabulated function outside of its range");
+
+        // we need at least two sampling points!
+        assert(numSamples_ >= 2);
+
+        if (x <= xValues_[1])
+            return 0;
+        else if (x >= xValues_[numSamples_ - 2])
+            return numSamples_ - 2;
+        else {
+            // bisection
+            size_t lowerIdx = 1;
+            size_t upperIdx = numSamples_ - 2;
+            while (lowerIdx + 1 < upperIdx) {
+                size_t pivotIdx = (lowerIdx + upperIdx) / 2;
+                if (x < xValues_[pivotIdx])
+                    upperIdx = pivotIdx;
+                else
+                    lowerIdx = pivotIdx;
+            }
+
+            return lowerIdx;
+        }
+    }
+
+    const Scalar* xValues_;
+    const Scalar* yValues_;
+    size_t numSamples_;
+};
+
+/*!
+ * \brief A read-only function of two variables which is sampled uniformly in the X
+ *        direction and whose sampling points are stored externally.
+ *
+ * The sampling points of all columns are stored consecutively; colBegin[i] is the
+ * index of the first sampling point of column i and colBegin[numX] is the total
+ * number of sampling points. The results are the same as the ones of the
+ * UniformXTabulated2DFunction which the data was taken from.
+ */
+template <class Scalar>
+class UniformXTabulated2DFunctionView
+{
+public:
+    typedef typename UniformXTabulated2DFunction<Scalar>::InterpolationPolicy InterpolationPolicy;
+
+    UniformXTabulated2DFunctionView()
+        : xPos_(nullptr)
+        , yPos_(nullptr)
+        , colBegin_(nullptr)
+        , sampleY_(nullptr)
+        , sampleValues_(nullptr)
+        , numX_(0)
+        , interpolationGuide_(InterpolationPolicy::Vertical)
+    {}
+
+    UniformXTabulated2DFunctionView(const Scalar* xPos,
+                                    const Scalar* yPos,
+                                    const uint64_t* colBegin,
+                                    const Scalar* sampleY,
+                                    const Scalar* sampleValues,
+                                    size_t numX,
+                                    InterpolationPolicy interpolationGuide)
+        : xPos_(xPos)
+        , yPos_(yPos)
+        , colBegin_(colBegin)
+        , sampleY_(sampleY)
+        , sampleValues_(sampleValues)
+        , numX_(numX)
+        , interpolationGuide_(interpolationGuide)
+    {}
+
+    size_t numX() const
+    { return numX_; }
+
+    size_t numY(unsigned i) const
+    { return colBegin_[i + 1] - colBegin_[i]; }
+
+    Scalar xMin() const
+    { return xPos_[0]; }
+
+    Scalar xMax() const
+    { return xPos_[numX_ - 1]; }
+
+    Scalar xAt(size_t i) const
+    { return xPos_[i]; }
+
+    Scalar yAt(size_t i, size_t j) const
+    { return sampleY_[colBegin_[i] + j]; }
+
+    Scalar valueAt(size_t i, size_t j) const
+    { return sampleValues_[colBegin_[i] + j]; }
+
+    Scalar yMin(unsigned i) const
+    { return yAt(i, 0); }
+
+    Scalar yMax(unsigned i) const
+    { return yAt(i, numY(i) - 1); }
+
+    InterpolationPolicy interpolationGuide() const
+    { return interpolationGuide_; }
+
+    /*!
+     * \copydoc UniformXTabulated2DFunction::applies
+     */
+    template <class Evaluation>
+    bool applies(const Evaluation& x, const Evaluation& y) const
+    {
+        if (x < xMin() || xMax() < x)
+            return false;
+
+        unsigned i = xSegmentIndex_(x);
+        Scalar alpha = xToAlpha_(Opm::decay<Scalar>(x), i);
+
+        Scalar minY = alpha*yMin(i) + (1 - alpha)*yMin(i + 1);
+        Scalar maxY = alpha*yMax(i) + (1 - alpha)*yMax(i + 1);
+
+        return minY <= y && y <= maxY;
+    }
+
+    /*!
+     * \copydoc UniformXTabulated2DFunction::eval
+     */
+    template <class Evaluation>
+    Evaluation eval(const Evaluation& x, const Evaluation& y, bool extrapolate = false) const
+    {
+#ifndef NDEBUG
+        if (!extrapolate && !applies(x, y))
+            throw NumericalIssue("Attempt to get undefined table value");
+#else
+        static_cast<void>(extrapolate);
+#endif
+
+        unsigned i = xSegmentIndex_(x);
+        const Evaluation& alpha = xToAlpha_(x, i);
+
+        // see UniformXTabulated2DFunction::eval() for the meaning of the shift
+        Evaluation shift = 0.0;
+        if (interpolationGuide_ == InterpolationPolicy::LeftExtreme)
+            shift = yPos_[i + 1] - yPos_[i];
+        else if (interpolationGuide_ == InterpolationPolicy::RightExtreme) {
+            shift = yPos_[i + 1] - yPos_[i];
+            auto yEnd = yPos_[i]*(1.0 - alpha) + yPos_[i + 1]*alpha;
+            if (yEnd > 0.)
+                shift = shift * y / yEnd;
+            else
+                shift = 0.;
+        }
+        auto yLower =  y - alpha*shift;
+        auto yUpper =  y + (1 - alpha)*shift;
+
+        unsigned j1 = ySegmentIndex_(yLower, i);
+        unsigned j2 = ySegmentIndex_(yUpper, i + 1);
+        const Evaluation& beta1 = yToBeta_(yLower, i, j1);
+        const Evaluation& beta2 = yToBeta_(yUpper, i + 1, j2);
+
+        const Evaluation& s1 = valueAt(i, j1)*(1.0 - beta1) + valueAt(i, j1 + 1)*beta1;
+        const Evaluation& s2 = valueAt(i + 1, j2)*(1.0 - beta2) + valueAt(i + 1, j2 + 1)*beta2;
+
+        return s1*(1.0 - alpha) + s2*alpha;
+    }
+
+private:
+    template <class Evaluation>
+    unsigned xSegmentIndex_(const Evaluation& x) const
+    {
+        assert(numX_ >= 2);
+
+        if (x <= xPos_[1])
+            return 0;
+        else if (x >= xPos_[numX_ - 2])
+            return numX_ - 2;
+
+        unsigned lowerIdx = 1;
+        unsigned upperIdx = numX_ - 2;
+        while (lowerIdx + 1 < upperIdx) {
+            unsigned pivotIdx = (lowerIdx + upperIdx) / 2;
+            if (x < xPos_[pivotIdx])
+                upperIdx = pivotIdx;
+            else
+                lowerIdx = pivotIdx;
+        }
+
+        return lowerIdx;
+    }
+
+    template <class Evaluation>
+    Evaluation xToAlpha_(const Evaluation& x, unsigned segmentIdx) const
+    {
+        Scalar x1 = xPos_[segmentIdx];
+        Scalar x2 = xPos_[segmentIdx + 1];
+        return (x - x1)/(x2 - x1);
+    }
+
+    template <class Evaluation>
+    unsigned ySegmentIndex_(const Evaluation& y, unsigned xSampleIdx) const
+    {
+        const Scalar* colY = sampleY_ + colBegin_[xSampleIdx];
+        unsigned n = numY(xSampleIdx);
+        assert(n >= 2);
+
+        if (y <= colY[1])
+            return 0;
+        else if (y >= colY[n - 2])
+            return n - 2;
+
+        unsigned lowerIdx = 1;
+        unsigned upperIdx = n - 2;
+        while (lowerIdx + 1 < upperIdx) {
+            unsigned pivotIdx = (lowerIdx + upperIdx) / 2;
+            if (y < colY[pivotIdx])
+                upperIdx = pivotIdx;
+            else
+                lowerIdx = pivotIdx;
+        }
+
+        return lowerIdx;
+    }
+
+    template <class Evaluation>
+    Evaluation yToBeta_(const Evaluation& y, unsigned xSampleIdx, unsigned ySegmentIdx) const
+    {
+        Scalar y1 = yAt(xSampleIdx, ySegmentIdx);
+        Scalar y2 = yAt(xSampleIdx, ySegmentIdx + 1);
+        return (y - y1)/(y2 - y1);
+    }
+
+    const Scalar* xPos_;
+    const Scalar* yPos_;
+    const uint64_t* colBegin_;
+    const Scalar* sampleY_;
+    const Scalar* sampleValues_;
+    size_t numX_;
+    InterpolationPolicy interpolationGuide_;
+};
+
+namespace FlatTableDetail {
+// the layout of a flat table image. all offsets are in bytes relative to the
+// beginning of the image, so an image can be mapped at any address.
+static const uint64_t magic = 0x454C4241544D504FULL; // "OPMTABLE"
+static const uint32_t version = 1;
+
+enum TableKind : uint32_t {
+    Tabulated1D = 1,
+    UniformXTabulated2D = 2
+};
+
+struct Header
+{
+    uint64_t magic;
+    uint32_t version;
+    uint32_t scalarSize;
+    uint64_t numTables;
+    uint64_t directoryOffset;
+    uint64_t size;
+};
+
+struct Entry
+{
+    uint32_t kind;
+    uint32_t interpolationGuide;
+    uint64_t numX;
+    uint64_t xOffset;
+    uint64_t yOffset;
+    uint64_t colBeginOffset;
+    uint64_t sampleYOffset;
+    uint64_t sampleValueOffset;
+};
+
+// all arrays are aligned to at least eight bytes
+inline uint64_t alignedSize(uint64_t numBytes, uint64_t alignment = 8)
+{ return (numBytes + alignment - 1) & ~(alignment - 1); }
+} // namespace FlatTableDetail
+
+/*!
+ * \brief Serializes tabulated functions into a contiguous, position independent
+ *        memory image.
+ *
+ * The image can be copied to any location, e.g., a shared memory segment, and then
+ * be accessed using FlatTableImage. Each added table is identified by its index in
+ * the order of addition.
+ */
+template <class Scalar>
+class FlatTableWriter
+{
+    typedef FlatTableDetail::Header Header;
+    typedef FlatTableDetail::Entry Entry;
+
+public:
+    /*!
+     * \brief Create an empty image.
+     *
+     * \param alignment The alignment of the arrays relative to the beginning of the
+     *                  image in bytes. This must be a power of two of at least eight,
+     *                  e.g., the size of a cache line.
+     */
+    explicit FlatTableWriter(size_t alignment = 8)
+        : alignment_(alignment)
+    {
+        if (alignment_ < 8 || (alignment_ & (alignment_ - 1)) != 0)
+            throw std::logic_error("The alignment of a table image must be a power of two of at least eight");
+
+        data_.resize(FlatTableDetail::alignedSize(sizeof(Header), alignment_), 0);
+    }
+
+    /*!
+     * \brief Add a one-dimensional table and return its index.
+     */
+    size_t add(const Tabulated1DFunction<Scalar>& fn)
+    {
+        Entry entry;
+        std::memset(&entry, 0, sizeof(entry));
+        entry.kind = FlatTableDetail::Tabulated1D;
+        entry.numX = fn.numSamples();
+        entry.xOffset = append_(fn.xValues().data(), fn.numSamples());
+        entry.yOffset = append_(fn.yValues().data(), fn.numSamples());
+
+        entries_.push_back(entry);
+        return entries_.size() - 1;
+    }
+
+    /*!
+     * \brief Add a two-dimensional table and return its index.
+     */
+    size_t add(const UniformXTabulated2DFunction<Scalar>& fn)
+    {
+        Entry entry;
+        std::memset(&entry, 0, sizeof(entry));
+        entry.kind = FlatTableDetail::UniformXTabulated2D;
+        entry.interpolationGuide = static_cast<uint32_t>(fn.interpolationGuide());
+        entry.numX = fn.numX();
+        entry.xOffset = append_(fn.xPos().data(), fn.numX());
+        entry.yOffset = append_(fn.yPos().data(), fn.yPos().size());
+
+        std::vector<uint64_t> colBegin(fn.numX() + 1, 0);
+        std::vector<Scalar> sampleY;
+        std::vector<Scalar> sampleValues;
+        for (unsigned i = 0; i < fn.numX(); ++i) {
+            for (unsigned j = 0; j < fn.numY(i); ++j) {
+                sampleY.push_back(fn.yAt(i, j));
+                sampleValues.push_back(fn.valueAt(i, j));
+            }
+            colBegin[i + 1] = sampleY.size();
+        }
+        entry.colBeginOffset = append_(colBegin.data(), colBegin.size());
+        entry.sampleYOffset = append_(sampleY.data(), sampleY.size());
+        entry.sampleValueOffset = append_(sampleValues.data(), sampleValues.size());
+
+        entries_.push_back(entry);
+        return entries_.size() - 1;
+    }
+
+    /*!
+     * \brief Returns the number of tables which have been added.
+     */
+    size_t numTables() const
+    { return entries_.size(); }
+
+    /*!
+     * \brief Returns the size of the image in bytes.
+     */
+    size_t size() const
+    { return data_.size() + entries_.size()*sizeof(Entry); }
+
+    /*!
+     * \brief Write the image to a memory location with room for size() bytes.
+     *
+     * The location must be aligned to eight bytes or to the alignment passed to the
+     * constructor if that is larger.
+     */
+    void writeTo(void* dest) const
+    {
+        Header header;
+        std::memset(&header, 0, sizeof(header));
+        header.magic = FlatTableDetail::magic;
+        header.version = FlatTableDetail::version;
+        header.scalarSize = sizeof(Scalar);
+        header.numTables = entries_.size();
+        header.directoryOffset = data_.size();
+        header.size = size();
+
+        char* destBytes = static_cast<char*>(dest);
+        std::memcpy(destBytes, data_.data(), data_.size());
+        std::memcpy(destBytes, &header, sizeof(header));
+        if (!entries_.empty())
+            std::memcpy(destBytes + data_.size(), entries_.data(), entries_.size()*sizeof(Entry));
+    }
+
+private:
+    template <class T>
+    uint64_t append_(const T* values, size_t n)
+    {
+        uint64_t offset = data_.size();
+        data_.resize(offset + FlatTableDetail::alignedSize(n*sizeof(T), alignment_), 0);
+        if (n > 0)
+            std::memcpy(data_.data() + offset, values, n*sizeof(T));
+        return offset;
+    }
+
+    size_t alignment_;
+    std::vector<char> data_;
+    std::vector<Entry> entries_;
+};
+
+/*!
+ * \brief Provides access to the tables of an image written by FlatTableWriter.
+ *
+ * The image is not copied, i.e., it must stay valid as long as the object or any
+ * view obtained from it is used. Since the views only read the image, it may reside
+ * in read-only memory.
+ */
+template <class Scalar>
+class FlatTableImage
+{
+    typedef FlatTableDetail::Header Header;
+    typedef FlatTableDetail::Entry Entry;
+
+public:
+    typedef Tabulated1DFunctionView<Scalar> OneDView;
+    typedef UniformXTabulated2DFunctionView<Scalar> TwoDView;
+
+    FlatTableImage()
+        : data_(nullptr)
+        , header_(nullptr)
+        , entries_(nullptr)
+    {}
+
+    /*!
+     * \brief Attach the object to an image.
+     *
+     * An exception is thrown if the memory does not contain a compatible image.
+     */
+    FlatTableImage(const void* data, size_t size)
+    {
+        data_ = static_cast<const char*>(data);
+        header_ = reinterpret_cast<const Header*>(data_);
+
+        if (size < sizeof(Header) || header_->magic != FlatTableDetail::magic)
+            throw std::runtime_error("Memory does not contain a table image");
+        if (header_->version != FlatTableDetail::version)
+            throw std::runtime_error("Unsupported version of the table image: "
+                                     +std::to_string(header_->version));
+        if (header_->scalarSize != sizeof(Scalar))
+            throw std::runtime_error("The table image uses a different floating point type");
+        if (header_->size > size
+            || header_->directoryOffset + header_->numTables*sizeof(Entry) > header_->size)
+            throw std::runtime_error("The table image is truncated");
+
+        entries_ = reinterpret_cast<const Entry*>(data_ + header_->directoryOffset);
+    }
+
+    size_t numTables() const
+    { return header_ ? header_->numTables : 0; }
+
+    /*!
+     * \brief Returns true iff a table is one-dimensional.
+     */
+    bool isOneD(size_t tableIdx) const
+    { return entry_(tableIdx).kind == FlatTableDetail::Tabulated1D; }
+
+    /*!
+     * \brief Returns a view on a one-dimensional table.
+     */
+    OneDView oneD(size_t tableIdx) const
+    {
+        const Entry& entry = entry_(tableIdx);
+        if (entry.kind != FlatTableDetail::Tabulated1D)
+            throw std::logic_error("Table "+std::to_string(tableIdx)+" is not one-dimensional");
+
+        return OneDView(array_<Scalar>(entry.xOffset),
+                        array_<Scalar>(entry.yOffset),
+                        entry.numX);
+    }
+
+    /*!
+     * \brief Returns a view on a two-dimensional table.
+     */
+    TwoDView twoD(size_t tableIdx) const
+    {
+        const Entry& entry = entry_(tableIdx);
+        if (entry.kind != FlatTableDetail::UniformXTabulated2D)
+            throw std::logic_error("Table "+std::to_string(tableIdx)+" is not two-dimensional");
+
+        typedef typename TwoDView::InterpolationPolicy InterpolationPolicy;
+        return TwoDView(array_<Scalar>(entry.xOffset),
+                        array_<Scalar>(entry.yOffset),
+                        array_<uint64_t>(entry.colBeginOffset),
+                        array_<Scalar>(entry.sampleYOffset),
+                        array_<Scalar>(entry.sampleValueOffset),
+                        entry.numX,
+                        static_cast<InterpolationPolicy>(entry.interpolationGuide));
+    }
+
+private:
+    const Entry& entry_(size_t tableIdx) const
+    {
+        if (tableIdx >= numTables())
+            throw std::out_of_range("Invalid table index "+std::to_string(tableIdx));
+        return entries_[tableIdx];
+    }
+
+    template <class T>
+    const T* array_(uint64_t offset) const
+    { return reinterpret_cast<const T*>(data_ + offset); }
+
+    const char* data_;
+    const Header* header_;
+    const Entry* entries_;
+};
+
+} // namespace Opm
+
+#endif
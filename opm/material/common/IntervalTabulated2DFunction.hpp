@@ -30,6 +30,7 @@
 
 #include <opm/material/common/Valgrind.hpp>
 #include <opm/material/common/Exceptions.hpp>
+#include <opm/material/common/EvaluationStatus.hpp>
 #include <opm/material/common/Unused.hpp>
 #include <opm/material/common/MathToolbox.hpp>
 
@@ -196,23 +197,39 @@ public:
             throw NumericalIssue(oss.str());
         };
 
-        // bi-linear interpolation: first, calculate the x and y indices in the lookup
-        // table ...
-        const unsigned i = xSegmentIndex_(x);
-        const unsigned j = ySegmentIndex_(y);
-
-        // bi-linear interpolation / extrapolation
-        const Evaluation alpha = xToAlpha(x, i);
-        const Evaluation beta = yToBeta(y, j);
-
-        const Evaluation s1 = valueAt(i, j) * (1.0 - beta) + valueAt(i, j + 1) * beta;
-        const Evaluation s2 = valueAt(i + 1, j) * (1.0 - beta) + valueAt(i + 1, j + 1) * beta;
-
-        Valgrind::CheckDefined(s1);
-        Valgrind::CheckDefined(s2);
+        return evalUnchecked_(x, y);
+    }
 
-        // ... and combine them using the x position
-        return s1*(1.0 - alpha) + s2*alpha;
+    /*!
+     * \brief Evaluate the function at a given (x,y) position without throwing.
+     *
+     * If the position is outside of the tabulated range in a direction which may not
+     * be extrapolated, the violation is recorded in the status object. Depending on
+     * its policy, the function is then extrapolated anyway or the coordinate is
+     * clamped to the tabulated range.
+     */
+    template <typename Evaluation>
+    Evaluation eval(const Evaluation& x,
+                    const Evaluation& y,
+                    EvaluationStatus<Scalar>& status,
+                    unsigned tableId = 0) const
+    {
+        const bool xViolated = !xExtrapolate_ && !appliesX(x);
+        const bool yViolated = !yExtrapolate_ && !appliesY(y);
+        if (!xViolated && !yViolated)
+            return evalUnchecked_(x, y);
+
+        status.record(tableId, Opm::scalarValue(x), Opm::scalarValue(y));
+        if (!status.clamp())
+            return evalUnchecked_(x, y);
+
+        Evaluation xClamped = x;
+        if (xViolated)
+            xClamped = Opm::min(Opm::max(x, xMin()), xMax());
+        Evaluation yClamped = y;
+        if (yViolated)
+            yClamped = Opm::min(Opm::max(y, yMin()), yMax());
+        return evalUnchecked_(xClamped, yClamped);
     }
 
 private:
@@ -226,29 +243,33 @@ private:
     bool xExtrapolate_ = false;
     bool yExtrapolate_ = false;
 
-    /*!
-     * \brief Return the interval index of a given position on the x-axis.
-     */
-    template <class Evaluation>
-    unsigned xSegmentIndex_(const Evaluation& x) const
+    template <typename Evaluation>
+    Evaluation evalUnchecked_(const Evaluation& x, const Evaluation& y) const
     {
-        assert(xExtrapolate_ || appliesX(x) );
+        // bi-linear interpolation: first, calculate the x and y indices in the lookup
+        // table ...
+        const unsigned i = segmentIndex_(x, xPos_);
+        const unsigned j = segmentIndex_(y, yPos_);
 
-        return segmentIndex_(x, xPos_);
-    }
+        // bi-linear interpolation / extrapolation
+        const Evaluation alpha = xToAlpha(x, i);
+        const Evaluation beta = yToBeta(y, j);
 
-    /*!
-     * \brief Return the interval index of a given position on the y-axis.
-     */
-    template <class Evaluation>
-    unsigned ySegmentIndex_(const Evaluation& y) const
-    {
-        assert(yExtrapolate_ || appliesY(y) );
+        const Evaluation s1 = valueAt(i, j) * (1.0 - beta) + valueAt(i, j + 1) * beta;
+        const Evaluation s2 = valueAt(i + 1, j) * (1.0 - beta) + valueAt(i + 1, j + 1) * beta;
 
-        return segmentIndex_(y, yPos_);
-    }
+        Valgrind::CheckDefined(s1);
+        Valgrind::CheckDefined(s2);
 
+        // ... and combine them using the x position
+        return s1*(1.0 - alpha) + s2*alpha;
+    }
 
+    /*!
+     * \brief Return the interval index of a given position on one of the axes.
+     *
+     * Positions outside of the range yield the first or the last interval.
+     */
     template <class Evaluation>
     static unsigned segmentIndex_(const Evaluation& v, const std::vector<Scalar>& vPos)
     {
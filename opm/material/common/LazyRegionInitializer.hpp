@@ -0,0 +1,150 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+
+  Consult the COPYING file in the top-level source directory of this
+  module for the precise wording of the license and the list of
+  copyright holders.
+*/
+/*!
+ * \file
+ * \copydoc Opm::LazyRegionInitializer
+ */
+#ifndef OPM_LAZY_REGION_INITIALIZER_HPP
+#define OPM_LAZY_REGION_INITIALIZER_HPP
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <cassert>
+#include <cstddef>
+
+namespace Opm {
+
+/*!
+ * \brief Keeps track of which regions of a region-based object have already been
+ *        initialized and initializes the remaining ones on demand.
+ *
+ * Each region is initialized at most once, even if several threads request it
+ * concurrently. Once a region is initialized, checking for it only costs an atomic
+ * load. If no regions have been registered using resize(), all regions are
+ * considered to be initialized, so objects which are set up eagerly do not need to
+ * special-case anything.
+ *
+ * Copies start with fresh synchronization primitives but remember which regions were
+ * already initialized at the time of copying.
+ */
+class LazyRegionInitializer
+{
+public:
+    LazyRegionInitializer()
+        : size_(0)
+    {}
+
+    LazyRegionInitializer(const LazyRegionInitializer& other)
+        : size_(0)
+    { *this = other; }
+
+    LazyRegionInitializer& operator=(const LazyRegionInitializer& other)
+    {
+        if (this == &other)
+            return *this;
+
+        resize(other.size_);
+        for (size_t regionIdx = 0; regionIdx < size_; ++regionIdx)
+            initialized_[regionIdx].store(other.isInitialized(regionIdx));
+
+        return *this;
+    }
+
+    /*!
+     * \brief Register a number of regions which are not initialized yet.
+     *
+     * Zero means that all regions are considered to be initialized.
+     */
+    void resize(size_t numRegions)
+    {
+        size_ = numRegions;
+        onceFlags_.reset(numRegions > 0 ? new std::once_flag[numRegions] : nullptr);
+        initialized_.reset(numRegions > 0 ? new std::atomic<bool>[numRegions] : nullptr);
+        for (size_t regionIdx = 0; regionIdx < numRegions; ++regionIdx)
+            initialized_[regionIdx].store(false);
+    }
+
+    /*!
+     * \brief Returns the number of registered regions.
+     */
+    size_t size() const
+    { return size_; }
+
+    /*!
+     * \brief Returns true if regions are initialized on demand.
+     */
+    bool isLazy() const
+    { return size_ > 0; }
+
+    /*!
+     * \brief Returns true iff a region has already been initialized.
+     */
+    bool isInitialized(size_t regionIdx) const
+    {
+        if (size_ == 0)
+            return true;
+
+        assert(regionIdx < size_);
+        return initialized_[regionIdx].load(std::memory_order_acquire);
+    }
+
+    /*!
+     * \brief Call a function for a region unless it was already called for it.
+     *
+     * If the function throws, the region is not considered initialized and the
+     * exception is propagated to the caller.
+     */
+    template <class InitFn>
+    void ensure(size_t regionIdx, InitFn initFn) const
+    {
+        if (isInitialized(regionIdx))
+            return;
+
+        std::call_once(onceFlags_[regionIdx],
+                       [&]()
+                       {
+                           initFn(regionIdx);
+                           initialized_[regionIdx].store(true, std::memory_order_release);
+                       });
+    }
+
+    /*!
+     * \brief Call a function for all regions for which it was not called yet.
+     */
+    template <class InitFn>
+    void ensureAll(InitFn initFn) const
+    {
+        for (size_t regionIdx = 0; regionIdx < size_; ++regionIdx)
+            ensure(regionIdx, initFn);
+    }
+
+private:
+    size_t size_;
+    std::unique_ptr<std::once_flag[]> onceFlags_;
+    std::unique_ptr<std::atomic<bool>[]> initialized_;
+};
+
+} // namespace Opm
+
+#endif
@@ -100,7 +100,7 @@ public:
      * This basically boils down to creating an uninitialized object of sufficient size.
      * This is method only non-trivial for dynamically-sized Evaluation objects.
      */
-    static Scalar createBlank(Scalar value OPM_UNUSED)
+    static Scalar createBlank(Scalar /*value*/)
     { return Scalar(); }
 
     /*!
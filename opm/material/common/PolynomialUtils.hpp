@@ -29,6 +29,9 @@
 
 #include <cmath>
 #include <algorithm>
+#include <limits>
+#include <type_traits>
+#include <cstddef>
 
 #include <opm/material/common/MathToolbox.hpp>
 
@@ -309,6 +312,222 @@ unsigned invertCubicPolynomial(SolContainer* sol,
 
     return 3;
 }
+
+/*!
+ * \ingroup Math
+ * \brief Attach the derivatives to a root of a cubic polynomial which depends on
+ *        some variables.
+ *
+ * The root x is expected to be computed from the values of the coefficients. Its
+ * derivatives are then given by the implicit function theorem,
+ * \f[ \frac{\partial x}{\partial \theta} =
+ *     - \frac{\partial p / \partial \theta}{p'(x)} \f]
+ * instead of being propagated through the formulas which determine the root. The
+ * value of the result is x. For multiple roots, p'(x) vanishes and the derivatives
+ * are set to zero.
+ *
+ * \param x The value of the root
+ * \param a The coefficient for the cubic term
+ * \param b The coefficient for the quadratic term
+ * \param c The coefficient for the linear term
+ * \param d The coefficient for the constant term
+ */
+template <class Evaluation>
+Evaluation cubicPolynomialRoot(const typename MathToolbox<Evaluation>::Scalar& x,
+                               const Evaluation& a,
+                               const Evaluation& b,
+                               const Evaluation& c,
+                               const Evaluation& d)
+{
+    typedef typename MathToolbox<Evaluation>::Scalar Scalar;
+
+    Scalar fPrime =
+        Opm::scalarValue(c) + x*(2*Opm::scalarValue(b) + x*3*Opm::scalarValue(a));
+    if (!(std::abs(fPrime) >= 1e-30))
+        return Opm::constant(a, x);
+
+    // only the derivatives of p w.r.t. the variables are required, so its value is
+    // subtracted. this leaves the value of x untouched.
+    const Evaluation& f = d + x*(c + x*(b + x*a));
+    return x - (f - Opm::scalarValue(f))/fPrime;
+}
+
+//! \cond SKIP_THIS
+// one Newton step for the normalized polynomial x^3 + b*x^2 + c*x + d which is only
+// accepted if it improves the root
+template <class Scalar>
+Scalar polishCubicPolynomialRoot_(Scalar x, Scalar b, Scalar c, Scalar d)
+{
+    Scalar fOld = d + x*(c + x*(b + x));
+    Scalar fPrime = c + x*(2*b + x*3);
+    bool validPrime = std::abs(fPrime) >= 1e-30;
+    Scalar xNew = x - fOld/(validPrime ? fPrime : Scalar(1.0));
+    Scalar fNew = d + xNew*(c + xNew*(b + xNew));
+    return (validPrime && std::abs(fNew) < std::abs(fOld)) ? xNew : x;
+}
+
+template <class Scalar>
+void invertCubicPolynomialsKernel_(size_t numPolys,
+                                   const Scalar* a,
+                                   const Scalar* b,
+                                   const Scalar* c,
+                                   const Scalar* d,
+                                   Scalar* sol,
+                                   unsigned* numSol)
+{
+    // both the case of a single real root and the one of three real roots are
+    // computed for all polynomials and the result is selected afterwards. Since the
+    // loop body does not branch, the compiler can vectorize it.
+    for (size_t polyIdx = 0; polyIdx < numPolys; ++polyIdx) {
+        // the degenerate polynomials are fixed up below
+        Scalar aSafe = (std::abs(a[polyIdx]) < 1e-30) ? Scalar(1.0) : a[polyIdx];
+        Scalar bn = b[polyIdx]/aSafe;
+        Scalar cn = c[polyIdx]/aSafe;
+        Scalar dn = d[polyIdx]/aSafe;
+
+        // get rid of the quadratic term by subsituting x = t - b/3, see
+        // invertCubicPolynomial()
+        Scalar p = cn - bn*bn/3;
+        Scalar q = dn + (2*bn*bn*bn - 9*bn*cn)/27;
+        Scalar wDisc = q*q/4 + p*p*p/27;
+        bool threeRoots = wDisc < 0;
+
+        // single real root: Cardano's formula. the sign of the square root is chosen
+        // such that no cancellation occurs, u is thus only zero if p and q are.
+        Scalar s = std::sqrt(std::max(wDisc, Scalar(0.0)));
+        Scalar u = std::cbrt(-q/2 - std::copysign(s, q));
+        Scalar t = u - p/(3*((u == 0) ? Scalar(1.0) : u));
+
+        // three real roots: the trigonometric form, which requires p < 0. the angle
+        // is computed using atan2() because acos() is ill-conditioned for nearly
+        // double roots. it is in [0, pi/3], so the roots are ordered.
+        Scalar r = std::sqrt(-std::min(p, Scalar(-1e-30))/3);
+        Scalar phi = std::atan2(std::sqrt(std::max(-wDisc, Scalar(0.0))), -q/2)/3;
+        Scalar tMin = 2*r*std::cos(phi + Scalar(2*M_PI/3));
+        Scalar tMid = 2*r*std::cos(phi - Scalar(2*M_PI/3));
+        Scalar tMax = 2*r*std::cos(phi);
+
+        Scalar x0 = polishCubicPolynomialRoot_((threeRoots ? tMin : t) - bn/3, bn, cn, dn);
+        Scalar x1 = polishCubicPolynomialRoot_((threeRoots ? tMid : t) - bn/3, bn, cn, dn);
+        Scalar x2 = polishCubicPolynomialRoot_((threeRoots ? tMax : t) - bn/3, bn, cn, dn);
+
+        // the Newton step may swap roots which are very close
+        Scalar lo = std::min(x0, x1);
+        Scalar hi = std::max(x0, x1);
+        sol[3*polyIdx + 0] = std::min(lo, x2);
+        sol[3*polyIdx + 1] = std::max(lo, std::min(hi, x2));
+        sol[3*polyIdx + 2] = std::max(hi, x2);
+        numSol[polyIdx] = threeRoots ? 3 : 1;
+    }
+
+    // polynomials with a vanishing cubic term are rare, so they are treated separately
+    for (size_t polyIdx = 0; polyIdx < numPolys; ++polyIdx) {
+        if (std::abs(a[polyIdx]) >= 1e-30)
+            continue;
+
+        Scalar* polySol = sol + 3*polyIdx;
+        unsigned n = invertQuadraticPolynomial(polySol, b[polyIdx], c[polyIdx], d[polyIdx]);
+        for (unsigned i = n; i < 3; ++i)
+            polySol[i] = (n > 0) ? polySol[n - 1] : std::numeric_limits<Scalar>::quiet_NaN();
+        numSol[polyIdx] = n;
+    }
+}
+
+template <class Scalar>
+void invertCubicPolynomials_(std::true_type /*isScalar*/,
+                             size_t numPolys,
+                             const Scalar* a,
+                             const Scalar* b,
+                             const Scalar* c,
+                             const Scalar* d,
+                             Scalar* sol,
+                             unsigned* numSol)
+{ invertCubicPolynomialsKernel_(numPolys, a, b, c, d, sol, numSol); }
+
+template <class Evaluation>
+void invertCubicPolynomials_(std::false_type /*isScalar*/,
+                             size_t numPolys,
+                             const Evaluation* a,
+                             const Evaluation* b,
+                             const Evaluation* c,
+                             const Evaluation* d,
+                             Evaluation* sol,
+                             unsigned* numSol)
+{
+    typedef typename MathToolbox<Evaluation>::Scalar Scalar;
+
+    // the roots are determined from the values of the coefficients in chunks which
+    // fit onto the stack
+    const size_t chunkSize = 64;
+    Scalar aVal[chunkSize], bVal[chunkSize], cVal[chunkSize], dVal[chunkSize];
+    Scalar x[3*chunkSize];
+    for (size_t beginIdx = 0; beginIdx < numPolys; beginIdx += chunkSize) {
+        size_t n = std::min(chunkSize, numPolys - beginIdx);
+        for (size_t i = 0; i < n; ++i) {
+            aVal[i] = Opm::scalarValue(a[beginIdx + i]);
+            bVal[i] = Opm::scalarValue(b[beginIdx + i]);
+            cVal[i] = Opm::scalarValue(c[beginIdx + i]);
+            dVal[i] = Opm::scalarValue(d[beginIdx + i]);
+        }
+
+        invertCubicPolynomialsKernel_(n, aVal, bVal, cVal, dVal, x, numSol + beginIdx);
+
+        for (size_t i = 0; i < n; ++i) {
+            size_t polyIdx = beginIdx + i;
+            Evaluation* polySol = sol + 3*polyIdx;
+            for (unsigned k = 0; k < 3; ++k) {
+                if (k < numSol[polyIdx])
+                    polySol[k] = cubicPolynomialRoot(x[3*i + k],
+                                                     a[polyIdx], b[polyIdx], c[polyIdx], d[polyIdx]);
+                else if (k > 0)
+                    polySol[k] = polySol[k - 1];
+                else
+                    polySol[k] = Opm::constant(a[polyIdx], x[3*i + k]);
+            }
+        }
+    }
+}
+//! \endcond
+
+/*!
+ * \ingroup Math
+ * \brief Invert a batch of cubic polynomials
+ *
+ * The polynomials are defined as
+ * \f[ p_i(x) = a_i\; x^3 + b_i\;x^2 + c_i\;x + d_i \f]
+ *
+ * This yields the same roots as invertCubicPolynomial(), but all polynomials are
+ * processed by a loop which does not branch, so it can be vectorized by the
+ * compiler. The "sol" argument must provide space for three roots per polynomial:
+ * The real roots of polynomial i are written to sol[3*i], sol[3*i + 1] and sol[3*i +
+ * 2] with the smallest root first, and their number is written to numSol[i]. The
+ * remaining entries are set to the largest real root, or to NaN if there is none.
+ * Unlike for invertCubicPolynomial(), a triple root is reported as a single one.
+ *
+ * If the coefficients are function evaluations, the roots are computed from their
+ * values and the derivatives are attached afterwards using cubicPolynomialRoot().
+ *
+ * \param numPolys The number of polynomials
+ * \param a The coefficients for the cubic terms
+ * \param b The coefficients for the quadratic terms
+ * \param c The coefficients for the linear terms
+ * \param d The coefficients for the constant terms
+ * \param sol Array into which the solutions are written
+ * \param numSol Array into which the numbers of real roots are written
+ */
+template <class Evaluation>
+void invertCubicPolynomials(size_t numPolys,
+                            const Evaluation* a,
+                            const Evaluation* b,
+                            const Evaluation* c,
+                            const Evaluation* d,
+                            Evaluation* sol,
+                            unsigned* numSol)
+{
+    typedef typename MathToolbox<Evaluation>::Scalar Scalar;
+    invertCubicPolynomials_(std::is_same<Evaluation, Scalar>(),
+                            numPolys, a, b, c, d, sol, numSol);
+}
 }
 
 #endif
@@ -0,0 +1,248 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+
+  Consult the COPYING file in the top-level source directory of this
+  module for the precise wording of the license and the list of
+  copyright holders.
+*/
+/*!
+ * \file
+ * \copydoc Opm::SharedMemorySegment
+ */
+#ifndef OPM_SHARED_MEMORY_SEGMENT_HPP
+#define OPM_SHARED_MEMORY_SEGMENT_HPP
+
+#include <string>
+#include <stdexcept>
+#include <cstring>
+#include <cerrno>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define OPM_SHARED_MEMORY_SEGMENT_USE_SHM_ 1
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace Opm {
+
+/*!
+ * \brief A named POSIX shared memory segment which is mapped into the address space
+ *        of the process.
+ *
+ * One process creates the segment and fills it, the other processes on the same
+ * node open it read-only. After all processes have opened the segment, its name can
+ * be removed using unlink(); the memory stays valid until the last mapping is
+ * closed. Since the segment may be mapped at different addresses in each process,
+ * the data must not contain pointers; see FlatTableWriter for a suitable
+ * representation of tabulated functions.
+ *
+ * The object is not copyable. All errors are reported by throwing
+ * std::runtime_error.
+ */
+class SharedMemorySegment
+{
+public:
+    SharedMemorySegment()
+        : data_(nullptr)
+        , size_(0)
+        , writable_(false)
+    {}
+
+    SharedMemorySegment(const SharedMemorySegment&) = delete;
+    SharedMemorySegment& operator=(const SharedMemorySegment&) = delete;
+
+    ~SharedMemorySegment()
+    { close(); }
+
+    /*!
+     * \brief Returns true if shared memory segments are supported on the platform.
+     */
+    static bool isSupported()
+    {
+#if OPM_SHARED_MEMORY_SEGMENT_USE_SHM_
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    /*!
+     * \brief Create a new segment and map it for reading and writing.
+     *
+     * The name must start with a slash and must not contain any other slashes. It is
+     * an error if a segment of the same name already exists.
+     */
+    void create(const std::string& name, size_t size)
+    {
+        close();
+#if OPM_SHARED_MEMORY_SEGMENT_USE_SHM_
+        int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, S_IRUSR | S_IWUSR);
+        if (fd < 0)
+            throwError_("Could not create shared memory segment '"+name+"'");
+
+        if (ftruncate(fd, static_cast<off_t>(size)) != 0) {
+            int err = errno;
+            ::close(fd);
+            shm_unlink(name.c_str());
+            errno = err;
+            throwError_("Could not resize shared memory segment '"+name+"'");
+        }
+
+        map_(fd, size, /*writable=*/true, name);
+#else
+        static_cast<void>(name);
+        static_cast<void>(size);
+        throw std::runtime_error("Shared memory segments are not supported on this platform");
+#endif
+    }
+
+    /*!
+     * \brief Map an existing segment read-only.
+     */
+    void open(const std::string& name)
+    {
+        close();
+#if OPM_SHARED_MEMORY_SEGMENT_USE_SHM_
+        int fd = shm_open(name.c_str(), O_RDONLY, 0);
+        if (fd < 0)
+            throwError_("Could not open shared memory segment '"+name+"'");
+
+        struct stat st;
+        if (fstat(fd, &st) != 0) {
+            int err = errno;
+            ::close(fd);
+            errno = err;
+            throwError_("Could not determine the size of shared memory segment '"+name+"'");
+        }
+
+        map_(fd, static_cast<size_t>(st.st_size), /*writable=*/false, name);
+#else
+        static_cast<void>(name);
+        throw std::runtime_error("Shared memory segments are not supported on this platform");
+#endif
+    }
+
+    /*!
+     * \brief Unmap the segment from the address space of the process.
+     */
+    void close()
+    {
+#if OPM_SHARED_MEMORY_SEGMENT_USE_SHM_
+        if (data_ && size_ > 0)
+            munmap(data_, size_);
+#endif
+        data_ = nullptr;
+        size_ = 0;
+        writable_ = false;
+    }
+
+    /*!
+     * \brief Remove the name of a segment.
+     *
+     * Existing mappings are not affected, but the segment can no longer be opened.
+     */
+    static void unlink(const std::string& name)
+    {
+#if OPM_SHARED_MEMORY_SEGMENT_USE_SHM_
+        if (shm_unlink(name.c_str()) != 0 && errno != ENOENT)
+            throwError_("Could not unlink shared memory segment '"+name+"'");
+#else
+        static_cast<void>(name);
+#endif
+    }
+
+    /*!
+     * \brief Returns true iff a segment is mapped.
+     */
+    bool isOpen() const
+    { return data_ != nullptr; }
+
+    /*!
+     * \brief Returns true iff the segment was created by this object.
+     */
+    bool isWritable() const
+    { return writable_; }
+
+    /*!
+     * \brief The size of the segment in bytes.
+     */
+    size_t size() const
+    { return size_; }
+
+    /*!
+     * \brief The beginning of the mapped segment.
+     *
+     * The address is aligned to a page boundary.
+     */
+    const void* data() const
+    { return data_; }
+
+    /*!
+     * \brief The beginning of the mapped segment for writing.
+     *
+     * This may only be called for segments which were created by this object.
+     */
+    void* writableData()
+    {
+        if (!writable_)
+            throw std::logic_error("Shared memory segment is mapped read-only");
+        return data_;
+    }
+
+private:
+#if OPM_SHARED_MEMORY_SEGMENT_USE_SHM_
+    void map_(int fd, size_t size, bool writable, const std::string& name)
+    {
+        void* addr = nullptr;
+        // mmap() does not accept empty mappings
+        if (size > 0) {
+            addr = mmap(nullptr, size,
+                        writable ? (PROT_READ | PROT_WRITE) : PROT_READ,
+                        MAP_SHARED, fd, 0);
+            if (addr == MAP_FAILED) {
+                int err = errno;
+                ::close(fd);
+                errno = err;
+                throwError_("Could not map shared memory segment '"+name+"'");
+            }
+        }
+
+        // the mapping stays valid after the file descriptor has been closed
+        ::close(fd);
+
+        data_ = addr;
+        size_ = size;
+        writable_ = writable;
+    }
+#endif
+
+    static void throwError_(const std::string& msg)
+    { throw std::runtime_error(msg+": "+std::strerror(errno)); }
+
+    void* data_;
+    size_t size_;
+    bool writable_;
+};
+
+} // namespace Opm
+
+#undef OPM_SHARED_MEMORY_SEGMENT_USE_SHM_
+
+#endif
@@ -28,10 +28,13 @@
 #define OPM_SPLINE_HPP
 
 #include <opm/material/common/TridiagonalMatrix.hpp>
+#include <opm/material/common/BatchedTridiagonalSolver.hpp>
 #include <opm/material/common/PolynomialUtils.hpp>
 #include <opm/material/common/Exceptions.hpp>
 #include <opm/material/common/Unused.hpp>
 
+#include <algorithm>
+#include <limits>
 #include <ostream>
 #include <vector>
 #include <tuple>
@@ -86,6 +89,12 @@ namespace Opm
  s \in \mathcal{C}^1
  * \f]
  * is true.
+ *
+ * Once the spline has been specified, its segments are converted to a "compiled"
+ * form, i.e., the coefficients of the cubic polynomial in the local coordinate
+ * \f$x - x_i\f$ of each segment are stored in a contiguous array. Evaluating the
+ * spline or its derivatives thus only requires to find the segment, which is an
+ * O(1) operation if the sampling points are equidistant, and a Horner scheme.
  */
 template<class Scalar>
 class Spline
@@ -297,6 +306,7 @@ public:
         M.solve(moments, d);
 
         this->setSlopesFromMoments_(slopeVec_, moments);
+        this->compile_();
     }
 
 
@@ -531,8 +541,10 @@ public:
             makePeriodicSpline_();
         else if (splineType == Natural)
             makeNaturalSpline_();
-        else if (splineType == Monotonic)
+        else if (splineType == Monotonic) {
             this->makeMonotonicSpline_(slopeVec_);
+            this->compile_();
+        }
         else
             throw std::runtime_error("Spline type "+std::to_string(int(splineType))+" not supported at this place");
     }
@@ -570,8 +582,10 @@ public:
             makePeriodicSpline_();
         else if (splineType == Natural)
             makeNaturalSpline_();
-        else if (splineType == Monotonic)
+        else if (splineType == Monotonic) {
             this->makeMonotonicSpline_(slopeVec_);
+            this->compile_();
+        }
         else
             throw std::runtime_error("Spline type "+std::to_string(int(splineType))+" not supported at this place");
     }
@@ -613,8 +627,10 @@ public:
             makePeriodicSpline_();
         else if (splineType == Natural)
             makeNaturalSpline_();
-        else if (splineType == Monotonic)
+        else if (splineType == Monotonic) {
             this->makeMonotonicSpline_(slopeVec_);
+            this->compile_();
+        }
         else
             throw std::runtime_error("Spline type "+std::to_string(int(splineType))+" not supported at this place");
     }
@@ -656,8 +672,10 @@ public:
             makePeriodicSpline_();
         else if (splineType == Natural)
             makeNaturalSpline_();
-        else if (splineType == Monotonic)
+        else if (splineType == Monotonic) {
             this->makeMonotonicSpline_(slopeVec_);
+            this->compile_();
+        }
         else
             throw std::runtime_error("Spline type "+std::to_string(int(splineType))+" not supported at this place");
     }
@@ -699,12 +717,87 @@ public:
             makePeriodicSpline_();
         else if (splineType == Natural)
             makeNaturalSpline_();
-        else if (splineType == Monotonic)
+        else if (splineType == Monotonic) {
             this->makeMonotonicSpline_(slopeVec_);
+            this->compile_();
+        }
         else
             throw std::runtime_error("Spline type "+std::to_string(int(splineType))+" not supported at this place");
     }
 
+    ///////////////////////////////////////
+    ///////////////////////////////////////
+    ///////////////////////////////////////
+    // Batched construction              //
+    ///////////////////////////////////////
+    ///////////////////////////////////////
+    ///////////////////////////////////////
+    /*!
+     * \brief Set the sampling points of many natural, periodic or
+     *        monotonic splines which exhibit the same number of
+     *        sampling points at once.
+     *
+     * The sampling points of spline k are x[k*nSamples + i] and
+     * y[k*nSamples + i] for 0 <= i < nSamples. The linear systems of
+     * equations for the moments of all splines are solved together
+     * using BatchedTridiagonalSolver, which makes constructing large
+     * numbers of splines (e.g. one per region or per cell) bulk work.
+     */
+    template <class ScalarArrayX, class ScalarArrayY>
+    static void setXYArraysBatch(size_t numSplines,
+                                 Spline* splines,
+                                 size_t nSamples,
+                                 const ScalarArrayX& x,
+                                 const ScalarArrayY& y,
+                                 SplineType splineType = Natural,
+                                 bool sortInputs = true)
+    {
+        assert(nSamples > 1);
+
+        for (size_t k = 0; k < numSplines; ++k)
+            splines[k].assignBatchSamples_(k, nSamples, x, y, sortInputs);
+
+        if (splineType == Monotonic) {
+            for (size_t k = 0; k < numSplines; ++k) {
+                splines[k].makeMonotonicSpline_(splines[k].slopeVec_);
+                splines[k].compile_();
+            }
+        }
+        else if (splineType == Natural || splineType == Periodic)
+            makeSplinesBatched_(numSplines, splines, splineType,
+                                static_cast<const Vector*>(nullptr),
+                                static_cast<const Vector*>(nullptr));
+        else
+            throw std::runtime_error("Spline type "+std::to_string(int(splineType))+" not supported at this place");
+    }
+
+    /*!
+     * \brief Set the sampling points and the boundary slopes of many
+     *        full splines which exhibit the same number of sampling
+     *        points at once.
+     *
+     * The sampling points are laid out like for the batched variant
+     * of natural splines, the boundary slopes of spline k are m0[k]
+     * and m1[k].
+     */
+    template <class ScalarArrayX, class ScalarArrayY, class ScalarArraySlopes>
+    static void setXYArraysBatch(size_t numSplines,
+                                 Spline* splines,
+                                 size_t nSamples,
+                                 const ScalarArrayX& x,
+                                 const ScalarArrayY& y,
+                                 const ScalarArraySlopes& m0,
+                                 const ScalarArraySlopes& m1,
+                                 bool sortInputs = true)
+    {
+        assert(nSamples > 1);
+
+        for (size_t k = 0; k < numSplines; ++k)
+            splines[k].assignBatchSamples_(k, nSamples, x, y, sortInputs);
+
+        makeSplinesBatched_(numSplines, splines, Full, &m0, &m1);
+    }
+
     /*!
      * \brief Return true iff the given x is in range [x1, xn].
      */
@@ -815,7 +908,35 @@ public:
             }
         }
 
-        return eval_(x, segmentIdx_(Opm::scalarValue(x)));
+        return evalCompiled_(x, segmentIdx_(Opm::scalarValue(x)));
+    }
+
+    /*!
+     * \brief Evaluate the spline for a batch of positions.
+     *
+     * This is equivalent to calling eval() for each of the positions, but the
+     * range check is done for the whole batch before any evaluation takes place.
+     *
+     * \param n The number of positions
+     * \param x Array of the positions on the abscissa
+     * \param y Array into which the values of the spline are written
+     * \param extrapolate If this parameter is set to true, the spline is extended
+     *                    beyond its range by straight lines.
+     */
+    template <class Evaluation>
+    void evalBatch(size_t n, const Evaluation* x, Evaluation* y, bool extrapolate = false) const
+    {
+        if (!extrapolate)
+            checkBatchRange_(n, x, "Tried to evaluate a spline outside of its range");
+
+        if (extrapolate) {
+            for (size_t i = 0; i < n; ++i)
+                y[i] = eval(x[i], /*extrapolate=*/true);
+            return;
+        }
+
+        for (size_t i = 0; i < n; ++i)
+            y[i] = evalCompiled_(x[i], segmentIdx_(Opm::scalarValue(x[i])));
     }
 
     /*!
@@ -844,9 +965,39 @@ public:
                 return evalDerivative_(xAt(numSamples() - 1), /*segmentIdx=*/numSamples() - 2);
         }
 
-        return evalDerivative_(x, segmentIdx_(Opm::scalarValue(x)));
+        return evalDerivativeCompiled_(x, segmentIdx_(Opm::scalarValue(x)));
     }
 
+    /*!
+     * \brief Evaluate the spline's derivative for a batch of positions.
+     *
+     * \copydetails evalBatch()
+     */
+    template <class Evaluation>
+    void evalDerivativeBatch(size_t n, const Evaluation* x, Evaluation* y, bool extrapolate = false) const
+    {
+        if (!extrapolate)
+            checkBatchRange_(n, x, "Tried to evaluate the derivative of a spline outside of its range");
+
+        if (extrapolate) {
+            for (size_t i = 0; i < n; ++i)
+                y[i] = evalDerivative(x[i], /*extrapolate=*/true);
+            return;
+        }
+
+        for (size_t i = 0; i < n; ++i)
+            y[i] = evalDerivativeCompiled_(x[i], segmentIdx_(Opm::scalarValue(x[i])));
+    }
+
+    /*!
+     * \brief Returns true iff the sampling points of the spline are equidistant.
+     *
+     * In this case, the segment which corresponds to a given position can be
+     * determined without a search.
+     */
+    bool hasUniformKnots() const
+    { return uniformKnots_; }
+
     /*!
      * \brief Evaluate the spline's second derivative at a given position.
      *
@@ -867,7 +1018,7 @@ public:
         else if (extrapolate)
             return 0.0;
 
-        return evalDerivative2_(x, segmentIdx_(Opm::scalarValue(x)));
+        return evalDerivative2Compiled_(x, segmentIdx_(Opm::scalarValue(x)));
     }
 
     /*!
@@ -890,7 +1041,7 @@ public:
         else if (extrapolate)
             return 0.0;
 
-        return evalDerivative3_(x, segmentIdx_(Opm::scalarValue(x)));
+        return evalDerivative3Compiled_(x, segmentIdx_(Opm::scalarValue(x)));
     }
 
     /*!
@@ -1089,6 +1240,90 @@ protected:
         slopeVec_.resize(nSamples);
     }
 
+    template <class ScalarArrayX, class ScalarArrayY>
+    void assignBatchSamples_(size_t splineIdx,
+                             size_t nSamples,
+                             const ScalarArrayX& x,
+                             const ScalarArrayY& y,
+                             bool sortInputs)
+    {
+        setNumSamples_(nSamples);
+        size_t offset = splineIdx*nSamples;
+        for (size_t i = 0; i < nSamples; ++i) {
+            xPos_[i] = x[offset + i];
+            yPos_[i] = y[offset + i];
+        }
+
+        if (sortInputs)
+            sortInput_();
+        else if (xPos_[0] > xPos_[numSamples() - 1])
+            reverseSamplingPoints_();
+    }
+
+    /*!
+     * \brief Compute the moments of a batch of splines whose sampling
+     *        points have already been set.
+     *
+     * The boundary slopes are only used for full splines.
+     */
+    template <class ScalarArraySlopes>
+    static void makeSplinesBatched_(size_t numSplines,
+                                    Spline* splines,
+                                    SplineType splineType,
+                                    const ScalarArraySlopes* m0,
+                                    const ScalarArraySlopes* m1)
+    {
+        if (numSplines == 0)
+            return;
+
+        size_t nSamples = splines[0].numSamples();
+        size_t n = (splineType == Periodic) ? nSamples - 1 : nSamples;
+
+        BatchedTridiagonalSolver<Scalar> solver(numSplines, n);
+        Matrix M(n);
+        Vector d(n);
+        for (size_t k = 0; k < numSplines; ++k) {
+            assert(splines[k].numSamples() == nSamples);
+            if (splineType == Periodic)
+                splines[k].makePeriodicSystem_(M, d);
+            else if (splineType == Full)
+                splines[k].makeFullSystem_(M, d, (*m0)[k], (*m1)[k]);
+            else
+                splines[k].makeNaturalSystem_(M, d);
+            solver.setSystem(k, M, d);
+        }
+
+        if (splineType == Periodic)
+            solver.solvePeriodic();
+        else
+            solver.solve();
+
+        Vector moments(n);
+        for (size_t k = 0; k < numSplines; ++k) {
+            solver.solution(k, moments);
+            if (splineType == Periodic)
+                expandPeriodicMoments_(moments, nSamples);
+
+            splines[k].setSlopesFromMoments_(splines[k].slopeVec_, moments);
+            splines[k].compile_();
+            moments.resize(n);
+        }
+    }
+
+    /*!
+     * \brief Convert the moments of the periodic system to the moments
+     *        at all sampling points.
+     */
+    static void expandPeriodicMoments_(Vector& moments, size_t nSamples)
+    {
+        moments.resize(nSamples);
+        for (int i = static_cast<int>(nSamples) - 2; i >= 0; --i) {
+            unsigned ui = static_cast<unsigned>(i);
+            moments[ui+1] = moments[ui];
+        }
+        moments[0] = moments[nSamples - 1];
+    }
+
     /*!
      * \brief Create a natural spline from the already set sampling points.
      *
@@ -1108,6 +1343,7 @@ protected:
 
         // convert the moments to slopes at the sample points
         this->setSlopesFromMoments_(slopeVec_, moments);
+        this->compile_();
     }
 
     /*!
@@ -1129,37 +1365,21 @@ protected:
 
         // convert the moments to slopes at the sample points
         this->setSlopesFromMoments_(slopeVec_, moments);
+        this->compile_();
     }
 
     /*!
      * \brief Create a periodic spline from the already set sampling points.
      *
-     * This creates a temporary matrix and right hand side vector.
+     * The corner entries of the periodic system are handled by
+     * BatchedTridiagonalSolver::solvePeriodic(), so this is a batch of
+     * size one.
      */
     void makePeriodicSpline_()
     {
-        Matrix M(numSamples() - 1);
-        Vector d(numSamples() - 1);
-        Vector moments(numSamples() - 1);
-
-        // create linear system of equations. This is a bit hacky,
-        // because it assumes that std::vector internally stores its
-        // data as a big C-style array, but it saves us from yet
-        // another copy operation
-        this->makePeriodicSystem_(M, d);
-
-        // solve for the moments (-> second derivatives)
-        M.solve(moments, d);
-
-        moments.resize(numSamples());
-        for (int i = static_cast<int>(numSamples()) - 2; i >= 0; --i) {
-            unsigned ui = static_cast<unsigned>(i);
-            moments[ui+1] = moments[ui];
-        }
-        moments[0] = moments[numSamples() - 1];
-
-        // convert the moments to slopes at the sample points
-        this->setSlopesFromMoments_(slopeVec_, moments);
+        makeSplinesBatched_(1, this, Periodic,
+                            static_cast<const Vector*>(nullptr),
+                            static_cast<const Vector*>(nullptr));
     }
 
     /*!
@@ -1392,19 +1612,26 @@ protected:
     void makeMonotonicSpline_(Vector& slopes)
     {
         auto n = numSamples();
+        const Scalar* x = xPos_.data();
+        const Scalar* y = yPos_.data();
 
-        // calculate the slopes of the secant lines
+        // calculate the slopes of the secant lines. this and the next loop do not
+        // exhibit any dependencies between the iterations and operate on raw
+        // arrays, so the compiler is free to vectorize them.
         std::vector<Scalar> delta(n);
+        Scalar* deltaPtr = delta.data();
         for (size_t k = 0; k < n - 1; ++k)
-            delta[k] = (y_(k + 1) - y_(k))/(x_(k + 1) - x_(k));
+            deltaPtr[k] = (y[k + 1] - y[k])/(x[k + 1] - x[k]);
 
         // calculate the "raw" slopes at the sample points
         for (size_t k = 1; k < n - 1; ++k)
-            slopes[k] = (delta[k - 1] + delta[k])/2;
+            slopes[k] = (deltaPtr[k - 1] + deltaPtr[k])/2;
         slopes[0] = delta[0];
         slopes[n - 1] = delta[n - 2];
 
-        // post-process the "raw" slopes at the sample points
+        // post-process the "raw" slopes at the sample points. since the slope at
+        // the right end of a segment may be modified when the segment is
+        // processed, this loop is inherently sequential.
         for (size_t k = 0; k < n - 1; ++k) {
             if (std::abs(delta[k]) < 1e-50) {
                 // make the spline flat if the inputs are equal
@@ -1490,6 +1717,93 @@ protected:
     }
 
 
+    /*!
+     * \brief Convert the spline to its compiled form.
+     *
+     * This computes the coefficients of the cubic polynomial in the local coordinate
+     * \f$t = x - x_i\f$ of each segment,
+     * \f[
+     p_i(t) = d_i + t\,(c_i + t\,(b_i + t\,a_i)) \;,
+     * \f]
+     * and determines whether the sampling points are equidistant.
+     */
+    void compile_()
+    {
+        size_t n = numSamples();
+        assert(n > 1);
+
+        coeffs_.resize(4*(n - 1));
+        for (size_t i = 0; i < n - 1; ++i) {
+            Scalar h = h_(i + 1);
+            Scalar secant = (y_(i + 1) - y_(i))/h;
+            Scalar m0 = slope_(i);
+            Scalar m1 = slope_(i + 1);
+
+            Scalar* c = &coeffs_[4*i];
+            c[0] = y_(i);
+            c[1] = m0;
+            c[2] = (3*secant - 2*m0 - m1)/h;
+            c[3] = (m0 + m1 - 2*secant)/(h*h);
+        }
+
+        // check whether the sampling points are equidistant
+        Scalar range = x_(n - 1) - x_(0);
+        Scalar knotDistance = range/(n - 1);
+        Scalar tol = 100*std::numeric_limits<Scalar>::epsilon()*range;
+        uniformKnots_ = true;
+        for (size_t i = 1; i < n - 1 && uniformKnots_; ++i)
+            uniformKnots_ = std::abs(x_(i) - (x_(0) + i*knotDistance)) <= tol;
+        invKnotDistance_ = 1/knotDistance;
+    }
+
+    // evaluate the compiled form of a spline segment
+    template <class Evaluation>
+    Evaluation evalCompiled_(const Evaluation& x, size_t i) const
+    {
+        const Scalar* c = &coeffs_[4*i];
+        const Evaluation& t = x - x_(i);
+        return c[0] + t*(c[1] + t*(c[2] + t*c[3]));
+    }
+
+    // evaluate the derivative of the compiled form of a spline segment
+    template <class Evaluation>
+    Evaluation evalDerivativeCompiled_(const Evaluation& x, size_t i) const
+    {
+        const Scalar* c = &coeffs_[4*i];
+        const Evaluation& t = x - x_(i);
+        return c[1] + t*(2*c[2] + t*(3*c[3]));
+    }
+
+    // evaluate the second derivative of the compiled form of a spline segment
+    template <class Evaluation>
+    Evaluation evalDerivative2Compiled_(const Evaluation& x, size_t i) const
+    {
+        const Scalar* c = &coeffs_[4*i];
+        const Evaluation& t = x - x_(i);
+        return 2*c[2] + t*(6*c[3]);
+    }
+
+    // evaluate the third derivative of the compiled form of a spline segment
+    template <class Evaluation>
+    Evaluation evalDerivative3Compiled_(const Evaluation& /*x*/, size_t i) const
+    { return 6*coeffs_[4*i + 3]; }
+
+    // make sure that all positions of a batch are within the range of the spline
+    template <class Evaluation>
+    void checkBatchRange_(size_t n, const Evaluation* x, const char* msg) const
+    {
+        Scalar xMin = x_(0);
+        Scalar xMax = x_(numSamples() - 1);
+        bool inRange = true;
+        for (size_t i = 0; i < n; ++i) {
+            Scalar xi = Opm::scalarValue(x[i]);
+            inRange = inRange && xMin <= xi && xi <= xMax;
+        }
+
+        if (!inRange)
+            throw Opm::NumericalIssue(msg);
+    }
+
     // evaluate the spline at a given the position and given the
     // segment index
     template <class Evaluation>
@@ -1735,6 +2049,19 @@ protected:
     // find the segment index for a given x coordinate
     size_t segmentIdx_(Scalar x) const
     {
+        if (uniformKnots_) {
+            Scalar maxIdx = static_cast<Scalar>(numSamples() - 2);
+            Scalar s = std::max(Scalar(0.0), std::min(maxIdx, (x - x_(0))*invKnotDistance_));
+            size_t i = static_cast<size_t>(s);
+
+            // correct for roundoff errors
+            if (i > 0 && x < x_(i))
+                -- i;
+            else if (i + 2 < numSamples() && x >= x_(i + 1))
+                ++ i;
+            return i;
+        }
+
         // bisection
         size_t iLow = 0;
         size_t iHigh = numSamples() - 1;
@@ -1801,6 +2128,11 @@ protected:
     Vector xPos_;
     Vector yPos_;
     Vector slopeVec_;
+
+    // the coefficients of the compiled form of the spline, four per segment
+    Vector coeffs_;
+    bool uniformKnots_ = false;
+    Scalar invKnotDistance_ = 0.0;
 };
 }
 
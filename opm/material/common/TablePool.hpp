@@ -0,0 +1,306 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+
+  Consult the COPYING file in the top-level source directory of this
+  module for the precise wording of the license and the list of
+  copyright holders.
+*/
+/*!
+ * \file
+ * \copydoc Opm::TablePool
+ */
+#ifndef OPM_TABLE_POOL_HPP
+#define OPM_TABLE_POOL_HPP
+
+#include <opm/material/common/FlatTables.hpp>
+
+#include <vector>
+#include <stdexcept>
+#include <string>
+#include <cstring>
+#include <cstddef>
+#include <cstdint>
+#include <cassert>
+
+namespace Opm {
+
+/*!
+ * \brief Stores the tables of all regions and properties of an object in a single
+ *        contiguous memory arena.
+ *
+ * Usually, each region of a PVT or saturation function object holds its own tables
+ * whose sampling points are allocated separately on the heap. If neighbouring cells
+ * belong to different regions, the tables which are accessed in turn are thus
+ * scattered over memory. This class copies them into a single buffer which is aligned
+ * to cache lines and in which every array starts at a cache line boundary. The tables
+ * are addressed by their region and property indices and are laid out in the order in
+ * which they were added.
+ *
+ * The tables are added first. After calling finalize(), they can be evaluated using
+ * the views returned by oneD() and twoD(), but no more tables can be added.
+ * Alternatively, a pool can use an image which lives outside of it, e.g., in a
+ * SharedMemorySegment which is filled by another process (see useExternalImage()).
+ */
+template <class Scalar>
+class TablePool
+{
+public:
+    typedef Tabulated1DFunctionView<Scalar> OneDView;
+    typedef UniformXTabulated2DFunctionView<Scalar> TwoDView;
+
+    //! The alignment of the arena and of the arrays within it in bytes
+    static const size_t alignment = 64;
+
+    TablePool()
+        : numRegions_(0)
+        , numProperties_(0)
+        , writer_(alignment)
+        , externalData_(nullptr)
+        , arenaOffset_(0)
+        , arenaSize_(0)
+    {}
+
+    TablePool(unsigned numRegions, unsigned numProperties)
+        : numRegions_(numRegions)
+        , numProperties_(numProperties)
+        , tableIdx_(numRegions*numProperties, static_cast<size_t>(noTable_))
+        , writer_(alignment)
+        , externalData_(nullptr)
+        , arenaOffset_(0)
+        , arenaSize_(0)
+    {}
+
+    TablePool(const TablePool& other)
+    { *this = other; }
+
+    TablePool& operator=(const TablePool& other)
+    {
+        if (this == &other)
+            return *this;
+
+        numRegions_ = other.numRegions_;
+        numProperties_ = other.numProperties_;
+        tableIdx_ = other.tableIdx_;
+        writer_ = other.writer_;
+
+        if (other.isExternal()) {
+            // external images are shared by all copies
+            buffer_.clear();
+            externalData_ = other.externalData_;
+            arenaOffset_ = 0;
+            arenaSize_ = other.arenaSize_;
+        }
+        else {
+            // the views of the other object point into its own arena
+            externalData_ = nullptr;
+            allocate_(other.arenaSize_);
+            if (arenaSize_ > 0)
+                std::memcpy(arena_(), other.data(), arenaSize_);
+        }
+        attach_();
+        return *this;
+    }
+
+    /*!
+     * \brief Add a one-dimensional table for a region and a property.
+     */
+    void add(unsigned regionIdx, unsigned propertyIdx, const Tabulated1DFunction<Scalar>& fn)
+    { slot_(regionIdx, propertyIdx) = writer_.add(fn); }
+
+    /*!
+     * \brief Add a two-dimensional table for a region and a property.
+     */
+    void add(unsigned regionIdx, unsigned propertyIdx, const UniformXTabulated2DFunction<Scalar>& fn)
+    { slot_(regionIdx, propertyIdx) = writer_.add(fn); }
+
+    /*!
+     * \brief Copy all added tables into the arena.
+     */
+    void finalize()
+    {
+        if (isFinalized())
+            throw std::logic_error("The table pool has already been finalized");
+
+        allocate_(writer_.size());
+        writer_.writeTo(arena_());
+        writer_ = FlatTableWriter<Scalar>(alignment);
+
+        attach_();
+    }
+
+    /*!
+     * \brief Use the tables of an image which is stored outside of the pool instead of
+     *        adding them.
+     *
+     * The image must be the arena of a pool with the same number of regions and
+     * properties to which a table was added for every slot in the order of the slots,
+     * i.e., region by region. The image is not copied, so it must stay valid as long
+     * as the pool or any of its copies is used. Since it is only read, it may reside
+     * in read-only memory. Afterwards, the pool is finalized.
+     */
+    void useExternalImage(const void* image, size_t size)
+    {
+        if (isFinalized())
+            throw std::logic_error("The table pool has already been finalized");
+
+        FlatTableImage<Scalar> flatImage(image, size);
+        if (flatImage.numTables() != tableIdx_.size())
+            throw std::runtime_error("The table image does not match the layout of the table pool");
+
+        for (size_t slotIdx = 0; slotIdx < tableIdx_.size(); ++slotIdx)
+            tableIdx_[slotIdx] = slotIdx;
+
+        writer_ = FlatTableWriter<Scalar>(alignment);
+        buffer_.clear();
+        externalData_ = static_cast<const char*>(image);
+        arenaOffset_ = 0;
+        arenaSize_ = size;
+
+        attach_();
+    }
+
+    /*!
+     * \brief Returns true if finalize() or useExternalImage() has been called.
+     */
+    bool isFinalized() const
+    { return arenaSize_ > 0; }
+
+    /*!
+     * \brief Returns true if the pool uses an image which is stored outside of it.
+     */
+    bool isExternal() const
+    { return externalData_ != nullptr; }
+
+    unsigned numRegions() const
+    { return numRegions_; }
+
+    unsigned numProperties() const
+    { return numProperties_; }
+
+    /*!
+     * \brief Returns true if a table was added for a region and a property.
+     */
+    bool contains(unsigned regionIdx, unsigned propertyIdx) const
+    {
+        return regionIdx < numRegions_ && propertyIdx < numProperties_
+            && tableIdx_[regionIdx*numProperties_ + propertyIdx] != noTable_;
+    }
+
+    /*!
+     * \brief Returns the one-dimensional table of a region and a property.
+     *
+     * The pool must be finalized and a one-dimensional table must have been added for
+     * the region and property.
+     */
+    const OneDView& oneD(unsigned regionIdx, unsigned propertyIdx) const
+    {
+        assert(isFinalized() && contains(regionIdx, propertyIdx));
+        return oneDViews_[regionIdx*numProperties_ + propertyIdx];
+    }
+
+    /*!
+     * \brief Returns the two-dimensional table of a region and a property.
+     *
+     * The pool must be finalized and a two-dimensional table must have been added for
+     * the region and property.
+     */
+    const TwoDView& twoD(unsigned regionIdx, unsigned propertyIdx) const
+    {
+        assert(isFinalized() && contains(regionIdx, propertyIdx));
+        return twoDViews_[regionIdx*numProperties_ + propertyIdx];
+    }
+
+    /*!
+     * \brief Returns the beginning of the arena.
+     *
+     * This contains a FlatTableImage with the tables in the order of their addition.
+     */
+    const void* data() const
+    { return externalData_ ? externalData_ : buffer_.data() + arenaOffset_; }
+
+    /*!
+     * \brief Returns the size of the arena in bytes.
+     */
+    size_t size() const
+    { return arenaSize_; }
+
+private:
+    static const size_t noTable_ = static_cast<size_t>(-1);
+
+    char* arena_()
+    { return buffer_.data() + arenaOffset_; }
+
+    // the standard allocators only guarantee the alignment of the fundamental types,
+    // so the arena starts at the first suitably aligned byte of a larger buffer
+    void allocate_(size_t size)
+    {
+        buffer_.assign(size + alignment - 1, 0);
+        size_t misalignment = reinterpret_cast<uintptr_t>(buffer_.data()) % alignment;
+        arenaOffset_ = (misalignment == 0) ? 0 : alignment - misalignment;
+        arenaSize_ = size;
+    }
+
+    size_t& slot_(unsigned regionIdx, unsigned propertyIdx)
+    {
+        if (isFinalized())
+            throw std::logic_error("Tables cannot be added to a finalized table pool");
+        if (regionIdx >= numRegions_ || propertyIdx >= numProperties_)
+            throw std::out_of_range("Invalid table pool slot ("+std::to_string(regionIdx)
+                                    +", "+std::to_string(propertyIdx)+")");
+
+        return tableIdx_[regionIdx*numProperties_ + propertyIdx];
+    }
+
+    void attach_()
+    {
+        oneDViews_.clear();
+        twoDViews_.clear();
+        if (!isFinalized())
+            return;
+
+        FlatTableImage<Scalar> image(data(), size());
+        oneDViews_.resize(tableIdx_.size());
+        twoDViews_.resize(tableIdx_.size());
+        for (size_t slotIdx = 0; slotIdx < tableIdx_.size(); ++slotIdx) {
+            size_t tableIdx = tableIdx_[slotIdx];
+            if (tableIdx == noTable_)
+                continue;
+
+            if (image.isOneD(tableIdx))
+                oneDViews_[slotIdx] = image.oneD(tableIdx);
+            else
+                twoDViews_[slotIdx] = image.twoD(tableIdx);
+        }
+    }
+
+    unsigned numRegions_;
+    unsigned numProperties_;
+    std::vector<size_t> tableIdx_;
+    FlatTableWriter<Scalar> writer_;
+    std::vector<char> buffer_;
+    const char* externalData_;
+    size_t arenaOffset_;
+    size_t arenaSize_;
+
+    std::vector<OneDView> oneDViews_;
+    std::vector<TwoDView> twoDViews_;
+};
+
+} // namespace Opm
+
+#endif
@@ -29,6 +29,7 @@
 
 #include <opm/material/densead/Math.hpp>
 #include <opm/material/common/Exceptions.hpp>
+#include <opm/material/common/EvaluationStatus.hpp>
 #include <opm/material/common/Unused.hpp>
 
 #include <algorithm>
@@ -238,6 +239,44 @@ public:
     Scalar valueAt(size_t i) const
     { return yValues_[i]; }
 
+    /*!
+     * \brief Precompute the slope and the intercept of each segment.
+     *
+     * Afterwards, eval() and evalDerivative() do not need to divide anymore: the
+     * function value is a single multiply-add of the slope and the intercept of the
+     * segment. Since the intercept is taken at \f$x = 0\f$, the results may differ from
+     * the ones of the uncompiled function in the last few bits. Setting new sampling
+     * points discards the precomputed coefficients.
+     */
+    void compile()
+    {
+        segmentCoeffs_.clear();
+        if (numSamples() < 2)
+            return;
+
+        size_t numSegments = numSamples() - 1;
+        segmentCoeffs_.resize(2*numSegments);
+        for (size_t segIdx = 0; segIdx < numSegments; ++segIdx) {
+            Scalar x0 = xValues_[segIdx];
+            Scalar x1 = xValues_[segIdx + 1];
+
+            Scalar y0 = yValues_[segIdx];
+            Scalar y1 = yValues_[segIdx + 1];
+
+            // zero-width segments are never selected by the segment lookup
+            Scalar m = (x1 != x0) ? (y1 - y0)/(x1 - x0) : 0.0;
+            segmentCoeffs_[2*segIdx] = m;
+            segmentCoeffs_[2*segIdx + 1] = y0 - m*x0;
+        }
+    }
+
+    /*!
+     * \brief Returns true if the slopes and intercepts of the segments have been
+     *        precomputed by compile().
+     */
+    bool isCompiled() const
+    { return !segmentCoeffs_.empty(); }
+
     /*!
      * \brief Return true iff the given x is in range [x1, xn].
      */
@@ -258,16 +297,58 @@ public:
     Evaluation eval(const Evaluation& x, bool extrapolate = false) const
     {
         size_t segIdx = findSegmentIndex_(x, extrapolate);
+        return evalInSegment_(x, segIdx);
+    }
 
-        Scalar x0 = xValues_[segIdx];
-        Scalar x1 = xValues_[segIdx + 1];
+    /*!
+     * \brief Evaluate the function at a given position without throwing.
+     *
+     * Arguments outside of the tabulated range are recorded in the status object and
+     * then either extrapolated or clamped according to its policy.
+     *
+     * \param x The value on the abscissa where the function ought to be evaluated
+     * \param status The object which collects the range violations
+     * \param tableId The identifier of the table which is recorded for violations
+     */
+    template <class Evaluation>
+    Evaluation eval(const Evaluation& x,
+                    EvaluationStatus<Scalar>& status,
+                    unsigned tableId = 0) const
+    {
+        if (!applies(x)) {
+            status.record(tableId, Opm::scalarValue(x));
 
-        Scalar y0 = yValues_[segIdx];
-        Scalar y1 = yValues_[segIdx + 1];
+            if (status.clamp()) {
+                Evaluation ret = blank(x);
+                ret = (x < xMin()) ? yValues_.front() : yValues_.back();
+                return ret;
+            }
+        }
 
-        return y0 + (y1 - y0)*(x - x0)/(x1 - x0);
+        return evalInSegment_(x, segmentIndex_(x));
     }
 
+    /*!
+     * \brief Returns the index of the segment which contains a given position.
+     *
+     * Together with evalInSegment(), this allows to evaluate several functions which
+     * have the same sampling points using a single lookup. The extrapolate argument
+     * has the same meaning as for eval().
+     */
+    template <class Evaluation>
+    size_t findSegmentIndex(const Evaluation& x, bool extrapolate = false) const
+    { return findSegmentIndex_(x, extrapolate); }
+
+    /*!
+     * \brief Evaluate the function in a segment which was determined before.
+     *
+     * If segIdx was returned by findSegmentIndex() of this function or of one with the
+     * same sampling points, the result is the same as the one of eval().
+     */
+    template <class Evaluation>
+    Evaluation evalInSegment(const Evaluation& x, size_t segIdx) const
+    { return evalInSegment_(x, segIdx); }
+
     /*!
      * \brief Evaluate the spline's derivative at a given position.
      *
@@ -449,6 +530,22 @@ public:
                yValues_ == data.yValues_;
     }
 
+    template <class Serializer>
+    void serializeOp(Serializer& serializer)
+    {
+        serializer(xValues_);
+        serializer(yValues_);
+
+        // the coefficients of the compiled form are not stored but recomputed
+        bool compiled = isCompiled();
+        serializer(compiled);
+        if (serializer.isLoading()) {
+            segmentCoeffs_.clear();
+            if (compiled)
+                compile();
+        }
+    }
+
 private:
     template <class Evaluation>
     size_t findSegmentIndex_(const Evaluation& x, bool extrapolate = false) const
@@ -456,6 +553,13 @@ private:
         if (!extrapolate && !applies(x))
             throw Opm::NumericalIssue("Tried to evaluate a tabulated function outside of its range");
 
+        return segmentIndex_(x);
+    }
+
+    // the segment index for arguments which are allowed to be out of range
+    template <class Evaluation>
+    size_t segmentIndex_(const Evaluation& x) const
+    {
         // we need at least two sampling points!
         assert(xValues_.size() >= 2);
 
@@ -481,9 +585,30 @@ private:
         }
     }
 
+    template <class Evaluation>
+    Evaluation evalInSegment_(const Evaluation& x, size_t segIdx) const
+    {
+        if (isCompiled())
+            return segmentCoeffs_[2*segIdx + 1] + segmentCoeffs_[2*segIdx]*x;
+
+        Scalar x0 = xValues_[segIdx];
+        Scalar x1 = xValues_[segIdx + 1];
+
+        Scalar y0 = yValues_[segIdx];
+        Scalar y1 = yValues_[segIdx + 1];
+
+        return y0 + (y1 - y0)*(x - x0)/(x1 - x0);
+    }
+
     template <class Evaluation>
     Evaluation evalDerivative_(const Evaluation& x, size_t segIdx) const
     {
+        if (isCompiled()) {
+            Evaluation ret = blank(x);
+            ret = segmentCoeffs_[2*segIdx];
+            return ret;
+        }
+
         Scalar x0 = xValues_[segIdx];
         Scalar x1 = xValues_[segIdx + 1];
 
@@ -588,10 +713,15 @@ private:
     {
         xValues_.resize(nSamples);
         yValues_.resize(nSamples);
+        segmentCoeffs_.clear();
     }
 
     std::vector<Scalar> xValues_;
     std::vector<Scalar> yValues_;
+
+    // slope and intercept of each segment if the function has been compiled. They
+    // are interleaved so that a lookup only touches a single cache line.
+    std::vector<Scalar> segmentCoeffs_;
 };
 } // namespace Opm
 
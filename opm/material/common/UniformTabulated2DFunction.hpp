@@ -50,6 +50,12 @@ class UniformTabulated2DFunction
 {
 public:
     UniformTabulated2DFunction()
+        : m_(0)
+        , n_(0)
+        , xMin_(0.0)
+        , xMax_(0.0)
+        , yMin_(0.0)
+        , yMax_(0.0)
     { }
 
      /*!
@@ -132,7 +138,7 @@ public:
      */
     Scalar iToX(unsigned i) const
     {
-        assert(0 <= i && i < numX());
+        assert(i < numX());
 
         return xMin() + i*(xMax() - xMin())/(numX() - 1);
     }
@@ -142,7 +148,7 @@ public:
       */
     Scalar jToY(unsigned j) const
     {
-        assert(0 <= j && j < numY());
+        assert(j < numY());
 
         return yMin() + j*(yMax() - yMin())/(numY() - 1);
     }
@@ -230,8 +236,8 @@ public:
      */
     Scalar getSamplePoint(unsigned i, unsigned j) const
     {
-        assert(0 <= i && i < m_);
-        assert(0 <= j && j < n_);
+        assert(i < m_);
+        assert(j < n_);
 
         return samples_[j*m_ + i];
     }
@@ -243,8 +249,8 @@ public:
      */
     void setSamplePoint(unsigned i, unsigned j, Scalar value)
     {
-        assert(0 <= i && i < m_);
-        assert(0 <= j && j < n_);
+        assert(i < m_);
+        assert(j < n_);
 
         samples_[j*m_ + i] = value;
     }
@@ -260,6 +266,18 @@ public:
                yMax_ == data.yMax_;
     }
 
+    template <class Serializer>
+    void serializeOp(Serializer& serializer)
+    {
+        serializer(samples_);
+        serializer(m_);
+        serializer(n_);
+        serializer(xMin_);
+        serializer(xMax_);
+        serializer(yMin_);
+        serializer(yMax_);
+    }
+
 
 private:
     // the vector which contains the values of the sample points
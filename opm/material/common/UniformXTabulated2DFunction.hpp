@@ -30,6 +30,7 @@
 
 #include <opm/material/common/Valgrind.hpp>
 #include <opm/material/common/Exceptions.hpp>
+#include <opm/material/common/EvaluationStatus.hpp>
 #include <opm/material/common/Unused.hpp>
 #include <opm/material/common/MathToolbox.hpp>
 
@@ -323,58 +324,35 @@ public:
         };
 #endif
 
-        // bi-linear interpolation: first, calculate the x and y indices in the lookup
-        // table ...
-        unsigned i = xSegmentIndex(x, extrapolate);
-        const Evaluation& alpha = xToAlpha(x, i);
-        // The 'shift' is used to shift the points used to interpolate within
-        // the (i) and (i+1) sets of sample points, so that when approaching
-        // the boundary of the domain given by the samples, one gets the same
-        // value as one would get by interpolating along the boundary curve
-        // itself.
-        Evaluation shift = 0.0;
-        if (interpolationGuide_ == InterpolationPolicy::Vertical) {
-            // Shift is zero, no need to reset it.
-        } else {
-            // find upper and lower y value
-            if (interpolationGuide_ == InterpolationPolicy::LeftExtreme) {
-                // The domain is above the boundary curve, up to y = infinity.
-                // The shift is therefore the same for all values of y.
-                shift = yPos_[i+1] - yPos_[i];
-            } else {
-                assert(interpolationGuide_ == InterpolationPolicy::RightExtreme);
-                // The domain is below the boundary curve, down to y = 0.
-                // The shift is therefore no longer the the same for all
-                // values of y, since at y = 0 the shift must be zero.
-                // The shift is computed by linear interpolation between
-                // the maximal value at the domain boundary curve, and zero.
-                shift = yPos_[i+1] - yPos_[i];
-                auto yEnd = yPos_[i]*(1.0 - alpha) + yPos_[i+1]*alpha;
-                if (yEnd > 0.) {
-                    shift = shift * y / yEnd;
-                } else {
-                    shift = 0.;
-                }
-            }
-        }
-        auto yLower =  y - alpha*shift;
-        auto yUpper =  y + (1-alpha)*shift;
-
-        unsigned j1 = ySegmentIndex(yLower, i, extrapolate);
-        unsigned j2 = ySegmentIndex(yUpper, i + 1, extrapolate);
-        const Evaluation& beta1 = yToBeta(yLower, i, j1);
-        const Evaluation& beta2 = yToBeta(yUpper, i + 1, j2);
-
-        // evaluate the two function values for the same y value ...
-        const Evaluation& s1 = valueAt(i, j1)*(1.0 - beta1) + valueAt(i, j1 + 1)*beta1;
-        const Evaluation& s2 = valueAt(i + 1, j2)*(1.0 - beta2) + valueAt(i + 1, j2 + 1)*beta2;
-
-        Valgrind::CheckDefined(s1);
-        Valgrind::CheckDefined(s2);
+        return evalImpl_(x, y, extrapolate, /*clampY=*/false, /*yViolated=*/nullptr);
+    }
 
-        // ... and combine them using the x position
-        const Evaluation& result = s1*(1.0 - alpha) + s2*alpha;
-        Valgrind::CheckDefined(result);
+    /*!
+     * \brief Evaluate the function at a given (x,y) position without throwing.
+     *
+     * If the position is outside of the tabulated range, the violation is recorded in
+     * the status object. Depending on its policy, the function is then extrapolated or
+     * the position is clamped to the range of the sampling points. For the y
+     * direction, the range of the two columns which are used for the interpolation is
+     * considered.
+     */
+    template <class Evaluation>
+    Evaluation eval(const Evaluation& x,
+                    const Evaluation& y,
+                    EvaluationStatus<Scalar>& status,
+                    unsigned tableId = 0) const
+    {
+        const bool xViolated = x < xMin() || xMax() < x;
+        bool yViolated;
+        Evaluation result;
+        if (xViolated && status.clamp())
+            result = evalImpl_<Evaluation>(Opm::min(Opm::max(x, xMin()), xMax()), y,
+                               /*extrapolate=*/true, /*clampY=*/true, &yViolated);
+        else
+            result = evalImpl_(x, y, /*extrapolate=*/true, status.clamp(), &yViolated);
+
+        if (xViolated || yViolated)
+            status.record(tableId, Opm::scalarValue(x), Opm::scalarValue(y));
 
         return result;
     }
@@ -388,14 +366,14 @@ public:
     {
         if (xPos_.empty() || xPos_.back() < nextX) {
             xPos_.push_back(nextX);
-            yPos_.push_back(-1e100);
+            yPos_.push_back(std::numeric_limits<Scalar>::lowest());
             samples_.push_back({});
             return xPos_.size() - 1;
         }
         else if (xPos_.front() > nextX) {
             // this is slow, but so what?
             xPos_.insert(xPos_.begin(), nextX);
-            yPos_.insert(yPos_.begin(), -1e100);
+            yPos_.insert(yPos_.begin(), std::numeric_limits<Scalar>::lowest());
             samples_.insert(samples_.begin(), std::vector<SamplePoint>());
             return 0;
         }
@@ -472,7 +450,92 @@ public:
                this->interpolationGuide() == data.interpolationGuide();
     }
 
+    template <class Serializer>
+    void serializeOp(Serializer& serializer)
+    {
+        serializer(samples_);
+        serializer(xPos_);
+        serializer(yPos_);
+        serializer(interpolationGuide_);
+    }
+
 private:
+    // bi-linear interpolation. If yViolated is not null, it is set to true if y is
+    // outside of the range of one of the two columns used. clampY moves it into this
+    // range.
+    template <class Evaluation>
+    Evaluation evalImpl_(const Evaluation& x,
+                         const Evaluation& y,
+                         bool extrapolate,
+                         bool clampY,
+                         bool* yViolated) const
+    {
+        // bi-linear interpolation: first, calculate the x and y indices in the lookup
+        // table ...
+        unsigned i = xSegmentIndex(x, extrapolate);
+        const Evaluation& alpha = xToAlpha(x, i);
+        // The 'shift' is used to shift the points used to interpolate within
+        // the (i) and (i+1) sets of sample points, so that when approaching
+        // the boundary of the domain given by the samples, one gets the same
+        // value as one would get by interpolating along the boundary curve
+        // itself.
+        Evaluation shift = 0.0;
+        if (interpolationGuide_ == InterpolationPolicy::Vertical) {
+            // Shift is zero, no need to reset it.
+        } else {
+            // find upper and lower y value
+            if (interpolationGuide_ == InterpolationPolicy::LeftExtreme) {
+                // The domain is above the boundary curve, up to y = infinity.
+                // The shift is therefore the same for all values of y.
+                shift = yPos_[i+1] - yPos_[i];
+            } else {
+                assert(interpolationGuide_ == InterpolationPolicy::RightExtreme);
+                // The domain is below the boundary curve, down to y = 0.
+                // The shift is therefore no longer the the same for all
+                // values of y, since at y = 0 the shift must be zero.
+                // The shift is computed by linear interpolation between
+                // the maximal value at the domain boundary curve, and zero.
+                shift = yPos_[i+1] - yPos_[i];
+                auto yEnd = yPos_[i]*(1.0 - alpha) + yPos_[i+1]*alpha;
+                if (yEnd > 0.) {
+                    shift = shift * y / yEnd;
+                } else {
+                    shift = 0.;
+                }
+            }
+        }
+        Evaluation yLower =  y - alpha*shift;
+        Evaluation yUpper =  y + (1-alpha)*shift;
+
+        if (yViolated) {
+            *yViolated =
+                yLower < yMin(i) || yMax(i) < yLower
+                || yUpper < yMin(i + 1) || yMax(i + 1) < yUpper;
+            if (*yViolated && clampY) {
+                yLower = Opm::min(Opm::max(yLower, yMin(i)), yMax(i));
+                yUpper = Opm::min(Opm::max(yUpper, yMin(i + 1)), yMax(i + 1));
+            }
+        }
+
+        unsigned j1 = ySegmentIndex(yLower, i, extrapolate);
+        unsigned j2 = ySegmentIndex(yUpper, i + 1, extrapolate);
+        const Evaluation& beta1 = yToBeta(yLower, i, j1);
+        const Evaluation& beta2 = yToBeta(yUpper, i + 1, j2);
+
+        // evaluate the two function values for the same y value ...
+        const Evaluation& s1 = valueAt(i, j1)*(1.0 - beta1) + valueAt(i, j1 + 1)*beta1;
+        const Evaluation& s2 = valueAt(i + 1, j2)*(1.0 - beta2) + valueAt(i + 1, j2 + 1)*beta2;
+
+        Valgrind::CheckDefined(s1);
+        Valgrind::CheckDefined(s2);
+
+        // ... and combine them using the x position
+        const Evaluation& result = s1*(1.0 - alpha) + s2*alpha;
+        Valgrind::CheckDefined(result);
+
+        return result;
+    }
+
     // the vector which contains the values of the sample points
     // f(x_i, y_j). don't use this directly, use getSamplePoint(i,j)
     // instead!
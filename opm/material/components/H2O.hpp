@@ -538,6 +538,101 @@ public:
         return heatCap_v_Region2_(temperature, pressure);
     }
 
+    /*!
+     * \brief The density \f$\mathrm{[kg/m^3]}\f$, the specific enthalpy and
+     *        internal energy \f$\mathrm{[J/kg]}\f$ and the specific isobaric
+     *        heat capacity \f$\mathrm{[J/(kg K)]}\f$ of liquid water.
+     *
+     * The results correspond to the ones of liquidDensity(), liquidEnthalpy(),
+     * liquidInternalEnergy() and liquidHeatCapacity(), but the IAPWS region 1
+     * equations are only evaluated once for all of them. Below the vapor
+     * pressure, the quantities are extrapolated linearly using their analytic
+     * pressure derivatives at the vapor pressure.
+     *
+     * \param temperature Absolute temperature of the fluid in \f$\mathrm{[K]}\f$
+     * \param pressure Phase pressure in \f$\mathrm{[Pa]}\f$
+     */
+    template <class Evaluation>
+    static void liquidProperties(const Evaluation& temperature,
+                                 const Evaluation& pressure,
+                                 Evaluation& density,
+                                 Evaluation& enthalpy,
+                                 Evaluation& internalEnergy,
+                                 Evaluation& heatCapacity)
+    {
+        if (!Region1::isValid(temperature, pressure))
+        {
+            std::ostringstream oss;
+            oss << "Properties of water are only implemented for temperatures below 623.15K and "
+                << "pressures below 100MPa. (T = " << temperature << ", p=" << pressure;
+            throw NumericalIssue(oss.str());
+        }
+
+        // regularization
+        const Evaluation& pv = vaporPressure(temperature);
+        if (pressure < pv) {
+            extrapolatedProperties_<Region1>(temperature, pv, pressure,
+                                             density, enthalpy, internalEnergy, heatCapacity);
+            return;
+        }
+
+        properties_<Region1>(temperature, pressure,
+                             density, enthalpy, internalEnergy, heatCapacity);
+    }
+
+    /*!
+     * \brief The density \f$\mathrm{[kg/m^3]}\f$, the specific enthalpy and
+     *        internal energy \f$\mathrm{[J/kg]}\f$ and the specific isobaric
+     *        heat capacity \f$\mathrm{[J/(kg K)]}\f$ of steam.
+     *
+     * The results correspond to the ones of gasDensity(), gasEnthalpy(),
+     * gasInternalEnergy() and gasHeatCapacity(), but the IAPWS region 2
+     * equations are only evaluated once for all of them. Above the vapor
+     * pressure, the quantities are extrapolated linearly using their analytic
+     * pressure derivatives at the vapor pressure.
+     *
+     * \param temperature Absolute temperature of the fluid in \f$\mathrm{[K]}\f$
+     * \param pressure Phase pressure in \f$\mathrm{[Pa]}\f$
+     */
+    template <class Evaluation>
+    static void gasProperties(const Evaluation& temperature,
+                              const Evaluation& pressure,
+                              Evaluation& density,
+                              Evaluation& enthalpy,
+                              Evaluation& internalEnergy,
+                              Evaluation& heatCapacity)
+    {
+        if (!Region2::isValid(temperature, pressure))
+        {
+            std::ostringstream oss;
+            oss << "Properties of steam are only implemented for temperatures below 623.15K and "
+                << "pressures below 100MPa. (T = " << temperature << ", p=" << pressure;
+            throw NumericalIssue(oss.str());
+        }
+
+        // regularization
+        if (pressure < triplePressure() - 100) {
+            // below the triple pressure, steam is treated as an ideal gas, see
+            // gasDensity() and gasInternalEnergy()
+            const Evaluation& p0 = Evaluation(triplePressure() - 100);
+            properties_<Region2>(temperature, p0,
+                                 density, enthalpy, internalEnergy, heatCapacity);
+            density *= pressure/p0;
+            internalEnergy = enthalpy - Rs*temperature;
+            return;
+        }
+
+        const Evaluation& pv = vaporPressure(temperature);
+        if (pressure > pv) {
+            extrapolatedProperties_<Region2>(temperature, pv, pressure,
+                                             density, enthalpy, internalEnergy, heatCapacity);
+            return;
+        }
+
+        properties_<Region2>(temperature, pressure,
+                             density, enthalpy, internalEnergy, heatCapacity);
+    }
+
     /*!
      * \brief Returns true iff the gas phase is assumed to be compressible
      */
@@ -875,109 +970,140 @@ private:
     // the unregularized specific enthalpy for liquid water
     template <class Evaluation>
     static Evaluation enthalpyRegion1_(const Evaluation& temperature, const Evaluation& pressure)
-    {
-        return
-            Region1::tau(temperature) *
-            Region1::dgamma_dtau(temperature, pressure) *
-            Rs*temperature;
-    }
+    { return enthalpy_(temperature, Region1::gibbsFreeEnergy(temperature, pressure)); }
 
     // the unregularized specific isobaric heat capacity
     template <class Evaluation>
     static Evaluation heatCap_p_Region1_(const Evaluation& temperature, const Evaluation& pressure)
-    {
-        return
-            - Opm::pow(Region1::tau(temperature), 2.0) *
-            Region1::ddgamma_ddtau(temperature, pressure) *
-            Rs;
-    }
+    { return heatCap_p_(Region1::gibbsFreeEnergy(temperature, pressure)); }
 
     // the unregularized specific isochoric heat capacity
     template <class Evaluation>
     static Evaluation heatCap_v_Region1_(const Evaluation& temperature, const Evaluation& pressure)
     {
-        double tau = Region1::tau(temperature);
-        double num = Region1::dgamma_dpi(temperature, pressure) - tau * Region1::ddgamma_dtaudpi(temperature, pressure);
-        double diff = std::pow(num, 2) / Region1::ddgamma_ddpi(temperature, pressure);
+        const auto& g = Region1::gibbsFreeEnergy(temperature, pressure);
+        const Evaluation& num = g.dgamma_dpi - g.tau*g.ddgamma_dtaudpi;
+        const Evaluation& diff = num*num/g.ddgamma_ddpi;
 
         return
-            - std::pow(tau, 2 ) *
-            Region1::ddgamma_ddtau(temperature, pressure) * Rs +
-            diff;
+            - g.tau*g.tau*g.ddgamma_ddtau*Rs
+            + diff;
     }
 
     // the unregularized specific internal energy for liquid water
     template <class Evaluation>
     static Evaluation internalEnergyRegion1_(const Evaluation& temperature, const Evaluation& pressure)
-    {
-        return
-            Rs * temperature *
-            ( Region1::tau(temperature)*Region1::dgamma_dtau(temperature, pressure) -
-              Region1::pi(pressure)*Region1::dgamma_dpi(temperature, pressure));
-    }
+    { return internalEnergy_(temperature, Region1::gibbsFreeEnergy(temperature, pressure)); }
 
     // the unregularized specific volume for liquid water
     template <class Evaluation>
     static Evaluation volumeRegion1_(const Evaluation& temperature, const Evaluation& pressure)
-    {
-        return
-            Region1::pi(pressure)*
-            Region1::dgamma_dpi(temperature, pressure) *
-            Rs * temperature / pressure;
-    }
+    { return volume_(temperature, pressure, Region1::gibbsFreeEnergy(temperature, pressure)); }
 
     // the unregularized specific enthalpy for steam
     template <class Evaluation>
     static Evaluation enthalpyRegion2_(const Evaluation& temperature, const Evaluation& pressure)
-    {
-        return
-            Region2::tau(temperature) *
-            Region2::dgamma_dtau(temperature, pressure) *
-            Rs*temperature;
-    }
+    { return enthalpy_(temperature, Region2::gibbsFreeEnergy(temperature, pressure)); }
 
     // the unregularized specific internal energy for steam
     template <class Evaluation>
     static Evaluation internalEnergyRegion2_(const Evaluation& temperature, const Evaluation& pressure)
-    {
-        return
-            Rs * temperature *
-            ( Region2::tau(temperature)*Region2::dgamma_dtau(temperature, pressure) -
-              Region2::pi(pressure)*Region2::dgamma_dpi(temperature, pressure));
-    }
+    { return internalEnergy_(temperature, Region2::gibbsFreeEnergy(temperature, pressure)); }
 
     // the unregularized specific isobaric heat capacity
     template <class Evaluation>
     static Evaluation heatCap_p_Region2_(const Evaluation& temperature, const Evaluation& pressure)
-    {
-        return
-            - Opm::pow(Region2::tau(temperature), 2 ) *
-            Region2::ddgamma_ddtau(temperature, pressure) *
-            Rs;
-    }
+    { return heatCap_p_(Region2::gibbsFreeEnergy(temperature, pressure)); }
 
     // the unregularized specific isochoric heat capacity
     template <class Evaluation>
     static Evaluation heatCap_v_Region2_(const Evaluation& temperature, const Evaluation& pressure)
     {
-        const Evaluation& tau = Region2::tau(temperature);
-        const Evaluation& pi = Region2::pi(pressure);
-        const Evaluation& num = 1 + pi * Region2::dgamma_dpi(temperature, pressure) + tau * pi * Region2::ddgamma_dtaudpi(temperature, pressure);
-        const Evaluation& diff = num * num / (1 - pi * pi * Region2::ddgamma_ddpi(temperature, pressure));
+        const auto& g = Region2::gibbsFreeEnergy(temperature, pressure);
+        const Evaluation& num = 1 + g.pi*g.dgamma_dpi + g.tau*g.pi*g.ddgamma_dtaudpi;
+        const Evaluation& diff = num*num/(1 - g.pi*g.pi*g.ddgamma_ddpi);
         return
-            - std::pow(tau, 2 ) *
-            Region2::ddgamma_ddtau(temperature, pressure) * Rs
+            - g.tau*g.tau*g.ddgamma_ddtau*Rs
             - diff;
     }
 
     // the unregularized specific volume for steam
     template <class Evaluation>
     static Evaluation volumeRegion2_(const Evaluation& temperature, const Evaluation& pressure)
+    { return volume_(temperature, pressure, Region2::gibbsFreeEnergy(temperature, pressure)); }
+
+    // the specific enthalpy given the Gibbs free energy of a region
+    template <class Evaluation>
+    static Evaluation enthalpy_(const Evaluation& temperature,
+                                const IAPWS::GibbsFreeEnergy<Evaluation>& g)
+    { return g.tau*g.dgamma_dtau*Rs*temperature; }
+
+    // the specific internal energy given the Gibbs free energy of a region
+    template <class Evaluation>
+    static Evaluation internalEnergy_(const Evaluation& temperature,
+                                      const IAPWS::GibbsFreeEnergy<Evaluation>& g)
+    { return Rs*temperature*(g.tau*g.dgamma_dtau - g.pi*g.dgamma_dpi); }
+
+    // the specific isobaric heat capacity given the Gibbs free energy of a region
+    template <class Evaluation>
+    static Evaluation heatCap_p_(const IAPWS::GibbsFreeEnergy<Evaluation>& g)
+    { return - g.tau*g.tau*g.ddgamma_ddtau*Rs; }
+
+    // the specific volume given the Gibbs free energy of a region
+    template <class Evaluation>
+    static Evaluation volume_(const Evaluation& temperature,
+                              const Evaluation& pressure,
+                              const IAPWS::GibbsFreeEnergy<Evaluation>& g)
+    { return g.pi*g.dgamma_dpi*Rs*temperature/pressure; }
+
+    // compute all quantities provided by liquidProperties() and gasProperties()
+    // using a single evaluation of the Gibbs free energy of a region
+    template <class Region, class Evaluation>
+    static void properties_(const Evaluation& temperature,
+                            const Evaluation& pressure,
+                            Evaluation& density,
+                            Evaluation& enthalpy,
+                            Evaluation& internalEnergy,
+                            Evaluation& heatCapacity)
     {
-        return
-            Region2::pi(pressure)*
-            Region2::dgamma_dpi(temperature, pressure) *
-            Rs * temperature / pressure;
+        const auto& g = Region::gibbsFreeEnergy(temperature, pressure);
+        density = 1.0/volume_(temperature, pressure, g);
+        enthalpy = enthalpy_(temperature, g);
+        internalEnergy = internalEnergy_(temperature, g);
+        heatCapacity = heatCap_p_(g);
+    }
+
+    // the same as properties_(), but the quantities are evaluated at the pressure
+    // 'p0' and extrapolated linearly to the pressure 'p'. The heat capacity is
+    // kept constant.
+    template <class Region, class Evaluation>
+    static void extrapolatedProperties_(const Evaluation& temperature,
+                                        const Evaluation& p0,
+                                        const Evaluation& p,
+                                        Evaluation& density,
+                                        Evaluation& enthalpy,
+                                        Evaluation& internalEnergy,
+                                        Evaluation& heatCapacity)
+    {
+        const auto& g = Region::gibbsFreeEnergy(temperature, p0);
+        const Evaluation& RT = Rs*temperature;
+        Scalar dpi_dp = Region::dpi_dp(p0);
+
+        const Evaluation& v = volume_(temperature, p0, g);
+        density = 1.0/v;
+        enthalpy = enthalpy_(temperature, g);
+        internalEnergy = internalEnergy_(temperature, g);
+        heatCapacity = heatCap_p_(g);
+
+        const Evaluation& dv_dp = RT*g.ddgamma_ddpi*dpi_dp*dpi_dp;
+        const Evaluation& dh_dp = RT*g.tau*g.ddgamma_dtaudpi*dpi_dp;
+        const Evaluation& du_dp =
+            RT*(g.tau*g.ddgamma_dtaudpi - g.dgamma_dpi - g.pi*g.ddgamma_ddpi)*dpi_dp;
+
+        const Evaluation& deltaP = p - p0;
+        density += - dv_dp/(v*v)*deltaP;
+        enthalpy += dh_dp*deltaP;
+        internalEnergy += du_dp*deltaP;
     }
 }; // end class
 
@@ -32,10 +32,34 @@
 #include <limits>
 #include <cassert>
 #include <iostream>
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
 
 #include <opm/material/common/MathToolbox.hpp>
 
 namespace Opm {
+namespace TabulatedComponentDetail {
+// the Component base class does not provide gasPressure() and
+// liquidPressure(), so these need to be detected
+template <class Scalar, class RawComponent, class = void>
+struct HasGasPressure : public std::false_type {};
+
+template <class Scalar, class RawComponent>
+struct HasGasPressure<Scalar, RawComponent,
+                      decltype(void(RawComponent::template gasPressure<Scalar>(Scalar(), Scalar())))>
+    : public std::true_type {};
+
+template <class Scalar, class RawComponent, class = void>
+struct HasLiquidPressure : public std::false_type {};
+
+template <class Scalar, class RawComponent>
+struct HasLiquidPressure<Scalar, RawComponent,
+                         decltype(void(RawComponent::template liquidPressure<Scalar>(Scalar(), Scalar())))>
+    : public std::true_type {};
+} // namespace TabulatedComponentDetail
+
 /*!
  * \ingroup Components
  *
@@ -45,6 +69,11 @@ namespace Opm {
  * At the moment, this class can only handle the sub-critical fluids
  * since it tabulates along the vapor pressure curve.
  *
+ * Any component can be wrapped: Quantities which are not provided by
+ * the raw component are not tabulated, and only the properties which
+ * are passed to init() are tabulated at all. All other quantities are
+ * forwarded to the raw component.
+ *
  * \tparam Scalar The type used for scalar values
  * \tparam RawComponent The component which ought to be tabulated
  * \tparam useVaporPressure If true, tabulate all quantities along the
@@ -59,6 +88,34 @@ public:
 
     static const bool isTabulated = true;
 
+    /*!
+     * \brief The quantities which can be tabulated.
+     *
+     * These flags can be combined and passed to init().
+     */
+    enum Property {
+        GasEnthalpy = 1 << 0,
+        LiquidEnthalpy = 1 << 1,
+        GasHeatCapacity = 1 << 2,
+        LiquidHeatCapacity = 1 << 3,
+        GasDensity = 1 << 4,
+        LiquidDensity = 1 << 5,
+        GasViscosity = 1 << 6,
+        LiquidViscosity = 1 << 7,
+        GasThermalConductivity = 1 << 8,
+        LiquidThermalConductivity = 1 << 9,
+        GasPressure = 1 << 10,
+        LiquidPressure = 1 << 11,
+
+        GasProperties =
+            GasEnthalpy | GasHeatCapacity | GasDensity | GasViscosity
+            | GasThermalConductivity | GasPressure,
+        LiquidProperties =
+            LiquidEnthalpy | LiquidHeatCapacity | LiquidDensity | LiquidViscosity
+            | LiquidThermalConductivity | LiquidPressure,
+        AllProperties = GasProperties | LiquidProperties
+    };
+
     /*!
      * \brief Initialize the tables.
      *
@@ -68,9 +125,11 @@ public:
      * \param pressMin The minimum of the pressure range in \f$\mathrm{[Pa]}\f$
      * \param pressMax The maximum of the pressure range in \f$\mathrm{[Pa]}\f$
      * \param nPress The number of entries/steps within the pressure range
+     * \param properties The quantities which ought to be tabulated (see Property)
      */
     static void init(Scalar tempMin, Scalar tempMax, unsigned nTemp,
-                     Scalar pressMin, Scalar pressMax, unsigned nPress)
+                     Scalar pressMin, Scalar pressMax, unsigned nPress,
+                     unsigned properties = AllProperties)
     {
         tempMin_ = tempMin;
         tempMax_ = tempMax;
@@ -80,25 +139,33 @@ public:
         nPress_ = nPress;
         nDensity_ = nPress_;
 
+        if (!TabulatedComponentDetail::HasGasPressure<Scalar, RawComponent>::value)
+            properties &= ~GasPressure;
+        if (!TabulatedComponentDetail::HasLiquidPressure<Scalar, RawComponent>::value)
+            properties &= ~LiquidPressure;
+        properties_ = properties;
+
         // allocate the arrays
-        vaporPressure_ = new Scalar[nTemp_];
-        minGasDensity__ = new Scalar[nTemp_];
-        maxGasDensity__ = new Scalar[nTemp_];
-        minLiquidDensity__ = new Scalar[nTemp_];
-        maxLiquidDensity__ = new Scalar[nTemp_];
-
-        gasEnthalpy_ = new Scalar[nTemp_*nPress_];
-        liquidEnthalpy_ = new Scalar[nTemp_*nPress_];
-        gasHeatCapacity_ = new Scalar[nTemp_*nPress_];
-        liquidHeatCapacity_ = new Scalar[nTemp_*nPress_];
-        gasDensity_ = new Scalar[nTemp_*nPress_];
-        liquidDensity_ = new Scalar[nTemp_*nPress_];
-        gasViscosity_ = new Scalar[nTemp_*nPress_];
-        liquidViscosity_ = new Scalar[nTemp_*nPress_];
-        gasThermalConductivity_ = new Scalar[nTemp_*nPress_];
-        liquidThermalConductivity_ = new Scalar[nTemp_*nPress_];
-        gasPressure_ = new Scalar[nTemp_*nDensity_];
-        liquidPressure_ = new Scalar[nTemp_*nDensity_];
+        size_t nTP = nTemp_*nPress_;
+        size_t nTRho = nTemp_*nDensity_;
+        allocate_(vaporPressure_, nTemp_, true);
+        allocate_(minGasDensity__, nTemp_, properties & GasPressure);
+        allocate_(maxGasDensity__, nTemp_, properties & GasPressure);
+        allocate_(minLiquidDensity__, nTemp_, properties & LiquidPressure);
+        allocate_(maxLiquidDensity__, nTemp_, properties & LiquidPressure);
+
+        allocate_(gasEnthalpy_, nTP, properties & GasEnthalpy);
+        allocate_(liquidEnthalpy_, nTP, properties & LiquidEnthalpy);
+        allocate_(gasHeatCapacity_, nTP, properties & GasHeatCapacity);
+        allocate_(liquidHeatCapacity_, nTP, properties & LiquidHeatCapacity);
+        allocate_(gasDensity_, nTP, properties & GasDensity);
+        allocate_(liquidDensity_, nTP, properties & LiquidDensity);
+        allocate_(gasViscosity_, nTP, properties & GasViscosity);
+        allocate_(liquidViscosity_, nTP, properties & LiquidViscosity);
+        allocate_(gasThermalConductivity_, nTP, properties & GasThermalConductivity);
+        allocate_(liquidThermalConductivity_, nTP, properties & LiquidThermalConductivity);
+        allocate_(gasPressure_, nTRho, properties & GasPressure);
+        allocate_(liquidPressure_, nTRho, properties & LiquidPressure);
 
         assert(std::numeric_limits<Scalar>::has_quiet_NaN);
         Scalar NaN = std::numeric_limits<Scalar>::quiet_NaN();
@@ -119,20 +186,30 @@ public:
 
                 unsigned i = iT + iP*nTemp_;
 
-                try { gasEnthalpy_[i] = RawComponent::gasEnthalpy(temperature, pressure); }
-                catch (const std::exception&) { gasEnthalpy_[i] = NaN; }
-
-                try { gasHeatCapacity_[i] = RawComponent::gasHeatCapacity(temperature, pressure); }
-                catch (const std::exception&) { gasHeatCapacity_[i] = NaN; }
-
-                try { gasDensity_[i] = RawComponent::gasDensity(temperature, pressure); }
-                catch (const std::exception&) { gasDensity_[i] = NaN; }
-
-                try { gasViscosity_[i] = RawComponent::gasViscosity(temperature, pressure); }
-                catch (const std::exception&) { gasViscosity_[i] = NaN; }
-
-                try { gasThermalConductivity_[i] = RawComponent::gasThermalConductivity(temperature, pressure); }
-                catch (const std::exception&) { gasThermalConductivity_[i] = NaN; }
+                if (gasEnthalpy_) {
+                    try { gasEnthalpy_[i] = RawComponent::gasEnthalpy(temperature, pressure); }
+                    catch (const std::exception&) { gasEnthalpy_[i] = NaN; }
+                }
+
+                if (gasHeatCapacity_) {
+                    try { gasHeatCapacity_[i] = RawComponent::gasHeatCapacity(temperature, pressure); }
+                    catch (const std::exception&) { gasHeatCapacity_[i] = NaN; }
+                }
+
+                if (gasDensity_) {
+                    try { gasDensity_[i] = RawComponent::gasDensity(temperature, pressure); }
+                    catch (const std::exception&) { gasDensity_[i] = NaN; }
+                }
+
+                if (gasViscosity_) {
+                    try { gasViscosity_[i] = RawComponent::gasViscosity(temperature, pressure); }
+                    catch (const std::exception&) { gasViscosity_[i] = NaN; }
+                }
+
+                if (gasThermalConductivity_) {
+                    try { gasThermalConductivity_[i] = RawComponent::gasThermalConductivity(temperature, pressure); }
+                    catch (const std::exception&) { gasThermalConductivity_[i] = NaN; }
+                }
             };
 
             Scalar plMin = minLiquidPressure_(iT);
@@ -142,34 +219,50 @@ public:
 
                 unsigned i = iT + iP*nTemp_;
 
-                try { liquidEnthalpy_[i] = RawComponent::liquidEnthalpy(temperature, pressure); }
-                catch (const std::exception&) { liquidEnthalpy_[i] = NaN; }
-
-                try { liquidHeatCapacity_[i] = RawComponent::liquidHeatCapacity(temperature, pressure); }
-                catch (const std::exception&) { liquidHeatCapacity_[i] = NaN; }
-
-                try { liquidDensity_[i] = RawComponent::liquidDensity(temperature, pressure); }
-                catch (const std::exception&) { liquidDensity_[i] = NaN; }
-
-                try { liquidViscosity_[i] = RawComponent::liquidViscosity(temperature, pressure); }
-                catch (const std::exception&) { liquidViscosity_[i] = NaN; }
-
-                try { liquidThermalConductivity_[i] = RawComponent::liquidThermalConductivity(temperature, pressure); }
-                catch (const std::exception&) { liquidThermalConductivity_[i] = NaN; }
+                if (liquidEnthalpy_) {
+                    try { liquidEnthalpy_[i] = RawComponent::liquidEnthalpy(temperature, pressure); }
+                    catch (const std::exception&) { liquidEnthalpy_[i] = NaN; }
+                }
+
+                if (liquidHeatCapacity_) {
+                    try { liquidHeatCapacity_[i] = RawComponent::liquidHeatCapacity(temperature, pressure); }
+                    catch (const std::exception&) { liquidHeatCapacity_[i] = NaN; }
+                }
+
+                if (liquidDensity_) {
+                    try { liquidDensity_[i] = RawComponent::liquidDensity(temperature, pressure); }
+                    catch (const std::exception&) { liquidDensity_[i] = NaN; }
+                }
+
+                if (liquidViscosity_) {
+                    try { liquidViscosity_[i] = RawComponent::liquidViscosity(temperature, pressure); }
+                    catch (const std::exception&) { liquidViscosity_[i] = NaN; }
+                }
+
+                if (liquidThermalConductivity_) {
+                    try { liquidThermalConductivity_[i] = RawComponent::liquidThermalConductivity(temperature, pressure); }
+                    catch (const std::exception&) { liquidThermalConductivity_[i] = NaN; }
+                }
             }
         }
 
         // fill the temperature-density arrays
-        for (unsigned iT = 0; iT < nTemp_; ++ iT) {
+        for (unsigned iT = 0; gasPressure_ && iT < nTemp_; ++ iT) {
             Scalar temperature = iT * (tempMax_ - tempMin_)/(nTemp_ - 1) + tempMin_;
 
             // calculate the minimum and maximum values for the gas
             // densities
-            minGasDensity__[iT] = RawComponent::gasDensity(temperature, minGasPressure_(iT));
-            if (iT < nTemp_ - 1)
-                maxGasDensity__[iT] = RawComponent::gasDensity(temperature, maxGasPressure_(iT + 1));
-            else
-                maxGasDensity__[iT] = RawComponent::gasDensity(temperature, maxGasPressure_(iT));
+            try {
+                minGasDensity__[iT] = RawComponent::gasDensity(temperature, minGasPressure_(iT));
+                if (iT < nTemp_ - 1)
+                    maxGasDensity__[iT] = RawComponent::gasDensity(temperature, maxGasPressure_(iT + 1));
+                else
+                    maxGasDensity__[iT] = RawComponent::gasDensity(temperature, maxGasPressure_(iT));
+            }
+            catch (const std::exception&) {
+                minGasDensity__[iT] = NaN;
+                maxGasDensity__[iT] = NaN;
+            }
 
             // fill the temperature, density gas arrays
             for (unsigned iRho = 0; iRho < nDensity_; ++ iRho) {
@@ -181,17 +274,27 @@ public:
 
                 unsigned i = iT + iRho*nTemp_;
 
-                try { gasPressure_[i] = RawComponent::gasPressure(temperature, density); }
+                try { gasPressure_[i] = rawGasPressure_(temperature, density); }
                 catch (const std::exception&) { gasPressure_[i] = NaN; };
             };
+        }
+
+        for (unsigned iT = 0; liquidPressure_ && iT < nTemp_; ++ iT) {
+            Scalar temperature = iT * (tempMax_ - tempMin_)/(nTemp_ - 1) + tempMin_;
 
             // calculate the minimum and maximum values for the liquid
             // densities
-            minLiquidDensity__[iT] = RawComponent::liquidDensity(temperature, minLiquidPressure_(iT));
-            if (iT < nTemp_ - 1)
-                maxLiquidDensity__[iT] = RawComponent::liquidDensity(temperature, maxLiquidPressure_(iT + 1));
-            else
-                maxLiquidDensity__[iT] = RawComponent::liquidDensity(temperature, maxLiquidPressure_(iT));
+            try {
+                minLiquidDensity__[iT] = RawComponent::liquidDensity(temperature, minLiquidPressure_(iT));
+                if (iT < nTemp_ - 1)
+                    maxLiquidDensity__[iT] = RawComponent::liquidDensity(temperature, maxLiquidPressure_(iT + 1));
+                else
+                    maxLiquidDensity__[iT] = RawComponent::liquidDensity(temperature, maxLiquidPressure_(iT));
+            }
+            catch (const std::exception&) {
+                minLiquidDensity__[iT] = NaN;
+                maxLiquidDensity__[iT] = NaN;
+            }
 
             // fill the temperature, density liquid arrays
             for (unsigned iRho = 0; iRho < nDensity_; ++ iRho) {
@@ -203,12 +306,68 @@ public:
 
                 unsigned i = iT + iRho*nTemp_;
 
-                try { liquidPressure_[i] = RawComponent::liquidPressure(temperature, density); }
+                try { liquidPressure_[i] = rawLiquidPressure_(temperature, density); }
                 catch (const std::exception&) { liquidPressure_[i] = NaN; };
             };
         }
     }
 
+    /*!
+     * \brief Initialize the tables with a resolution which is sufficient
+     *        to reproduce the raw component within a given tolerance.
+     *
+     * Starting with a coarse table, the resolution of the temperature or the
+     * pressure axis is doubled until the error of the interpolation at the
+     * midpoints between the sampling points is below the tolerance. The
+     * error of a quantity is measured relative to the largest magnitude of
+     * the quantity within the table. Refinement stops when the number of
+     * sampling points of an axis exceeds maxSamples.
+     *
+     * \return The largest relative error of the final tables.
+     */
+    static Scalar initWithTolerance(Scalar tempMin, Scalar tempMax,
+                                    Scalar pressMin, Scalar pressMax,
+                                    Scalar tolerance,
+                                    unsigned properties = AllProperties,
+                                    unsigned maxSamples = 1025)
+    {
+        unsigned nTemp = 9;
+        unsigned nPress = 9;
+        while (true) {
+            init(tempMin, tempMax, nTemp, pressMin, pressMax, nPress, properties);
+
+            Scalar errorT = 0.0;
+            Scalar errorP = 0.0;
+            estimateErrors_(errorT, errorP);
+            if (std::max(errorT, errorP) <= tolerance)
+                return std::max(errorT, errorP);
+
+            // refine the axis which causes the larger error. since the new
+            // resolution is 2*(n - 1) + 1, the old sampling points are kept
+            bool refineT = errorT > tolerance && 2*nTemp - 1 <= maxSamples;
+            bool refineP = errorP > tolerance && 2*nPress - 1 <= maxSamples;
+            if (refineT && refineP) {
+                if (errorT > errorP)
+                    refineP = false;
+                else
+                    refineT = false;
+            }
+            else if (!refineT && !refineP)
+                return std::max(errorT, errorP);
+
+            if (refineT)
+                nTemp = 2*nTemp - 1;
+            else
+                nPress = 2*nPress - 1;
+        }
+    }
+
+    /*!
+     * \brief Returns the quantities which are currently tabulated.
+     */
+    static unsigned tabulatedProperties()
+    { return properties_; }
+
     /*!
      * \brief A human readable name for the component.
      */
@@ -361,8 +520,7 @@ public:
                                                        temperature,
                                                        density);
         if (std::isnan(Opm::scalarValue(result)))
-            return RawComponent::gasPressure(temperature,
-                                             density);
+            return rawGasPressure_(temperature, density);
         return result;
     }
 
@@ -379,8 +537,7 @@ public:
                                                           temperature,
                                                           density);
         if (std::isnan(Opm::scalarValue(result)))
-            return RawComponent::liquidPressure(temperature,
-                                                density);
+            return rawLiquidPressure_(temperature, density);
         return result;
     }
 
@@ -508,6 +665,121 @@ public:
     }
 
 private:
+    static void allocate_(Scalar*& values, size_t n, bool enabled)
+    {
+        delete[] values;
+        values = enabled ? new Scalar[n] : nullptr;
+    }
+
+    template <class Evaluation>
+    static Evaluation rawGasPressure_(const Evaluation& temperature, Scalar density)
+    {
+        return rawGasPressure_(temperature, density,
+                               TabulatedComponentDetail::HasGasPressure<Scalar, RawComponent>());
+    }
+
+    template <class Evaluation>
+    static Evaluation rawGasPressure_(const Evaluation& temperature, Scalar density, std::true_type)
+    { return RawComponent::template gasPressure<Evaluation>(temperature, density); }
+
+    template <class Evaluation>
+    static Evaluation rawGasPressure_(const Evaluation& /* temperature */, Scalar /* density */, std::false_type)
+    { throw std::runtime_error(std::string("Not implemented: ") + RawComponent::name() + "::gasPressure()"); }
+
+    template <class Evaluation>
+    static Evaluation rawLiquidPressure_(const Evaluation& temperature, Scalar density)
+    {
+        return rawLiquidPressure_(temperature, density,
+                                  TabulatedComponentDetail::HasLiquidPressure<Scalar, RawComponent>());
+    }
+
+    template <class Evaluation>
+    static Evaluation rawLiquidPressure_(const Evaluation& temperature, Scalar density, std::true_type)
+    { return RawComponent::template liquidPressure<Evaluation>(temperature, density); }
+
+    template <class Evaluation>
+    static Evaluation rawLiquidPressure_(const Evaluation& /* temperature */, Scalar /* density */, std::false_type)
+    { throw std::runtime_error(std::string("Not implemented: ") + RawComponent::name() + "::liquidPressure()"); }
+
+    // estimate the largest relative interpolation error of the tabulated
+    // quantities between the sampling points along the temperature and the
+    // pressure axes
+    static void estimateErrors_(Scalar& errorT, Scalar& errorP)
+    {
+        errorT = 0.0;
+        errorP = 0.0;
+
+        const Scalar* gasTables[] = { gasEnthalpy_, gasHeatCapacity_, gasDensity_, gasViscosity_, gasThermalConductivity_ };
+        const Scalar* liquidTables[] = { liquidEnthalpy_, liquidHeatCapacity_, liquidDensity_, liquidViscosity_, liquidThermalConductivity_ };
+        for (unsigned quantityIdx = 0; quantityIdx < 5; ++quantityIdx) {
+            if (gasTables[quantityIdx])
+                estimateErrors_(errorT, errorP, gasTables[quantityIdx], quantityIdx, /*gas=*/true);
+            if (liquidTables[quantityIdx])
+                estimateErrors_(errorT, errorP, liquidTables[quantityIdx], quantityIdx, /*gas=*/false);
+        }
+    }
+
+    static void estimateErrors_(Scalar& errorT, Scalar& errorP,
+                                const Scalar* values,
+                                unsigned quantityIdx,
+                                bool gas)
+    {
+        Scalar scale = 0.0;
+        for (size_t i = 0; i < nTemp_*nPress_; ++i)
+            if (std::isfinite(values[i]))
+                scale = std::max(scale, std::abs(values[i]));
+        if (!(scale > 0.0))
+            return;
+
+        for (unsigned iT = 0; iT < nTemp_ - 1; ++iT) {
+            Scalar T = iT * (tempMax_ - tempMin_)/(nTemp_ - 1) + tempMin_;
+            Scalar TMid = (iT + 0.5) * (tempMax_ - tempMin_)/(nTemp_ - 1) + tempMin_;
+            Scalar pMin = gas ? minGasPressure_(iT) : minLiquidPressure_(iT);
+            Scalar pMax = gas ? maxGasPressure_(iT) : maxLiquidPressure_(iT);
+
+            for (unsigned iP = 0; iP < nPress_ - 1; ++iP) {
+                Scalar p = iP * (pMax - pMin)/(nPress_ - 1) + pMin;
+                Scalar pMid = (iP + 0.5) * (pMax - pMin)/(nPress_ - 1) + pMin;
+
+                errorT = std::max(errorT, relativeError_(values, quantityIdx, gas, TMid, p, scale));
+                errorP = std::max(errorP, relativeError_(values, quantityIdx, gas, T, pMid, scale));
+            }
+        }
+    }
+
+    static Scalar relativeError_(const Scalar* values,
+                                 unsigned quantityIdx,
+                                 bool gas,
+                                 Scalar T,
+                                 Scalar p,
+                                 Scalar scale)
+    {
+        Scalar tabulated =
+            gas
+            ? interpolateGasTP_(values, T, p)
+            : interpolateLiquidTP_(values, T, p);
+        if (!std::isfinite(tabulated))
+            return 0.0; // the raw component is used in this case
+
+        Scalar raw;
+        try {
+            switch (quantityIdx) {
+            case 0: raw = gas ? RawComponent::gasEnthalpy(T, p) : RawComponent::liquidEnthalpy(T, p); break;
+            case 1: raw = gas ? RawComponent::gasHeatCapacity(T, p) : RawComponent::liquidHeatCapacity(T, p); break;
+            case 2: raw = gas ? RawComponent::gasDensity(T, p) : RawComponent::liquidDensity(T, p); break;
+            case 3: raw = gas ? RawComponent::gasViscosity(T, p) : RawComponent::liquidViscosity(T, p); break;
+            default: raw = gas ? RawComponent::gasThermalConductivity(T, p) : RawComponent::liquidThermalConductivity(T, p); break;
+            }
+        }
+        catch (const std::exception&) {
+            return 0.0;
+        }
+
+        if (!std::isfinite(raw))
+            return 0.0;
+        return std::abs(tabulated - raw)/scale;
+    }
+
     // returns an interpolated value depending on temperature
     template <class Evaluation>
     static Evaluation interpolateT_(const Scalar* values, const Evaluation& T)
@@ -529,6 +801,10 @@ private:
     template <class Evaluation>
     static Evaluation interpolateLiquidTP_(const Scalar* values, const Evaluation& T, const Evaluation& p)
     {
+        // the quantity is not tabulated
+        if (!values)
+            return std::numeric_limits<Scalar>::quiet_NaN();
+
         Evaluation alphaT = tempIdx_(T);
         if (alphaT < 0 || alphaT >= nTemp_ - 1)
             return std::numeric_limits<Scalar>::quiet_NaN();
@@ -562,6 +838,10 @@ private:
     template <class Evaluation>
     static Evaluation interpolateGasTP_(const Scalar* values, const Evaluation& T, const Evaluation& p)
     {
+        // the quantity is not tabulated
+        if (!values)
+            return std::numeric_limits<Scalar>::quiet_NaN();
+
         Evaluation alphaT = tempIdx_(T);
         if (alphaT < 0 || alphaT >= nTemp_ - 1)
             return std::numeric_limits<Scalar>::quiet_NaN();
@@ -595,16 +875,20 @@ private:
     // returns an interpolated value for gas depending on
     // temperature and density
     template <class Evaluation>
-    static Evaluation interpolateGasTRho_(const Scalar* values, const Evaluation& T, const Evaluation& rho)
+    static Evaluation interpolateGasTRho_(const Scalar* values, const Evaluation& T, Scalar rho)
     {
+        // the quantity is not tabulated
+        if (!values)
+            return std::numeric_limits<Scalar>::quiet_NaN();
+
         Evaluation alphaT = tempIdx_(T);
         unsigned iT = std::max(0,
                                std::min(static_cast<int>(nTemp_ - 2),
-                                        static_cast<int>(alphaT)));
+                                        static_cast<int>(Opm::scalarValue(alphaT))));
         alphaT -= iT;
 
-        Evaluation alphaP1 = densityGasIdx_(rho, iT);
-        Evaluation alphaP2 = densityGasIdx_(rho, iT + 1);
+        Scalar alphaP1 = densityGasIdx_(rho, iT);
+        Scalar alphaP2 = densityGasIdx_(rho, iT + 1);
         unsigned iP1 =
             std::max(0,
                      std::min(static_cast<int>(nDensity_ - 2),
@@ -626,14 +910,18 @@ private:
     // returns an interpolated value for liquid depending on
     // temperature and density
     template <class Evaluation>
-    static Evaluation interpolateLiquidTRho_(const Scalar* values, const Evaluation& T, const Evaluation& rho)
+    static Evaluation interpolateLiquidTRho_(const Scalar* values, const Evaluation& T, Scalar rho)
     {
+        // the quantity is not tabulated
+        if (!values)
+            return std::numeric_limits<Scalar>::quiet_NaN();
+
         Evaluation alphaT = tempIdx_(T);
-        unsigned iT = std::max<int>(0, std::min<int>(nTemp_ - 2, static_cast<int>(alphaT)));
+        unsigned iT = std::max<int>(0, std::min<int>(nTemp_ - 2, static_cast<int>(Opm::scalarValue(alphaT))));
         alphaT -= iT;
 
-        Evaluation alphaP1 = densityLiquidIdx_(rho, iT);
-        Evaluation alphaP2 = densityLiquidIdx_(rho, iT + 1);
+        Scalar alphaP1 = densityLiquidIdx_(rho, iT);
+        Scalar alphaP2 = densityLiquidIdx_(rho, iT + 1);
         unsigned iP1 = std::max<int>(0, std::min<int>(nDensity_ - 2, static_cast<int>(alphaP1)));
         unsigned iP2 = std::max<int>(0, std::min<int>(nDensity_ - 2, static_cast<int>(alphaP2)));
         alphaP1 -= iP1;
@@ -784,6 +1072,9 @@ private:
     static Scalar* gasPressure_;
     static Scalar* liquidPressure_;
 
+    // the quantities which are tabulated
+    static unsigned properties_;
+
     // temperature, pressure and density ranges
     static Scalar tempMin_;
     static Scalar tempMax_;
@@ -833,6 +1124,8 @@ Scalar* TabulatedComponent<Scalar, RawComponent, useVaporPressure>::gasPressure_
 template <class Scalar, class RawComponent, bool useVaporPressure>
 Scalar* TabulatedComponent<Scalar, RawComponent, useVaporPressure>::liquidPressure_;
 template <class Scalar, class RawComponent, bool useVaporPressure>
+unsigned TabulatedComponent<Scalar, RawComponent, useVaporPressure>::properties_;
+template <class Scalar, class RawComponent, bool useVaporPressure>
 Scalar TabulatedComponent<Scalar, RawComponent, useVaporPressure>::tempMin_;
 template <class Scalar, class RawComponent, bool useVaporPressure>
 Scalar TabulatedComponent<Scalar, RawComponent, useVaporPressure>::tempMax_;
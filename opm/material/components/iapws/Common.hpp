@@ -248,6 +248,31 @@ const Scalar Common<Scalar>::tripleTemperature = 273.16;
 template <class Scalar>
 const Scalar Common<Scalar>::triplePressure = 611.657;
 
+/*!
+ * \ingroup IAPWS
+ *
+ * \brief The dimensionless Gibbs free energy of a region of the IAPWS '97
+ *        formulation together with its first and second partial derivatives
+ *        to the reduced temperature \f$\tau\f$ and the reduced pressure
+ *        \f$\pi\f$.
+ *
+ * Objects of this type are computed by the gibbsFreeEnergy() methods of the
+ * regions.
+ */
+template <class Evaluation>
+struct GibbsFreeEnergy
+{
+    Evaluation tau;
+    Evaluation pi;
+
+    Evaluation gamma;
+    Evaluation dgamma_dtau;
+    Evaluation dgamma_dpi;
+    Evaluation ddgamma_ddtau;
+    Evaluation ddgamma_dtaudpi;
+    Evaluation ddgamma_ddpi;
+};
+
 } // namespace IAPWS
 } // namespace Opm
 
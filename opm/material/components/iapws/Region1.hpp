@@ -27,6 +27,7 @@
 #ifndef OPM_IAPWS_REGION1_HPP
 #define OPM_IAPWS_REGION1_HPP
 
+#include <opm/material/components/iapws/Common.hpp>
 #include <opm/material/common/MathToolbox.hpp>
 
 #include <cmath>
@@ -297,6 +298,70 @@ public:
         return result;
     }
 
+    /*!
+     * \brief The Gibbs free energy for IAPWS region 1 (i.e. liquid) and its
+     *        first and second partial derivatives (dimensionless).
+     *
+     * This is equivalent to calling gamma(), dgamma_dtau(), dgamma_dpi(),
+     * ddgamma_ddtau(), ddgamma_dtaudpi() and ddgamma_ddpi() individually, but
+     * the powers of \f$7.1 - \pi\f$ and \f$\tau - 1.222\f$ are only
+     * computed once for all of them and without calling pow().
+     *
+     * \param temperature temperature of component in \f$\mathrm{[K]}\f$
+     * \param pressure pressure of component in \f$\mathrm{[Pa]}\f$
+     */
+    template <class Evaluation>
+    static GibbsFreeEnergy<Evaluation> gibbsFreeEnergy(const Evaluation& temperature,
+                                                       const Evaluation& pressure)
+    {
+        GibbsFreeEnergy<Evaluation> result;
+        result.tau = tau(temperature);
+        result.pi = pi(pressure);
+
+        const Evaluation& a = 7.1 - result.pi;
+        const Evaluation& b = result.tau - 1.222;
+
+        // a^k for 0 <= k <= 32 and b^k for -41 <= k <= 17
+        Evaluation aPow[33];
+        aPow[0] = 1.0;
+        for (int k = 1; k < 33; ++k)
+            aPow[k] = aPow[k - 1]*a;
+
+        Evaluation bPowStorage[59];
+        Evaluation* bPow = bPowStorage + 41;
+        bPow[0] = 1.0;
+        for (int k = 1; k <= 17; ++k)
+            bPow[k] = bPow[k - 1]*b;
+        const Evaluation& bInv = 1.0/b;
+        for (int k = 1; k <= 41; ++k)
+            bPow[-k] = bPow[-k + 1]*bInv;
+
+        // the derivatives are obtained by weighting the terms of gamma by
+        // their exponents and dividing by a and b afterwards
+        Evaluation g = 0.0, gI = 0.0, gII = 0.0, gJ = 0.0, gJJ = 0.0, gIJ = 0.0;
+        for (int i = 0; i < 34; ++i) {
+            const Scalar Ii = I(i);
+            const Scalar Ji = J(i);
+            const Evaluation& t = n(i)*aPow[static_cast<int>(Ii)]*bPow[static_cast<int>(Ji)];
+
+            g += t;
+            gI += Ii*t;
+            gII += Ii*(Ii - 1)*t;
+            gJ += Ji*t;
+            gJJ += Ji*(Ji - 1)*t;
+            gIJ += Ii*Ji*t;
+        }
+
+        result.gamma = g;
+        result.dgamma_dpi = -gI/a;
+        result.ddgamma_ddpi = gII/(a*a);
+        result.dgamma_dtau = gJ/b;
+        result.ddgamma_ddtau = gJJ/(b*b);
+        result.ddgamma_dtaudpi = -gIJ/(a*b);
+
+        return result;
+    }
+
 private:
     static Scalar n(int i)
     {
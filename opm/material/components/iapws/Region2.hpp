@@ -27,6 +27,7 @@
 #ifndef OPM_IAPWS_REGION2_HPP
 #define OPM_IAPWS_REGION2_HPP
 
+#include <opm/material/components/iapws/Common.hpp>
 #include <opm/material/common/MathToolbox.hpp>
 
 #include <cmath>
@@ -335,6 +336,87 @@ public:
         return result;
     }
 
+    /*!
+     * \brief The Gibbs free energy for IAPWS region 2 (i.e. sub-critical
+     *        steam) and its first and second partial derivatives
+     *        (dimensionless).
+     *
+     * This is equivalent to calling gamma(), dgamma_dtau(), dgamma_dpi(),
+     * ddgamma_ddtau(), ddgamma_dtaudpi() and ddgamma_ddpi() individually, but
+     * the powers of \f$\tau\f$, \f$\pi\f$ and \f$\tau - 0.5\f$ are only
+     * computed once for all of them and without calling pow().
+     *
+     * \param temperature temperature of component in \f$\mathrm{[K]}\f$
+     * \param pressure pressure of component in \f$\mathrm{[Pa]}\f$
+     */
+    template <class Evaluation>
+    static GibbsFreeEnergy<Evaluation> gibbsFreeEnergy(const Evaluation& temperature,
+                                                       const Evaluation& pressure)
+    {
+        GibbsFreeEnergy<Evaluation> result;
+        result.tau = tau(temperature);
+        result.pi = pi(pressure);
+
+        const Evaluation& tau_ = result.tau;
+        const Evaluation& pi_ = result.pi;
+        const Evaluation& b = tau_ - 0.5;
+
+        // tau^k for -5 <= k <= 3
+        Evaluation tauPowStorage[9];
+        Evaluation* tauPow = tauPowStorage + 5;
+        tauPow[0] = 1.0;
+        for (int k = 1; k <= 3; ++k)
+            tauPow[k] = tauPow[k - 1]*tau_;
+        const Evaluation& tauInv = 1.0/tau_;
+        for (int k = 1; k <= 5; ++k)
+            tauPow[-k] = tauPow[-k + 1]*tauInv;
+
+        // pi^k for 0 <= k <= 24 and b^k for 0 <= k <= 58
+        Evaluation piPow[25];
+        piPow[0] = 1.0;
+        for (int k = 1; k < 25; ++k)
+            piPow[k] = piPow[k - 1]*pi_;
+
+        Evaluation bPow[59];
+        bPow[0] = 1.0;
+        for (int k = 1; k < 59; ++k)
+            bPow[k] = bPow[k - 1]*b;
+
+        // ideal gas part
+        Evaluation g0 = 0.0, g0J = 0.0, g0JJ = 0.0;
+        for (int i = 0; i < 9; ++i) {
+            const Scalar Ji = J_g(i);
+            const Evaluation& t = n_g(i)*tauPow[static_cast<int>(Ji)];
+
+            g0 += t;
+            g0J += Ji*t;
+            g0JJ += Ji*(Ji - 1)*t;
+        }
+
+        // residual part
+        Evaluation gr = 0.0, grI = 0.0, grII = 0.0, grJ = 0.0, grJJ = 0.0, grIJ = 0.0;
+        for (int i = 0; i < 43; ++i) {
+            const Scalar Ii = I_r(i);
+            const Scalar Ji = J_r(i);
+            const Evaluation& t = n_r(i)*piPow[static_cast<int>(Ii)]*bPow[static_cast<int>(Ji)];
+
+            gr += t;
+            grI += Ii*t;
+            grII += Ii*(Ii - 1)*t;
+            grJ += Ji*t;
+            grJJ += Ji*(Ji - 1)*t;
+            grIJ += Ii*Ji*t;
+        }
+
+        result.gamma = Opm::log(pi_) + g0 + gr;
+        result.dgamma_dpi = (1.0 + grI)/pi_;
+        result.ddgamma_ddpi = (grII - 1.0)/(pi_*pi_);
+        result.dgamma_dtau = g0J/tau_ + grJ/b;
+        result.ddgamma_ddtau = g0JJ/(tau_*tau_) + grJJ/(b*b);
+        result.ddgamma_dtaudpi = grIJ/(pi_*b);
+
+        return result;
+    }
 
 private:
     static Scalar n_g(int i)
@@ -28,13 +28,19 @@
 #define OPM_COMPOSITION_FROM_FUGACITIES_HPP
 
 #include <opm/material/common/MathToolbox.hpp>
+#include <opm/material/densead/Evaluation.hpp>
 #include <opm/material/common/Exceptions.hpp>
 #include <opm/material/common/Valgrind.hpp>
+#include <opm/material/common/BatchedLuSolver.hpp>
+#include <opm/material/fluidstates/CompositionalFluidState.hpp>
 
 #include <dune/common/fvector.hh>
 #include <dune/common/fmatrix.hh>
 
 #include <limits>
+#include <vector>
+#include <sstream>
+#include <type_traits>
 
 namespace Opm {
 
@@ -174,6 +180,175 @@ public:
         throw Opm::NumericalIssue(oss.str());
     }
 
+    /*!
+     * \brief Calculates the composition of a phase for a batch of fluid
+     *        states from the component fugacities.
+     *
+     * The Newton iterations are done on scalar copies of the fluid states
+     * and the linear systems of all states which are not yet converged are
+     * solved together using BatchedLuSolver. If Evaluation is not a
+     * scalar, the derivatives of the composition are recovered by a single
+     * Newton step at the converged composition for which only the defect is
+     * evaluated using automatic differentiation, i.e., by means of the
+     * implicit function theorem.
+     *
+     * If warmStart is true, the compositions of the phase which are stored
+     * in the fluid states are used as the initial guess (e.g., the result
+     * of the previous time step), else the guess of guessInitial() is used.
+     */
+    template <class FluidState>
+    static void solveBatch(size_t numStates,
+                           FluidState* fluidStates,
+                           typename FluidSystem::template ParameterCache<typename FluidState::Scalar>* paramCaches,
+                           unsigned phaseIdx,
+                           const ComponentVector* targetFugs,
+                           bool warmStart = true)
+    {
+        if (FluidSystem::isIdealMixture(phaseIdx)) {
+            for (size_t stateIdx = 0; stateIdx < numStates; ++stateIdx)
+                solveIdealMix_(fluidStates[stateIdx], paramCaches[stateIdx], phaseIdx, targetFugs[stateIdx]);
+            return;
+        }
+
+        typedef Opm::CompositionalFluidState<Scalar, FluidSystem, /*storeEnthalpy=*/false> ScalarFluidState;
+        typedef typename FluidSystem::template ParameterCache<Scalar> ScalarParamCache;
+        typedef Dune::FieldVector<Scalar, numComponents> ScalarVector;
+        typedef Dune::FieldMatrix<Scalar, numComponents, numComponents> ScalarMatrix;
+
+        // the Newton method only needs the pressure, the temperature and the
+        // composition of the phase
+        std::vector<ScalarFluidState> scalarStates(numStates);
+        std::vector<ScalarParamCache> scalarCaches(numStates);
+        std::vector<ScalarVector> scalarTargetFugs(numStates);
+        std::vector<size_t> active(numStates);
+        for (size_t stateIdx = 0; stateIdx < numStates; ++stateIdx) {
+            const FluidState& fs = fluidStates[stateIdx];
+            ScalarFluidState& sfs = scalarStates[stateIdx];
+            sfs.setPressure(phaseIdx, Opm::scalarValue(fs.pressure(phaseIdx)));
+            sfs.setTemperature(Opm::scalarValue(fs.temperature(phaseIdx)));
+            for (unsigned compIdx = 0; compIdx < numComponents; ++compIdx) {
+                Scalar x = 1.0/numComponents;
+                if (warmStart)
+                    x = Opm::scalarValue(fs.moleFraction(phaseIdx, compIdx));
+                sfs.setMoleFraction(phaseIdx, compIdx, x);
+                scalarTargetFugs[stateIdx][compIdx] = Opm::scalarValue(targetFugs[stateIdx][compIdx]);
+            }
+            scalarCaches[stateIdx].updatePhase(sfs, phaseIdx);
+            active[stateIdx] = stateIdx;
+        }
+
+        /////////////////////////
+        // Newton method
+        /////////////////////////
+        BatchedLuSolver<Scalar, numComponents> lu;
+        ScalarMatrix J;
+        ScalarVector b;
+        ScalarVector x;
+
+        const int nMax = 25;
+        for (int nIdx = 0; nIdx < nMax && !active.empty(); ++nIdx) {
+            lu.resize(active.size());
+            for (size_t sysIdx = 0; sysIdx < active.size(); ++sysIdx) {
+                size_t stateIdx = active[sysIdx];
+                linearize_(J, b, scalarStates[stateIdx], scalarCaches[stateIdx], phaseIdx, scalarTargetFugs[stateIdx]);
+                for (unsigned i = 0; i < numComponents; ++i) {
+                    lu.rhs(sysIdx, i) = b[i];
+                    for (unsigned j = 0; j < numComponents; ++j)
+                        lu.matrix(sysIdx, i, j) = J[i][j];
+                }
+            }
+
+            lu.factorize();
+            lu.solve();
+
+            // update the compositions and remove the converged systems from
+            // the active set
+            size_t numActive = 0;
+            for (size_t sysIdx = 0; sysIdx < active.size(); ++sysIdx) {
+                size_t stateIdx = active[sysIdx];
+                if (lu.isSingular(sysIdx))
+                    throw Opm::NumericalIssue("Singular Jacobian while calculating the "
+                                              +std::string(FluidSystem::phaseName(phaseIdx))
+                                              +"Phase composition");
+
+                for (unsigned i = 0; i < numComponents; ++i)
+                    x[i] = lu.solution(sysIdx, i);
+
+                Scalar relError = update_(scalarStates[stateIdx], scalarCaches[stateIdx], x, b, phaseIdx, scalarTargetFugs[stateIdx]);
+                if (!(relError < 1e-9))
+                    active[numActive++] = stateIdx;
+            }
+            active.resize(numActive);
+        }
+
+        if (!active.empty()) {
+            std::ostringstream oss;
+            oss << "Calculating the " << FluidSystem::phaseName(phaseIdx)
+                << "Phase composition failed for " << active.size() << " of "
+                << numStates << " fluid states";
+            throw Opm::NumericalIssue(oss.str());
+        }
+
+        // copy the converged compositions back
+        for (size_t stateIdx = 0; stateIdx < numStates; ++stateIdx) {
+            for (unsigned compIdx = 0; compIdx < numComponents; ++compIdx)
+                fluidStates[stateIdx].setMoleFraction(phaseIdx, compIdx,
+                                                      scalarStates[stateIdx].moleFraction(phaseIdx, compIdx));
+            paramCaches[stateIdx].updatePhase(fluidStates[stateIdx], phaseIdx);
+        }
+
+        if (!std::is_same<Evaluation, Scalar>::value) {
+            // the Jacobian at the solution is required for the derivatives. unlike
+            // for the Newton method, its errors directly end up in the result, so it
+            // is not approximated by finite differences
+            lu.resize(numStates);
+            for (size_t stateIdx = 0; stateIdx < numStates; ++stateIdx) {
+                linearizeExact_(J, scalarStates[stateIdx], phaseIdx);
+                for (unsigned i = 0; i < numComponents; ++i)
+                    for (unsigned j = 0; j < numComponents; ++j)
+                        lu.matrix(stateIdx, i, j) = J[i][j];
+            }
+            lu.factorize();
+
+            ComponentVector delta;
+            for (size_t stateIdx = 0; stateIdx < numStates; ++stateIdx) {
+                FluidState& fs = fluidStates[stateIdx];
+                if (lu.isSingular(stateIdx))
+                    throw Opm::NumericalIssue("Singular Jacobian while calculating the "
+                                              +std::string(FluidSystem::phaseName(phaseIdx))
+                                              +"Phase composition");
+
+                for (unsigned i = 0; i < numComponents; ++i) {
+                    const Evaluation& phi = FluidSystem::fugacityCoefficient(fs, paramCaches[stateIdx], phaseIdx, i);
+                    delta[i] = targetFugs[stateIdx][i] - phi*fs.pressure(phaseIdx)*fs.moleFraction(phaseIdx, i);
+                }
+                lu.solve(stateIdx, delta);
+
+                for (unsigned i = 0; i < numComponents; ++i) {
+                    Evaluation newx = fs.moleFraction(phaseIdx, i) - delta[i];
+                    if (targetFugs[stateIdx][i] > 0)
+                        newx = Opm::max(0.0, newx);
+                    else if (targetFugs[stateIdx][i] < 0)
+                        newx = Opm::min(0.0, newx);
+                    else
+                        newx = 0;
+                    fs.setMoleFraction(phaseIdx, i, newx);
+                }
+                paramCaches[stateIdx].updateComposition(fs, phaseIdx);
+            }
+        }
+
+        for (size_t stateIdx = 0; stateIdx < numStates; ++stateIdx) {
+            FluidState& fs = fluidStates[stateIdx];
+            for (unsigned i = 0; i < numComponents; ++i) {
+                const Evaluation& phi = FluidSystem::fugacityCoefficient(fs, paramCaches[stateIdx], phaseIdx, i);
+                fs.setFugacityCoefficient(phaseIdx, i, phi);
+            }
+
+            const Evaluation& rho = FluidSystem::density(fs, paramCaches[stateIdx], phaseIdx);
+            fs.setDensity(phaseIdx, rho);
+        }
+    }
 
 protected:
     // update the phase composition in case the phase is an ideal
@@ -205,13 +380,13 @@ protected:
         return;
     }
 
-    template <class FluidState>
-    static Scalar linearize_(Dune::FieldMatrix<Evaluation, numComponents, numComponents>& J,
-                             Dune::FieldVector<Evaluation, numComponents>& defect,
+    template <class FluidState, class Eval>
+    static Scalar linearize_(Dune::FieldMatrix<Eval, numComponents, numComponents>& J,
+                             Dune::FieldVector<Eval, numComponents>& defect,
                              FluidState& fluidState,
                              typename FluidSystem::template ParameterCache<typename FluidState::Scalar>& paramCache,
                              unsigned phaseIdx,
-                             const ComponentVector& targetFug)
+                             const Dune::FieldVector<Eval, numComponents>& targetFug)
     {
         // reset jacobian
         J = 0;
@@ -220,11 +395,11 @@ protected:
         // calculate the defect (deviation of the current fugacities
         // from the target fugacities)
         for (unsigned i = 0; i < numComponents; ++ i) {
-            const Evaluation& phi = FluidSystem::fugacityCoefficient(fluidState,
+            const Eval& phi = FluidSystem::fugacityCoefficient(fluidState,
                                                           paramCache,
                                                           phaseIdx,
                                                           i);
-            const Evaluation& f = phi*fluidState.pressure(phaseIdx)*fluidState.moleFraction(phaseIdx, i);
+            const Eval& f = phi*fluidState.pressure(phaseIdx)*fluidState.moleFraction(phaseIdx, i);
             fluidState.setFugacityCoefficient(phaseIdx, i, phi);
 
             defect[i] = targetFug[i] - f;
@@ -241,7 +416,7 @@ protected:
             // forward differences
 
             // deviate the mole fraction of the i-th component
-            Evaluation xI = fluidState.moleFraction(phaseIdx, i);
+            Eval xI = fluidState.moleFraction(phaseIdx, i);
             fluidState.setMoleFraction(phaseIdx, i, xI + eps);
             paramCache.updateSingleMoleFraction(fluidState, phaseIdx, i);
 
@@ -249,17 +424,17 @@ protected:
             // fugacities
             for (unsigned j = 0; j < numComponents; ++j) {
                 // compute the j-th component's fugacity coefficient ...
-                const Evaluation& phi = FluidSystem::fugacityCoefficient(fluidState,
-                                                                         paramCache,
-                                                                         phaseIdx,
-                                                                         j);
+                const Eval& phi = FluidSystem::fugacityCoefficient(fluidState,
+                                                                   paramCache,
+                                                                   phaseIdx,
+                                                                   j);
                 // ... and its fugacity ...
-                const Evaluation& f =
+                const Eval& f =
                     phi *
                     fluidState.pressure(phaseIdx) *
                     fluidState.moleFraction(phaseIdx, j);
                 // as well as the defect for this fugacity
-                const Evaluation& defJPlusEps = targetFug[j] - f;
+                const Eval& defJPlusEps = targetFug[j] - f;
 
                 // use forward differences to calculate the defect's
                 // derivative
@@ -277,19 +452,49 @@ protected:
         return absError;
     }
 
-    template <class FluidState>
+    // calculate the Jacobian of the fugacity defect w.r.t. the mole fractions using
+    // automatic differentiation
+    template <class ScalarFluidState>
+    static void linearizeExact_(Dune::FieldMatrix<Scalar, numComponents, numComponents>& J,
+                                const ScalarFluidState& scalarState,
+                                unsigned phaseIdx)
+    {
+        typedef DenseAd::Evaluation<Scalar, numComponents> JacobianEval;
+        typedef Opm::CompositionalFluidState<JacobianEval, FluidSystem, /*storeEnthalpy=*/false> JacobianFluidState;
+
+        JacobianFluidState fluidState;
+        fluidState.setPressure(phaseIdx, scalarState.pressure(phaseIdx));
+        fluidState.setTemperature(scalarState.temperature(phaseIdx));
+        for (unsigned i = 0; i < numComponents; ++i)
+            fluidState.setMoleFraction(phaseIdx, i,
+                                       JacobianEval::createVariable(scalarState.moleFraction(phaseIdx, i), i));
+
+        typename FluidSystem::template ParameterCache<JacobianEval> paramCache;
+        paramCache.updatePhase(fluidState, phaseIdx);
+
+        // the target fugacities do not depend on the composition, so the derivatives
+        // of the defect are the negative ones of the fugacities
+        for (unsigned j = 0; j < numComponents; ++j) {
+            const JacobianEval& phi = FluidSystem::fugacityCoefficient(fluidState, paramCache, phaseIdx, j);
+            const JacobianEval& f = phi*fluidState.pressure(phaseIdx)*fluidState.moleFraction(phaseIdx, j);
+            for (unsigned i = 0; i < numComponents; ++i)
+                J[j][i] = -f.derivative(i);
+        }
+    }
+
+    template <class FluidState, class Eval>
     static Scalar update_(FluidState& fluidState,
                           typename FluidSystem::template ParameterCache<typename FluidState::Scalar>& paramCache,
-                          Dune::FieldVector<Evaluation, numComponents>& x,
-                          Dune::FieldVector<Evaluation, numComponents>& /*b*/,
+                          Dune::FieldVector<Eval, numComponents>& x,
+                          Dune::FieldVector<Eval, numComponents>& /*b*/,
                           unsigned phaseIdx,
-                          const Dune::FieldVector<Evaluation, numComponents>& targetFug)
+                          const Dune::FieldVector<Eval, numComponents>& targetFug)
     {
         // store original composition and calculate relative error
-        Dune::FieldVector<Evaluation, numComponents> origComp;
+        Dune::FieldVector<Eval, numComponents> origComp;
         Scalar relError = 0;
-        Evaluation sumDelta = 0.0;
-        Evaluation sumx = 0.0;
+        Eval sumDelta = 0.0;
+        Eval sumx = 0.0;
         for (unsigned i = 0; i < numComponents; ++i) {
             origComp[i] = fluidState.moleFraction(phaseIdx, i);
             relError = std::max(relError, std::abs(Opm::scalarValue(x[i])));
@@ -305,7 +510,7 @@ protected:
 
         // change composition
         for (unsigned i = 0; i < numComponents; ++i) {
-            Evaluation newx = origComp[i] - x[i];
+            Eval newx = origComp[i] - x[i];
             // only allow negative mole fractions if the target fugacity is negative
             if (targetFug[i] > 0)
                 newx = Opm::max(0.0, newx);
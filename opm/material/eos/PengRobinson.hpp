@@ -186,7 +186,11 @@ public:
         Valgrind::CheckDefined(a2);
         Valgrind::CheckDefined(a3);
         Valgrind::CheckDefined(a4);
-        int numSol = invertCubicPolynomial(Z, a1, a2, a3, a4);
+        // the roots are calculated from the values of the coefficients by the
+        // branch-free cubic solver, their derivatives are given by the implicit
+        // function theorem
+        unsigned numSol;
+        Opm::invertCubicPolynomials(1, &a1, &a2, &a3, &a4, Z, &numSol);
         if (numSol == 3) {
             // the EOS has three intersections with the pressure,
             // i.e. the molar volume of gas is the largest one and the
@@ -465,7 +469,14 @@ protected:
         // invert resulting cubic polynomial analytically
         Evaluation allV[4];
         allV[0] = V;
-        int numSol = 1 + Opm::invertCubicPolynomial<Evaluation>(allV + 1, b1, b2, b3, b4);
+        typedef typename Opm::MathToolbox<Evaluation>::Scalar ValueScalar;
+        ValueScalar cubicValues[3];
+        int numCubicSol = Opm::invertCubicPolynomial(cubicValues,
+                                                     Opm::scalarValue(b1), Opm::scalarValue(b2),
+                                                     Opm::scalarValue(b3), Opm::scalarValue(b4));
+        for (int i = 0; i < numCubicSol; ++i)
+            allV[i + 1] = Opm::cubicPolynomialRoot(cubicValues[i], b1, b2, b3, b4);
+        int numSol = 1 + numCubicSol;
 
         // sort all roots of the derivative
         std::sort(allV + 0, allV + numSol);
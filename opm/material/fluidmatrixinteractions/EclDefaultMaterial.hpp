@@ -28,6 +28,7 @@
 #define OPM_ECL_DEFAULT_MATERIAL_HPP
 
 #include "EclDefaultMaterialParams.hpp"
+#include "TwoPhaseSatAllHelper.hpp"
 
 #include <opm/material/common/Valgrind.hpp>
 #include <opm/material/common/MathToolbox.hpp>
@@ -311,9 +312,45 @@ public:
     {
         typedef typename std::remove_reference<decltype(values[0])>::type Evaluation;
 
-        values[waterPhaseIdx] = krw<FluidState, Evaluation>(params, fluidState);
-        values[oilPhaseIdx] = krn<FluidState, Evaluation>(params, fluidState);
-        values[gasPhaseIdx] = krg<FluidState, Evaluation>(params, fluidState);
+        const Scalar Swco = params.Swl();
+        const Evaluation Sw = Opm::decay<Evaluation>(fluidState.saturation(waterPhaseIdx));
+        const Evaluation Sg = Opm::decay<Evaluation>(fluidState.saturation(gasPhaseIdx));
+
+        const Evaluation SwMax = Opm::max(Evaluation(Swco), Sw);
+        const Evaluation Sw_ow = Sg + SwMax;
+        const Evaluation So_go = 1.0 - Sw_ow;
+        const Evaluation Sw_go = 1.0 - Swco - Sg;
+
+        // the curves of a two-phase system can only share a table lookup if they are
+        // evaluated at the same saturation. This is the case for the oil-water system
+        // without free gas and for the gas-oil system at or below connate water.
+        Evaluation krw;
+        Evaluation kro_ow;
+        if (Sw_ow == Sw) {
+            Evaluation pcow;
+            TwoPhaseSatAllHelper<OilWaterMaterialLaw>::eval(params.oilWaterParams(), Sw,
+                                                            krw, kro_ow, pcow);
+        }
+        else {
+            krw = OilWaterMaterialLaw::twoPhaseSatKrw(params.oilWaterParams(), Sw);
+            kro_ow = OilWaterMaterialLaw::twoPhaseSatKrn(params.oilWaterParams(), Sw_ow);
+        }
+
+        Evaluation kro_go;
+        Evaluation krg;
+        if (So_go == Sw_go) {
+            Evaluation pcgo;
+            TwoPhaseSatAllHelper<GasOilMaterialLaw>::eval(params.gasOilParams(), Sw_go,
+                                                          kro_go, krg, pcgo);
+        }
+        else {
+            kro_go = GasOilMaterialLaw::twoPhaseSatKrw(params.gasOilParams(), So_go);
+            krg = GasOilMaterialLaw::twoPhaseSatKrn(params.gasOilParams(), Sw_go);
+        }
+
+        values[waterPhaseIdx] = krw;
+        values[oilPhaseIdx] = krnFromTwoPhase_(params, SwMax, Sg, kro_ow, kro_go);
+        values[gasPhaseIdx] = krg;
     }
 
     /*!
@@ -359,22 +396,7 @@ public:
         const Evaluation kro_ow = OilWaterMaterialLaw::twoPhaseSatKrn(params.oilWaterParams(), Sw_ow);
         const Evaluation kro_go = GasOilMaterialLaw::twoPhaseSatKrw(params.gasOilParams(), So_go);
 
-        // avoid the division by zero: chose a regularized kro which is used if Sw - Swco
-        // < epsilon/2 and interpolate between the oridinary and the regularized kro between
-        // epsilon and epsilon/2
-        const Scalar epsilon = 1e-5;
-        if (Opm::scalarValue(Sw_ow) - Swco < epsilon) {
-            const Evaluation kro2 = (kro_ow + kro_go)/2;;
-            if (Opm::scalarValue(Sw_ow) - Swco > epsilon/2) {
-                const Evaluation kro1 = (Sg*kro_go + (Sw - Swco)*kro_ow)/(Sw_ow - Swco);
-                const Evaluation alpha = (epsilon - (Sw_ow - Swco))/(epsilon/2);
-                return kro2*alpha + kro1*(1 - alpha);
-            }
-
-            return kro2;
-        }
-        else
-            return (Sg*kro_go + (Sw - Swco)*kro_ow)/(Sw_ow - Swco);
+        return krnFromTwoPhase_(params, Sw, Sg, kro_ow, kro_go);
     }
 
     /*!
@@ -431,6 +453,37 @@ public:
         const auto sat = Opm::scalarValue(fluidState.saturation(phaseIndex));
         return std::clamp(sat, Scalar{0.0}, Scalar{1.0});
     }
+
+private:
+    // combine the oil relative permeabilities of the two two-phase systems. Sw is the
+    // water saturation limited to connate water.
+    template <class Evaluation>
+    static Evaluation krnFromTwoPhase_(const Params& params,
+                                       const Evaluation& Sw,
+                                       const Evaluation& Sg,
+                                       const Evaluation& kro_ow,
+                                       const Evaluation& kro_go)
+    {
+        const Scalar Swco = params.Swl();
+        const Evaluation Sw_ow = Sg + Sw;
+
+        // avoid the division by zero: chose a regularized kro which is used if Sw - Swco
+        // < epsilon/2 and interpolate between the oridinary and the regularized kro between
+        // epsilon and epsilon/2
+        const Scalar epsilon = 1e-5;
+        if (Opm::scalarValue(Sw_ow) - Swco < epsilon) {
+            const Evaluation kro2 = (kro_ow + kro_go)/2;;
+            if (Opm::scalarValue(Sw_ow) - Swco > epsilon/2) {
+                const Evaluation kro1 = (Sg*kro_go + (Sw - Swco)*kro_ow)/(Sw_ow - Swco);
+                const Evaluation alpha = (epsilon - (Sw_ow - Swco))/(epsilon/2);
+                return kro2*alpha + kro1*(1 - alpha);
+            }
+
+            return kro2;
+        }
+        else
+            return (Sg*kro_go + (Sw - Swco)*kro_ow)/(Sw_ow - Swco);
+    }
 };
 } // namespace Opm
 
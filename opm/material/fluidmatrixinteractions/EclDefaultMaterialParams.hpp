@@ -129,6 +129,17 @@ public:
     bool inconsistentHysteresisUpdate() const
     { return true; }
 
+    template <class Serializer>
+    void serializeOp(Serializer& serializer)
+    {
+        serializer(gasOilParams_);
+        serializer(oilWaterParams_);
+        serializer(Swl_);
+
+        if (serializer.isLoading())
+            EnsureFinalized::finalize();
+    }
+
 private:
     std::shared_ptr<GasOilParams> gasOilParams_;
     std::shared_ptr<OilWaterParams> oilWaterParams_;
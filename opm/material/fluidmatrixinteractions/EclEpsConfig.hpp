@@ -261,6 +261,19 @@ public:
     }
 #endif
 
+    template <class Serializer>
+    void serializeOp(Serializer& serializer)
+    {
+        serializer(enableSatScaling_);
+        serializer(enableThreePointKrSatScaling_);
+        serializer(enablePcScaling_);
+        serializer(enableLeverettScaling_);
+        serializer(enableKrwScaling_);
+        serializer(enableKrnScaling_);
+        serializer(enableThreePointKrwScaling_);
+        serializer(enableThreePointKrnScaling_);
+    }
+
 private:
     // enable scaling of the input saturations (i.e., rescale the x-Axis)
     bool enableSatScaling_;
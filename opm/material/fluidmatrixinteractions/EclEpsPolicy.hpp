@@ -0,0 +1,200 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+
+  Consult the COPYING file in the top-level source directory of this
+  module for the precise wording of the license and the list of
+  copyright holders.
+*/
+/*!
+ * \file
+ * \brief Policies which determine how EclEpsTwoPhaseLaw decides which quantities
+ *        are scaled.
+ */
+#ifndef OPM_ECL_EPS_POLICY_HPP
+#define OPM_ECL_EPS_POLICY_HPP
+
+#include "EclEpsConfig.hpp"
+
+namespace Opm {
+/*!
+ * \ingroup FluidMatrixInteractions
+ *
+ * \brief The endpoint scaling policy which queries the EclEpsConfig object of the
+ *        parameters for every decision.
+ *
+ * This is the default policy of EclEpsTwoPhaseLaw and supports all configurations.
+ */
+class EclEpsDynamicPolicy
+{
+public:
+    static bool isCompatible(const EclEpsConfig& /*config*/)
+    { return true; }
+
+    static bool enableSatScaling(const EclEpsConfig& config)
+    { return config.enableSatScaling(); }
+
+    static bool enableThreePointKrSatScaling(const EclEpsConfig& config)
+    { return config.enableThreePointKrSatScaling(); }
+
+    static bool enablePcScaling(const EclEpsConfig& config)
+    { return config.enablePcScaling(); }
+
+    static bool enableLeverettScaling(const EclEpsConfig& config)
+    { return config.enableLeverettScaling(); }
+
+    static bool enableKrwScaling(const EclEpsConfig& config)
+    { return config.enableKrwScaling(); }
+
+    static bool enableThreePointKrwScaling(const EclEpsConfig& config)
+    { return config.enableThreePointKrwScaling(); }
+
+    static bool enableKrnScaling(const EclEpsConfig& config)
+    { return config.enableKrnScaling(); }
+
+    static bool enableThreePointKrnScaling(const EclEpsConfig& config)
+    { return config.enableThreePointKrnScaling(); }
+};
+
+/*!
+ * \brief Specifies how the saturations are scaled by an EclEpsStaticPolicy.
+ */
+enum class EclEpsSatScalingType {
+    None,
+    TwoPoint,
+    ThreePoint
+};
+
+/*!
+ * \ingroup FluidMatrixInteractions
+ *
+ * \brief An endpoint scaling policy for which the kind of saturation scaling and
+ *        whether any vertical scaling happens is fixed at compile time.
+ *
+ * If vertical scaling is disabled, the scaled relative permeabilities and capillary
+ * pressures are the unscaled ones and all branches related to them vanish. If it is
+ * enabled, the details of the vertical scaling are still taken from the
+ * EclEpsConfig object. A policy must only be used for configurations for which
+ * isCompatible() returns true; use eclEpsVisitPolicy() to pick one.
+ *
+ * The policy only selects the code path. The parameter objects still refer to
+ * complete EclEpsScalingPoints records whatever the policy is, i.e., the end points
+ * which the policy does not look at are stored anyway. EclMaterialLawManager keeps
+ * the memory required for these records small by sharing them between all elements
+ * which exhibit the same end points.
+ */
+template <EclEpsSatScalingType satScalingType, bool enableVerticalScaling>
+class EclEpsStaticPolicy
+{
+public:
+    static bool isCompatible(const EclEpsConfig& config)
+    {
+        if (enableSatScaling(config) != config.enableSatScaling())
+            return false;
+        if (enableSatScaling(config)
+            && enableThreePointKrSatScaling(config) != config.enableThreePointKrSatScaling())
+            return false;
+
+        return enableVerticalScaling || !hasVerticalScaling_(config);
+    }
+
+    static constexpr bool enableSatScaling(const EclEpsConfig& /*config*/)
+    { return satScalingType != EclEpsSatScalingType::None; }
+
+    static constexpr bool enableThreePointKrSatScaling(const EclEpsConfig& /*config*/)
+    { return satScalingType == EclEpsSatScalingType::ThreePoint; }
+
+    static bool enablePcScaling(const EclEpsConfig& config)
+    { return enableVerticalScaling && config.enablePcScaling(); }
+
+    static bool enableLeverettScaling(const EclEpsConfig& config)
+    { return enableVerticalScaling && config.enableLeverettScaling(); }
+
+    static bool enableKrwScaling(const EclEpsConfig& config)
+    { return enableVerticalScaling && config.enableKrwScaling(); }
+
+    static bool enableThreePointKrwScaling(const EclEpsConfig& config)
+    { return enableVerticalScaling && config.enableThreePointKrwScaling(); }
+
+    static bool enableKrnScaling(const EclEpsConfig& config)
+    { return enableVerticalScaling && config.enableKrnScaling(); }
+
+    static bool enableThreePointKrnScaling(const EclEpsConfig& config)
+    { return enableVerticalScaling && config.enableThreePointKrnScaling(); }
+
+private:
+    static bool hasVerticalScaling_(const EclEpsConfig& config)
+    {
+        return
+            config.enablePcScaling()
+            || config.enableLeverettScaling()
+            || config.enableKrwScaling()
+            || config.enableKrnScaling();
+    }
+};
+
+/*!
+ * \brief Call a visitor with the most specialized endpoint scaling policy which is
+ *        compatible with two given configurations.
+ *
+ * The visitor is called with a default constructed object of the policy class, i.e.,
+ * it must provide an <tt>operator()</tt> which is templated on the policy
+ * type. Typically, this is used to select the instantiation of a simulator's
+ * material law once after the deck has been read, e.g., for the gas-oil and the
+ * oil-water configurations of EclMaterialLawManager.
+ */
+template <class Visitor>
+void eclEpsVisitPolicy(const EclEpsConfig& config1,
+                       const EclEpsConfig& config2,
+                       Visitor& visitor)
+{
+    typedef EclEpsStaticPolicy<EclEpsSatScalingType::None, false> NoScalingPolicy;
+    typedef EclEpsStaticPolicy<EclEpsSatScalingType::None, true> VerticalOnlyPolicy;
+    typedef EclEpsStaticPolicy<EclEpsSatScalingType::TwoPoint, false> TwoPointPolicy;
+    typedef EclEpsStaticPolicy<EclEpsSatScalingType::TwoPoint, true> TwoPointVerticalPolicy;
+    typedef EclEpsStaticPolicy<EclEpsSatScalingType::ThreePoint, false> ThreePointPolicy;
+    typedef EclEpsStaticPolicy<EclEpsSatScalingType::ThreePoint, true> ThreePointVerticalPolicy;
+
+    if (NoScalingPolicy::isCompatible(config1) && NoScalingPolicy::isCompatible(config2))
+        visitor(NoScalingPolicy());
+    else if (VerticalOnlyPolicy::isCompatible(config1) && VerticalOnlyPolicy::isCompatible(config2))
+        visitor(VerticalOnlyPolicy());
+    else if (TwoPointPolicy::isCompatible(config1) && TwoPointPolicy::isCompatible(config2))
+        visitor(TwoPointPolicy());
+    else if (TwoPointVerticalPolicy::isCompatible(config1) && TwoPointVerticalPolicy::isCompatible(config2))
+        visitor(TwoPointVerticalPolicy());
+    else if (ThreePointPolicy::isCompatible(config1) && ThreePointPolicy::isCompatible(config2))
+        visitor(ThreePointPolicy());
+    else if (ThreePointVerticalPolicy::isCompatible(config1) && ThreePointVerticalPolicy::isCompatible(config2))
+        visitor(ThreePointVerticalPolicy());
+    else
+        visitor(EclEpsDynamicPolicy());
+}
+
+/*!
+ * \brief Call a visitor with the most specialized endpoint scaling policy which is
+ *        compatible with a given configuration.
+ *
+ * See the variant of this function for two configurations for details.
+ */
+template <class Visitor>
+void eclEpsVisitPolicy(const EclEpsConfig& config, Visitor& visitor)
+{ eclEpsVisitPolicy(config, config, visitor); }
+
+} // namespace Opm
+
+#endif
@@ -119,6 +119,31 @@ struct EclEpsScalingPointsInfo
                maxKrg == data.maxKrg;
     }
 
+    template <class Serializer>
+    void serializeOp(Serializer& serializer)
+    {
+        serializer(Swl);
+        serializer(Sgl);
+        serializer(Swcr);
+        serializer(Sgcr);
+        serializer(Sowcr);
+        serializer(Sogcr);
+        serializer(Swu);
+        serializer(Sgu);
+        serializer(maxPcow);
+        serializer(maxPcgo);
+        serializer(pcowLeverettFactor);
+        serializer(pcgoLeverettFactor);
+        serializer(Krwr);
+        serializer(Krgr);
+        serializer(Krorw);
+        serializer(Krorg);
+        serializer(maxKrw);
+        serializer(maxKrow);
+        serializer(maxKrog);
+        serializer(maxKrg);
+    }
+
     void print() const
     {
         std::cout << "    Swl: " << Swl << '\n'
@@ -497,6 +522,19 @@ public:
                   << "    saturationKrnPoints_[2]: " << saturationKrnPoints_[2] << "\n";
     }
 
+    template <class Serializer>
+    void serializeOp(Serializer& serializer)
+    {
+        serializer(maxPcnwOrLeverettFactor_);
+        serializer(maxKrw_);
+        serializer(Krwr_);
+        serializer(maxKrn_);
+        serializer(Krnr_);
+        serializer(saturationPcPoints_);
+        serializer(saturationKrwPoints_);
+        serializer(saturationKrnPoints_);
+    }
+
 private:
     // Points used for vertical scaling of capillary pressure
     Scalar maxPcnwOrLeverettFactor_;
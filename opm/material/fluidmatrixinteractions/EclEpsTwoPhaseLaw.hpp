@@ -28,6 +28,8 @@
 #define OPM_ECL_EPS_TWO_PHASE_LAW_HPP
 
 #include "EclEpsTwoPhaseLawParams.hpp"
+#include "EclEpsPolicy.hpp"
+#include "TwoPhaseSatAllHelper.hpp"
 
 #include <opm/material/fluidstates/SaturationOverlayFluidState.hpp>
 
@@ -46,9 +48,16 @@ namespace Opm {
  * and produce unscaled quantities. This class implements the "impedance adaption" layer
  * between the two worlds. The basic purpose of it is thus the same as the one of \a
  * EffToAbsLaw, but it is quite a bit more complex.
+ *
+ * Which quantities get scaled is decided by the policy class. The default policy
+ * queries the configuration object of the parameters for each of these decisions,
+ * whereas EclEpsStaticPolicy fixes the kind of saturation scaling at compile time so
+ * that the corresponding branches are removed by the compiler. (See
+ * eclEpsVisitPolicy() for how to select a policy which matches a configuration.)
  */
 template <class EffLawT,
-          class ParamsT = EclEpsTwoPhaseLawParams<EffLawT> >
+          class ParamsT = EclEpsTwoPhaseLawParams<EffLawT>,
+          class PolicyT = EclEpsDynamicPolicy>
 class EclEpsTwoPhaseLaw : public EffLawT::Traits
 {
     typedef EffLawT EffLaw;
@@ -56,6 +65,7 @@ class EclEpsTwoPhaseLaw : public EffLawT::Traits
 public:
     typedef typename EffLaw::Traits Traits;
     typedef ParamsT Params;
+    typedef PolicyT Policy;
     typedef typename EffLaw::Scalar Scalar;
 
     enum { wettingPhaseIdx = Traits::wettingPhaseIdx };
@@ -261,6 +271,38 @@ public:
         return unscaledToScaledSatKrn(params, SwUnscaled);
     }
 
+    /*!
+     * \brief The relative permeabilities and the capillary pressure for a given
+     *        wetting phase saturation.
+     *
+     * Without saturation scaling, all quantities are evaluated at the same unscaled
+     * saturation, so the effective law can look them up at once.
+     */
+    template <class Evaluation>
+    static void twoPhaseSatAll(const Params& params,
+                               const Evaluation& SwScaled,
+                               Evaluation& krw,
+                               Evaluation& krn,
+                               Evaluation& pcnw)
+    {
+        if (Policy::enableSatScaling(params.config())) {
+            krw = twoPhaseSatKrw(params, SwScaled);
+            krn = twoPhaseSatKrn(params, SwScaled);
+            pcnw = twoPhaseSatPcnw(params, SwScaled);
+            return;
+        }
+
+        Evaluation krwUnscaled;
+        Evaluation krnUnscaled;
+        Evaluation pcnwUnscaled;
+        TwoPhaseSatAllHelper<EffLaw>::eval(params.effectiveLawParams(), SwScaled,
+                                           krwUnscaled, krnUnscaled, pcnwUnscaled);
+
+        krw = unscaledToScaledKrw_(SwScaled, params, krwUnscaled);
+        krn = unscaledToScaledKrn_(SwScaled, params, krnUnscaled);
+        pcnw = unscaledToScaledPcnw_(params, pcnwUnscaled);
+    }
+
     /*!
      * \brief Convert an absolute saturation to an effective one for capillary pressure.
      *
@@ -269,7 +311,7 @@ public:
     template <class Evaluation>
     static Evaluation scaledToUnscaledSatPc(const Params& params, const Evaluation& SwScaled)
     {
-        if (!params.config().enableSatScaling())
+        if (!Policy::enableSatScaling(params.config()))
             return SwScaled;
 
         // the saturations of capillary pressure are always scaled using two-point
@@ -282,7 +324,7 @@ public:
     template <class Evaluation>
     static Evaluation unscaledToScaledSatPc(const Params& params, const Evaluation& SwUnscaled)
     {
-        if (!params.config().enableSatScaling())
+        if (!Policy::enableSatScaling(params.config()))
             return SwUnscaled;
 
         // the saturations of capillary pressure are always scaled using two-point
@@ -299,10 +341,10 @@ public:
     template <class Evaluation>
     static Evaluation scaledToUnscaledSatKrw(const Params& params, const Evaluation& SwScaled)
     {
-        if (!params.config().enableSatScaling())
+        if (!Policy::enableSatScaling(params.config()))
             return SwScaled;
 
-        if (params.config().enableThreePointKrSatScaling()) {
+        if (Policy::enableThreePointKrSatScaling(params.config())) {
             return scaledToUnscaledSatThreePoint_(SwScaled,
                                                   params.unscaledPoints().saturationKrwPoints(),
                                                   params.scaledPoints().saturationKrwPoints());
@@ -317,10 +359,10 @@ public:
     template <class Evaluation>
     static Evaluation unscaledToScaledSatKrw(const Params& params, const Evaluation& SwUnscaled)
     {
-        if (!params.config().enableSatScaling())
+        if (!Policy::enableSatScaling(params.config()))
             return SwUnscaled;
 
-        if (params.config().enableThreePointKrSatScaling()) {
+        if (Policy::enableThreePointKrSatScaling(params.config())) {
             return unscaledToScaledSatThreePoint_(SwUnscaled,
                                                   params.unscaledPoints().saturationKrwPoints(),
                                                   params.scaledPoints().saturationKrwPoints());
@@ -339,10 +381,10 @@ public:
     template <class Evaluation>
     static Evaluation scaledToUnscaledSatKrn(const Params& params, const Evaluation& SwScaled)
     {
-        if (!params.config().enableSatScaling())
+        if (!Policy::enableSatScaling(params.config()))
             return SwScaled;
 
-        if (params.config().enableThreePointKrSatScaling())
+        if (Policy::enableThreePointKrSatScaling(params.config()))
             return scaledToUnscaledSatThreePoint_(SwScaled,
                                                   params.unscaledPoints().saturationKrnPoints(),
                                                   params.scaledPoints().saturationKrnPoints());
@@ -356,10 +398,10 @@ public:
     template <class Evaluation>
     static Evaluation unscaledToScaledSatKrn(const Params& params, const Evaluation& SwUnscaled)
     {
-        if (!params.config().enableSatScaling())
+        if (!Policy::enableSatScaling(params.config()))
             return SwUnscaled;
 
-        if (params.config().enableThreePointKrSatScaling()) {
+        if (Policy::enableThreePointKrSatScaling(params.config())) {
             return unscaledToScaledSatThreePoint_(SwUnscaled,
                                                   params.unscaledPoints().saturationKrnPoints(),
                                                   params.scaledPoints().saturationKrnPoints());
@@ -477,11 +519,11 @@ private:
     template <class Evaluation>
     static Evaluation unscaledToScaledPcnw_(const Params& params, const Evaluation& unscaledPcnw)
     {
-        if (params.config().enableLeverettScaling()) {
+        if (Policy::enableLeverettScaling(params.config())) {
             Scalar alpha = params.scaledPoints().leverettFactor();
             return unscaledPcnw*alpha;
         }
-        else if (params.config().enablePcScaling()) {
+        else if (Policy::enablePcScaling(params.config())) {
             Scalar alpha = params.scaledPoints().maxPcnw()/params.unscaledPoints().maxPcnw();
             return unscaledPcnw*alpha;
         }
@@ -492,11 +534,11 @@ private:
     template <class Evaluation>
     static Evaluation scaledToUnscaledPcnw_(const Params& params, const Evaluation& scaledPcnw)
     {
-        if (params.config().enableLeverettScaling()) {
+        if (Policy::enableLeverettScaling(params.config())) {
             Scalar alpha = params.scaledPoints().leverettFactor();
             return scaledPcnw/alpha;
         }
-        else if (params.config().enablePcScaling()) {
+        else if (Policy::enablePcScaling(params.config())) {
             Scalar alpha = params.unscaledPoints().maxPcnw()/params.scaledPoints().maxPcnw();
             return scaledPcnw/alpha;
         }
@@ -514,13 +556,13 @@ private:
     {
         const auto& cfg = params.config();
 
-        if (! cfg.enableKrwScaling())
+        if (! Policy::enableKrwScaling(cfg))
             return unscaledKrw;
 
         const auto& scaled   = params.scaledPoints();
         const auto& unscaled = params.unscaledPoints();
 
-        if (! cfg.enableThreePointKrwScaling()) {
+        if (! Policy::enableThreePointKrwScaling(cfg)) {
             // Simple case: Run uses pure vertical scaling of water relperm (keyword KRW)
             const Scalar alpha = scaled.maxKrw() / unscaled.maxKrw();
             return unscaledKrw * alpha;
@@ -570,7 +612,7 @@ private:
     template <class Evaluation>
     static Evaluation scaledToUnscaledKrw_(const Params& params, const Evaluation& scaledKrw)
     {
-        if (!params.config().enableKrwScaling())
+        if (!Policy::enableKrwScaling(params.config()))
             return scaledKrw;
 
         Scalar alpha = params.unscaledPoints().maxKrw()/params.scaledPoints().maxKrw();
@@ -587,13 +629,13 @@ private:
     {
         const auto& cfg = params.config();
 
-        if (! cfg.enableKrnScaling())
+        if (! Policy::enableKrnScaling(cfg))
             return unscaledKrn;
 
         const auto& scaled = params.scaledPoints();
         const auto& unscaled = params.unscaledPoints();
 
-        if (! cfg.enableThreePointKrnScaling()) {
+        if (! Policy::enableThreePointKrnScaling(cfg)) {
             // Simple case: Run uses pure vertical scaling of non-wetting
             // phase's relative permeability (e.g., KRG)
             const Scalar alpha = scaled.maxKrn() / unscaled.maxKrn();
@@ -648,7 +690,7 @@ private:
     template <class Evaluation>
     static Evaluation scaledToUnscaledKrn_(const Params& params, const Evaluation& scaledKrn)
     {
-        if (!params.config().enableKrnScaling())
+        if (!Policy::enableKrnScaling(params.config()))
             return scaledKrn;
 
         Scalar alpha = params.unscaledPoints().maxKrn()/params.scaledPoints().maxKrn();
@@ -60,6 +60,7 @@ public:
     typedef Opm::EclEpsScalingPoints<Scalar> ScalingPoints;
 
     EclEpsTwoPhaseLawParams()
+        : ownsScaledPoints_(false)
     {
     }
 
@@ -73,6 +74,7 @@ public:
         assert(config_);
         if (config_->enableSatScaling()) {
             assert(unscaledPoints_);
+            assert(scaledPoints_);
         }
         assert(effectiveLawParams_);
 #endif
@@ -105,21 +107,39 @@ public:
 
     /*!
      * \brief Set the scaling points which are seen by the physical model
+     *
+     * The object may be shared with other parameter objects. To modify the scaling
+     * points of a single parameter object, a new object must be set.
      */
-    void setScaledPoints(std::shared_ptr<ScalingPoints> value)
-    { scaledPoints_ = *value; }
+    void setScaledPoints(std::shared_ptr<const ScalingPoints> value)
+    {
+        scaledPoints_ = value;
+        ownsScaledPoints_ = false;
+    }
 
     /*!
      * \brief Returns the scaling points which are seen by the physical model
      */
     const ScalingPoints& scaledPoints() const
-    { return scaledPoints_; }
+    { return *scaledPoints_; }
 
     /*!
-     * \brief Returns the scaling points which are seen by the physical model
+     * \brief Returns the scaling points which are seen by the physical model for
+     *        modification
+     *
+     * If the object is shared with other parameter objects or if it was not created by
+     * this method, the parameter object gets its own copy first.
      */
     ScalingPoints& scaledPoints()
-    { return scaledPoints_; }
+    {
+        if (!ownsScaledPoints_ || scaledPoints_.use_count() > 1) {
+            scaledPoints_ = std::make_shared<ScalingPoints>(*scaledPoints_);
+            ownsScaledPoints_ = true;
+        }
+
+        // the object has been created as non-const above and nobody else refers to it
+        return const_cast<ScalingPoints&>(*scaledPoints_);
+    }
 
     /*!
      * \brief Sets the parameter object for the effective/nested material law.
@@ -133,12 +153,29 @@ public:
     const EffLawParams& effectiveLawParams() const
     { return *effectiveLawParams_; }
 
+    template <class Serializer>
+    void serializeOp(Serializer& serializer)
+    {
+        serializer(effectiveLawParams_);
+        serializer(config_);
+        serializer(unscaledPoints_);
+        serializer(scaledPoints_);
+
+        if (serializer.isLoading()) {
+            ownsScaledPoints_ = false;
+            EnsureFinalized::finalize();
+        }
+    }
+
 private:
     std::shared_ptr<EffLawParams> effectiveLawParams_;
 
     std::shared_ptr<EclEpsConfig> config_;
     std::shared_ptr<ScalingPoints> unscaledPoints_;
-    ScalingPoints scaledPoints_;
+    std::shared_ptr<const ScalingPoints> scaledPoints_;
+
+    // true iff scaledPoints_ has been created by the non-const scaledPoints() method
+    bool ownsScaledPoints_;
 };
 
 } // namespace Opm
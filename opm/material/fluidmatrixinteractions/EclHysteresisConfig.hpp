@@ -125,6 +125,14 @@ public:
     }
 #endif
 
+    template <class Serializer>
+    void serializeOp(Serializer& serializer)
+    {
+        serializer(enableHysteresis_);
+        serializer(pcHysteresisModel_);
+        serializer(krHysteresisModel_);
+    }
+
 private:
     // enable hysteresis at all
     bool enableHysteresis_;
@@ -0,0 +1,136 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+
+  Consult the COPYING file in the top-level source directory of this
+  module for the precise wording of the license and the list of
+  copyright holders.
+*/
+/*!
+ * \file
+ * \brief Policies which determine how EclHysteresisTwoPhaseLaw decides which
+ *        curves are used.
+ */
+#ifndef OPM_ECL_HYSTERESIS_POLICY_HPP
+#define OPM_ECL_HYSTERESIS_POLICY_HPP
+
+#include "EclHysteresisConfig.hpp"
+
+namespace Opm {
+/*!
+ * \ingroup FluidMatrixInteractions
+ *
+ * \brief The hysteresis policy which queries the EclHysteresisConfig object of the
+ *        parameters for every evaluation.
+ *
+ * This is the default policy of EclHysteresisTwoPhaseLaw and supports all
+ * configurations.
+ */
+class EclHysteresisDynamicPolicy
+{
+public:
+    static bool isCompatible(const EclHysteresisConfig& /*config*/)
+    { return true; }
+
+    static bool enableKrHysteresis(const EclHysteresisConfig& config)
+    { return config.enableHysteresis() && config.krHysteresisModel() >= 0; }
+
+    static bool enableImbibitionKrw(const EclHysteresisConfig& config)
+    { return config.krHysteresisModel() != 0; }
+};
+
+/*!
+ * \brief Specifies the relative permeability hysteresis of an
+ *        EclHysteresisStaticPolicy.
+ *
+ * The values correspond to the relative permeability hysteresis models of the
+ * EHYSTR keyword which are implemented by EclHysteresisTwoPhaseLaw.
+ */
+enum class EclKrHysteresisType {
+    //! Only the drainage curves are used
+    None,
+    //! Carlson's model for the non-wetting phase, the drainage curve for the wetting
+    //! phase (model 0)
+    Carlson,
+    //! Carlson's model for the non-wetting phase, the imbibition curve for the
+    //! wetting phase (model 1)
+    CarlsonImbibitionKrw
+};
+
+/*!
+ * \ingroup FluidMatrixInteractions
+ *
+ * \brief A hysteresis policy for which the relative permeability hysteresis model is
+ *        fixed at compile time.
+ *
+ * With EclKrHysteresisType::None, the material law reduces to the drainage curves
+ * without consulting the configuration object at all. A policy must only be used for
+ * configurations for which isCompatible() returns true; use eclHysteresisVisitPolicy()
+ * to pick one.
+ */
+template <EclKrHysteresisType krHysteresisType>
+class EclHysteresisStaticPolicy
+{
+public:
+    static bool isCompatible(const EclHysteresisConfig& config)
+    {
+        if (!config.enableHysteresis() || config.krHysteresisModel() < 0)
+            return krHysteresisType == EclKrHysteresisType::None;
+        if (config.krHysteresisModel() == 0)
+            return krHysteresisType == EclKrHysteresisType::Carlson;
+        if (config.krHysteresisModel() == 1)
+            return krHysteresisType == EclKrHysteresisType::CarlsonImbibitionKrw;
+
+        return false;
+    }
+
+    static constexpr bool enableKrHysteresis(const EclHysteresisConfig& /*config*/)
+    { return krHysteresisType != EclKrHysteresisType::None; }
+
+    static constexpr bool enableImbibitionKrw(const EclHysteresisConfig& /*config*/)
+    { return krHysteresisType == EclKrHysteresisType::CarlsonImbibitionKrw; }
+};
+
+/*!
+ * \brief Call a visitor with the hysteresis policy which is compatible with a given
+ *        configuration.
+ *
+ * The visitor is called with a default constructed object of the policy class, i.e.,
+ * it must provide an <tt>operator()</tt> which is templated on the policy
+ * type. Typically, this is used to select the instantiation of a simulator's
+ * material law once after the deck has been read.
+ */
+template <class Visitor>
+void eclHysteresisVisitPolicy(const EclHysteresisConfig& config, Visitor& visitor)
+{
+    typedef EclHysteresisStaticPolicy<EclKrHysteresisType::None> NoHysteresisPolicy;
+    typedef EclHysteresisStaticPolicy<EclKrHysteresisType::Carlson> CarlsonPolicy;
+    typedef EclHysteresisStaticPolicy<EclKrHysteresisType::CarlsonImbibitionKrw> CarlsonImbibitionKrwPolicy;
+
+    if (NoHysteresisPolicy::isCompatible(config))
+        visitor(NoHysteresisPolicy());
+    else if (CarlsonPolicy::isCompatible(config))
+        visitor(CarlsonPolicy());
+    else if (CarlsonImbibitionKrwPolicy::isCompatible(config))
+        visitor(CarlsonImbibitionKrwPolicy());
+    else
+        visitor(EclHysteresisDynamicPolicy());
+}
+
+} // namespace Opm
+
+#endif
@@ -28,15 +28,25 @@
 #define OPM_ECL_HYSTERESIS_TWO_PHASE_LAW_HPP
 
 #include "EclHysteresisTwoPhaseLawParams.hpp"
+#include "EclHysteresisPolicy.hpp"
+#include "TwoPhaseSatAllHelper.hpp"
 
 namespace Opm {
 /*!
  * \ingroup FluidMatrixInteractions
  *
  * \brief This material law implements the hysteresis model of the ECL file format
+ *
+ * Which curves are used is decided by the policy class. The default policy queries
+ * the configuration object of the parameters for each evaluation, whereas
+ * EclHysteresisStaticPolicy fixes the relative permeability hysteresis model at
+ * compile time so that the corresponding branches are removed by the compiler. (See
+ * eclHysteresisVisitPolicy() for how to select a policy which matches a
+ * configuration.)
  */
 template <class EffectiveLawT,
-          class ParamsT = EclHysteresisTwoPhaseLawParams<EffectiveLawT> >
+          class ParamsT = EclHysteresisTwoPhaseLawParams<EffectiveLawT>,
+          class PolicyT = EclHysteresisDynamicPolicy>
 class EclHysteresisTwoPhaseLaw : public EffectiveLawT::Traits
 {
 public:
@@ -45,6 +55,7 @@ public:
 
     typedef typename EffectiveLaw::Traits Traits;
     typedef ParamsT Params;
+    typedef PolicyT Policy;
     typedef typename EffectiveLaw::Scalar Scalar;
 
     enum { wettingPhaseIdx = Traits::wettingPhaseIdx };
@@ -228,10 +239,10 @@ public:
     static Evaluation twoPhaseSatKrw(const Params& params, const Evaluation& Sw)
     {
         // if no relperm hysteresis is enabled, use the drainage curve
-        if (!params.config().enableHysteresis() || params.config().krHysteresisModel() < 0)
+        if (!Policy::enableKrHysteresis(params.config()))
             return EffectiveLaw::twoPhaseSatKrw(params.drainageParams(), Sw);
 
-        if (params.config().krHysteresisModel() == 0)
+        if (!Policy::enableImbibitionKrw(params.config()))
             // use drainage curve for wetting phase
             return EffectiveLaw::twoPhaseSatKrw(params.drainageParams(), Sw);
 
@@ -254,7 +265,7 @@ public:
     static Evaluation twoPhaseSatKrn(const Params& params, const Evaluation& Sw)
     {
         // if no relperm hysteresis is enabled, use the drainage curve
-        if (!params.config().enableHysteresis() || params.config().krHysteresisModel() < 0)
+        if (!Policy::enableKrHysteresis(params.config()))
             return EffectiveLaw::twoPhaseSatKrn(params.drainageParams(), Sw);
 
         // if it is enabled, use either the drainage or the imbibition curve. if the
@@ -265,6 +276,30 @@ public:
         return EffectiveLaw::twoPhaseSatKrn(params.imbibitionParams(),
                                             Sw + params.deltaSwImbKrn());
     }
+
+    /*!
+     * \brief The relative permeabilities and the capillary pressure for a given
+     *        wetting phase saturation.
+     *
+     * If hysteresis is disabled, all quantities come from the drainage curves and
+     * can be looked up at once.
+     */
+    template <class Evaluation>
+    static void twoPhaseSatAll(const Params& params,
+                               const Evaluation& Sw,
+                               Evaluation& krw,
+                               Evaluation& krn,
+                               Evaluation& pcnw)
+    {
+        if (!Policy::enableKrHysteresis(params.config())) {
+            TwoPhaseSatAllHelper<EffectiveLaw>::eval(params.drainageParams(), Sw, krw, krn, pcnw);
+            return;
+        }
+
+        krw = twoPhaseSatKrw(params, Sw);
+        krn = twoPhaseSatKrn(params, Sw);
+        pcnw = twoPhaseSatPcnw(params, Sw);
+    }
 };
 } // namespace Opm
 
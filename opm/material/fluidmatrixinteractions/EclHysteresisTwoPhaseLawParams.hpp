@@ -273,6 +273,36 @@ public:
             updateDynamicParams_();
     }
 
+    /*!
+     * \brief Set the main drainage curve saturations for the capillary pressure and
+     *        the non-wetting phase relperm unconditionally.
+     *
+     * In contrast to update(), this may also move the saturations upwards, e.g., when
+     * restoring the state of a previous time step.
+     */
+    void resetMdc(Scalar pcSwMdc, Scalar krnSwMdc)
+    {
+        pcSwMdc_ = pcSwMdc;
+        krnSwMdc_ = krnSwMdc;
+
+        if (config().enableHysteresis())
+            updateDynamicParams_();
+    }
+
+    template <class Serializer>
+    void serializeOp(Serializer& serializer)
+    {
+        serializer(config_);
+        serializer(imbibitionParams_);
+        serializer(drainageParams_);
+        serializer(krnSwMdc_);
+        serializer(pcSwMdc_);
+        serializer(deltaSwImbKrn_);
+
+        if (serializer.isLoading())
+            EnsureFinalized::finalize();
+    }
+
 private:
     void updateDynamicParams_()
     {
@@ -34,13 +34,16 @@
 #include <opm/material/fluidmatrixinteractions/EclTwoPhaseMaterialParams.hpp>
 #include <opm/material/fluidmatrixinteractions/PiecewiseLinearTwoPhaseMaterial.hpp>
 #include <opm/material/fluidmatrixinteractions/EclEpsTwoPhaseLaw.hpp>
+#include <opm/material/fluidmatrixinteractions/EclEpsPolicy.hpp>
 #include <opm/material/fluidmatrixinteractions/EclHysteresisTwoPhaseLaw.hpp>
+#include <opm/material/fluidmatrixinteractions/EclHysteresisPolicy.hpp>
 #include <opm/material/fluidmatrixinteractions/EclEpsScalingPoints.hpp>
 #include <opm/material/fluidmatrixinteractions/EclEpsConfig.hpp>
 #include <opm/material/fluidmatrixinteractions/EclHysteresisConfig.hpp>
 #include <opm/material/fluidmatrixinteractions/EclMultiplexerMaterial.hpp>
 #include <opm/material/fluidmatrixinteractions/MaterialTraits.hpp>
 #include <opm/material/fluidstates/SimpleModularFluidState.hpp>
+#include <opm/material/common/FileBackedArray.hpp>
 
 #if HAVE_OPM_COMMON
 #include <opm/common/OpmLog/OpmLog.hpp>
@@ -52,8 +55,11 @@
 
 #include <algorithm>
 #include <cassert>
+#include <functional>
 #include <memory>
 #include <stdexcept>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace Opm {
@@ -63,12 +69,21 @@ namespace Opm {
  *
  * \brief Provides an simple way to create and manage the material law objects
  *        for a complete ECL deck.
+ *
+ * The endpoint scaling and the hysteresis policies are used by the material laws of
+ * the gas-oil and the oil-water systems. By default, the configuration is queried at
+ * runtime. Policies which match a deck can be selected using
+ * eclMaterialLawVisitEpsPolicy() and eclMaterialLawVisitHysteresisPolicy().
  */
-template <class TraitsT>
+template <class TraitsT,
+          class EpsPolicyT = EclEpsDynamicPolicy,
+          class HysteresisPolicyT = EclHysteresisDynamicPolicy>
 class EclMaterialLawManager
 {
 private:
     typedef TraitsT Traits;
+    typedef EpsPolicyT EpsPolicy;
+    typedef HysteresisPolicyT HysteresisPolicy;
     typedef typename Traits::Scalar Scalar;
     enum { waterPhaseIdx = Traits::wettingPhaseIdx };
     enum { oilPhaseIdx = Traits::nonWettingPhaseIdx };
@@ -85,14 +100,22 @@ private:
     typedef typename OilWaterEffectiveTwoPhaseLaw::Params OilWaterEffectiveTwoPhaseParams;
 
     // the two-phase material law which is defined on absolute (scaled) saturations
-    typedef EclEpsTwoPhaseLaw<GasOilEffectiveTwoPhaseLaw> GasOilEpsTwoPhaseLaw;
-    typedef EclEpsTwoPhaseLaw<OilWaterEffectiveTwoPhaseLaw> OilWaterEpsTwoPhaseLaw;
+    typedef EclEpsTwoPhaseLaw<GasOilEffectiveTwoPhaseLaw,
+                              EclEpsTwoPhaseLawParams<GasOilEffectiveTwoPhaseLaw>,
+                              EpsPolicy> GasOilEpsTwoPhaseLaw;
+    typedef EclEpsTwoPhaseLaw<OilWaterEffectiveTwoPhaseLaw,
+                              EclEpsTwoPhaseLawParams<OilWaterEffectiveTwoPhaseLaw>,
+                              EpsPolicy> OilWaterEpsTwoPhaseLaw;
     typedef typename GasOilEpsTwoPhaseLaw::Params GasOilEpsTwoPhaseParams;
     typedef typename OilWaterEpsTwoPhaseLaw::Params OilWaterEpsTwoPhaseParams;
 
     // the scaled two-phase material laws with hystersis
-    typedef EclHysteresisTwoPhaseLaw<GasOilEpsTwoPhaseLaw> GasOilTwoPhaseLaw;
-    typedef EclHysteresisTwoPhaseLaw<OilWaterEpsTwoPhaseLaw> OilWaterTwoPhaseLaw;
+    typedef EclHysteresisTwoPhaseLaw<GasOilEpsTwoPhaseLaw,
+                                     EclHysteresisTwoPhaseLawParams<GasOilEpsTwoPhaseLaw>,
+                                     HysteresisPolicy> GasOilTwoPhaseLaw;
+    typedef EclHysteresisTwoPhaseLaw<OilWaterEpsTwoPhaseLaw,
+                                     EclHysteresisTwoPhaseLawParams<OilWaterEpsTwoPhaseLaw>,
+                                     HysteresisPolicy> OilWaterTwoPhaseLaw;
     typedef typename GasOilTwoPhaseLaw::Params GasOilTwoPhaseHystParams;
     typedef typename OilWaterTwoPhaseLaw::Params OilWaterTwoPhaseHystParams;
 
@@ -113,7 +136,20 @@ private:
     typedef std::vector<std::shared_ptr<OilWaterTwoPhaseHystParams> > OilWaterParamVector;
     typedef std::vector<std::shared_ptr<MaterialLawParams> > MaterialLawParamsVector;
 
+    // the scaled end points which have already been created while the elements are
+    // initialized. they are indexed by a hash of the scaling point information, so
+    // elements with identical end points share their records.
+    struct ScaledPointsRecord
+    {
+        std::shared_ptr<EclEpsScalingPointsInfo<Scalar> > info;
+        std::shared_ptr<EclEpsScalingPoints<Scalar> > points;
+    };
+    typedef std::unordered_multimap<size_t, ScaledPointsRecord> ScaledPointsCache;
+
 public:
+    //! The number of entries per element in the array returned by hysteresisState()
+    enum { numHysteresisStateValues = 4 };
+
     EclMaterialLawManager()
     {}
 
@@ -138,6 +174,16 @@ public:
         gasOilConfig->initFromState(eclState, Opm::EclGasOilSystem);
         oilWaterConfig->initFromState(eclState, Opm::EclOilWaterSystem);
 
+        if (!EpsPolicy::isCompatible(*gasOilConfig) || !EpsPolicy::isCompatible(*oilWaterConfig))
+            throw std::runtime_error("The endpoint scaling policy of the material law manager is "
+                                     "not compatible with the deck. (Use "
+                                     "eclMaterialLawVisitEpsPolicy() to select one.)");
+
+        if (!HysteresisPolicy::isCompatible(*hysteresisConfig_))
+            throw std::runtime_error("The hysteresis policy of the material law manager is not "
+                                     "compatible with the deck. (Use "
+                                     "eclMaterialLawVisitHysteresisPolicy() to select one.)");
+
         const auto& tables = eclState.getTableManager();
 
         {
@@ -173,26 +219,19 @@ public:
         }
     }
 
-    void initParamsForElements(const EclipseState& eclState, size_t numCompressedElems)
+    /*!
+     * \brief Create the material law parameters of all elements.
+     *
+     * If lazyTables is true, the parameters of the saturation functions are only
+     * read for the saturation regions which are used by at least one of the
+     * elements, i.e., a process of a domain-decomposed run only pays for the
+     * regions it owns.
+     */
+    void initParamsForElements(const EclipseState& eclState, size_t numCompressedElems, bool lazyTables = false)
     {
         // get the number of saturation regions
         const size_t numSatRegions = eclState.runspec().tabdims().getNumSatTables();
 
-        // setup the saturation region specific parameters
-        gasOilUnscaledPointsVector_.resize(numSatRegions);
-        oilWaterUnscaledPointsVector_.resize(numSatRegions);
-        gasOilEffectiveParamVector_.resize(numSatRegions);
-        oilWaterEffectiveParamVector_.resize(numSatRegions);
-        for (unsigned satRegionIdx = 0; satRegionIdx < numSatRegions; ++satRegionIdx) {
-            // unscaled points for end-point scaling
-            readGasOilUnscaledPoints_(gasOilUnscaledPointsVector_, gasOilConfig, eclState, satRegionIdx);
-            readOilWaterUnscaledPoints_(oilWaterUnscaledPointsVector_, oilWaterConfig, eclState, satRegionIdx);
-
-            // the parameters for the effective two-phase matererial laws
-            readGasOilEffectiveParameters_(gasOilEffectiveParamVector_, eclState, satRegionIdx);
-            readOilWaterEffectiveParameters_(oilWaterEffectiveParamVector_, eclState, satRegionIdx);
-        }
-
         // copy the SATNUM grid property. in some cases this is not necessary, but it
         // should not require much memory anyway...
         satnumRegionArray_.resize(numCompressedElems);
@@ -215,6 +254,34 @@ public:
             }
         }
 
+        // determine the saturation regions which are required
+        std::vector<char> satRegionIsUsed(numSatRegions, !lazyTables);
+        if (lazyTables) {
+            for (unsigned elemIdx = 0; elemIdx < numCompressedElems; ++elemIdx) {
+                satRegionIsUsed[static_cast<unsigned>(satnumRegionArray_[elemIdx])] = 1;
+                if (enableHysteresis())
+                    satRegionIsUsed[static_cast<unsigned>(imbnumRegionArray_[elemIdx])] = 1;
+            }
+        }
+
+        // setup the saturation region specific parameters
+        gasOilUnscaledPointsVector_.resize(numSatRegions);
+        oilWaterUnscaledPointsVector_.resize(numSatRegions);
+        gasOilEffectiveParamVector_.resize(numSatRegions);
+        oilWaterEffectiveParamVector_.resize(numSatRegions);
+        for (unsigned satRegionIdx = 0; satRegionIdx < numSatRegions; ++satRegionIdx) {
+            if (!satRegionIsUsed[satRegionIdx])
+                continue;
+
+            // unscaled points for end-point scaling
+            readGasOilUnscaledPoints_(gasOilUnscaledPointsVector_, gasOilConfig, eclState, satRegionIdx);
+            readOilWaterUnscaledPoints_(oilWaterUnscaledPointsVector_, oilWaterConfig, eclState, satRegionIdx);
+
+            // the parameters for the effective two-phase matererial laws
+            readGasOilEffectiveParameters_(gasOilEffectiveParamVector_, eclState, satRegionIdx);
+            readOilWaterEffectiveParameters_(oilWaterEffectiveParamVector_, eclState, satRegionIdx);
+        }
+
         // read the scaled end point scaling parameters which are specific for each
         // element
         GasOilScalingInfoVector gasOilScaledInfoVector(numCompressedElems);
@@ -236,9 +303,14 @@ public:
 
         EclEpsGridProperties epsGridProperties(eclState, false);
 
+        // usually, most elements do not exhibit cell specific end points, so records
+        // are shared between all elements which use the same ones
+        ScaledPointsCache gasOilScaledPointsCache;
+        ScaledPointsCache oilWaterScaledPointsCache;
         for (unsigned elemIdx = 0; elemIdx < numCompressedElems; ++elemIdx) {
             readGasOilScaledPoints_(gasOilScaledInfoVector,
                                     gasOilScaledPointsVector,
+                                    gasOilScaledPointsCache,
                                     gasOilConfig,
                                     eclState,
                                     epsGridProperties,
@@ -246,17 +318,22 @@ public:
 
             readOilWaterScaledPoints_(oilWaterScaledEpsInfoDrainage_,
                                       oilWaterScaledEpsPointsDrainage,
+                                      oilWaterScaledPointsCache,
                                       oilWaterConfig,
                                       eclState,
                                       epsGridProperties,
                                       elemIdx);
         }
+        numUniqueScaledEpsPoints_ = gasOilScaledPointsCache.size() + oilWaterScaledPointsCache.size();
 
         if (enableHysteresis()) {
             EclEpsGridProperties epsImbGridProperties(eclState, true);
+            ScaledPointsCache gasOilScaledImbPointsCache;
+            ScaledPointsCache oilWaterScaledImbPointsCache;
             for (unsigned elemIdx = 0; elemIdx < numCompressedElems; ++elemIdx) {
                 readGasOilScaledPoints_(gasOilScaledImbInfoVector,
                                         gasOilScaledImbPointsVector,
+                                        gasOilScaledImbPointsCache,
                                         gasOilConfig,
                                         eclState,
                                         epsImbGridProperties,
@@ -264,11 +341,14 @@ public:
 
                 readOilWaterScaledPoints_(oilWaterScaledImbInfoVector,
                                           oilWaterScaledImbPointsVector,
+                                          oilWaterScaledImbPointsCache,
                                           oilWaterConfig,
                                           eclState,
                                           epsImbGridProperties,
                                           elemIdx);
             }
+            numUniqueScaledEpsPoints_ +=
+                gasOilScaledImbPointsCache.size() + oilWaterScaledImbPointsCache.size();
         }
 
         // create the parameter objects for the two-phase laws
@@ -371,6 +451,23 @@ public:
 
             materialLawParams_[elemIdx]->finalize();
         }
+
+        if (enableHysteresis()) {
+            hysteresisState_.resize(numHysteresisStateValues*numCompressedElems);
+            hysteresisElements_.clear();
+            for (unsigned elemIdx = 0; elemIdx < numCompressedElems; ++elemIdx) {
+                storeHysteresisState_(elemIdx);
+
+                // if the imbibition curves of an element are the same as its drainage
+                // curves, its scanning curves are the drainage curves as well
+                if (materialLawParams_[elemIdx]->approach() == EclMultiplexerApproach::EclOnePhaseApproach)
+                    continue;
+                if (imbnumRegionArray_[elemIdx] != satnumRegionArray_[elemIdx]
+                    || !(*gasOilScaledImbInfoVector[elemIdx] == *gasOilScaledInfoVector[elemIdx])
+                    || !(*oilWaterScaledImbInfoVector[elemIdx] == *oilWaterScaledEpsInfoDrainage_[elemIdx]))
+                    hysteresisElements_.push_back(elemIdx);
+            }
+        }
     }
 
 
@@ -386,7 +483,7 @@ public:
                          Scalar pcow,
                          Scalar Sw)
     {
-        auto& elemScaledEpsInfo = *oilWaterScaledEpsInfoDrainage_[elemIdx];
+        const auto& elemScaledEpsInfo = *oilWaterScaledEpsInfoDrainage_[elemIdx];
 
         // TODO: Mixed wettability systems - see ecl kw OPTIONS switch 74
 
@@ -421,9 +518,13 @@ public:
             const Scalar pcowAtSwThreshold = 1.0; //Pascal
             // avoid divison by very small number
             if (std::abs(pcowAtSw) > pcowAtSwThreshold) {
-                elemScaledEpsInfo.maxPcow *= pcow/pcowAtSw;
+                // the end points may be shared with other elements, so the element
+                // gets its own copy of the ones which are modified
+                auto& elemModifiedEpsInfo = *unshareOilWaterScaledEpsInfoDrainage_(elemIdx);
+                elemModifiedEpsInfo.maxPcow *= pcow/pcowAtSw;
+
                 auto& elemEclEpsScalingPoints = oilWaterScaledEpsPointsDrainage(elemIdx);
-                elemEclEpsScalingPoints.init(elemScaledEpsInfo, *oilWaterEclEpsConfig_, Opm::EclOilWaterSystem);
+                elemEclEpsScalingPoints.init(elemModifiedEpsInfo, *oilWaterEclEpsConfig_, Opm::EclOilWaterSystem);
             }
         }
 
@@ -433,6 +534,27 @@ public:
     bool enableEndPointScaling() const
     { return enableEndPointScaling_; }
 
+    /*!
+     * \brief Returns the number of distinct records of scaled end points which were
+     *        created by initParamsForElements().
+     *
+     * Elements which use the same scaled end points share a record. The number includes
+     * the records of the gas-oil and the oil-water systems as well as the ones for
+     * imbibition if hysteresis is enabled.
+     */
+    size_t numUniqueScaledEpsPoints() const
+    { return numUniqueScaledEpsPoints_; }
+
+    /*!
+     * \brief Returns true iff the saturation function tables of a saturation region
+     *        have been read by initParamsForElements().
+     *
+     * This is always the case unless the tables are read lazily and the region is not
+     * used by any of the elements.
+     */
+    bool satRegionIsInitialized(unsigned satRegionIdx) const
+    { return oilWaterEffectiveParamVector_[satRegionIdx] != nullptr; }
+
     bool enableHysteresis() const
     { return hysteresisConfig_->enableHysteresis(); }
 
@@ -555,8 +677,192 @@ public:
         if (!enableHysteresis())
             return;
 
-        auto threePhaseParams = materialLawParams_[elemIdx];
-        MaterialLaw::updateHysteresis(*threePhaseParams, fluidState);
+        auto& threePhaseParams = *materialLawParams_[elemIdx];
+        MaterialLaw::updateHysteresis(threePhaseParams, fluidState);
+        storeHysteresisState_(elemIdx);
+    }
+
+    /*!
+     * \brief Update the hysteresis parameters of all elements.
+     *
+     * fluidStates[elemIdx] must be the fluid state of element elemIdx. Compared to
+     * calling updateHysteresis() for each element, the three-phase approach is only
+     * dispatched once and no shared pointers are copied. Only the elements whose
+     * imbibition curves differ from their drainage curves are visited because the
+     * hysteresis does not have any effect for the others, i.e., their main drainage
+     * curve saturations are not tracked by this method. The scanning curves of a
+     * visited element are only updated if one of its saturations has moved below the
+     * main drainage curve saturation.
+     *
+     * \return The number of elements whose main drainage curve saturations changed.
+     */
+    template <class FluidStateContainer>
+    size_t updateHysteresisAll(const FluidStateContainer& fluidStates)
+    {
+        if (!enableHysteresis())
+            return 0;
+
+        switch (threePhaseApproach_) {
+        case EclMultiplexerApproach::EclStone1Approach:
+            return updateHysteresisAll_<EclMultiplexerApproach::EclStone1Approach,
+                                        typename MaterialLaw::Stone1Material>(fluidStates);
+
+        case EclMultiplexerApproach::EclStone2Approach:
+            return updateHysteresisAll_<EclMultiplexerApproach::EclStone2Approach,
+                                        typename MaterialLaw::Stone2Material>(fluidStates);
+
+        case EclMultiplexerApproach::EclDefaultApproach:
+            return updateHysteresisAll_<EclMultiplexerApproach::EclDefaultApproach,
+                                        typename MaterialLaw::DefaultMaterial>(fluidStates);
+
+        case EclMultiplexerApproach::EclTwoPhaseApproach:
+            return updateHysteresisAll_<EclMultiplexerApproach::EclTwoPhaseApproach,
+                                        typename MaterialLaw::TwoPhaseMaterial>(fluidStates);
+
+        case EclMultiplexerApproach::EclOnePhaseApproach:
+            return 0;
+        }
+
+        return 0;
+    }
+
+    /*!
+     * \brief Re-create the parameter objects of the elements which are owned by the
+     *        calling thread.
+     *
+     * initParamsForElements() allocates the parameters of all elements on a single
+     * thread. Since operating systems usually place memory on the NUMA node of the
+     * thread which first writes to it, all parameters then reside on one node. To avoid
+     * this, each thread of a simulator may call this method after the initialization
+     * to copy the parameters of the elements it owns, i.e., of the elements for which
+     * elementOwner[elemIdx] == ownerIdx, to memory which it touches first. The objects
+     * which are shared by several elements, e.g., the saturation functions of the
+     * regions, are not copied.
+     *
+     * The calls of different threads may run concurrently provided that no other
+     * method of this object is called meanwhile. References to the parameters of the
+     * handled elements which were obtained before become invalid.
+     */
+    void firstTouchElementParams(const std::vector<unsigned>& elementOwner, unsigned ownerIdx)
+    {
+        size_t numElems = materialLawParams_.size();
+        if (elementOwner.size() != numElems)
+            throw std::runtime_error("The size of the partition does not match the number of elements.");
+
+        for (unsigned elemIdx = 0; elemIdx < numElems; ++elemIdx) {
+            if (elementOwner[elemIdx] != ownerIdx)
+                continue;
+
+            const MaterialLawParams& oldParams = *materialLawParams_[elemIdx];
+            auto newParams = std::make_shared<MaterialLawParams>();
+            newParams->setApproach(oldParams.approach());
+            switch (oldParams.approach()) {
+            case EclMultiplexerApproach::EclStone1Approach:
+                copyElementParams_<EclMultiplexerApproach::EclStone1Approach>(*newParams, oldParams);
+                break;
+
+            case EclMultiplexerApproach::EclStone2Approach:
+                copyElementParams_<EclMultiplexerApproach::EclStone2Approach>(*newParams, oldParams);
+                break;
+
+            case EclMultiplexerApproach::EclDefaultApproach:
+                copyElementParams_<EclMultiplexerApproach::EclDefaultApproach>(*newParams, oldParams);
+                break;
+
+            case EclMultiplexerApproach::EclTwoPhaseApproach:
+                copyElementParams_<EclMultiplexerApproach::EclTwoPhaseApproach>(*newParams, oldParams);
+                break;
+
+            case EclMultiplexerApproach::EclOnePhaseApproach:
+                break;
+            }
+            newParams->finalize();
+
+            materialLawParams_[elemIdx] = newParams;
+        }
+    }
+
+    /*!
+     * \brief The main drainage curve saturations of all elements.
+     *
+     * For each element, this contains numHysteresisStateValues entries: the MDC
+     * saturations used for the capillary pressure and the non-wetting phase relperm of
+     * the oil-water system followed by the same quantities for the gas-oil system. The
+     * array is kept up to date by the methods of this class which modify the hysteresis
+     * parameters, so it can be used for checkpointing as is.
+     */
+    const std::vector<Scalar>& hysteresisState() const
+    { return hysteresisState_; }
+
+    /*!
+     * \brief Restore the main drainage curve saturations of all elements.
+     *
+     * The argument must have been obtained using hysteresisState(). Only the scanning
+     * curves of the elements whose state differs from the current one are updated.
+     */
+    void setHysteresisState(const std::vector<Scalar>& state)
+    {
+        if (!enableHysteresis())
+            throw std::runtime_error("Cannot set hysteresis state if hysteresis not enabled.");
+        if (state.size() != hysteresisState_.size())
+            throw std::runtime_error("The size of the hysteresis state does not match the number of elements.");
+
+        size_t numElems = materialLawParams_.size();
+        for (unsigned elemIdx = 0; elemIdx < numElems; ++elemIdx)
+            resetHysteresisState_(elemIdx, &state[numHysteresisStateValues*elemIdx]);
+    }
+
+    /*!
+     * \brief Write the main drainage curve saturations of all elements to a file.
+     *
+     * The file contains the same values as hysteresisState(). It is written through a
+     * FileBackedArray in blocks of elementsPerBlock elements, so writing it does not
+     * require additional memory which depends on the size of the grid.
+     *
+     * Note that this is only a checkpoint of the hysteresis state: the parameter
+     * objects of all elements as well as hysteresisState() remain in main memory, so
+     * the resident memory of this class is not reduced by using a file.
+     */
+    void saveHysteresisState(const std::string& fileName, size_t elementsPerBlock = 4096) const
+    {
+        FileBackedArray<Scalar> state;
+        state.create(fileName, hysteresisState_.size());
+        Scalar* stateData = state.writableData();
+        state.sweep(numHysteresisStateValues*elementsPerBlock,
+                    [this, stateData](size_t beginIdx, size_t endIdx) {
+                        std::copy(this->hysteresisState_.begin() + beginIdx,
+                                  this->hysteresisState_.begin() + endIdx,
+                                  stateData + beginIdx);
+                    });
+        state.flush();
+    }
+
+    /*!
+     * \brief Restore the main drainage curve saturations of all elements from a file.
+     *
+     * The file must have been written by saveHysteresisState(). In contrast to
+     * setHysteresisState(), the state is streamed from the file in blocks of
+     * elementsPerBlock elements instead of being copied into memory at once. The
+     * values are applied to the parameter objects in main memory, i.e., the file is
+     * not used anymore after this method returns.
+     */
+    void loadHysteresisState(const std::string& fileName, size_t elementsPerBlock = 4096)
+    {
+        if (!enableHysteresis())
+            throw std::runtime_error("Cannot set hysteresis state if hysteresis not enabled.");
+
+        FileBackedArray<Scalar> state;
+        state.open(fileName);
+        if (state.size() != hysteresisState_.size())
+            throw std::runtime_error("The size of the hysteresis state does not match the number of elements.");
+
+        const Scalar* stateData = state.data();
+        state.sweep(numHysteresisStateValues*elementsPerBlock,
+                    [this, stateData](size_t beginIdx, size_t endIdx) {
+                        for (size_t i = beginIdx; i < endIdx; i += numHysteresisStateValues)
+                            this->resetHysteresisState_(static_cast<unsigned>(i/numHysteresisStateValues),
+                                                        stateData + i);
+                    });
     }
 
     void oilWaterHysteresisParams(Scalar& pcSwMdc,
@@ -579,6 +885,7 @@ public:
 
         auto& params = materialLawParams(elemIdx);
         MaterialLaw::setOilWaterHysteresisParams(pcSwMdc, krnSwMdc, params);
+        storeHysteresisState_(elemIdx);
     }
 
     void gasOilHysteresisParams(Scalar& pcSwMdc,
@@ -601,43 +908,185 @@ public:
 
         auto& params = materialLawParams(elemIdx);
         MaterialLaw::setGasOilHysteresisParams(pcSwMdc, krnSwMdc, params);
+        storeHysteresisState_(elemIdx);
     }
 
+    /*!
+     * \brief Returns the scaled drainage end points of the oil-water system of an
+     *        element for modification.
+     *
+     * The end points may be shared with other elements. In this case, the element
+     * gets its own copy first, so the modification does not affect any other element.
+     * Use sharedOilWaterScaledEpsPointsDrainage() to read them without copying.
+     */
     EclEpsScalingPoints<Scalar>& oilWaterScaledEpsPointsDrainage(unsigned elemIdx)
+    { return oilWaterDrainageParams_(elemIdx).scaledPoints(); }
+
+    /*!
+     * \brief Returns the scaled drainage end points of the oil-water system of an
+     *        element.
+     *
+     * The object may be shared with other elements which use the same end points.
+     */
+    const EclEpsScalingPoints<Scalar>& sharedOilWaterScaledEpsPointsDrainage(unsigned elemIdx) const
+    {
+        const auto& params = const_cast<EclMaterialLawManager*>(this)->oilWaterDrainageParams_(elemIdx);
+        return params.scaledPoints();
+    }
+
+    const Opm::EclEpsScalingPointsInfo<Scalar>& oilWaterScaledEpsInfoDrainage(size_t elemIdx) const
+    { return *oilWaterScaledEpsInfoDrainage_[elemIdx]; }
+
+    std::shared_ptr<EclEpsScalingPointsInfo<Scalar> >& oilWaterScaledEpsInfoDrainagePointerReferenceHack(unsigned elemIdx)
+    { return unshareOilWaterScaledEpsInfoDrainage_(elemIdx); }
+
+    /*!
+     * \brief Store or load the parameters of all elements.
+     *
+     * Parameter objects which are shared between elements are stored only once and
+     * are shared again after loading. See saveBinary() and loadBinary().
+     */
+    template <class Serializer>
+    void serializeOp(Serializer& serializer)
+    {
+        serializer(enableEndPointScaling_);
+        serializer(hysteresisConfig_);
+        serializer(oilWaterEclEpsConfig_);
+        serializer(unscaledEpsInfo_);
+        serializer(oilWaterScaledEpsInfoDrainage_);
+        serializer(numUniqueScaledEpsPoints_);
+        serializer(gasOilUnscaledPointsVector_);
+        serializer(oilWaterUnscaledPointsVector_);
+        serializer(gasOilEffectiveParamVector_);
+        serializer(oilWaterEffectiveParamVector_);
+        serializer(threePhaseApproach_);
+        serializer(twoPhaseApproach_);
+        serializer(materialLawParams_);
+        serializer(hysteresisState_);
+        serializer(hysteresisElements_);
+        serializer(satnumRegionArray_);
+        serializer(imbnumRegionArray_);
+        serializer(stoneEtas);
+        serializer(hasGas);
+        serializer(hasOil);
+        serializer(hasWater);
+        serializer(gasOilConfig);
+        serializer(oilWaterConfig);
+    }
+
+private:
+    template <EclMultiplexerApproach approach, class RealMaterialLaw, class FluidStateContainer>
+    size_t updateHysteresisAll_(const FluidStateContainer& fluidStates)
+    {
+        size_t numChanged = 0;
+        for (unsigned elemIdx : hysteresisElements_) {
+            auto& realParams = materialLawParams_[elemIdx]->template getRealParams<approach>();
+            RealMaterialLaw::updateHysteresis(realParams, fluidStates[elemIdx]);
+            if (storeHysteresisState_(elemIdx, realParams.oilWaterParams(), realParams.gasOilParams()))
+                ++numChanged;
+        }
+
+        return numChanged;
+    }
+
+    // copy the three-phase parameters of an element including its two-phase
+    // parameters. the objects which the latter refer to are shared by many elements
+    template <EclMultiplexerApproach approach>
+    void copyElementParams_(MaterialLawParams& dest, const MaterialLawParams& src) const
+    {
+        auto& destParams = dest.template getRealParams<approach>();
+        const auto& srcParams = src.template getRealParams<approach>();
+
+        destParams = srcParams;
+        destParams.setGasOilParams(std::make_shared<GasOilTwoPhaseHystParams>(srcParams.gasOilParams()));
+        destParams.setOilWaterParams(std::make_shared<OilWaterTwoPhaseHystParams>(srcParams.oilWaterParams()));
+    }
+
+    // call a functor with the hysteresis parameters of the oil-water and the gas-oil
+    // systems of an element
+    template <class Functor>
+    void visitHysteresisParams_(unsigned elemIdx, Functor f)
     {
         auto& materialParams = *materialLawParams_[elemIdx];
         switch (materialParams.approach()) {
         case EclMultiplexerApproach::EclStone1Approach: {
             auto& realParams = materialParams.template getRealParams<EclMultiplexerApproach::EclStone1Approach>();
-            return realParams.oilWaterParams().drainageParams().scaledPoints();
+            f(realParams.oilWaterParams(), realParams.gasOilParams());
+            break;
         }
 
         case EclMultiplexerApproach::EclStone2Approach: {
             auto& realParams = materialParams.template getRealParams<EclMultiplexerApproach::EclStone2Approach>();
-            return realParams.oilWaterParams().drainageParams().scaledPoints();
+            f(realParams.oilWaterParams(), realParams.gasOilParams());
+            break;
         }
 
         case EclMultiplexerApproach::EclDefaultApproach: {
             auto& realParams = materialParams.template getRealParams<EclMultiplexerApproach::EclDefaultApproach>();
-            return realParams.oilWaterParams().drainageParams().scaledPoints();
+            f(realParams.oilWaterParams(), realParams.gasOilParams());
+            break;
         }
 
         case EclMultiplexerApproach::EclTwoPhaseApproach: {
             auto& realParams = materialParams.template getRealParams<EclMultiplexerApproach::EclTwoPhaseApproach>();
-            return realParams.oilWaterParams().drainageParams().scaledPoints();
+            f(realParams.oilWaterParams(), realParams.gasOilParams());
+            break;
         }
-        default:
-            throw std::logic_error("Enum value for material approach unknown!");
+
+        case EclMultiplexerApproach::EclOnePhaseApproach:
+            break;
         }
     }
 
-    const Opm::EclEpsScalingPointsInfo<Scalar>& oilWaterScaledEpsInfoDrainage(size_t elemIdx) const
-    { return *oilWaterScaledEpsInfoDrainage_[elemIdx]; }
+    // copy the main drainage curve saturations of an element to the flat array of
+    // the hysteresis state. returns true if they changed
+    bool storeHysteresisState_(unsigned elemIdx,
+                               const OilWaterTwoPhaseHystParams& oilWaterParams,
+                               const GasOilTwoPhaseHystParams& gasOilParams)
+    {
+        Scalar* state = &hysteresisState_[numHysteresisStateValues*elemIdx];
+        const Scalar newState[numHysteresisStateValues] = {
+            oilWaterParams.pcSwMdc(),
+            oilWaterParams.krnSwMdc(),
+            gasOilParams.pcSwMdc(),
+            gasOilParams.krnSwMdc()
+        };
+
+        if (std::equal(newState, newState + numHysteresisStateValues, state))
+            return false;
+
+        std::copy(newState, newState + numHysteresisStateValues, state);
+        return true;
+    }
 
-    std::shared_ptr<EclEpsScalingPointsInfo<Scalar> >& oilWaterScaledEpsInfoDrainagePointerReferenceHack(unsigned elemIdx)
-    { return oilWaterScaledEpsInfoDrainage_[elemIdx]; }
+    // set the main drainage curve saturations of an element and update its scanning
+    // curves if they changed
+    void resetHysteresisState_(unsigned elemIdx, const Scalar* newState)
+    {
+        Scalar* curState = &hysteresisState_[numHysteresisStateValues*elemIdx];
+        if (std::equal(newState, newState + numHysteresisStateValues, curState))
+            return;
+
+        visitHysteresisParams_(elemIdx, [newState](OilWaterTwoPhaseHystParams& oilWaterParams,
+                                                   GasOilTwoPhaseHystParams& gasOilParams) {
+                if (newState[0] != oilWaterParams.pcSwMdc() || newState[1] != oilWaterParams.krnSwMdc())
+                    oilWaterParams.resetMdc(newState[0], newState[1]);
+                if (newState[2] != gasOilParams.pcSwMdc() || newState[3] != gasOilParams.krnSwMdc())
+                    gasOilParams.resetMdc(newState[2], newState[3]);
+            });
+        std::copy(newState, newState + numHysteresisStateValues, curState);
+    }
+
+    bool storeHysteresisState_(unsigned elemIdx)
+    {
+        bool changed = false;
+        visitHysteresisParams_(elemIdx, [this, elemIdx, &changed](OilWaterTwoPhaseHystParams& oilWaterParams,
+                                                                      GasOilTwoPhaseHystParams& gasOilParams) {
+                changed = this->storeHysteresisState_(elemIdx, oilWaterParams, gasOilParams);
+            });
+        return changed;
+    }
 
-private:
     void readGlobalEpsOptions_(const Opm::EclipseState& eclState)
     {
         oilWaterEclEpsConfig_ = std::make_shared<Opm::EclEpsConfig>();
@@ -899,35 +1348,138 @@ private:
     template <class InfoContainer, class PointsContainer>
     void readGasOilScaledPoints_(InfoContainer& destInfo,
                                  PointsContainer& destPoints,
+                                 ScaledPointsCache& cache,
                                  std::shared_ptr<EclEpsConfig> config,
                                  const Opm::EclipseState& eclState,
                                  const EclEpsGridProperties& epsGridProperties,
                                  unsigned elemIdx)
     {
-        unsigned satRegionIdx = epsGridProperties.satRegion( elemIdx );
-
-        destInfo[elemIdx] = std::make_shared<EclEpsScalingPointsInfo<Scalar> >(unscaledEpsInfo_[satRegionIdx]);
-        destInfo[elemIdx]->extractScaled(eclState, epsGridProperties, elemIdx);
-
-        destPoints[elemIdx] = std::make_shared<EclEpsScalingPoints<Scalar> >();
-        destPoints[elemIdx]->init(*destInfo[elemIdx], *config, EclGasOilSystem);
+        readScaledPoints_(destInfo, destPoints, cache, *config, eclState,
+                          epsGridProperties, elemIdx, EclGasOilSystem);
     }
 
     template <class InfoContainer, class PointsContainer>
     void readOilWaterScaledPoints_(InfoContainer& destInfo,
                                    PointsContainer& destPoints,
+                                   ScaledPointsCache& cache,
                                    std::shared_ptr<EclEpsConfig> config,
                                    const Opm::EclipseState& eclState,
                                    const EclEpsGridProperties& epsGridProperties,
                                    unsigned elemIdx)
+    {
+        readScaledPoints_(destInfo, destPoints, cache, *config, eclState,
+                          epsGridProperties, elemIdx, EclOilWaterSystem);
+    }
+
+    template <class InfoContainer, class PointsContainer>
+    void readScaledPoints_(InfoContainer& destInfo,
+                           PointsContainer& destPoints,
+                           ScaledPointsCache& cache,
+                           const EclEpsConfig& config,
+                           const Opm::EclipseState& eclState,
+                           const EclEpsGridProperties& epsGridProperties,
+                           unsigned elemIdx,
+                           EclTwoPhaseSystemType systemType)
     {
         unsigned satRegionIdx = epsGridProperties.satRegion( elemIdx );
 
-        destInfo[elemIdx] = std::make_shared<EclEpsScalingPointsInfo<Scalar> >(unscaledEpsInfo_[satRegionIdx]);
-        destInfo[elemIdx]->extractScaled(eclState, epsGridProperties, elemIdx);
+        EclEpsScalingPointsInfo<Scalar> info(unscaledEpsInfo_[satRegionIdx]);
+        info.extractScaled(eclState, epsGridProperties, elemIdx);
+
+        // re-use the record of an element with the same end points if possible
+        size_t hash = hashScaledEpsInfo_(info);
+        auto range = cache.equal_range(hash);
+        for (auto it = range.first; it != range.second; ++it) {
+            if (*it->second.info == info) {
+                destInfo[elemIdx] = it->second.info;
+                destPoints[elemIdx] = it->second.points;
+                return;
+            }
+        }
+
+        ScaledPointsRecord record;
+        record.info = std::make_shared<EclEpsScalingPointsInfo<Scalar> >(info);
+        if (usesScaledPoints_(config)) {
+            record.points = std::make_shared<EclEpsScalingPoints<Scalar> >();
+            record.points->init(info, config, systemType);
+        }
+        else if (systemType == EclGasOilSystem)
+            // the material laws never look at the scaled points, so the ones of the
+            // saturation region are good enough
+            record.points = gasOilUnscaledPointsVector_[satRegionIdx];
+        else
+            record.points = oilWaterUnscaledPointsVector_[satRegionIdx];
+        cache.emplace(hash, record);
+
+        destInfo[elemIdx] = record.info;
+        destPoints[elemIdx] = record.points;
+    }
+
+    // returns true if the endpoint scaling policy requires the scaled points of a
+    // two-phase system
+    static bool usesScaledPoints_(const EclEpsConfig& config)
+    {
+        return
+            EpsPolicy::enableSatScaling(config)
+            || EpsPolicy::enablePcScaling(config)
+            || EpsPolicy::enableLeverettScaling(config)
+            || EpsPolicy::enableKrwScaling(config)
+            || EpsPolicy::enableKrnScaling(config);
+    }
+
+    static size_t hashScaledEpsInfo_(const EclEpsScalingPointsInfo<Scalar>& info)
+    {
+        const Scalar values[] = {
+            info.Swl, info.Sgl, info.Swcr, info.Sgcr, info.Sowcr, info.Sogcr,
+            info.Swu, info.Sgu, info.maxPcow, info.maxPcgo,
+            info.pcowLeverettFactor, info.pcgoLeverettFactor,
+            info.Krwr, info.Krgr, info.Krorw, info.Krorg,
+            info.maxKrw, info.maxKrow, info.maxKrog, info.maxKrg
+        };
+
+        std::hash<Scalar> hasher;
+        size_t hash = 0;
+        for (const Scalar& value : values)
+            hash ^= hasher(value) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+        return hash;
+    }
+
+    // the drainage end points of the oil-water system may be shared between
+    // elements. this gives an element its own copy before it gets modified.
+    std::shared_ptr<EclEpsScalingPointsInfo<Scalar> >& unshareOilWaterScaledEpsInfoDrainage_(unsigned elemIdx)
+    {
+        auto& info = oilWaterScaledEpsInfoDrainage_[elemIdx];
+        if (info.use_count() > 1)
+            info = std::make_shared<EclEpsScalingPointsInfo<Scalar> >(*info);
+        return info;
+    }
+
+    OilWaterEpsTwoPhaseParams& oilWaterDrainageParams_(unsigned elemIdx)
+    {
+        auto& materialParams = *materialLawParams_[elemIdx];
+        switch (materialParams.approach()) {
+        case EclMultiplexerApproach::EclStone1Approach: {
+            auto& realParams = materialParams.template getRealParams<EclMultiplexerApproach::EclStone1Approach>();
+            return realParams.oilWaterParams().drainageParams();
+        }
+
+        case EclMultiplexerApproach::EclStone2Approach: {
+            auto& realParams = materialParams.template getRealParams<EclMultiplexerApproach::EclStone2Approach>();
+            return realParams.oilWaterParams().drainageParams();
+        }
+
+        case EclMultiplexerApproach::EclDefaultApproach: {
+            auto& realParams = materialParams.template getRealParams<EclMultiplexerApproach::EclDefaultApproach>();
+            return realParams.oilWaterParams().drainageParams();
+        }
 
-        destPoints[elemIdx] = std::make_shared<EclEpsScalingPoints<Scalar> >();
-        destPoints[elemIdx]->init(*destInfo[elemIdx], *config, EclOilWaterSystem);
+        case EclMultiplexerApproach::EclTwoPhaseApproach: {
+            auto& realParams = materialParams.template getRealParams<EclMultiplexerApproach::EclTwoPhaseApproach>();
+            return realParams.oilWaterParams().drainageParams();
+        }
+        default:
+            throw std::logic_error("Enum value for material approach unknown!");
+        }
     }
 
     void initThreePhaseParams_(const Opm::EclipseState& /* eclState */,
@@ -1009,6 +1561,7 @@ private:
     std::shared_ptr<EclEpsConfig> oilWaterEclEpsConfig_;
     std::vector<Opm::EclEpsScalingPointsInfo<Scalar>> unscaledEpsInfo_;
     OilWaterScalingInfoVector oilWaterScaledEpsInfoDrainage_;
+    size_t numUniqueScaledEpsPoints_ = 0;
 
     GasOilScalingPointsVector gasOilUnscaledPointsVector_;
     OilWaterScalingPointsVector oilWaterUnscaledPointsVector_;
@@ -1021,6 +1574,12 @@ private:
 
     std::vector<std::shared_ptr<MaterialLawParams> > materialLawParams_;
 
+    // the main drainage curve saturations of all elements, see hysteresisState()
+    std::vector<Scalar> hysteresisState_;
+
+    // the elements which are visited by updateHysteresisAll()
+    std::vector<unsigned> hysteresisElements_;
+
     std::vector<int> satnumRegionArray_;
     std::vector<int> imbnumRegionArray_;
     std::vector<Scalar> stoneEtas;
@@ -1032,6 +1591,40 @@ private:
     std::shared_ptr<Opm::EclEpsConfig> gasOilConfig;
     std::shared_ptr<Opm::EclEpsConfig> oilWaterConfig;
 };
+
+/*!
+ * \brief Call a visitor with the most specialized endpoint scaling policy for
+ *        EclMaterialLawManager which is compatible with a deck.
+ *
+ * The visitor is called with a default constructed object of the policy class. This
+ * class can be used as the second template argument of EclMaterialLawManager.
+ */
+template <class Visitor>
+void eclMaterialLawVisitEpsPolicy(const Opm::EclipseState& eclState, Visitor& visitor)
+{
+    EclEpsConfig gasOilConfig;
+    EclEpsConfig oilWaterConfig;
+    gasOilConfig.initFromState(eclState, EclGasOilSystem);
+    oilWaterConfig.initFromState(eclState, EclOilWaterSystem);
+
+    eclEpsVisitPolicy(gasOilConfig, oilWaterConfig, visitor);
+}
+
+/*!
+ * \brief Call a visitor with the hysteresis policy for EclMaterialLawManager which is
+ *        compatible with a deck.
+ *
+ * The visitor is called with a default constructed object of the policy class. This
+ * class can be used as the third template argument of EclMaterialLawManager.
+ */
+template <class Visitor>
+void eclMaterialLawVisitHysteresisPolicy(const Opm::EclipseState& eclState, Visitor& visitor)
+{
+    EclHysteresisConfig hysteresisConfig;
+    hysteresisConfig.initFromState(eclState.runspec());
+
+    eclHysteresisVisitPolicy(hysteresisConfig, visitor);
+}
 } // namespace Opm
 
 #endif
@@ -204,6 +204,39 @@ public:
         return this->template castTo<TwoPhaseParams>();
     }
 
+    template <class Serializer>
+    void serializeOp(Serializer& serializer)
+    {
+        EclMultiplexerApproach approach = approach_;
+        serializer(approach);
+        if (serializer.isLoading()) {
+            realParams_.reset();
+            setApproach(approach);
+            finalize();
+        }
+
+        switch (approach_) {
+        case EclMultiplexerApproach::EclStone1Approach:
+            serializer(this->template castTo<Stone1Params>());
+            break;
+
+        case EclMultiplexerApproach::EclStone2Approach:
+            serializer(this->template castTo<Stone2Params>());
+            break;
+
+        case EclMultiplexerApproach::EclDefaultApproach:
+            serializer(this->template castTo<DefaultParams>());
+            break;
+
+        case EclMultiplexerApproach::EclTwoPhaseApproach:
+            serializer(this->template castTo<TwoPhaseParams>());
+            break;
+
+        case EclMultiplexerApproach::EclOnePhaseApproach:
+            break;
+        }
+    }
+
 private:
     template <class ParamT>
     ParamT& castTo()
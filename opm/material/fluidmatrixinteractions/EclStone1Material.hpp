@@ -28,6 +28,7 @@
 #define OPM_ECL_STONE1_MATERIAL_HPP
 
 #include "EclStone1MaterialParams.hpp"
+#include "TwoPhaseSatAllHelper.hpp"
 
 #include <opm/material/common/Valgrind.hpp>
 #include <opm/material/common/MathToolbox.hpp>
@@ -316,9 +317,27 @@ public:
     {
         typedef typename std::remove_reference<decltype(values[0])>::type Evaluation;
 
-        values[waterPhaseIdx] = krw<FluidState, Evaluation>(params, fluidState);
-        values[oilPhaseIdx] = krn<FluidState, Evaluation>(params, fluidState);
-        values[gasPhaseIdx] = krg<FluidState, Evaluation>(params, fluidState);
+        const Scalar Swco = params.Swl();
+        const Evaluation Sw = Opm::decay<Evaluation>(fluidState.saturation(waterPhaseIdx));
+        const Evaluation Sg = Opm::decay<Evaluation>(fluidState.saturation(gasPhaseIdx));
+
+        // both curves of each two-phase system are evaluated at the same saturation,
+        // so they can share a single table lookup
+        Evaluation krw;
+        Evaluation kro_ow;
+        Evaluation pcow;
+        TwoPhaseSatAllHelper<OilWaterMaterialLaw>::eval(params.oilWaterParams(), Sw,
+                                                        krw, kro_ow, pcow);
+
+        Evaluation kro_go;
+        Evaluation krg;
+        Evaluation pcgo;
+        TwoPhaseSatAllHelper<GasOilMaterialLaw>::eval(params.gasOilParams(), 1 - Swco - Sg,
+                                                      kro_go, krg, pcgo);
+
+        values[waterPhaseIdx] = krw;
+        values[oilPhaseIdx] = krnFromTwoPhase_(params, Sw, Sg, kro_ow, kro_go);
+        values[gasPhaseIdx] = krg;
     }
 
     /*!
@@ -356,33 +375,13 @@ public:
         // "Swco" is used.
         const Scalar Swco = params.Swl();
 
-        // oil relperm at connate water saturations (with Sg=0)
-        const Scalar krocw = params.krocw();
-
         const Evaluation& Sw = Opm::decay<Evaluation>(fluidState.saturation(waterPhaseIdx));
         const Evaluation& Sg = Opm::decay<Evaluation>(fluidState.saturation(gasPhaseIdx));
 
         const Evaluation kro_ow = OilWaterMaterialLaw::twoPhaseSatKrn(params.oilWaterParams(), Sw);
         const Evaluation kro_go = GasOilMaterialLaw::twoPhaseSatKrw(params.gasOilParams(), 1 - Sg - Swco);
 
-        Evaluation beta;
-        if (Sw <= Swco)
-            beta = 1.0;
-        else {
-            // there seems to be an error in the ECL documentation: using the approach to
-            // the scaled saturations as described there leads to significant deviations
-            // from the results produced by Eclipse 100.
-            const Evaluation SSw = (Sw - Swco)/(1.0 - Swco);
-            const Evaluation SSg = Sg/(1.0 - Swco);
-            const Evaluation SSo = 1.0 - SSw - SSg;
-
-            if (SSw >= 1.0 || SSg >= 1.0)
-                beta = 1.0;
-            else
-                beta = Opm::pow( SSo/((1 - SSw)*(1 - SSg)), params.eta());
-        }
-
-        return Opm::max(0.0, Opm::min(1.0, beta*kro_ow*kro_go/krocw));
+        return krnFromTwoPhase_(params, Sw, Sg, kro_ow, kro_go);
     }
 
     /*!
@@ -404,6 +403,40 @@ public:
                                      /*krwSw=*/ 1.0 - Swco - Sg,
                                      /*krnSw=*/ 1.0 - Swco - Sg);
     }
+
+private:
+    // combine the oil relative permeabilities of the two two-phase systems
+    template <class Evaluation>
+    static Evaluation krnFromTwoPhase_(const Params& params,
+                                       const Evaluation& Sw,
+                                       const Evaluation& Sg,
+                                       const Evaluation& kro_ow,
+                                       const Evaluation& kro_go)
+    {
+        const Scalar Swco = params.Swl();
+
+        // oil relperm at connate water saturations (with Sg=0)
+        const Scalar krocw = params.krocw();
+
+        Evaluation beta;
+        if (Sw <= Swco)
+            beta = 1.0;
+        else {
+            // there seems to be an error in the ECL documentation: using the approach to
+            // the scaled saturations as described there leads to significant deviations
+            // from the results produced by Eclipse 100.
+            const Evaluation SSw = (Sw - Swco)/(1.0 - Swco);
+            const Evaluation SSg = Sg/(1.0 - Swco);
+            const Evaluation SSo = 1.0 - SSw - SSg;
+
+            if (SSw >= 1.0 || SSg >= 1.0)
+                beta = 1.0;
+            else
+                beta = Opm::pow( SSo/((1 - SSw)*(1 - SSg)), params.eta());
+        }
+
+        return Opm::max(0.0, Opm::min(1.0, beta*kro_ow*kro_go/krocw));
+    }
 };
 } // namespace Opm
 
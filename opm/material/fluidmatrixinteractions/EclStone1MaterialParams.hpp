@@ -145,6 +145,19 @@ public:
     Scalar eta() const
     { EnsureFinalized::check(); return eta_; }
 
+    template <class Serializer>
+    void serializeOp(Serializer& serializer)
+    {
+        serializer(gasOilParams_);
+        serializer(oilWaterParams_);
+        serializer(Swl_);
+        serializer(eta_);
+        serializer(krocw_);
+
+        if (serializer.isLoading())
+            EnsureFinalized::finalize();
+    }
+
 private:
     std::shared_ptr<GasOilParams> gasOilParams_;
     std::shared_ptr<OilWaterParams> oilWaterParams_;
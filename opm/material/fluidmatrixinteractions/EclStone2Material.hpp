@@ -28,6 +28,7 @@
 #define OPM_ECL_STONE2_MATERIAL_HPP
 
 #include "EclStone2MaterialParams.hpp"
+#include "TwoPhaseSatAllHelper.hpp"
 
 #include <opm/material/common/Valgrind.hpp>
 #include <opm/material/common/MathToolbox.hpp>
@@ -317,9 +318,27 @@ public:
     {
         typedef typename std::remove_reference<decltype(values[0])>::type Evaluation;
 
-        values[waterPhaseIdx] = krw<FluidState, Evaluation>(params, fluidState);
-        values[oilPhaseIdx] = krn<FluidState, Evaluation>(params, fluidState);
-        values[gasPhaseIdx] = krg<FluidState, Evaluation>(params, fluidState);
+        const Scalar Swco = params.Swl();
+        const Evaluation Sw = Opm::decay<Evaluation>(fluidState.saturation(waterPhaseIdx));
+        const Evaluation Sg = Opm::decay<Evaluation>(fluidState.saturation(gasPhaseIdx));
+
+        // both curves of each two-phase system are evaluated at the same saturation,
+        // so they can share a single table lookup
+        Evaluation krw;
+        Evaluation krow;
+        Evaluation pcow;
+        TwoPhaseSatAllHelper<OilWaterMaterialLaw>::eval(params.oilWaterParams(), Sw,
+                                                        krw, krow, pcow);
+
+        Evaluation krog;
+        Evaluation krg;
+        Evaluation pcgo;
+        TwoPhaseSatAllHelper<GasOilMaterialLaw>::eval(params.gasOilParams(), 1 - Swco - Sg,
+                                                      krog, krg, pcgo);
+
+        values[waterPhaseIdx] = krw;
+        values[oilPhaseIdx] = krnFromTwoPhase_(params, krw, krow, krg, krog);
+        values[gasPhaseIdx] = krg;
     }
 
     /*!
@@ -356,13 +375,12 @@ public:
         const Evaluation Sw = Opm::decay<Evaluation>(fluidState.saturation(waterPhaseIdx));
         const Evaluation Sg = Opm::decay<Evaluation>(fluidState.saturation(gasPhaseIdx));
 
-        const Scalar krocw = OilWaterMaterialLaw::twoPhaseSatKrn(params.oilWaterParams(), Swco);
         const Evaluation krow = OilWaterMaterialLaw::twoPhaseSatKrn(params.oilWaterParams(), Sw);
         const Evaluation krw = OilWaterMaterialLaw::twoPhaseSatKrw(params.oilWaterParams(), Sw);
         const Evaluation krg = GasOilMaterialLaw::twoPhaseSatKrn(params.gasOilParams(), 1 - Swco - Sg);
         const Evaluation krog = GasOilMaterialLaw::twoPhaseSatKrw(params.gasOilParams(), 1 - Swco - Sg);
 
-        return krocw * ((krow/krocw + krw) * (krog/krocw + krg) - krw - krg);
+        return krnFromTwoPhase_(params, krw, krow, krg, krog);
     }
 
     /*!
@@ -384,6 +402,21 @@ public:
                                      /*krwSw=*/ 1.0 - Swco - Sg,
                                      /*krnSw=*/ 1.0 - Swco - Sg);
     }
+
+private:
+    // combine the relative permeabilities of the two two-phase systems into the one
+    // of the oil phase
+    template <class Evaluation>
+    static Evaluation krnFromTwoPhase_(const Params& params,
+                                       const Evaluation& krw,
+                                       const Evaluation& krow,
+                                       const Evaluation& krg,
+                                       const Evaluation& krog)
+    {
+        const Scalar krocw = OilWaterMaterialLaw::twoPhaseSatKrn(params.oilWaterParams(), params.Swl());
+
+        return krocw * ((krow/krocw + krw) * (krog/krocw + krg) - krw - krg);
+    }
 };
 } // namespace Opm
 
@@ -117,6 +117,17 @@ public:
     Scalar Swl() const
     { EnsureFinalized::check(); return Swl_; }
 
+    template <class Serializer>
+    void serializeOp(Serializer& serializer)
+    {
+        serializer(gasOilParams_);
+        serializer(oilWaterParams_);
+        serializer(Swl_);
+
+        if (serializer.isLoading())
+            EnsureFinalized::finalize();
+    }
+
 private:
     std::shared_ptr<GasOilParams> gasOilParams_;
     std::shared_ptr<OilWaterParams> oilWaterParams_;
@@ -108,6 +108,17 @@ public:
     void setOilWaterParams(std::shared_ptr<OilWaterParams> val)
     { oilWaterParams_ = val; }
 
+    template <class Serializer>
+    void serializeOp(Serializer& serializer)
+    {
+        serializer(approach_);
+        serializer(gasOilParams_);
+        serializer(oilWaterParams_);
+
+        if (serializer.isLoading())
+            EnsureFinalized::finalize();
+    }
+
 private:
     EclTwoPhaseApproach approach_;
 
@@ -0,0 +1,272 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+
+  Consult the COPYING file in the top-level source directory of this
+  module for the precise wording of the license and the list of
+  copyright holders.
+*/
+/*!
+ * \file
+ * \copydoc Opm::PLScanningCurve
+ */
+#ifndef OPM_PL_SCANNING_CURVE_HPP
+#define OPM_PL_SCANNING_CURVE_HPP
+
+#include <vector>
+#include <cassert>
+#include <cstddef>
+
+namespace Opm {
+
+/*!
+ * \brief Represents a scanning curve in the Parker-Lenhard hysteresis model.
+ *
+ * The scanning curves of a hysteresis history are stored contiguously and
+ * ordered by their loop number, i.e., the curve with one reversal less is
+ * located directly in front of a curve and the one with one more reversal
+ * directly behind it. The first entry of the storage is a sentinel which
+ * represents the beginning of the main drainage curve. The storage is managed
+ * by ParkerLenhardParams, so the curves never allocate memory themselves.
+ */
+template <class ScalarT>
+class PLScanningCurve
+{
+public:
+    typedef ScalarT Scalar;
+
+    /*!
+     * \brief Return the previous scanning curve, i.e. the curve
+     *        with one less reversal than the current one.
+     */
+    PLScanningCurve* prev() const
+    {
+        if (loopNum_ < 0)
+            return nullptr;
+        return const_cast<PLScanningCurve*>(this - 1);
+    }
+
+    /*!
+     * \brief Return the next scanning curve, i.e. the curve
+     *        with one more reversal than the current one.
+     */
+    PLScanningCurve* next() const
+    {
+        if (!hasNext_)
+            return nullptr;
+        return const_cast<PLScanningCurve*>(this + 1);
+    }
+
+    /*!
+     * \brief Returns true iff the given effective saturation
+     *        Swei is within the scope of the curve, i.e.
+     *        whether Swei is part of the curve's
+     *        domain and the curve thus applies to Swi.
+     */
+    bool isValidAt_Sw(Scalar SwReversal) const
+    {
+        if (isImbib())
+            // for inbibition the given saturation
+            // must be between the start of the
+            // current imbibition and the the start
+            // of the last drainage
+            return this->Sw() < SwReversal && SwReversal < prev()->Sw();
+        else
+            // for drainage the given saturation
+            // must be between the start of the
+            // last imbibition and the start
+            // of the current drainage
+            return prev()->Sw() < SwReversal && SwReversal < this->Sw();
+    }
+
+    /*!
+     * \brief Returns true iff the scanning curve is a
+     *        imbibition curve.
+     */
+    bool isImbib() const
+    { return loopNum()%2 == 1; }
+
+    /*!
+     * \brief Returns true iff the scanning curve is a
+     *        drainage curve.
+     */
+    bool isDrain() const
+    { return !isImbib(); }
+
+    /*!
+     * \brief The loop number of the scanning curve.
+     *
+     * The MDC is 0, PISC is 1, PDSC is 2, ...
+     */
+    int loopNum() const
+    { return loopNum_; }
+
+    /*!
+     * \brief Absolute wetting-phase saturation at the
+     *        scanning curve's reversal point.
+     */
+    Scalar Sw() const
+    { return Sw_; }
+
+    /*!
+     * \brief Capillary pressure at the last reversal point.
+     */
+    Scalar pcnw() const
+    { return pcnw_; }
+
+    /*!
+     * \brief Apparent saturation of the last reversal point on
+     *        the pressure MIC.
+     */
+    Scalar SwMic() const
+    { return SwMic_; }
+
+    /*!
+     * \brief Apparent saturation of the last reversal point on
+     *        the pressure MDC.
+     */
+    Scalar SwMdc() const
+    { return SwMdc_; }
+
+    /*!
+     * \brief Initialize the sentinel and the main drainage curve at the
+     *        beginning of a storage area for scanning curves.
+     *
+     * Any history which was stored in the area before is forgotten. The
+     * area must provide space for at least two curves.
+     */
+    static void initMdc(PLScanningCurve* storage, Scalar Swr)
+    {
+        storage[0].set_(/*loopNum=*/-1, Swr, /*pcnw=*/1e12, /*SwMic=*/Swr, /*SwMdc=*/Swr);
+        storage[0].hasNext_ = true;
+        storage[1].set_(/*loopNum=*/0, /*Sw=*/1.0, /*pcnw=*/0.0, /*SwMic=*/1.0, /*SwMdc=*/1.0);
+    }
+
+    /*!
+     * \brief Set the next scanning curve.
+     *
+     * Next in the sense of the number of reversals from imbibition to
+     * drainage or vince versa. If this curve already has a list of next
+     * curves, it is forgotten. The caller must ensure that the storage area
+     * of the curve has space for the next curve.
+     */
+    void setNext(Scalar SwReversal,
+                 Scalar pcnwReversal,
+                 Scalar SwMiCurve,
+                 Scalar SwMdCurve)
+    {
+        hasNext_ = true;
+        (this + 1)->set_(loopNum_ + 1, SwReversal, pcnwReversal, SwMiCurve, SwMdCurve);
+    }
+
+private:
+    void set_(int loopN,
+              Scalar SwReversal,
+              Scalar pcnwReversal,
+              Scalar SwMiCurve,
+              Scalar SwMdCurve)
+    {
+        loopNum_ = loopN;
+        hasNext_ = false;
+        Sw_ = SwReversal;
+        pcnw_ = pcnwReversal;
+        SwMic_ = SwMiCurve;
+        SwMdc_ = SwMdCurve;
+    }
+
+    Scalar Sw_;
+    Scalar pcnw_;
+
+    Scalar SwMdc_;
+    Scalar SwMic_;
+
+    int loopNum_;
+    bool hasNext_;
+};
+
+/*!
+ * \brief A pool which provides the storage for the scanning curves of many
+ *        ParkerLenhardParams objects using a single allocation.
+ *
+ * Each parameter object gets a fixed-capacity slice of the pool which is
+ * assigned using ParkerLenhardParams::setScanningCurveStorage(). Since the
+ * slices of different objects do not overlap, the hysteresis of different
+ * cells can be updated concurrently. Resizing the pool invalidates all
+ * slices, i.e., the storage of the parameter objects needs to be set again
+ * afterwards.
+ */
+template <class ScalarT>
+class PLScanningCurveArena
+{
+public:
+    typedef ScalarT Scalar;
+    typedef PLScanningCurve<Scalar> ScanningCurve;
+
+    explicit PLScanningCurveArena(size_t numSlices = 0, unsigned maxCurves = 32)
+    { resize(numSlices, maxCurves); }
+
+    /*!
+     * \brief Change the number of slices and the maximum number of scanning
+     *        curves per slice.
+     *
+     * The main drainage curve is included in the maximum number of curves, so
+     * it must be at least 1.
+     */
+    void resize(size_t numSlices, unsigned maxCurves)
+    {
+        assert(maxCurves >= 1);
+
+        numSlices_ = numSlices;
+        maxCurves_ = maxCurves;
+        curves_.resize(numSlices*sliceSize_());
+    }
+
+    /*!
+     * \brief Return the number of slices of the pool.
+     */
+    size_t numSlices() const
+    { return numSlices_; }
+
+    /*!
+     * \brief Return the maximum number of scanning curves of a slice.
+     */
+    unsigned maxCurves() const
+    { return maxCurves_; }
+
+    /*!
+     * \brief Return the storage area of a slice.
+     */
+    ScanningCurve* slice(size_t sliceIdx)
+    {
+        assert(sliceIdx < numSlices_);
+        return curves_.data() + sliceIdx*sliceSize_();
+    }
+
+private:
+    // the sentinel in front of the main drainage curve requires an additional
+    // entry
+    size_t sliceSize_() const
+    { return maxCurves_ + 1; }
+
+    std::vector<ScanningCurve> curves_;
+    size_t numSlices_;
+    unsigned maxCurves_;
+};
+
+} // namespace Opm
+
+#endif
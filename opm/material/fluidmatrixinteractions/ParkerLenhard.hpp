@@ -36,199 +36,6 @@
 
 namespace Opm {
 
-/*!
- * \brief Represents a scanning curve in the Parker-Lenhard hysteresis model.
- *
- * The class has pointers to the scanning curves
- * with higher and lower loop number, this saving
- * the history of the imbibitions and drainages.
- */
-template <class ScalarT>
-class PLScanningCurve
-{
-public:
-    typedef ScalarT Scalar;
-
-    /*!
-     * \brief Constructs main imbibition curve.
-     *
-     * Further scanning curves can be added with
-     * setNext.
-     */
-    PLScanningCurve(Scalar Swr)
-    {
-        loopNum_ = 0;
-        prev_ = new PLScanningCurve(NULL, // prev
-                                    this, // next
-                                    -1, // loop number
-                                    Swr, // Sw
-                                    1e12, // pcnw
-                                    Swr, // SwMic
-                                    Swr); // SwMdc
-        next_ = NULL;
-
-        Sw_ = 1.0;
-        pcnw_ = 0.0;
-        SwMic_ = 1.0;
-        SwMdc_ = 1.0;
-    }
-
-protected:
-    PLScanningCurve(PLScanningCurve* prevSC,
-                    PLScanningCurve* nextSC,
-                    int loopN,
-                    Scalar SwReversal,
-                    Scalar pcnwReversal,
-                    Scalar SwMiCurve,
-                    Scalar SwMdCurve)
-    {
-        prev_ = prevSC;
-        next_ = nextSC;
-        loopNum_ = loopN;
-        Sw_ = SwReversal;
-        pcnw_ = pcnwReversal;
-        SwMic_ = SwMiCurve;
-        SwMdc_ = SwMdCurve;
-    }
-
-public:
-    /*!
-     * \brief Destructor. After it was called
-     *        all references to the next() curve are
-     *        invalid!
-     */
-    ~PLScanningCurve()
-    {
-        if (loopNum_ == 0)
-            delete prev_;
-        if (loopNum_ >= 0)
-            delete next_;
-    }
-
-    /*!
-     * \brief Return the previous scanning curve, i.e. the curve
-     *        with one less reversal than the current one.
-     */
-    PLScanningCurve* prev() const
-    { return prev_; }
-
-    /*!
-     * \brief Return the next scanning curve, i.e. the curve
-     *        with one more reversal than the current one.
-     */
-    PLScanningCurve* next() const
-    { return next_; }
-
-    /*!
-     * \brief Set the next scanning curve.
-     *
-     * Next in the sense of the number of reversals
-     * from imbibition to drainage or vince versa. If this
-     * curve already has a list of next curves, it is
-     * deleted and thus forgotten.
-     */
-    void setNext(Scalar SwReversal,
-                 Scalar pcnwReversal,
-                 Scalar SwMiCurve,
-                 Scalar SwMdCurve)
-    {
-        // if next_ is NULL, delete does nothing, so
-        // this is valid!!
-        delete next_;
-
-        next_ = new PLScanningCurve(this, // prev
-                                    NULL, // next
-                                    loopNum() + 1,
-                                    SwReversal,
-                                    pcnwReversal,
-                                    SwMiCurve,
-                                    SwMdCurve);
-    }
-
-    /*!
-     * \brief Returns true iff the given effective saturation
-     *        Swei is within the scope of the curve, i.e.
-     *        whether Swei is part of the curve's
-     *        domain and the curve thus applies to Swi.
-     */
-    bool isValidAt_Sw(Scalar SwReversal)
-    {
-        if (isImbib())
-            // for inbibition the given saturation
-            // must be between the start of the
-            // current imbibition and the the start
-            // of the last drainage
-            return this->Sw() < SwReversal && SwReversal < prev_->Sw();
-        else
-            // for drainage the given saturation
-            // must be between the start of the
-            // last imbibition and the start
-            // of the current drainage
-            return prev_->Sw() < SwReversal && SwReversal < this->Sw();
-    }
-
-    /*!
-     * \brief Returns true iff the scanning curve is a
-     *        imbibition curve.
-     */
-    bool isImbib()
-    { return loopNum()%2 == 1; }
-
-    /*!
-     * \brief Returns true iff the scanning curve is a
-     *        drainage curve.
-     */
-    bool isDrain()
-    { return !isImbib(); }
-
-    /*!
-     * \brief The loop number of the scanning curve.
-     *
-     * The MDC is 0, PISC is 1, PDSC is 2, ...
-     */
-    int loopNum()
-    { return loopNum_; }
-
-    /*!
-     * \brief Absolute wetting-phase saturation at the
-     *        scanning curve's reversal point.
-     */
-    Scalar Sw() const
-    { return Sw_; }
-
-    /*!
-     * \brief Capillary pressure at the last reversal point.
-     */
-    Scalar pcnw() const
-    { return pcnw_; }
-
-    /*!
-     * \brief Apparent saturation of the last reversal point on
-     *        the pressure MIC.
-     */
-    Scalar SwMic()
-    { return SwMic_; }
-
-    /*!
-     * \brief Apparent saturation of the last reversal point on
-     *        the pressure MDC.
-     */
-    Scalar SwMdc()
-    { return SwMdc_; }
-
-private:
-    PLScanningCurve* prev_;
-    PLScanningCurve* next_;
-
-    int loopNum_;
-
-    Scalar Sw_;
-    Scalar pcnw_;
-
-    Scalar SwMdc_;
-    Scalar SwMic_;
-};
-
 /*!
  * \ingroup material
  * \brief Implements the Parker-Lenhard twophase
@@ -287,13 +94,7 @@ public:
      *        initial parameters on the main drainage curve
      */
     static void reset(Params& params)
-    {
-        delete params.mdc(); // this will work even if mdc_ == NULL!
-        params.setMdc(new ScanningCurve(params.SwrPc()));
-        params.setCsc(params.mdc());
-        params.setPisc(NULL);
-        params.setCurrentSnr(0.0);
-    }
+    { params.resetHysteresis(); }
 
     /*!
      * \brief Set the current absolute saturation for the
@@ -322,9 +123,11 @@ public:
         Scalar Sw_mic = VanGenuchten::twoPhaseSatSw(params.micParams(), pc);
         Scalar Sw_mdc = VanGenuchten::twoPhaseSatSw(params.mdcParams(), pc);
 
+        // make room for the new scanning curve if the storage is exhausted
+        if (!params.canAddScanningCurve(curve))
+            curve = params.growScanningCurves(curve);
+
         curve->setNext(Sw, pc, Sw_mic, Sw_mdc);
-        if (!curve->next())
-            return;
 
         params.setCsc(curve);
 
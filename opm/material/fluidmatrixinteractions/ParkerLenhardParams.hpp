@@ -28,19 +28,29 @@
 #define OPM_PARKER_LENHARD_PARAMS_HPP
 
 #include <opm/material/fluidmatrixinteractions/RegularizedVanGenuchten.hpp>
+#include <opm/material/fluidmatrixinteractions/PLScanningCurve.hpp>
 #include <opm/material/common/EnsureFinalized.hpp>
 
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <string>
 #include <cassert>
 
 namespace Opm
 {
-// forward declaration
-template <class ScalarT>
-class PLScanningCurve;
-
 /*!
  * \brief Default parameter class for the Parker-Lenhard hysteresis
  *        model.
+ *
+ * The scanning curves of the hysteresis history are kept in a contiguous
+ * storage area. By default, each object allocates this area when it is
+ * constructed and doubles its capacity if a reversal does not fit anymore, so
+ * updating the hysteresis only allocates memory if the history becomes deeper
+ * than ever before. For large grids, the storage of all cells should be taken
+ * from a PLScanningCurveArena instead. The slices of an arena cannot grow, so
+ * their capacity must be chosen large enough for the expected number of
+ * reversals.
  */
 template <class TraitsT>
 class ParkerLenhardParams : public EnsureFinalized
@@ -52,25 +62,126 @@ public:
     typedef Opm::RegularizedVanGenuchten<TraitsT> VanGenuchten;
     typedef typename VanGenuchten::Params VanGenuchtenParams;
     typedef PLScanningCurve<Scalar> ScanningCurve;
+    typedef PLScanningCurveArena<Scalar> ScanningCurveArena;
+
+    //! The initial maximum number of scanning curves if no arena is used
+    static const unsigned defaultMaxScanningCurves = 32;
 
-    ParkerLenhardParams()
+    /*!
+     * \brief Create a parameter object which owns its scanning curves.
+     *
+     * The maximum number of scanning curves includes the main drainage curve,
+     * so it must be at least 1.
+     */
+    explicit ParkerLenhardParams(unsigned maxScanningCurves = defaultMaxScanningCurves)
     {
         currentSnr_ = 0;
-        mdc_ = new ScanningCurve(/*Swr=*/0);
-        pisc_ = csc_ = NULL;
+        SwrPc_ = 0;
+        allocateScanningCurves_(maxScanningCurves);
+        resetScanningCurves_(SwrPc_);
     }
 
+    /*!
+     * \brief Copy constructor.
+     *
+     * The hysteresis history is not copied and the new object always uses
+     * its own storage for the scanning curves.
+     */
     ParkerLenhardParams(const ParkerLenhardParams& p)
         : EnsureFinalized( p )
     {
         currentSnr_ = 0;
         SwrPc_ = p.SwrPc_;
-        mdc_ = new ScanningCurve(SwrPc_);
-        pisc_ = csc_ = NULL;
+        allocateScanningCurves_(p.maxScanningCurves_);
+        resetScanningCurves_(SwrPc_);
+    }
+
+    ParkerLenhardParams& operator=(const ParkerLenhardParams&) = delete;
+
+    /*!
+     * \brief Use a slice of an arena to store the scanning curves.
+     *
+     * The hysteresis history is reset, and the arena must outlive this
+     * object.
+     */
+    void setScanningCurveStorage(ScanningCurveArena& arena, size_t sliceIdx)
+    {
+        ownScanningCurves_.reset();
+        curves_ = arena.slice(sliceIdx);
+        maxScanningCurves_ = arena.maxCurves();
+        resetScanningCurves_(SwrPc_);
     }
 
-    ~ParkerLenhardParams()
-    { delete mdc_; }
+    /*!
+     * \brief Returns the maximum number of scanning curves, including the main
+     *        drainage curve.
+     */
+    unsigned maxScanningCurves() const
+    { return maxScanningCurves_; }
+
+    /*!
+     * \brief Use storage owned by this object for a given maximum number of
+     *        scanning curves.
+     *
+     * The hysteresis history is reset. If the object previously used the
+     * slice of an arena, the slice is not used anymore.
+     */
+    void setMaxScanningCurves(unsigned maxCurves)
+    {
+        allocateScanningCurves_(maxCurves);
+        resetScanningCurves_(SwrPc_);
+    }
+
+    /*!
+     * \brief Returns true iff the scanning curves are stored in the slice of
+     *        an arena.
+     */
+    bool usesScanningCurveArena() const
+    { return !ownScanningCurves_; }
+
+    /*!
+     * \brief Forget the hysteresis history and start over on the main drainage
+     *        curve.
+     */
+    void resetHysteresis()
+    {
+        resetScanningCurves_(SwrPc());
+        currentSnr_ = 0.0;
+    }
+
+    /*!
+     * \brief Returns true iff a new scanning curve can be added after a given
+     *        one without exceeding the capacity of the storage.
+     */
+    bool canAddScanningCurve(const ScanningCurve* curve) const
+    { return curve->loopNum() + 1 < static_cast<int>(maxScanningCurves_); }
+
+    /*!
+     * \brief Double the capacity of the storage for the scanning curves while
+     *        keeping the hysteresis history.
+     *
+     * Since this moves the curves, the location of a given curve in the new
+     * storage is returned. The storage of an arena slice cannot grow, so
+     * std::runtime_error is thrown in this case.
+     */
+    ScanningCurve* growScanningCurves(const ScanningCurve* curve)
+    {
+        if (usesScanningCurveArena())
+            throw std::runtime_error("The capacity of the Parker-Lenhard scanning curve arena ("
+                                     + std::to_string(maxScanningCurves_)
+                                     + " curves per slice) has been exceeded");
+
+        const ScanningCurve* oldCurves = curves_;
+        const unsigned oldMaxCurves = maxScanningCurves_;
+        std::unique_ptr<ScanningCurve[]> oldStorage(ownScanningCurves_.release());
+        allocateScanningCurves_(2*oldMaxCurves);
+        std::copy(oldCurves, oldCurves + oldMaxCurves + 1, curves_);
+
+        if (pisc_)
+            pisc_ = curves_ + (pisc_ - oldCurves);
+        csc_ = curves_ + (csc_ - oldCurves);
+        return curves_ + (curve - oldCurves);
+    }
 
     /*!
      * \brief Returns the parameters of the main imbibition curve (which uses
@@ -153,13 +264,7 @@ public:
      * \brief Returns the main drainage curve
      */
     ScanningCurve* mdc() const
-    { EnsureFinalized::check(); return mdc_; }
-
-    /*!
-     * \brief Set the main drainage curve.
-     */
-    void setMdc(ScanningCurve* val)
-    { mdc_ = val; }
+    { EnsureFinalized::check(); return curves_ + 1; }
 
     /*!
      * \brief Returns the primary imbibition scanning curve
@@ -186,13 +291,33 @@ public:
     { csc_ = val; }
 
 private:
+    void allocateScanningCurves_(unsigned maxCurves)
+    {
+        assert(maxCurves >= 1);
+
+        // the sentinel in front of the main drainage curve requires an
+        // additional entry
+        ownScanningCurves_.reset(new ScanningCurve[maxCurves + 1]);
+        curves_ = ownScanningCurves_.get();
+        maxScanningCurves_ = maxCurves;
+    }
+
+    void resetScanningCurves_(Scalar Swr)
+    {
+        ScanningCurve::initMdc(curves_, Swr);
+        pisc_ = nullptr;
+        csc_ = curves_ + 1;
+    }
+
     const VanGenuchtenParams* micParams_;
     const VanGenuchtenParams* mdcParams_;
     Scalar SwrPc_;
     Scalar SwrKr_;
     Scalar Snr_;
     Scalar currentSnr_;
-    mutable ScanningCurve* mdc_;
+    std::unique_ptr<ScanningCurve[]> ownScanningCurves_;
+    ScanningCurve* curves_;
+    unsigned maxScanningCurves_;
     mutable ScanningCurve* pisc_;
     mutable ScanningCurve* csc_;
 };
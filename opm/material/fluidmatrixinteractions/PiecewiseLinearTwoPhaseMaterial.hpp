@@ -140,7 +140,7 @@ public:
      */
     template <class Evaluation>
     static Evaluation twoPhaseSatPcnw(const Params& params, const Evaluation& Sw)
-    { return eval_(params.SwPcwnSamples(), params.pcnwSamples(), Sw); }
+    { return evalCurve_(params.SwPcwnSamples(), params.pcnwSamples(), params.pcnwSegmentCoeffs(), Sw); }
 
     template <class Evaluation>
     static Evaluation twoPhaseSatPcnwInv(const Params& params, const Evaluation& pcnw)
@@ -184,7 +184,7 @@ public:
 
     template <class Evaluation>
     static Evaluation twoPhaseSatKrw(const Params& params, const Evaluation& Sw)
-    { return eval_(params.SwKrwSamples(), params.krwSamples(), Sw); }
+    { return evalCurve_(params.SwKrwSamples(), params.krwSamples(), params.krwSegmentCoeffs(), Sw); }
 
     template <class Evaluation>
     static Evaluation twoPhaseSatKrwInv(const Params& params, const Evaluation& krw)
@@ -205,13 +205,106 @@ public:
 
     template <class Evaluation>
     static Evaluation twoPhaseSatKrn(const Params& params, const Evaluation& Sw)
-    { return eval_(params.SwKrnSamples(), params.krnSamples(), Sw); }
+    { return evalCurve_(params.SwKrnSamples(), params.krnSamples(), params.krnSegmentCoeffs(), Sw); }
 
     template <class Evaluation>
     static Evaluation twoPhaseSatKrnInv(const Params& params, const Evaluation& krn)
     { return eval_(params.krnSamples(), params.SwKrnSamples(), krn); }
 
+    /*!
+     * \brief The relative permeabilities of both phases and the capillary pressure
+     *        for a given wetting phase saturation.
+     *
+     * If all curves are sampled at the same saturations, the saturation segment is
+     * only looked up once. Each curve is then evaluated in this segment exactly like
+     * twoPhaseSatKrw(), twoPhaseSatKrn() and twoPhaseSatPcnw() do: compiled curves
+     * use the precomputed slope and intercept of the segment, the others divide by
+     * the width of the segment. The results are thus the same as the ones of the
+     * separate methods.
+     */
+    template <class Evaluation>
+    static void twoPhaseSatAll(const Params& params,
+                               const Evaluation& Sw,
+                               Evaluation& krw,
+                               Evaluation& krn,
+                               Evaluation& pcnw)
+    {
+        if (!params.sharedSwSamples()) {
+            krw = twoPhaseSatKrw(params, Sw);
+            krn = twoPhaseSatKrn(params, Sw);
+            pcnw = twoPhaseSatPcnw(params, Sw);
+            return;
+        }
+
+        const ValueVector& SwSamples = params.SwKrwSamples();
+        const ValueVector& krwSamples = params.krwSamples();
+        const ValueVector& krnSamples = params.krnSamples();
+        const ValueVector& pcnwSamples = params.pcnwSamples();
+
+        if (Sw <= SwSamples.front()) {
+            krw = krwSamples.front();
+            krn = krnSamples.front();
+            pcnw = pcnwSamples.front();
+            return;
+        }
+        if (Sw >= SwSamples.back()) {
+            krw = krwSamples.back();
+            krn = krnSamples.back();
+            pcnw = pcnwSamples.back();
+            return;
+        }
+
+        size_t segIdx = findSegmentIndex_(SwSamples, Opm::scalarValue(Sw));
+
+        krw = evalSegment_(SwSamples, krwSamples, params.krwSegmentCoeffs(), segIdx, Sw);
+        krn = evalSegment_(SwSamples, krnSamples, params.krnSegmentCoeffs(), segIdx, Sw);
+        pcnw = evalSegment_(SwSamples, pcnwSamples, params.pcnwSegmentCoeffs(), segIdx, Sw);
+    }
+
 private:
+    // evaluate a curve of the parameter object, using the slopes and intercepts of its
+    // segments if it has been compiled
+    template <class Evaluation>
+    static Evaluation evalCurve_(const ValueVector& xValues,
+                                 const ValueVector& yValues,
+                                 const ValueVector& segmentCoeffs,
+                                 const Evaluation& x)
+    {
+        if (segmentCoeffs.empty())
+            return eval_(xValues, yValues, x);
+
+        if (x <= xValues.front())
+            return yValues.front();
+        if (x >= xValues.back())
+            return yValues.back();
+
+        size_t segIdx = findSegmentIndex_(xValues, Opm::scalarValue(x));
+        return evalSegment_(xValues, yValues, segmentCoeffs, segIdx, x);
+    }
+
+    // evaluate a curve with ascending abscissas within a given segment. if the
+    // coefficient vector is empty, the curve has not been compiled
+    template <class Evaluation>
+    static Evaluation evalSegment_(const ValueVector& xValues,
+                                   const ValueVector& yValues,
+                                   const ValueVector& segmentCoeffs,
+                                   size_t segIdx,
+                                   const Evaluation& x)
+    {
+        if (!segmentCoeffs.empty())
+            return segmentCoeffs[2*segIdx + 1] + segmentCoeffs[2*segIdx]*x;
+
+        Scalar x0 = xValues[segIdx];
+        Scalar x1 = xValues[segIdx + 1];
+
+        Scalar y0 = yValues[segIdx];
+        Scalar y1 = yValues[segIdx + 1];
+
+        Scalar m = (y1 - y0)/(x1 - x0);
+
+        return y0 + (x - x0)*m;
+    }
+
     template <class Evaluation>
     static Evaluation eval_(const ValueVector& xValues,
                             const ValueVector& yValues,
@@ -51,6 +51,8 @@ public:
     typedef TraitsT Traits;
 
     PiecewiseLinearTwoPhaseMaterialParams()
+        : sharedSwSamples_(false)
+        , compiled_(false)
     {
     }
 
@@ -74,8 +76,67 @@ public:
         if (SwKrnSamples_.front() > SwKrnSamples_.back())
             swapOrder_(SwKrnSamples_, krnSamples_);
 
+        updateSharedSwSamples_();
     }
 
+    /*!
+     * \brief Precompute the slope and the intercept of each segment of the curves.
+     *
+     * This must be called after finalize(). Afterwards, evaluating a curve only needs
+     * a single multiply-add instead of a division. Since the intercepts are taken at
+     * \f$S_w = 0\f$, the results may differ from the ones of the uncompiled curves in
+     * the last few bits.
+     */
+    void compile()
+    {
+        EnsureFinalized::check();
+
+        compileCurve_(SwPcwnSamples_, pcwnSamples_, pcnwSegmentCoeffs_);
+        compileCurve_(SwKrwSamples_, krwSamples_, krwSegmentCoeffs_);
+        compileCurve_(SwKrnSamples_, krnSamples_, krnSegmentCoeffs_);
+        compiled_ = true;
+    }
+
+    /*!
+     * \brief Returns true if compile() has been called.
+     */
+    bool isCompiled() const
+    { return compiled_; }
+
+    /*!
+     * \brief The slopes and intercepts of the segments of the capillary pressure
+     *        curve.
+     *
+     * The slope of segment i is stored at index 2i, its intercept at 2i + 1. The vector
+     * is empty if the curve has not been compiled.
+     */
+    const ValueVector& pcnwSegmentCoeffs() const
+    { return pcnwSegmentCoeffs_; }
+
+    /*!
+     * \brief The slopes and intercepts of the segments of the relative permeability
+     *        curve of the wetting phase.
+     */
+    const ValueVector& krwSegmentCoeffs() const
+    { return krwSegmentCoeffs_; }
+
+    /*!
+     * \brief The slopes and intercepts of the segments of the relative permeability
+     *        curve of the non-wetting phase.
+     */
+    const ValueVector& krnSegmentCoeffs() const
+    { return krnSegmentCoeffs_; }
+
+    /*!
+     * \brief Returns true if the capillary pressure and both relative permeability
+     *        curves are sampled at the same saturations.
+     *
+     * This is the case for tables derived from SWOF or SGOF keywords and allows to
+     * evaluate all curves using a single lookup of the saturation segment.
+     */
+    bool sharedSwSamples() const
+    { EnsureFinalized::check(); return sharedSwSamples_; }
+
     /*!
      * \brief Return the wetting-phase saturation values of all sampling points.
      */
@@ -118,6 +179,9 @@ public:
 
         std::copy(SwValues.begin(), SwValues.end(), SwPcwnSamples_.begin());
         std::copy(values.begin(), values.end(), pcwnSamples_.begin());
+
+        pcnwSegmentCoeffs_.clear();
+        compiled_ = false;
     }
 
     /*!
@@ -146,6 +210,9 @@ public:
 
         std::copy(SwValues.begin(), SwValues.end(), SwKrwSamples_.begin());
         std::copy(values.begin(), values.end(), krwSamples_.begin());
+
+        krwSegmentCoeffs_.clear();
+        compiled_ = false;
     }
 
     /*!
@@ -174,9 +241,74 @@ public:
 
         std::copy(SwValues.begin(), SwValues.end(), SwKrnSamples_.begin());
         std::copy(values.begin(), values.end(), krnSamples_.begin());
+
+        krnSegmentCoeffs_.clear();
+        compiled_ = false;
+    }
+
+    template <class Serializer>
+    void serializeOp(Serializer& serializer)
+    {
+        serializer(SwPcwnSamples_);
+        serializer(SwKrwSamples_);
+        serializer(SwKrnSamples_);
+        serializer(pcwnSamples_);
+        serializer(krwSamples_);
+        serializer(krnSamples_);
+
+        // the coefficients of the compiled curves are not stored but recomputed
+        bool compiled = compiled_;
+        serializer(compiled);
+
+        if (serializer.isLoading()) {
+            updateSharedSwSamples_();
+            EnsureFinalized::finalize();
+
+            pcnwSegmentCoeffs_.clear();
+            krwSegmentCoeffs_.clear();
+            krnSegmentCoeffs_.clear();
+            compiled_ = false;
+            if (compiled)
+                compile();
+        }
     }
 
 private:
+    // only curves with ascending saturations are compiled, the others keep an empty
+    // coefficient vector and are evaluated the conventional way
+    static void compileCurve_(const ValueVector& xValues,
+                              const ValueVector& yValues,
+                              ValueVector& coeffs)
+    {
+        coeffs.clear();
+        if (xValues.size() < 2 || !(xValues.front() < xValues.back()))
+            return;
+
+        size_t numSegments = xValues.size() - 1;
+        coeffs.resize(2*numSegments);
+        for (size_t segIdx = 0; segIdx < numSegments; ++segIdx) {
+            Scalar x0 = xValues[segIdx];
+            Scalar x1 = xValues[segIdx + 1];
+
+            Scalar y0 = yValues[segIdx];
+            Scalar y1 = yValues[segIdx + 1];
+
+            // zero-width segments are never selected by the segment lookup
+            Scalar m = (x1 > x0) ? (y1 - y0)/(x1 - x0) : 0.0;
+            coeffs[2*segIdx] = m;
+            coeffs[2*segIdx + 1] = y0 - m*x0;
+        }
+    }
+
+    void updateSharedSwSamples_()
+    {
+        sharedSwSamples_ =
+            SwPcwnSamples_ == SwKrwSamples_
+            && SwKrwSamples_ == SwKrnSamples_
+            && SwKrwSamples_.size() > 1
+            && SwKrwSamples_.front() < SwKrwSamples_.back();
+    }
+
     void swapOrder_(ValueVector& swValues, ValueVector& values) const
     {
         if (swValues.front() > values.back()) {
@@ -198,6 +330,13 @@ private:
     ValueVector pcwnSamples_;
     ValueVector krwSamples_;
     ValueVector krnSamples_;
+
+    ValueVector pcnwSegmentCoeffs_;
+    ValueVector krwSegmentCoeffs_;
+    ValueVector krnSegmentCoeffs_;
+
+    bool sharedSwSamples_;
+    bool compiled_;
 };
 } // namespace Opm
 
@@ -0,0 +1,100 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+
+  Consult the COPYING file in the top-level source directory of this
+  module for the precise wording of the license and the list of
+  copyright holders.
+*/
+/*!
+ * \file
+ * \copydoc Opm::TwoPhaseSatAllHelper
+ */
+#ifndef OPM_TWO_PHASE_SAT_ALL_HELPER_HPP
+#define OPM_TWO_PHASE_SAT_ALL_HELPER_HPP
+
+#include <type_traits>
+
+namespace Opm {
+namespace TwoPhaseSatAllDetail {
+template <class TwoPhaseLaw, class Evaluation, class = void>
+struct HasTwoPhaseSatAll : public std::false_type {};
+
+template <class TwoPhaseLaw, class Evaluation>
+struct HasTwoPhaseSatAll<TwoPhaseLaw, Evaluation,
+                         decltype(void(TwoPhaseLaw::twoPhaseSatAll(std::declval<const typename TwoPhaseLaw::Params&>(),
+                                                                   std::declval<const Evaluation&>(),
+                                                                   std::declval<Evaluation&>(),
+                                                                   std::declval<Evaluation&>(),
+                                                                   std::declval<Evaluation&>())))>
+    : public std::true_type {};
+} // namespace TwoPhaseSatAllDetail
+
+/*!
+ * \ingroup FluidMatrixInteractions
+ *
+ * \brief Evaluates the relative permeabilities and the capillary pressure of a
+ *        two-phase material law for the same wetting phase saturation.
+ *
+ * If the material law provides a fused twoPhaseSatAll() method, this is used,
+ * else the quantities are evaluated separately using the two-phase saturation
+ * API.
+ */
+template <class TwoPhaseLaw>
+class TwoPhaseSatAllHelper
+{
+    typedef typename TwoPhaseLaw::Params Params;
+
+public:
+    template <class Evaluation>
+    static void eval(const Params& params,
+                     const Evaluation& Sw,
+                     Evaluation& krw,
+                     Evaluation& krn,
+                     Evaluation& pcnw)
+    {
+        eval_(params, Sw, krw, krn, pcnw,
+              TwoPhaseSatAllDetail::HasTwoPhaseSatAll<TwoPhaseLaw, Evaluation>());
+    }
+
+private:
+    template <class Evaluation>
+    static void eval_(const Params& params,
+                      const Evaluation& Sw,
+                      Evaluation& krw,
+                      Evaluation& krn,
+                      Evaluation& pcnw,
+                      std::true_type)
+    { TwoPhaseLaw::twoPhaseSatAll(params, Sw, krw, krn, pcnw); }
+
+    template <class Evaluation>
+    static void eval_(const Params& params,
+                      const Evaluation& Sw,
+                      Evaluation& krw,
+                      Evaluation& krn,
+                      Evaluation& pcnw,
+                      std::false_type)
+    {
+        krw = TwoPhaseLaw::twoPhaseSatKrw(params, Sw);
+        krn = TwoPhaseLaw::twoPhaseSatKrn(params, Sw);
+        pcnw = TwoPhaseLaw::twoPhaseSatPcnw(params, Sw);
+    }
+};
+
+} // namespace Opm
+
+#endif
@@ -175,71 +175,210 @@ public:
         unsigned regionIdx_;
     };
 
+    /*!
+     * \brief The complete state of a black-oil fluid system.
+     *
+     * All static methods of BlackOilFluidSystem operate on the instance which is active
+     * for the calling thread. By default, this is a single instance which is shared by
+     * all threads, so a program which does not deal with instances explicitly behaves
+     * as if the fluid system only consisted of static attributes. Several fluid models
+     * can be used within the same process by activating a different instance on each
+     * thread using ScopedInstance. Copying an instance does not copy the PVT objects,
+     * i.e., the tables which are not modified afterwards are shared by the copies.
+     *
+     * The active instance is a property of the thread, i.e., threads which are started
+     * by the program or by OpenMP use the global instance regardless of the instance
+     * which is active for the thread that starts them. This is not detected: A thread
+     * which does not activate an instance silently reads and modifies the global one.
+     * To use another instance within a parallel region, it must thus be activated by
+     * each thread of the region, e.g.:
+     *
+     * \code
+     * auto& instance = FluidSystem::activeInstance();
+     * #pragma omp parallel
+     * {
+     *     typename FluidSystem::ScopedInstance scope(instance);
+     *     // ...
+     * }
+     * \endcode
+     *
+     * Since the active instance is looked up in thread-local storage, each call of a
+     * static method costs an additional indirection compared to plain static
+     * attributes. The static attributes surfacePressure and surfaceTemperature are
+     * kept for compatibility; they always refer to the global instance.
+     */
+    class Instance
+    {
+        friend class BlackOilFluidSystem;
+
+        Scalar reservoirTemperature_ = 0.0;
+        Scalar surfaceTemperature_ = 273.15 + 15.56; // [K]
+        Scalar surfacePressure_ = 1.01325e5; // [Pa]
+
+        std::shared_ptr<GasPvt> gasPvt_;
+        std::shared_ptr<OilPvt> oilPvt_;
+        std::shared_ptr<WaterPvt> waterPvt_;
+
+        bool enableDissolvedGas_ = false;
+        bool enableVaporizedOil_ = false;
+        bool enableDiffusion_ = false;
+
+        // HACK for GCC 4.4: the array size has to be specified using the literal value '3'
+        // here, because GCC 4.4 seems to be unable to determine the number of phases from
+        // the BlackOil fluid system in the attribute declaration below...
+        std::vector<std::array<Scalar, /*numPhases=*/3> > referenceDensity_;
+        std::vector<std::array<Scalar, /*numComponents=*/3> > molarMass_;
+        std::vector<std::array<Scalar, /*numComponents=*/3 * /*numPhases=*/3> > diffusionCoefficients_;
+
+        unsigned char numActivePhases_ = 0;
+        std::array<bool, /*numPhases=*/3> phaseIsActive_{};
+        std::array<short, /*numPhases=*/3> activeToCanonicalPhaseIdx_{};
+        std::array<short, /*numPhases=*/3> canonicalToActivePhaseIdx_{};
+
+        bool isInitialized_ = false;
+
+    public:
+        /*!
+         * \brief The pressure at the surface [Pa].
+         */
+        Scalar surfacePressure() const
+        { return surfacePressure_; }
+
+        /*!
+         * \brief The temperature at the surface [K].
+         */
+        Scalar surfaceTemperature() const
+        { return surfaceTemperature_; }
+
+        /*!
+         * \brief Store or load the complete state of the instance.
+         *
+         * This allows to skip the initialization from the deck, e.g., for restarts;
+         * see saveBinary() and loadBinary().
+         */
+        template <class Serializer>
+        void serializeOp(Serializer& serializer)
+        {
+            serializer(reservoirTemperature_);
+            serializer(surfaceTemperature_);
+            serializer(surfacePressure_);
+            serializer(gasPvt_);
+            serializer(oilPvt_);
+            serializer(waterPvt_);
+            serializer(enableDissolvedGas_);
+            serializer(enableVaporizedOil_);
+            serializer(enableDiffusion_);
+            serializer(referenceDensity_);
+            serializer(molarMass_);
+            serializer(diffusionCoefficients_);
+            serializer(numActivePhases_);
+            serializer(phaseIsActive_);
+            serializer(activeToCanonicalPhaseIdx_);
+            serializer(canonicalToActivePhaseIdx_);
+            serializer(isInitialized_);
+        }
+    };
+
+    /*!
+     * \brief Makes an instance of the fluid system the active one of the calling
+     *        thread during its lifetime.
+     *
+     * The previously active instance is restored by the destructor. The instance must
+     * outlive the ScopedInstance object.
+     */
+    class ScopedInstance
+    {
+    public:
+        explicit ScopedInstance(Instance& instance)
+            : previousInstance_(activeInstance_)
+        { activeInstance_ = &instance; }
+
+        ~ScopedInstance()
+        { activeInstance_ = previousInstance_; }
+
+        ScopedInstance(const ScopedInstance&) = delete;
+        ScopedInstance& operator=(const ScopedInstance&) = delete;
+
+    private:
+        Instance* previousInstance_;
+    };
+
+    /*!
+     * \brief Returns the instance of the fluid system which is used by the calling
+     *        thread.
+     */
+    static Instance& activeInstance()
+    { return instance_(); }
+
     /****************************************
      * Initialization
      ****************************************/
 #if HAVE_ECL_INPUT
     /*!
      * \brief Initialize the fluid system using an ECL deck object
+     *
+     * If lazyTables is true, the interpolation tables of the PVT regions are built
+     * when a region is used for the first time instead of all at once. Currently,
+     * this applies to the PVTO tables of live oil.
      */
-    static void initFromState(const EclipseState& eclState, const Schedule& schedule)
+    static void initFromState(const EclipseState& eclState, const Schedule& schedule, bool lazyTables = false)
     {
         size_t numRegions = eclState.runspec().tabdims().getNumPVTTables();
         initBegin(numRegions);
 
-        numActivePhases_ = 0;
-        std::fill_n(&phaseIsActive_[0], numPhases, false);
+        instance_().numActivePhases_ = 0;
+        std::fill_n(&instance_().phaseIsActive_[0], numPhases, false);
 
 
         if (eclState.runspec().phases().active(Phase::OIL)) {
-            phaseIsActive_[oilPhaseIdx] = true;
-            ++ numActivePhases_;
+            instance_().phaseIsActive_[oilPhaseIdx] = true;
+            ++ instance_().numActivePhases_;
         }
 
         if (eclState.runspec().phases().active(Phase::GAS)) {
-            phaseIsActive_[gasPhaseIdx] = true;
-            ++ numActivePhases_;
+            instance_().phaseIsActive_[gasPhaseIdx] = true;
+            ++ instance_().numActivePhases_;
         }
 
         if (eclState.runspec().phases().active(Phase::WATER)) {
-            phaseIsActive_[waterPhaseIdx] = true;
-            ++ numActivePhases_;
+            instance_().phaseIsActive_[waterPhaseIdx] = true;
+            ++ instance_().numActivePhases_;
         }
 
         // set the surface conditions using the STCOND keyword
-        surfaceTemperature = eclState.getTableManager().stCond().temperature;
-        surfacePressure = eclState.getTableManager().stCond().pressure;
+        setSurfaceConditions(eclState.getTableManager().stCond().pressure,
+                             eclState.getTableManager().stCond().temperature);
 
         // The reservoir temperature does not really belong into the table manager. TODO:
         // change this in opm-parser
         setReservoirTemperature(eclState.getTableManager().rtemp());
 
         // this fluidsystem only supports two or three phases
-        assert(numActivePhases_ >= 1 && numActivePhases_ <= 3);
+        assert(instance_().numActivePhases_ >= 1 && instance_().numActivePhases_ <= 3);
 
         setEnableDissolvedGas(eclState.getSimulationConfig().hasDISGAS());
         setEnableVaporizedOil(eclState.getSimulationConfig().hasVAPOIL());
 
         if (phaseIsActive(gasPhaseIdx)) {
-            gasPvt_ = std::make_shared<GasPvt>();
-            gasPvt_->initFromState(eclState, schedule);
+            instance_().gasPvt_ = std::make_shared<GasPvt>();
+            instance_().gasPvt_->initFromState(eclState, schedule);
         }
 
         if (phaseIsActive(oilPhaseIdx)) {
-            oilPvt_ = std::make_shared<OilPvt>();
-            oilPvt_->initFromState(eclState, schedule);
+            instance_().oilPvt_ = std::make_shared<OilPvt>();
+            instance_().oilPvt_->initFromState(eclState, schedule, lazyTables);
         }
 
         if (phaseIsActive(waterPhaseIdx)) {
-            waterPvt_ = std::make_shared<WaterPvt>();
-            waterPvt_->initFromState(eclState, schedule);
+            instance_().waterPvt_ = std::make_shared<WaterPvt>();
+            instance_().waterPvt_->initFromState(eclState, schedule);
         }
 
         // set the reference densities of all PVT regions
         for (unsigned regionIdx = 0; regionIdx < numRegions; ++regionIdx) {
-            setReferenceDensities(phaseIsActive(oilPhaseIdx)? oilPvt_->oilReferenceDensity(regionIdx):700.,
-                                  phaseIsActive(waterPhaseIdx)? waterPvt_->waterReferenceDensity(regionIdx):1000.,
-                                  phaseIsActive(gasPhaseIdx)? gasPvt_->gasReferenceDensity(regionIdx):2.,
+            setReferenceDensities(phaseIsActive(oilPhaseIdx)? instance_().oilPvt_->oilReferenceDensity(regionIdx):700.,
+                                  phaseIsActive(waterPhaseIdx)? instance_().waterPvt_->waterReferenceDensity(regionIdx):1000.,
+                                  phaseIsActive(gasPhaseIdx)? instance_().gasPvt_->gasReferenceDensity(regionIdx):2.,
                                   regionIdx);
         }
 
@@ -252,8 +391,8 @@ public:
         // brine
         if (eclState.runspec().co2Storage()) {
             for (unsigned regionIdx = 0; regionIdx < numRegions; ++regionIdx) {
-                molarMass_[regionIdx][oilCompIdx] = BrineCo2Pvt<Scalar>::Brine::molarMass();
-                molarMass_[regionIdx][gasCompIdx] = BrineCo2Pvt<Scalar>::CO2::molarMass();
+                instance_().molarMass_[regionIdx][oilCompIdx] = BrineCo2Pvt<Scalar>::Brine::molarMass();
+                instance_().molarMass_[regionIdx][gasCompIdx] = BrineCo2Pvt<Scalar>::CO2::molarMass();
             }
         }
 
@@ -263,12 +402,12 @@ public:
             if(!diffCoeffTables.empty()) {
                 // if diffusion coefficient table is empty we relay on the PVT model to
                 // to give us the coefficients.
-                diffusionCoefficients_.resize(numRegions,{0,0,0,0,0,0,0,0,0});
+                instance_().diffusionCoefficients_.resize(numRegions,{0,0,0,0,0,0,0,0,0});
                 assert(diffCoeffTables.size() == numRegions);
                 for (unsigned regionIdx = 0; regionIdx < numRegions; ++regionIdx) {
                     const auto& diffCoeffTable = diffCoeffTables[regionIdx];
-                    molarMass_[regionIdx][oilCompIdx] = diffCoeffTable.oil_mw;
-                    molarMass_[regionIdx][gasCompIdx] = diffCoeffTable.gas_mw;
+                    instance_().molarMass_[regionIdx][oilCompIdx] = diffCoeffTable.oil_mw;
+                    instance_().molarMass_[regionIdx][gasCompIdx] = diffCoeffTable.gas_mw;
                     setDiffusionCoefficient(diffCoeffTable.gas_in_gas, gasCompIdx, gasPhaseIdx, regionIdx);
                     setDiffusionCoefficient(diffCoeffTable.oil_in_gas, oilCompIdx, gasPhaseIdx, regionIdx);
                     setDiffusionCoefficient(diffCoeffTable.gas_in_oil, gasCompIdx, oilPhaseIdx, regionIdx);
@@ -293,26 +432,37 @@ public:
      */
     static void initBegin(size_t numPvtRegions)
     {
-        isInitialized_ = false;
+        instance_().isInitialized_ = false;
 
-        enableDissolvedGas_ = true;
-        enableVaporizedOil_ = false;
-        enableDiffusion_ = false;
+        instance_().enableDissolvedGas_ = true;
+        instance_().enableVaporizedOil_ = false;
+        instance_().enableDiffusion_ = false;
 
-        oilPvt_ = nullptr;
-        gasPvt_ = nullptr;
-        waterPvt_ = nullptr;
+        instance_().oilPvt_ = nullptr;
+        instance_().gasPvt_ = nullptr;
+        instance_().waterPvt_ = nullptr;
 
-        surfaceTemperature = 273.15 + 15.56; // [K]
-        surfacePressure = 1.01325e5; // [Pa]
-        setReservoirTemperature(surfaceTemperature);
+        setSurfaceConditions(/*pressure=*/1.01325e5, /*temperature=*/273.15 + 15.56);
+        setReservoirTemperature(instance_().surfaceTemperature_);
 
-        numActivePhases_ = numPhases;
-        std::fill_n(&phaseIsActive_[0], numPhases, true);
+        instance_().numActivePhases_ = numPhases;
+        std::fill_n(&instance_().phaseIsActive_[0], numPhases, true);
 
         resizeArrays_(numPvtRegions);
     }
 
+    /*!
+     * \brief Set the pressure [Pa] and the temperature [K] at surface conditions.
+     *
+     * By default, these are the standard conditions of 1 atm and 15.56 degrees
+     * Celsius.
+     */
+    static void setSurfaceConditions(Scalar pressure, Scalar temperature)
+    {
+        instance_().surfacePressure_ = pressure;
+        instance_().surfaceTemperature_ = temperature;
+    }
+
     /*!
      * \brief Specify whether the fluid system should consider that the gas component can
      *        dissolve in the oil phase
@@ -320,7 +470,7 @@ public:
      * By default, dissolved gas is considered.
      */
     static void setEnableDissolvedGas(bool yesno)
-    { enableDissolvedGas_ = yesno; }
+    { instance_().enableDissolvedGas_ = yesno; }
 
     /*!
      * \brief Specify whether the fluid system should consider that the oil component can
@@ -329,7 +479,7 @@ public:
      * By default, vaporized oil is not considered.
      */
     static void setEnableVaporizedOil(bool yesno)
-    { enableVaporizedOil_ = yesno; }
+    { instance_().enableVaporizedOil_ = yesno; }
 
     /*!
      * \brief Specify whether the fluid system should consider diffusion
@@ -337,26 +487,26 @@ public:
      * By default, diffusion is not considered.
      */
     static void setEnableDiffusion(bool yesno)
-    { enableDiffusion_ = yesno; }
+    { instance_().enableDiffusion_ = yesno; }
 
 
     /*!
      * \brief Set the pressure-volume-saturation (PVT) relations for the gas phase.
      */
     static void setGasPvt(std::shared_ptr<GasPvt> pvtObj)
-    { gasPvt_ = pvtObj; }
+    { instance_().gasPvt_ = pvtObj; }
 
     /*!
      * \brief Set the pressure-volume-saturation (PVT) relations for the oil phase.
      */
     static void setOilPvt(std::shared_ptr<OilPvt> pvtObj)
-    { oilPvt_ = pvtObj; }
+    { instance_().oilPvt_ = pvtObj; }
 
     /*!
      * \brief Set the pressure-volume-saturation (PVT) relations for the water phase.
      */
     static void setWaterPvt(std::shared_ptr<WaterPvt> pvtObj)
-    { waterPvt_ = pvtObj; }
+    { instance_().waterPvt_ = pvtObj; }
 
     /*!
      * \brief Initialize the values of the reference densities
@@ -370,9 +520,9 @@ public:
                                       Scalar rhoGas,
                                       unsigned regionIdx)
     {
-        referenceDensity_[regionIdx][oilPhaseIdx] = rhoOil;
-        referenceDensity_[regionIdx][waterPhaseIdx] = rhoWater;
-        referenceDensity_[regionIdx][gasPhaseIdx] = rhoGas;
+        instance_().referenceDensity_[regionIdx][oilPhaseIdx] = rhoOil;
+        instance_().referenceDensity_[regionIdx][waterPhaseIdx] = rhoWater;
+        instance_().referenceDensity_[regionIdx][gasPhaseIdx] = rhoGas;
     }
 
 
@@ -382,42 +532,42 @@ public:
     static void initEnd()
     {
         // calculate the final 2D functions which are used for interpolation.
-        size_t numRegions = molarMass_.size();
+        size_t numRegions = instance_().molarMass_.size();
         for (unsigned regionIdx = 0; regionIdx < numRegions; ++ regionIdx) {
             // calculate molar masses
 
             // water is simple: 18 g/mol
-            molarMass_[regionIdx][waterCompIdx] = 18e-3;
+            instance_().molarMass_[regionIdx][waterCompIdx] = 18e-3;
 
             if (phaseIsActive(gasPhaseIdx)) {
                 // for gas, we take the density at standard conditions and assume it to be ideal
-                Scalar p = surfacePressure;
-                Scalar T = surfaceTemperature;
-                Scalar rho_g = referenceDensity_[/*regionIdx=*/0][gasPhaseIdx];
-                molarMass_[regionIdx][gasCompIdx] = Opm::Constants<Scalar>::R*T*rho_g / p;
+                Scalar p = instance_().surfacePressure_;
+                Scalar T = instance_().surfaceTemperature_;
+                Scalar rho_g = instance_().referenceDensity_[/*regionIdx=*/0][gasPhaseIdx];
+                instance_().molarMass_[regionIdx][gasCompIdx] = Opm::Constants<Scalar>::R*T*rho_g / p;
             }
             else
                 // hydrogen gas. we just set this do avoid NaNs later
-                molarMass_[regionIdx][gasCompIdx] = 2e-3;
+                instance_().molarMass_[regionIdx][gasCompIdx] = 2e-3;
 
             // finally, for oil phase, we take the molar mass from the spe9 paper
-            molarMass_[regionIdx][oilCompIdx] = 175e-3; // kg/mol
+            instance_().molarMass_[regionIdx][oilCompIdx] = 175e-3; // kg/mol
         }
 
 
         int activePhaseIdx = 0;
         for (unsigned phaseIdx = 0; phaseIdx < numPhases; ++phaseIdx) {
             if(phaseIsActive(phaseIdx)){
-                canonicalToActivePhaseIdx_[phaseIdx] = activePhaseIdx;
-                activeToCanonicalPhaseIdx_[activePhaseIdx] = phaseIdx;
+                instance_().canonicalToActivePhaseIdx_[phaseIdx] = activePhaseIdx;
+                instance_().activeToCanonicalPhaseIdx_[activePhaseIdx] = phaseIdx;
                 activePhaseIdx++;
             }
         }
-        isInitialized_ = true;
+        instance_().isInitialized_ = true;
     }
 
     static bool isInitialized()
-    { return isInitialized_; }
+    { return instance_().isInitialized_; }
 
     /****************************************
      * Generic phase properties
@@ -433,11 +583,11 @@ public:
     //! Index of the gas phase
     static const unsigned gasPhaseIdx = IndexTraits::gasPhaseIdx;
 
-    //! The pressure at the surface
-    static Scalar surfacePressure;
+    //! The pressure at the surface of the global instance, see Instance::surfacePressure()
+    static Scalar& surfacePressure;
 
-    //! The temperature at the surface
-    static Scalar surfaceTemperature;
+    //! The temperature at the surface of the global instance, see Instance::surfaceTemperature()
+    static Scalar& surfaceTemperature;
 
     //! \copydoc BaseFluidSystem::phaseName
     static const char* phaseName(unsigned phaseIdx)
@@ -476,20 +626,15 @@ public:
     //! Index of the gas component
     static const unsigned gasCompIdx = IndexTraits::gasCompIdx;
 
-protected:
-    static unsigned char numActivePhases_;
-    static std::array<bool,numPhases> phaseIsActive_;
-
-public:
     //! \brief Returns the number of active fluid phases (i.e., usually three)
     static unsigned numActivePhases()
-    { return numActivePhases_; }
+    { return instance_().numActivePhases_; }
 
     //! \brief Returns whether a fluid phase is active
     static unsigned phaseIsActive(unsigned phaseIdx)
     {
         assert(phaseIdx < numPhases);
-        return phaseIsActive_[phaseIdx];
+        return instance_().phaseIsActive_[phaseIdx];
     }
 
     //! \brief returns the index of "primary" component of a phase (solvent)
@@ -542,7 +687,7 @@ public:
 
     //! \copydoc BaseFluidSystem::molarMass
     static Scalar molarMass(unsigned compIdx, unsigned regionIdx = 0)
-    { return molarMass_[regionIdx][compIdx]; }
+    { return instance_().molarMass_[regionIdx][compIdx]; }
 
     //! \copydoc BaseFluidSystem::isIdealMixture
     static bool isIdealMixture(unsigned /*phaseIdx*/)
@@ -570,7 +715,7 @@ public:
      * By default, this is 1.
      */
     static size_t numRegions()
-    { return molarMass_.size(); }
+    { return instance_().molarMass_.size(); }
 
     /*!
      * \brief Returns whether the fluid system should consider that the gas component can
@@ -579,7 +724,7 @@ public:
      * By default, dissolved gas is considered.
      */
     static bool enableDissolvedGas()
-    { return enableDissolvedGas_; }
+    { return instance_().enableDissolvedGas_; }
 
     /*!
      * \brief Returns whether the fluid system should consider that the oil component can
@@ -588,7 +733,7 @@ public:
      * By default, vaporized oil is not considered.
      */
     static bool enableVaporizedOil()
-    { return enableVaporizedOil_; }
+    { return instance_().enableVaporizedOil_; }
 
     /*!
      * \brief Returns whether the fluid system should consider diffusion
@@ -596,7 +741,7 @@ public:
      * By default, diffusion is not considered.
      */
     static bool enableDiffusion()
-    { return enableDiffusion_; }
+    { return instance_().enableDiffusion_; }
 
     /*!
      * \brief Returns the density of a fluid phase at surface pressure [kg/m^3]
@@ -604,7 +749,7 @@ public:
      * \copydoc Doxygen::phaseIdxParam
      */
     static Scalar referenceDensity(unsigned phaseIdx, unsigned regionIdx)
-    { return referenceDensity_[regionIdx][phaseIdx]; }
+    { return instance_().referenceDensity_[regionIdx][phaseIdx]; }
 
     /****************************************
      * thermodynamic quantities (generic version)
@@ -665,7 +810,7 @@ public:
             if (enableDissolvedGas()) {
                 // miscible oil
                 const LhsEval& Rs = Opm::BlackOil::template getRs_<ThisType, FluidState, LhsEval>(fluidState, regionIdx);
-                const LhsEval& bo = oilPvt_->inverseFormationVolumeFactor(regionIdx, T, p, Rs);
+                const LhsEval& bo = instance_().oilPvt_->inverseFormationVolumeFactor(regionIdx, T, p, Rs);
 
                 return
                     bo*referenceDensity(oilPhaseIdx, regionIdx)
@@ -674,7 +819,7 @@ public:
 
             // immiscible oil
             const LhsEval Rs(0.0);
-            const auto& bo = oilPvt_->inverseFormationVolumeFactor(regionIdx, T, p, Rs);
+            const auto& bo = instance_().oilPvt_->inverseFormationVolumeFactor(regionIdx, T, p, Rs);
 
             return referenceDensity(phaseIdx, regionIdx)*bo;
         }
@@ -683,7 +828,7 @@ public:
             if (enableVaporizedOil()) {
                 // miscible gas
                 const LhsEval& Rv = Opm::BlackOil::template getRv_<ThisType, FluidState, LhsEval>(fluidState, regionIdx);
-                const LhsEval& bg = gasPvt_->inverseFormationVolumeFactor(regionIdx, T, p, Rv);
+                const LhsEval& bg = instance_().gasPvt_->inverseFormationVolumeFactor(regionIdx, T, p, Rv);
 
                 return
                     bg*referenceDensity(gasPhaseIdx, regionIdx)
@@ -692,14 +837,14 @@ public:
 
             // immiscible gas
             const LhsEval Rv(0.0);
-            const auto& bg = gasPvt_->inverseFormationVolumeFactor(regionIdx, T, p, Rv);
+            const auto& bg = instance_().gasPvt_->inverseFormationVolumeFactor(regionIdx, T, p, Rv);
             return bg*referenceDensity(phaseIdx, regionIdx);
         }
 
         case waterPhaseIdx:
             return
                 referenceDensity(waterPhaseIdx, regionIdx)
-                * waterPvt_->inverseFormationVolumeFactor(regionIdx, T, p, saltConcentration);
+                * instance_().waterPvt_->inverseFormationVolumeFactor(regionIdx, T, p, saltConcentration);
         }
 
         throw std::logic_error("Unhandled phase index "+std::to_string(phaseIdx));
@@ -728,7 +873,7 @@ public:
             if (enableDissolvedGas()) {
                 // miscible oil
                 const LhsEval& Rs = saturatedDissolutionFactor<FluidState, LhsEval>(fluidState, oilPhaseIdx, regionIdx);
-                const LhsEval& bo = oilPvt_->inverseFormationVolumeFactor(regionIdx, T, p, Rs);
+                const LhsEval& bo = instance_().oilPvt_->inverseFormationVolumeFactor(regionIdx, T, p, Rs);
 
                 return
                     bo*referenceDensity(oilPhaseIdx, regionIdx)
@@ -737,7 +882,7 @@ public:
 
             // immiscible oil
             const LhsEval Rs(0.0);
-            const LhsEval& bo = oilPvt_->inverseFormationVolumeFactor(regionIdx, T, p, Rs);
+            const LhsEval& bo = instance_().oilPvt_->inverseFormationVolumeFactor(regionIdx, T, p, Rs);
             return referenceDensity(phaseIdx, regionIdx)*bo;
         }
 
@@ -745,7 +890,7 @@ public:
             if (enableVaporizedOil()) {
                 // miscible gas
                 const LhsEval& Rv = saturatedDissolutionFactor<FluidState, LhsEval>(fluidState, gasPhaseIdx, regionIdx);
-                const LhsEval& bg = gasPvt_->inverseFormationVolumeFactor(regionIdx, T, p, Rv);
+                const LhsEval& bg = instance_().gasPvt_->inverseFormationVolumeFactor(regionIdx, T, p, Rv);
 
                 return
                     bg*referenceDensity(gasPhaseIdx, regionIdx)
@@ -754,7 +899,7 @@ public:
 
             // immiscible gas
             const LhsEval Rv(0.0);
-            const LhsEval& bg = gasPvt_->inverseFormationVolumeFactor(regionIdx, T, p, Rv);
+            const LhsEval& bg = instance_().gasPvt_->inverseFormationVolumeFactor(regionIdx, T, p, Rv);
 
             return referenceDensity(phaseIdx, regionIdx)*bg;
 
@@ -794,34 +939,34 @@ public:
             if (enableDissolvedGas()) {
                 const auto& Rs = Opm::BlackOil::template getRs_<ThisType, FluidState, LhsEval>(fluidState, regionIdx);
                 if (fluidState.saturation(gasPhaseIdx) > 0.0
-                    && Rs >= (1.0 - 1e-10)*oilPvt_->saturatedGasDissolutionFactor(regionIdx, Opm::scalarValue(T), Opm::scalarValue(p)))
+                    && Rs >= (1.0 - 1e-10)*instance_().oilPvt_->saturatedGasDissolutionFactor(regionIdx, Opm::scalarValue(T), Opm::scalarValue(p)))
                 {
-                    return oilPvt_->saturatedInverseFormationVolumeFactor(regionIdx, T, p);
+                    return instance_().oilPvt_->saturatedInverseFormationVolumeFactor(regionIdx, T, p);
                 } else {
-                    return oilPvt_->inverseFormationVolumeFactor(regionIdx, T, p, Rs);
+                    return instance_().oilPvt_->inverseFormationVolumeFactor(regionIdx, T, p, Rs);
                 }
             }
 
             const LhsEval Rs(0.0);
-            return oilPvt_->inverseFormationVolumeFactor(regionIdx, T, p, Rs);
+            return instance_().oilPvt_->inverseFormationVolumeFactor(regionIdx, T, p, Rs);
         }
         case gasPhaseIdx: {
             if (enableVaporizedOil()) {
                 const auto& Rv = Opm::BlackOil::template getRv_<ThisType, FluidState, LhsEval>(fluidState, regionIdx);
                 if (fluidState.saturation(oilPhaseIdx) > 0.0
-                    && Rv >= (1.0 - 1e-10)*gasPvt_->saturatedOilVaporizationFactor(regionIdx, Opm::scalarValue(T), Opm::scalarValue(p)))
+                    && Rv >= (1.0 - 1e-10)*instance_().gasPvt_->saturatedOilVaporizationFactor(regionIdx, Opm::scalarValue(T), Opm::scalarValue(p)))
                 {
-                    return gasPvt_->saturatedInverseFormationVolumeFactor(regionIdx, T, p);
+                    return instance_().gasPvt_->saturatedInverseFormationVolumeFactor(regionIdx, T, p);
                 } else {
-                    return gasPvt_->inverseFormationVolumeFactor(regionIdx, T, p, Rv);
+                    return instance_().gasPvt_->inverseFormationVolumeFactor(regionIdx, T, p, Rv);
                 }
             }
 
             const LhsEval Rv(0.0);
-            return gasPvt_->inverseFormationVolumeFactor(regionIdx, T, p, Rv);
+            return instance_().gasPvt_->inverseFormationVolumeFactor(regionIdx, T, p, Rv);
         }
         case waterPhaseIdx:
-            return waterPvt_->inverseFormationVolumeFactor(regionIdx, T, p, saltConcentration);
+            return instance_().waterPvt_->inverseFormationVolumeFactor(regionIdx, T, p, saltConcentration);
         default: throw std::logic_error("Unhandled phase index "+std::to_string(phaseIdx));
         }
     }
@@ -846,9 +991,9 @@ public:
         const auto& saltConcentration = Opm::decay<LhsEval>(fluidState.saltConcentration());
 
         switch (phaseIdx) {
-        case oilPhaseIdx: return oilPvt_->saturatedInverseFormationVolumeFactor(regionIdx, T, p);
-        case gasPhaseIdx: return gasPvt_->saturatedInverseFormationVolumeFactor(regionIdx, T, p);
-        case waterPhaseIdx: return waterPvt_->inverseFormationVolumeFactor(regionIdx, T, p, saltConcentration);
+        case oilPhaseIdx: return instance_().oilPvt_->saturatedInverseFormationVolumeFactor(regionIdx, T, p);
+        case gasPhaseIdx: return instance_().gasPvt_->saturatedInverseFormationVolumeFactor(regionIdx, T, p);
+        case waterPhaseIdx: return instance_().waterPvt_->inverseFormationVolumeFactor(regionIdx, T, p, saltConcentration);
         default: throw std::logic_error("Unhandled phase index "+std::to_string(phaseIdx));
         }
     }
@@ -895,11 +1040,11 @@ public:
                     // immiscible with the oil component
                     return phi_gG*1e6;
 
-                const auto& R_vSat = gasPvt_->saturatedOilVaporizationFactor(regionIdx, T, p);
+                const auto& R_vSat = instance_().gasPvt_->saturatedOilVaporizationFactor(regionIdx, T, p);
                 const auto& X_gOSat = convertRvToXgO(R_vSat, regionIdx);
                 const auto& x_gOSat = convertXgOToxgO(X_gOSat, regionIdx);
 
-                const auto& R_sSat = oilPvt_->saturatedGasDissolutionFactor(regionIdx, T, p);
+                const auto& R_sSat = instance_().oilPvt_->saturatedGasDissolutionFactor(regionIdx, T, p);
                 const auto& X_oGSat = convertRsToXoG(R_sSat, regionIdx);
                 const auto& x_oGSat = convertXoGToxoG(X_oGSat, regionIdx);
                 const auto& x_oOSat = 1.0 - x_oGSat;
@@ -931,12 +1076,12 @@ public:
                     // immiscible with the gas component
                     return phi_oO*1e6;
 
-                const auto& R_vSat = gasPvt_->saturatedOilVaporizationFactor(regionIdx, T, p);
+                const auto& R_vSat = instance_().gasPvt_->saturatedOilVaporizationFactor(regionIdx, T, p);
                 const auto& X_gOSat = convertRvToXgO(R_vSat, regionIdx);
                 const auto& x_gOSat = convertXgOToxgO(X_gOSat, regionIdx);
                 const auto& x_gGSat = 1.0 - x_gOSat;
 
-                const auto& R_sSat = oilPvt_->saturatedGasDissolutionFactor(regionIdx, T, p);
+                const auto& R_sSat = instance_().oilPvt_->saturatedGasDissolutionFactor(regionIdx, T, p);
                 const auto& X_oGSat = convertRsToXoG(R_sSat, regionIdx);
                 const auto& x_oGSat = convertXoGToxoG(X_oGSat, regionIdx);
 
@@ -993,38 +1138,38 @@ public:
             if (enableDissolvedGas()) {
                 const auto& Rs = Opm::BlackOil::template getRs_<ThisType, FluidState, LhsEval>(fluidState, regionIdx);
                 if (fluidState.saturation(gasPhaseIdx) > 0.0
-                    && Rs >= (1.0 - 1e-10)*oilPvt_->saturatedGasDissolutionFactor(regionIdx, Opm::scalarValue(T), Opm::scalarValue(p)))
+                    && Rs >= (1.0 - 1e-10)*instance_().oilPvt_->saturatedGasDissolutionFactor(regionIdx, Opm::scalarValue(T), Opm::scalarValue(p)))
                 {
-                    return oilPvt_->saturatedViscosity(regionIdx, T, p);
+                    return instance_().oilPvt_->saturatedViscosity(regionIdx, T, p);
                 } else {
-                    return oilPvt_->viscosity(regionIdx, T, p, Rs);
+                    return instance_().oilPvt_->viscosity(regionIdx, T, p, Rs);
                 }
             }
 
             const LhsEval Rs(0.0);
-            return oilPvt_->viscosity(regionIdx, T, p, Rs);
+            return instance_().oilPvt_->viscosity(regionIdx, T, p, Rs);
         }
 
         case gasPhaseIdx: {
             if (enableVaporizedOil()) {
                 const auto& Rv = Opm::BlackOil::template getRv_<ThisType, FluidState, LhsEval>(fluidState, regionIdx);
                 if (fluidState.saturation(oilPhaseIdx) > 0.0
-                    && Rv >= (1.0 - 1e-10)*gasPvt_->saturatedOilVaporizationFactor(regionIdx, Opm::scalarValue(T), Opm::scalarValue(p)))
+                    && Rv >= (1.0 - 1e-10)*instance_().gasPvt_->saturatedOilVaporizationFactor(regionIdx, Opm::scalarValue(T), Opm::scalarValue(p)))
                 {
-                    return gasPvt_->saturatedViscosity(regionIdx, T, p);
+                    return instance_().gasPvt_->saturatedViscosity(regionIdx, T, p);
                 } else {
-                    return gasPvt_->viscosity(regionIdx, T, p, Rv);
+                    return instance_().gasPvt_->viscosity(regionIdx, T, p, Rv);
                 }
             }
 
             const LhsEval Rv(0.0);
-            return gasPvt_->viscosity(regionIdx, T, p, Rv);
+            return instance_().gasPvt_->viscosity(regionIdx, T, p, Rv);
         }
 
         case waterPhaseIdx:
             // since water is always assumed to be immiscible in the black-oil model,
             // there is no "saturated water"
-            return waterPvt_->viscosity(regionIdx, T, p, saltConcentration);
+            return instance_().waterPvt_->viscosity(regionIdx, T, p, saltConcentration);
         }
 
         throw std::logic_error("Unhandled phase index "+std::to_string(phaseIdx));
@@ -1045,17 +1190,17 @@ public:
         switch (phaseIdx) {
         case oilPhaseIdx:
             return
-                oilPvt_->internalEnergy(regionIdx, T, p, Opm::BlackOil::template getRs_<ThisType, FluidState, LhsEval>(fluidState, regionIdx))
+                instance_().oilPvt_->internalEnergy(regionIdx, T, p, Opm::BlackOil::template getRs_<ThisType, FluidState, LhsEval>(fluidState, regionIdx))
                 + p/density<FluidState, LhsEval>(fluidState, phaseIdx, regionIdx);
 
         case gasPhaseIdx:
             return
-                gasPvt_->internalEnergy(regionIdx, T, p, Opm::BlackOil::template getRv_<ThisType, FluidState, LhsEval>(fluidState, regionIdx))
+                instance_().gasPvt_->internalEnergy(regionIdx, T, p, Opm::BlackOil::template getRv_<ThisType, FluidState, LhsEval>(fluidState, regionIdx))
                 + p/density<FluidState, LhsEval>(fluidState, phaseIdx, regionIdx);
 
         case waterPhaseIdx:
             return
-                waterPvt_->internalEnergy(regionIdx, T, p)
+                instance_().waterPvt_->internalEnergy(regionIdx, T, p)
                 + p/density<FluidState, LhsEval>(fluidState, phaseIdx, regionIdx);
 
         default: throw std::logic_error("Unhandled phase index "+std::to_string(phaseIdx));
@@ -1084,8 +1229,8 @@ public:
         const auto& So = Opm::decay<LhsEval>(fluidState.saturation(oilPhaseIdx));
 
         switch (phaseIdx) {
-        case oilPhaseIdx: return oilPvt_->saturatedGasDissolutionFactor(regionIdx, T, p, So, maxOilSaturation);
-        case gasPhaseIdx: return gasPvt_->saturatedOilVaporizationFactor(regionIdx, T, p, So, maxOilSaturation);
+        case oilPhaseIdx: return instance_().oilPvt_->saturatedGasDissolutionFactor(regionIdx, T, p, So, maxOilSaturation);
+        case gasPhaseIdx: return instance_().gasPvt_->saturatedOilVaporizationFactor(regionIdx, T, p, So, maxOilSaturation);
         case waterPhaseIdx: return 0.0;
         default: throw std::logic_error("Unhandled phase index "+std::to_string(phaseIdx));
         }
@@ -1111,8 +1256,8 @@ public:
         const auto& T = Opm::decay<LhsEval>(fluidState.temperature(phaseIdx));
 
         switch (phaseIdx) {
-        case oilPhaseIdx: return oilPvt_->saturatedGasDissolutionFactor(regionIdx, T, p);
-        case gasPhaseIdx: return gasPvt_->saturatedOilVaporizationFactor(regionIdx, T, p);
+        case oilPhaseIdx: return instance_().oilPvt_->saturatedGasDissolutionFactor(regionIdx, T, p);
+        case gasPhaseIdx: return instance_().gasPvt_->saturatedOilVaporizationFactor(regionIdx, T, p);
         case waterPhaseIdx: return 0.0;
         default: throw std::logic_error("Unhandled phase index "+std::to_string(phaseIdx));
         }
@@ -1160,8 +1305,8 @@ public:
         const auto& T = Opm::decay<LhsEval>(fluidState.temperature(phaseIdx));
 
         switch (phaseIdx) {
-        case oilPhaseIdx: return oilPvt_->saturationPressure(regionIdx, T, Opm::BlackOil::template getRs_<ThisType, FluidState, LhsEval>(fluidState, regionIdx));
-        case gasPhaseIdx: return gasPvt_->saturationPressure(regionIdx, T, Opm::BlackOil::template getRv_<ThisType, FluidState, LhsEval>(fluidState, regionIdx));
+        case oilPhaseIdx: return instance_().oilPvt_->saturationPressure(regionIdx, T, Opm::BlackOil::template getRs_<ThisType, FluidState, LhsEval>(fluidState, regionIdx));
+        case gasPhaseIdx: return instance_().gasPvt_->saturationPressure(regionIdx, T, Opm::BlackOil::template getRv_<ThisType, FluidState, LhsEval>(fluidState, regionIdx));
         case waterPhaseIdx: return 0.0;
         default: throw std::logic_error("Unhandled phase index "+std::to_string(phaseIdx));
         }
@@ -1177,8 +1322,8 @@ public:
     template <class LhsEval>
     static LhsEval convertXoGToRs(const LhsEval& XoG, unsigned regionIdx)
     {
-        Scalar rho_oRef = referenceDensity_[regionIdx][oilPhaseIdx];
-        Scalar rho_gRef = referenceDensity_[regionIdx][gasPhaseIdx];
+        Scalar rho_oRef = instance_().referenceDensity_[regionIdx][oilPhaseIdx];
+        Scalar rho_gRef = instance_().referenceDensity_[regionIdx][gasPhaseIdx];
 
         return XoG/(1.0 - XoG)*(rho_oRef/rho_gRef);
     }
@@ -1190,8 +1335,8 @@ public:
     template <class LhsEval>
     static LhsEval convertXgOToRv(const LhsEval& XgO, unsigned regionIdx)
     {
-        Scalar rho_oRef = referenceDensity_[regionIdx][oilPhaseIdx];
-        Scalar rho_gRef = referenceDensity_[regionIdx][gasPhaseIdx];
+        Scalar rho_oRef = instance_().referenceDensity_[regionIdx][oilPhaseIdx];
+        Scalar rho_gRef = instance_().referenceDensity_[regionIdx][gasPhaseIdx];
 
         return XgO/(1.0 - XgO)*(rho_gRef/rho_oRef);
     }
@@ -1203,8 +1348,8 @@ public:
     template <class LhsEval>
     static LhsEval convertRsToXoG(const LhsEval& Rs, unsigned regionIdx)
     {
-        Scalar rho_oRef = referenceDensity_[regionIdx][oilPhaseIdx];
-        Scalar rho_gRef = referenceDensity_[regionIdx][gasPhaseIdx];
+        Scalar rho_oRef = instance_().referenceDensity_[regionIdx][oilPhaseIdx];
+        Scalar rho_gRef = instance_().referenceDensity_[regionIdx][gasPhaseIdx];
 
         const LhsEval& rho_oG = Rs*rho_gRef;
         return rho_oG/(rho_oRef + rho_oG);
@@ -1217,8 +1362,8 @@ public:
     template <class LhsEval>
     static LhsEval convertRvToXgO(const LhsEval& Rv, unsigned regionIdx)
     {
-        Scalar rho_oRef = referenceDensity_[regionIdx][oilPhaseIdx];
-        Scalar rho_gRef = referenceDensity_[regionIdx][gasPhaseIdx];
+        Scalar rho_oRef = instance_().referenceDensity_[regionIdx][oilPhaseIdx];
+        Scalar rho_gRef = instance_().referenceDensity_[regionIdx][gasPhaseIdx];
 
         const LhsEval& rho_gO = Rv*rho_oRef;
         return rho_gO/(rho_gRef + rho_gO);
@@ -1230,8 +1375,8 @@ public:
     template <class LhsEval>
     static LhsEval convertXoGToxoG(const LhsEval& XoG, unsigned regionIdx)
     {
-        Scalar MO = molarMass_[regionIdx][oilCompIdx];
-        Scalar MG = molarMass_[regionIdx][gasCompIdx];
+        Scalar MO = instance_().molarMass_[regionIdx][oilCompIdx];
+        Scalar MG = instance_().molarMass_[regionIdx][gasCompIdx];
 
         return XoG*MO / (MG*(1 - XoG) + XoG*MO);
     }
@@ -1242,8 +1387,8 @@ public:
     template <class LhsEval>
     static LhsEval convertxoGToXoG(const LhsEval& xoG, unsigned regionIdx)
     {
-        Scalar MO = molarMass_[regionIdx][oilCompIdx];
-        Scalar MG = molarMass_[regionIdx][gasCompIdx];
+        Scalar MO = instance_().molarMass_[regionIdx][oilCompIdx];
+        Scalar MG = instance_().molarMass_[regionIdx][gasCompIdx];
 
         return xoG*MG / (xoG*(MG - MO) + MO);
     }
@@ -1254,8 +1399,8 @@ public:
     template <class LhsEval>
     static LhsEval convertXgOToxgO(const LhsEval& XgO, unsigned regionIdx)
     {
-        Scalar MO = molarMass_[regionIdx][oilCompIdx];
-        Scalar MG = molarMass_[regionIdx][gasCompIdx];
+        Scalar MO = instance_().molarMass_[regionIdx][oilCompIdx];
+        Scalar MG = instance_().molarMass_[regionIdx][gasCompIdx];
 
         return XgO*MG / (MO*(1 - XgO) + XgO*MG);
     }
@@ -1266,8 +1411,8 @@ public:
     template <class LhsEval>
     static LhsEval convertxgOToXgO(const LhsEval& xgO, unsigned regionIdx)
     {
-        Scalar MO = molarMass_[regionIdx][oilCompIdx];
-        Scalar MG = molarMass_[regionIdx][gasCompIdx];
+        Scalar MO = instance_().molarMass_[regionIdx][oilCompIdx];
+        Scalar MG = instance_().molarMass_[regionIdx][gasCompIdx];
 
         return xgO*MO / (xgO*(MO - MG) + MG);
     }
@@ -1280,7 +1425,7 @@ public:
      *       specific methods of the fluid systems from above should be used instead.
      */
     static const GasPvt& gasPvt()
-    { return *gasPvt_; }
+    { return *instance_().gasPvt_; }
 
     /*!
      * \brief Return a reference to the low-level object which calculates the oil phase
@@ -1290,7 +1435,7 @@ public:
      *       specific methods of the fluid systems from above should be used instead.
      */
     static const OilPvt& oilPvt()
-    { return *oilPvt_; }
+    { return *instance_().oilPvt_; }
 
     /*!
      * \brief Return a reference to the low-level object which calculates the water phase
@@ -1300,7 +1445,7 @@ public:
      *       specific methods of the fluid systems from above should be used instead.
      */
     static const WaterPvt& waterPvt()
-    { return *waterPvt_; }
+    { return *instance_().waterPvt_; }
 
     /*!
      * \brief Set the temperature of the reservoir.
@@ -1308,7 +1453,7 @@ public:
      * This method is black-oil specific and only makes sense for isothermal simulations.
      */
     static Scalar reservoirTemperature(unsigned pvtRegionIdx OPM_UNUSED = 0)
-    { return reservoirTemperature_; }
+    { return instance_().reservoirTemperature_; }
 
     /*!
      * \brief Return the temperature of the reservoir.
@@ -1316,26 +1461,26 @@ public:
      * This method is black-oil specific and only makes sense for isothermal simulations.
      */
     static void setReservoirTemperature(Scalar value)
-    { reservoirTemperature_ = value; }
+    { instance_().reservoirTemperature_ = value; }
 
     static short activeToCanonicalPhaseIdx(unsigned activePhaseIdx) {
         assert(activePhaseIdx<numActivePhases());
-        return activeToCanonicalPhaseIdx_[activePhaseIdx];
+        return instance_().activeToCanonicalPhaseIdx_[activePhaseIdx];
     }
 
     static short canonicalToActivePhaseIdx(unsigned phaseIdx) {
         assert(phaseIdx<numPhases);
         assert(phaseIsActive(phaseIdx));
-        return canonicalToActivePhaseIdx_[phaseIdx];
+        return instance_().canonicalToActivePhaseIdx_[phaseIdx];
     }
 
     //! \copydoc BaseFluidSystem::diffusionCoefficient
     static Scalar diffusionCoefficient(unsigned compIdx, unsigned phaseIdx, unsigned regionIdx = 0)
-    { return diffusionCoefficients_[regionIdx][numPhases*compIdx + phaseIdx]; }
+    { return instance_().diffusionCoefficients_[regionIdx][numPhases*compIdx + phaseIdx]; }
 
     //! \copydoc BaseFluidSystem::setDiffusionCoefficient
     static void setDiffusionCoefficient(Scalar coefficient, unsigned compIdx, unsigned phaseIdx, unsigned regionIdx = 0)
-    { diffusionCoefficients_[regionIdx][numPhases*compIdx + phaseIdx] = coefficient ; }
+    { instance_().diffusionCoefficients_[regionIdx][numPhases*compIdx + phaseIdx] = coefficient ; }
 
     /*!
      * \copydoc BaseFluidSystem::diffusionCoefficient
@@ -1351,7 +1496,7 @@ public:
             return 0.0;
 
         // diffusion coefficients are set, and we use them
-        if(!diffusionCoefficients_.empty()) {
+        if(!instance_().diffusionCoefficients_.empty()) {
             return diffusionCoefficient(compIdx, phaseIdx, paramCache.regionIndex());
         }
 
@@ -1369,92 +1514,35 @@ public:
 private:
     static void resizeArrays_(size_t numRegions)
     {
-        molarMass_.resize(numRegions);
-        referenceDensity_.resize(numRegions);
+        instance_().molarMass_.resize(numRegions);
+        instance_().referenceDensity_.resize(numRegions);
     }
 
-    static Scalar reservoirTemperature_;
+    // the thread-local pointer is initialized by a constant, so accessing it does not
+    // require a guard for dynamic initialization
+    static Instance& instance_()
+    { return *activeInstance_; }
 
-    static std::shared_ptr<GasPvt> gasPvt_;
-    static std::shared_ptr<OilPvt> oilPvt_;
-    static std::shared_ptr<WaterPvt> waterPvt_;
-
-    static bool enableDissolvedGas_;
-    static bool enableVaporizedOil_;
-    static bool enableDiffusion_;
-
-    // HACK for GCC 4.4: the array size has to be specified using the literal value '3'
-    // here, because GCC 4.4 seems to be unable to determine the number of phases from
-    // the BlackOil fluid system in the attribute declaration below...
-    static std::vector<std::array<Scalar, /*numPhases=*/3> > referenceDensity_;
-    static std::vector<std::array<Scalar, /*numComponents=*/3> > molarMass_;
-    static std::vector<std::array<Scalar, /*numComponents=*/3 * /*numPhases=*/3> > diffusionCoefficients_;
-
-    static std::array<short, numPhases> activeToCanonicalPhaseIdx_;
-    static std::array<short, numPhases> canonicalToActivePhaseIdx_;
-
-    static bool isInitialized_;
+    static Instance defaultInstance_;
+    static thread_local Instance* activeInstance_;
 };
 
 template <class Scalar, class IndexTraits>
-unsigned char BlackOilFluidSystem<Scalar, IndexTraits>::numActivePhases_;
-
-template <class Scalar, class IndexTraits>
-std::array<bool, BlackOilFluidSystem<Scalar, IndexTraits>::numPhases> BlackOilFluidSystem<Scalar, IndexTraits>::phaseIsActive_;
-
-template <class Scalar, class IndexTraits>
-std::array<short, BlackOilFluidSystem<Scalar, IndexTraits>::numPhases> BlackOilFluidSystem<Scalar, IndexTraits>::activeToCanonicalPhaseIdx_;
-
-template <class Scalar, class IndexTraits>
-std::array<short, BlackOilFluidSystem<Scalar, IndexTraits>::numPhases> BlackOilFluidSystem<Scalar, IndexTraits>::canonicalToActivePhaseIdx_;
-
-template <class Scalar, class IndexTraits>
-Scalar
-BlackOilFluidSystem<Scalar, IndexTraits>::surfaceTemperature; // [K]
-
-template <class Scalar, class IndexTraits>
-Scalar
-BlackOilFluidSystem<Scalar, IndexTraits>::surfacePressure; // [Pa]
-
-template <class Scalar, class IndexTraits>
-Scalar
-BlackOilFluidSystem<Scalar, IndexTraits>::reservoirTemperature_;
-
-template <class Scalar, class IndexTraits>
-bool BlackOilFluidSystem<Scalar, IndexTraits>::enableDissolvedGas_;
-
-template <class Scalar, class IndexTraits>
-bool BlackOilFluidSystem<Scalar, IndexTraits>::enableVaporizedOil_;
-
-template <class Scalar, class IndexTraits>
-bool BlackOilFluidSystem<Scalar, IndexTraits>::enableDiffusion_;
-
-template <class Scalar, class IndexTraits>
-std::shared_ptr<OilPvtMultiplexer<Scalar> >
-BlackOilFluidSystem<Scalar, IndexTraits>::oilPvt_;
-
-template <class Scalar, class IndexTraits>
-std::shared_ptr<Opm::GasPvtMultiplexer<Scalar> >
-BlackOilFluidSystem<Scalar, IndexTraits>::gasPvt_;
-
-template <class Scalar, class IndexTraits>
-std::shared_ptr<WaterPvtMultiplexer<Scalar> >
-BlackOilFluidSystem<Scalar, IndexTraits>::waterPvt_;
-
-template <class Scalar, class IndexTraits>
-std::vector<std::array<Scalar, 3> >
-BlackOilFluidSystem<Scalar, IndexTraits>::referenceDensity_;
+typename BlackOilFluidSystem<Scalar, IndexTraits>::Instance
+BlackOilFluidSystem<Scalar, IndexTraits>::defaultInstance_;
 
 template <class Scalar, class IndexTraits>
-std::vector<std::array<Scalar, 3> >
-BlackOilFluidSystem<Scalar, IndexTraits>::molarMass_;
+Scalar& BlackOilFluidSystem<Scalar, IndexTraits>::surfacePressure =
+    BlackOilFluidSystem<Scalar, IndexTraits>::defaultInstance_.surfacePressure_;
 
 template <class Scalar, class IndexTraits>
-std::vector<std::array<Scalar, 9> >
-BlackOilFluidSystem<Scalar, IndexTraits>::diffusionCoefficients_;
+Scalar& BlackOilFluidSystem<Scalar, IndexTraits>::surfaceTemperature =
+    BlackOilFluidSystem<Scalar, IndexTraits>::defaultInstance_.surfaceTemperature_;
 
 template <class Scalar, class IndexTraits>
-bool BlackOilFluidSystem<Scalar, IndexTraits>::isInitialized_ = false;
+thread_local typename BlackOilFluidSystem<Scalar, IndexTraits>::Instance*
+BlackOilFluidSystem<Scalar, IndexTraits>::activeInstance_ =
+    &BlackOilFluidSystem<Scalar, IndexTraits>::defaultInstance_;
 
 } // namespace Opm
 
@@ -41,6 +41,7 @@
 
 #include <opm/material/binarycoefficients/H2O_CO2.hpp>
 #include <opm/material/binarycoefficients/Brine_CO2.hpp>
+#include <opm/material/binarycoefficients/Brine_CO2SolubilityTable.hpp>
 #include <opm/material/binarycoefficients/H2O_N2.hpp>
 
 #include <opm/material/common/Unused.hpp>
@@ -80,6 +81,9 @@ public:
     //! The binary coefficients for brine and CO2 used by this fluid system
     typedef Opm::BinaryCoeff::Brine_CO2<Scalar, H2O, CO2> BinaryCoeffBrineCO2;
 
+    //! The tabulated surrogate for the mutual solubilities of brine and CO2
+    typedef Opm::BinaryCoeff::Brine_CO2SolubilityTable<Scalar, BinaryCoeffBrineCO2> SolubilityTable;
+
     /****************************************
      * Fluid phase related static parameters
      ****************************************/
@@ -207,9 +211,14 @@ public:
      * \param pressMin The minimum pressure used for tabulation of water [Pa]
      * \param pressMax The maximum pressure used for tabulation of water [Pa]
      * \param nPress The number of ticks on the pressure axis of the  table of water
+     * \param solubilityTolerance The maximum relative error of the tabulated mutual
+     *                            solubilities of brine and CO2. If this is not
+     *                            positive (the default), the solubilities are not
+     *                            tabulated.
      */
     static void init(Scalar tempMin, Scalar tempMax, unsigned nTemp,
-                     Scalar pressMin, Scalar pressMax, unsigned nPress)
+                     Scalar pressMin, Scalar pressMax, unsigned nPress,
+                     Scalar solubilityTolerance = 0.0)
     {
         if (H2O::isTabulated) {
             H2O_Tabulated::init(tempMin, tempMax, nTemp,
@@ -223,8 +232,27 @@ public:
             Brine_Tabulated::init(tempMin, tempMax, nTemp,
                                   pressMin, pressMax, nPress);
         }
+
+        // the solubilities are only sampled where the CO2 tables are valid
+        Scalar solTempMin = std::max(tempMin, CO2::minTabulatedTemperature());
+        Scalar solTempMax = std::min(tempMax, CO2::maxTabulatedTemperature());
+        Scalar solPressMin = std::max(pressMin, CO2::minTabulatedPressure());
+        Scalar solPressMax = std::min(pressMax, CO2::maxTabulatedPressure());
+        if (solubilityTolerance > 0.0 && solTempMin < solTempMax && solPressMin < solPressMax)
+            solubilityTable_.init(Brine_IAPWS::salinity,
+                                  solTempMin, solTempMax,
+                                  solPressMin, solPressMax,
+                                  solubilityTolerance);
+        else
+            solubilityTable_ = SolubilityTable();
     }
 
+    /*!
+     * \brief Returns the tabulated mutual solubilities of brine and CO2.
+     */
+    static const SolubilityTable& solubilityTable()
+    { return solubilityTable_; }
+
     /*!
      * \copydoc BaseFluidSystem::density
      */
@@ -331,12 +359,19 @@ public:
         // could use some cleanup.
         LhsEval xlH2O, xgH2O;
         LhsEval xlCO2, xgCO2;
-        BinaryCoeffBrineCO2::calculateMoleFractions(temperature,
+        if (solubilityTable_.applies(temperature, pressure)
+            && solubilityTable_.salinity() == Brine_IAPWS::salinity)
+            solubilityTable_.calculateMoleFractions(temperature,
                                                     pressure,
-                                                    Brine_IAPWS::salinity,
-                                                    /*knownPhaseIdx=*/-1,
                                                     xlCO2,
                                                     xgH2O);
+        else
+            BinaryCoeffBrineCO2::calculateMoleFractions(temperature,
+                                                        pressure,
+                                                        Brine_IAPWS::salinity,
+                                                        /*knownPhaseIdx=*/-1,
+                                                        xlCO2,
+                                                        xgH2O);
 
         // normalize the phase compositions
         xlCO2 = Opm::max(0.0, Opm::min(1.0, xlCO2));
@@ -599,8 +634,14 @@ private:
         /* Enthalpy of brine with dissolved CO2 */
         return (h_ls1 - X_CO2_w*hw + hg*X_CO2_w)*1E3; /*J/kg*/
     }
+
+    static SolubilityTable solubilityTable_;
 };
 
+template <class Scalar, class CO2Tables>
+typename BrineCO2FluidSystem<Scalar, CO2Tables>::SolubilityTable
+BrineCO2FluidSystem<Scalar, CO2Tables>::solubilityTable_;
+
 } // namespace Opm
 
 #endif
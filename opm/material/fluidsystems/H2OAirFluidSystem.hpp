@@ -40,6 +40,7 @@
 
 #include <iostream>
 #include <cassert>
+#include <type_traits>
 
 namespace Opm {
 
@@ -239,14 +240,42 @@ public:
      * \param pressMin The minimum pressure used for tabulation of water [Pa]
      * \param pressMax The maximum pressure used for tabulation of water [Pa]
      * \param nPress The number of ticks on the pressure axis of the  table of water
+     *
+     * Only the quantities of water which are required by this fluid system are
+     * tabulated.
      */
     static void init(Scalar tempMin, Scalar tempMax, unsigned nTemp,
                      Scalar pressMin, Scalar pressMax, unsigned nPress)
     {
-        if (H2O::isTabulated) {
-            H2O::init(tempMin, tempMax, nTemp,
-                      pressMin, pressMax, nPress);
-        }
+        initH2O_(std::integral_constant<bool, H2O::isTabulated>(),
+                 tempMin, tempMax, nTemp,
+                 pressMin, pressMax, nPress);
+    }
+
+    /*!
+     * \brief Initialize the fluid system's static parameters using problem specific
+     *        temperature and pressure ranges and a given accuracy of the tables
+     *
+     * The resolution of the tables of water is chosen such that the tabulated
+     * quantities reproduce the raw component within the tolerance (see
+     * TabulatedComponent::initWithTolerance()).
+     *
+     * \param tempMin The minimum temperature used for tabulation of water [K]
+     * \param tempMax The maximum temperature used for tabulation of water [K]
+     * \param pressMin The minimum pressure used for tabulation of water [Pa]
+     * \param pressMax The maximum pressure used for tabulation of water [Pa]
+     * \param tolerance The maximum relative error of the tabulated quantities
+     *
+     * \return The largest relative error of the tables of water
+     */
+    static Scalar initWithTolerance(Scalar tempMin, Scalar tempMax,
+                                    Scalar pressMin, Scalar pressMax,
+                                    Scalar tolerance)
+    {
+        return initH2OWithTolerance_(std::integral_constant<bool, H2O::isTabulated>(),
+                                     tempMin, tempMax,
+                                     pressMin, pressMax,
+                                     tolerance);
     }
 
     //! \copydoc BaseFluidSystem::density
@@ -457,6 +486,50 @@ public:
             return lambdaAir + lambdaH2O;
         }
     }
+
+private:
+    // the quantities of water which are evaluated by this fluid system. the heat
+    // capacities and the inverse pressure tables are never used, so they are not
+    // tabulated
+    static unsigned tabulatedH2OProperties_()
+    {
+        return
+            H2O::LiquidDensity | H2O::GasDensity
+            | H2O::LiquidViscosity | H2O::GasViscosity
+            | H2O::LiquidEnthalpy | H2O::GasEnthalpy
+            | H2O::LiquidThermalConductivity | H2O::GasThermalConductivity;
+    }
+
+    static void initH2O_(std::true_type /*isTabulated*/,
+                         Scalar tempMin, Scalar tempMax, unsigned nTemp,
+                         Scalar pressMin, Scalar pressMax, unsigned nPress)
+    {
+        H2O::init(tempMin, tempMax, nTemp,
+                  pressMin, pressMax, nPress,
+                  tabulatedH2OProperties_());
+    }
+
+    static void initH2O_(std::false_type /*isTabulated*/,
+                         Scalar /*tempMin*/, Scalar /*tempMax*/, unsigned /*nTemp*/,
+                         Scalar /*pressMin*/, Scalar /*pressMax*/, unsigned /*nPress*/)
+    { }
+
+    static Scalar initH2OWithTolerance_(std::true_type /*isTabulated*/,
+                                        Scalar tempMin, Scalar tempMax,
+                                        Scalar pressMin, Scalar pressMax,
+                                        Scalar tolerance)
+    {
+        return H2O::initWithTolerance(tempMin, tempMax,
+                                      pressMin, pressMax,
+                                      tolerance,
+                                      tabulatedH2OProperties_());
+    }
+
+    static Scalar initH2OWithTolerance_(std::false_type /*isTabulated*/,
+                                        Scalar /*tempMin*/, Scalar /*tempMax*/,
+                                        Scalar /*pressMin*/, Scalar /*pressMax*/,
+                                        Scalar /*tolerance*/)
+    { return 0.0; }
 };
 
 } // namespace Opm
@@ -30,6 +30,7 @@
 #include <opm/material/Constants.hpp>
 
 #include <opm/material/common/Tabulated1DFunction.hpp>
+#include <opm/material/common/EvaluationStatus.hpp>
 #include <opm/material/components/Brine.hpp>
 #include <opm/material/components/SimpleHuDuanH2O.hpp>
 #include <opm/material/components/CO2.hpp>
@@ -37,6 +38,7 @@
 #include <opm/material/components/TabulatedComponent.hpp>
 #include <opm/material/binarycoefficients/H2O_CO2.hpp>
 #include <opm/material/binarycoefficients/Brine_CO2.hpp>
+#include <opm/material/binarycoefficients/Brine_CO2SolubilityTable.hpp>
 #include <opm/material/components/co2tables.inc>
 
 
@@ -77,6 +79,9 @@ public:
     //! The binary coefficients for brine and CO2 used by this fluid system
     typedef Opm::BinaryCoeff::Brine_CO2<Scalar, H2O, CO2> BinaryCoeffBrineCO2;
 
+    //! The tabulated surrogate for the solubilities which is used for each PVT region
+    typedef Opm::BinaryCoeff::Brine_CO2SolubilityTable<Scalar, BinaryCoeffBrineCO2> SolubilityTable;
+
     explicit BrineCo2Pvt() = default;
     BrineCo2Pvt(const std::vector<Scalar>& brineReferenceDensity,
                 const std::vector<Scalar>& co2ReferenceDensity,
@@ -119,6 +124,8 @@ public:
 
         brineReferenceDensity_[regionIdx] = Brine::liquidDensity(T_ref, P_ref);
         co2ReferenceDensity_[regionIdx] = CO2::gasDensity(T_ref, P_ref);
+
+        initEnd();
     }
 #endif
 
@@ -127,6 +134,35 @@ public:
         brineReferenceDensity_.resize(numRegions);
         co2ReferenceDensity_.resize(numRegions);
         salinity_.resize(numRegions);
+        solubilityTables_.resize(numRegions);
+    }
+
+    /*!
+     * \brief Specify how the solubility of CO2 in brine is tabulated.
+     *
+     * By default, the solubility is not tabulated. If the tolerance is positive,
+     * initEnd() samples the mole fractions of the Spycher-Pruess model for each PVT
+     * region and the gas dissolution factor is subsequently interpolated within the
+     * given temperature and pressure range. Outside of this range or if the tolerance
+     * is not positive, the correlation is evaluated directly.
+     *
+     * \param tolerance The maximum relative error of the interpolated mole fractions
+     * \param tempMin The minimum of the temperature range [K]
+     * \param tempMax The maximum of the temperature range [K]
+     * \param pressMin The minimum of the pressure range [Pa]
+     * \param pressMax The maximum of the pressure range [Pa]
+     */
+    void setSolubilityTabulation(Scalar tolerance,
+                                 Scalar tempMin = CO2::minTabulatedTemperature(),
+                                 Scalar tempMax = CO2::maxTabulatedTemperature(),
+                                 Scalar pressMin = CO2::minTabulatedPressure(),
+                                 Scalar pressMax = CO2::maxTabulatedPressure())
+    {
+        solubilityTolerance_ = tolerance;
+        solubilityTempMin_ = tempMin;
+        solubilityTempMax_ = tempMax;
+        solubilityPressMin_ = pressMin;
+        solubilityPressMax_ = pressMax;
     }
 
 
@@ -148,7 +184,18 @@ public:
      */
     void initEnd()
     {
-
+        solubilityTables_.resize(numRegions());
+        for (unsigned regionIdx = 0; regionIdx < numRegions(); ++regionIdx) {
+            if (solubilityTolerance_ > 0.0)
+                solubilityTables_[regionIdx].init(salinity_[regionIdx],
+                                                  solubilityTempMin_,
+                                                  solubilityTempMax_,
+                                                  solubilityPressMin_,
+                                                  solubilityPressMax_,
+                                                  solubilityTolerance_);
+            else
+                solubilityTables_[regionIdx] = SolubilityTable();
+        }
     }
 
     /*!
@@ -223,6 +270,44 @@ public:
         return density_(regionIdx, temperature, pressure, rsSat)/brineReferenceDensity_[regionIdx];
     }
 
+    /*!
+     * \brief Returns the formation volume factor [-] of the fluid phase without
+     *        throwing.
+     *
+     * Temperatures and pressures outside of the range of the density correlation are
+     * recorded in the status object using the region index as the table identifier.
+     * Depending on the policy of the status object, the correlation is then evaluated
+     * anyway or the arguments are clamped to the valid range. Arguments beyond the range
+     * of the water density correlation are always clamped.
+     */
+    template <class Evaluation>
+    Evaluation inverseFormationVolumeFactor(unsigned regionIdx,
+                                            const Evaluation& temperature,
+                                            const Evaluation& pressure,
+                                            const Evaluation& Rs,
+                                            EvaluationStatus<Scalar>& status) const
+    {
+        return density_(regionIdx, temperature, pressure, Rs, &status)/brineReferenceDensity_[regionIdx];
+    }
+
+    /*!
+     * \brief Returns the formation volume factor [-] of brine saturated with CO2 at a
+     *        given pressure without throwing.
+     *
+     * Arguments outside of the valid range are treated like for the non-throwing
+     * inverseFormationVolumeFactor(). The solubility of CO2 is evaluated like by the
+     * non-throwing saturatedGasDissolutionFactor().
+     */
+    template <class Evaluation>
+    Evaluation saturatedInverseFormationVolumeFactor(unsigned regionIdx,
+                                                     const Evaluation& temperature,
+                                                     const Evaluation& pressure,
+                                                     EvaluationStatus<Scalar>& status) const
+    {
+        Evaluation rsSat = rsSat_(regionIdx, temperature, pressure, status);
+        return density_(regionIdx, temperature, pressure, rsSat, &status)/brineReferenceDensity_[regionIdx];
+    }
+
     /*!
      * \brief Returns the saturation pressure of the brine phase [Pa]
      *        depending on its mass fraction of the gas component
@@ -262,6 +347,24 @@ public:
         return rsSat_(regionIdx, temperature, pressure);
     }
 
+    /*!
+     * \brief Returns the gas dissoluiton factor \f$R_s\f$ [m^3/m^3] of the liquid phase
+     *        without throwing.
+     *
+     * The CO2 tables cannot be extrapolated, so temperatures and pressures beyond
+     * their range are recorded in the status object using the region index as the
+     * table identifier and always clamped to it, i.e., the result is the dissolution
+     * factor at the closest valid point.
+     */
+    template <class Evaluation>
+    Evaluation saturatedGasDissolutionFactor(unsigned regionIdx,
+                                             const Evaluation& temperature,
+                                             const Evaluation& pressure,
+                                             EvaluationStatus<Scalar>& status) const
+    {
+        return rsSat_(regionIdx, temperature, pressure, status);
+    }
+
     const Scalar oilReferenceDensity(unsigned regionIdx) const
     { return brineReferenceDensity_[regionIdx]; }
 
@@ -271,10 +374,34 @@ public:
     const Scalar salinity(unsigned regionIdx) const
     { return salinity_[regionIdx]; }
 
+    const SolubilityTable& solubilityTable(unsigned regionIdx) const
+    { return solubilityTables_[regionIdx]; }
+
     bool operator==(const BrineCo2Pvt<Scalar>& data) const
     {
         return co2ReferenceDensity_ == data.co2ReferenceDensity_ &&
-                brineReferenceDensity_ == data.brineReferenceDensity_;
+                brineReferenceDensity_ == data.brineReferenceDensity_ &&
+                salinity_ == data.salinity_ &&
+                solubilityTables_ == data.solubilityTables_ &&
+                solubilityTolerance_ == data.solubilityTolerance_ &&
+                solubilityTempMin_ == data.solubilityTempMin_ &&
+                solubilityTempMax_ == data.solubilityTempMax_ &&
+                solubilityPressMin_ == data.solubilityPressMin_ &&
+                solubilityPressMax_ == data.solubilityPressMax_;
+    }
+
+    template <class Serializer>
+    void serializeOp(Serializer& serializer)
+    {
+        serializer(brineReferenceDensity_);
+        serializer(co2ReferenceDensity_);
+        serializer(salinity_);
+        serializer(solubilityTables_);
+        serializer(solubilityTolerance_);
+        serializer(solubilityTempMin_);
+        serializer(solubilityTempMax_);
+        serializer(solubilityPressMin_);
+        serializer(solubilityPressMax_);
     }
 
     template <class Evaluation>
@@ -297,17 +424,29 @@ private:
     std::vector<Scalar> brineReferenceDensity_;
     std::vector<Scalar> co2ReferenceDensity_;
     std::vector<Scalar> salinity_;
+    std::vector<SolubilityTable> solubilityTables_;
+
+    Scalar solubilityTolerance_ = 0.0;
+    Scalar solubilityTempMin_ = CO2::minTabulatedTemperature();
+    Scalar solubilityTempMax_ = CO2::maxTabulatedTemperature();
+    Scalar solubilityPressMin_ = CO2::minTabulatedPressure();
+    Scalar solubilityPressMax_ = CO2::maxTabulatedPressure();
 
     template <class LhsEval>
     LhsEval density_(unsigned regionIdx,
                      const LhsEval& temperature,
                      const LhsEval& pressure,
-                     const LhsEval& Rs) const
+                     const LhsEval& Rs,
+                     EvaluationStatus<Scalar>* status = nullptr) const
     {
         LhsEval xlCO2 = convertXoGToxoG_(convertRsToXoG_(Rs,regionIdx));
-        LhsEval result = liquidDensity_(temperature,
-                                        pressure,
-                                        xlCO2);
+        LhsEval result;
+        if (status)
+            result = liquidDensity_(temperature, pressure, xlCO2, *status, regionIdx);
+        else
+            result = liquidDensity_(temperature,
+                                    pressure,
+                                    xlCO2);
 
         Valgrind::CheckDefined(result);
         return result;
@@ -336,6 +475,41 @@ private:
             throw NumericalIssue(oss.str());
         }
 
+        return liquidDensityUnchecked_(T, pl, xlCO2);
+    }
+
+    // the liquid density which records range violations instead of throwing. Besides
+    // the range of the brine-CO2 correlation, this considers the one of the water
+    // density (T <= 647K, p <= 100MPa, see SimpleHuDuanH2O). The latter cannot be
+    // extrapolated, so the arguments are always clamped to it.
+    template <class LhsEval>
+    LhsEval liquidDensity_(const LhsEval& T,
+                           const LhsEval& pl,
+                           const LhsEval& xlCO2,
+                           EvaluationStatus<Scalar>& status,
+                           unsigned tableId) const
+    {
+        const Scalar TMin = 273.15;
+        const Scalar TMax = 647.0;
+        const Scalar pMax = 100e6;
+
+        if (TMin <= T && T <= TMax && pl <= pMax)
+            return liquidDensityUnchecked_(T, pl, xlCO2);
+
+        status.record(tableId, Opm::scalarValue(T), Opm::scalarValue(pl));
+        if (!status.clamp())
+            return liquidDensityUnchecked_<LhsEval>(Opm::min(T, TMax), Opm::min(pl, pMax), xlCO2);
+
+        return liquidDensityUnchecked_<LhsEval>(Opm::min(Opm::max(T, TMin), TMax),
+                                                Opm::min(pl, pMax),
+                                                xlCO2);
+    }
+
+    template <class LhsEval>
+    LhsEval liquidDensityUnchecked_(const LhsEval& T,
+                                    const LhsEval& pl,
+                                    const LhsEval& xlCO2) const
+    {
         const LhsEval& rho_brine = Brine::liquidDensity(T, pl);
         const LhsEval& rho_pure = H2O::liquidDensity(T, pl);
         const LhsEval& rho_lCO2 = liquidDensityWaterCO2_(T, pl, xlCO2);
@@ -427,15 +601,23 @@ private:
                    const LhsEval& pressure) const
     {
         // calulate the equilibrium composition for the given
-        // temperature and pressure. 
+        // temperature and pressure. if the solubilities have been tabulated for
+        // this region, they are interpolated instead of evaluated.
         LhsEval xgH2O;
         LhsEval xlCO2;
-        BinaryCoeffBrineCO2::calculateMoleFractions(temperature,
-                                                    pressure,
-                                                    salinity_[regionIdx],
-                                                    /*knownPhaseIdx=*/-1,
-                                                    xlCO2,
-                                                    xgH2O);
+        if (regionIdx < solubilityTables_.size()
+            && solubilityTables_[regionIdx].applies(temperature, pressure))
+            solubilityTables_[regionIdx].calculateMoleFractions(temperature,
+                                                                pressure,
+                                                                xlCO2,
+                                                                xgH2O);
+        else
+            BinaryCoeffBrineCO2::calculateMoleFractions(temperature,
+                                                        pressure,
+                                                        salinity_[regionIdx],
+                                                        /*knownPhaseIdx=*/-1,
+                                                        xlCO2,
+                                                        xgH2O);
 
         // normalize the phase compositions
         xlCO2 = Opm::max(0.0, Opm::min(1.0, xlCO2));
@@ -443,6 +625,30 @@ private:
         return convertXoGToRs(convertxoGToXoG(xlCO2), regionIdx);
     }
 
+    // the saturated gas dissolution factor which records range violations instead
+    // of throwing. the CO2 tables cannot be extrapolated, so arguments outside of
+    // their range are always clamped. within the range, the solubility is always
+    // defined, so any exception raised there is a genuine error and is passed on
+    template <class LhsEval>
+    LhsEval rsSat_(unsigned regionIdx,
+                   const LhsEval& temperature,
+                   const LhsEval& pressure,
+                   EvaluationStatus<Scalar>& status) const
+    {
+        const Scalar TMin = CO2::minTabulatedTemperature();
+        const Scalar TMax = CO2::maxTabulatedTemperature();
+        const Scalar pMin = CO2::minTabulatedPressure();
+        const Scalar pMax = CO2::maxTabulatedPressure();
+
+        if (TMin <= temperature && temperature <= TMax && pMin <= pressure && pressure <= pMax)
+            return rsSat_(regionIdx, temperature, pressure);
+
+        status.record(regionIdx, Opm::scalarValue(temperature), Opm::scalarValue(pressure));
+        return rsSat_<LhsEval>(regionIdx,
+                               Opm::min(Opm::max(temperature, TMin), TMax),
+                               Opm::min(Opm::max(pressure, pMin), pMax));
+    }
+
     template <class LhsEval>
     static LhsEval liquidEnthalpyBrineCO2_(const LhsEval& T,
                                            const LhsEval& p,
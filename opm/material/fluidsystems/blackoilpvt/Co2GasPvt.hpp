@@ -227,6 +227,12 @@ public:
         return gasReferenceDensity_ == data.gasReferenceDensity_;
     }
 
+    template <class Serializer>
+    void serializeOp(Serializer& serializer)
+    {
+        serializer(gasReferenceDensity_);
+    }
+
 private:
     std::vector<Scalar> gasReferenceDensity_;
 };
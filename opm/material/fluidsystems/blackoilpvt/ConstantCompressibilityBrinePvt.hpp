@@ -230,6 +230,17 @@ public:
                this->viscosibilityTables() == data.viscosibilityTables();
     }
 
+    template <class Serializer>
+    void serializeOp(Serializer& serializer)
+    {
+        serializer(waterReferenceDensity_);
+        serializer(referencePressure_);
+        serializer(formationVolumeTables_);
+        serializer(compressibilityTables_);
+        serializer(viscosityTables_);
+        serializer(viscosibilityTables_);
+    }
+
 private:
     std::vector<Scalar> waterReferenceDensity_;
     std::vector<Scalar> referencePressure_;
@@ -305,6 +305,17 @@ public:
                this->oilViscosibility() == data.oilViscosibility();
     }
 
+    template <class Serializer>
+    void serializeOp(Serializer& serializer)
+    {
+        serializer(oilReferenceDensity_);
+        serializer(oilReferencePressure_);
+        serializer(oilReferenceFormationVolumeFactor_);
+        serializer(oilCompressibility_);
+        serializer(oilViscosity_);
+        serializer(oilViscosibility_);
+    }
+
 private:
     std::vector<Scalar> oilReferenceDensity_;
     std::vector<Scalar> oilReferencePressure_;
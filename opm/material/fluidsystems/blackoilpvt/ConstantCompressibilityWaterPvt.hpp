@@ -210,6 +210,50 @@ public:
         return (1.0 + X*(1.0 + X/2.0))/BwRef;
     }
 
+    /*!
+     * \brief Returns the inverse formation volume factor [-] and the dynamic viscosity
+     *        [Pa s] of the fluid phase.
+     *
+     * The viscosity is computed from the inverse formation volume factor, so the
+     * latter is only evaluated once.
+     */
+    template <class Evaluation>
+    void inverseFormationVolumeFactorAndViscosity(unsigned regionIdx,
+                                                  const Evaluation& temperature,
+                                                  const Evaluation& pressure,
+                                                  const Evaluation& saltconcentration,
+                                                  Evaluation& invB,
+                                                  Evaluation& mu) const
+    { inverseFormationVolumeFactorAndViscosity(1, &regionIdx, &temperature, &pressure, &saltconcentration, &invB, &mu); }
+
+    /*!
+     * \brief Computes the inverse formation volume factors and the viscosities of a
+     *        batch of values.
+     *
+     * All arrays must have numValues entries.
+     */
+    template <class Evaluation>
+    void inverseFormationVolumeFactorAndViscosity(size_t numValues,
+                                                  const unsigned* regionIdx,
+                                                  const Evaluation* temperature,
+                                                  const Evaluation* pressure,
+                                                  const Evaluation* saltconcentration,
+                                                  Evaluation* invB,
+                                                  Evaluation* mu) const
+    {
+        for (size_t i = 0; i < numValues; ++i) {
+            unsigned pvtRegionIdx = regionIdx[i];
+            invB[i] = inverseFormationVolumeFactor(pvtRegionIdx, temperature[i], pressure[i], saltconcentration[i]);
+
+            Scalar BwMuwRef = waterViscosity_[pvtRegionIdx]*waterReferenceFormationVolumeFactor_[pvtRegionIdx];
+            Scalar pRef = waterReferencePressure_[pvtRegionIdx];
+            const Evaluation& Y =
+                (waterCompressibility_[pvtRegionIdx] - waterViscosibility_[pvtRegionIdx])
+                * (pressure[i] - pRef);
+            mu[i] = BwMuwRef*invB[i]/(1 + Y*(1 + Y/2));
+        }
+    }
+
     const Scalar waterReferenceDensity(unsigned regionIdx) const
     { return waterReferenceDensity_[regionIdx]; }
 
@@ -238,6 +282,17 @@ public:
                this->waterViscosibility() == data.waterViscosibility();
     }
 
+    template <class Serializer>
+    void serializeOp(Serializer& serializer)
+    {
+        serializer(waterReferenceDensity_);
+        serializer(waterReferencePressure_);
+        serializer(waterReferenceFormationVolumeFactor_);
+        serializer(waterCompressibility_);
+        serializer(waterViscosity_);
+        serializer(waterViscosibility_);
+    }
+
 private:
     std::vector<Scalar> waterReferenceDensity_;
     std::vector<Scalar> waterReferencePressure_;
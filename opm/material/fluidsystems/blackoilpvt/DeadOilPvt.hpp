@@ -30,6 +30,7 @@
 #include <opm/material/common/UniformXTabulated2DFunction.hpp>
 #include <opm/material/common/Tabulated1DFunction.hpp>
 #include <opm/material/common/Spline.hpp>
+#include <opm/material/common/TablePool.hpp>
 
 #if HAVE_ECL_INPUT
 #include <opm/parser/eclipse/EclipseState/EclipseState.hpp>
@@ -107,6 +108,7 @@ public:
         inverseOilB_.resize(numRegions);
         inverseOilBMu_.resize(numRegions);
         oilMu_.resize(numRegions);
+        tablePool_ = TablePool<Scalar>();
     }
 
     /*!
@@ -131,7 +133,10 @@ public:
      * component in the oil phase is missing when assuming dead oil.
      */
     void setInverseOilFormationVolumeFactor(unsigned regionIdx, const TabulatedOneDFunction& invBo)
-    { inverseOilB_[regionIdx] = invBo; }
+    {
+        inverseOilB_[regionIdx] = invBo;
+        tablePool_ = TablePool<Scalar>();
+    }
 
     /*!
      * \brief Initialize the viscosity of the oil phase.
@@ -139,7 +144,10 @@ public:
      * This is a function of \f$(R_s, p_o)\f$...
      */
     void setOilViscosity(unsigned regionIdx, const TabulatedOneDFunction& muo)
-    { oilMu_[regionIdx] = muo; }
+    {
+        oilMu_[regionIdx] = muo;
+        tablePool_ = TablePool<Scalar>();
+    }
 
     /*!
      * \brief Finish initializing the oil phase PVT properties.
@@ -169,6 +177,65 @@ public:
                                                   pressureColumn,
                                                   invBMuColumn);
         }
+
+        tablePool_ = TablePool<Scalar>();
+    }
+
+    /*!
+     * \brief Copy the tables of all regions into a single contiguous arena.
+     *
+     * This must be called after initEnd(). Afterwards, the properties are evaluated
+     * using the copies, which avoids scattered memory accesses if consecutively
+     * evaluated cells belong to different PVT regions. Changing the tables discards
+     * the copies.
+     */
+    void packTables()
+    {
+        size_t numRegions = inverseOilB_.size();
+        TablePool<Scalar> pool(numRegions, numPooledProperties_);
+        for (unsigned regionIdx = 0; regionIdx < numRegions; ++ regionIdx) {
+            pool.add(regionIdx, invOilBPoolIdx_, inverseOilB_[regionIdx]);
+            pool.add(regionIdx, invOilBMuPoolIdx_, inverseOilBMu_[regionIdx]);
+        }
+        pool.finalize();
+        tablePool_ = pool;
+    }
+
+    /*!
+     * \brief Returns true if the tables have been copied using packTables().
+     */
+    bool tablesPacked() const
+    { return tablePool_.isFinalized(); }
+
+    /*!
+     * \brief Returns the image which contains the packed tables.
+     *
+     * This is only valid after packTables() has been called. The image is position
+     * independent, i.e., it can be copied to memory which is shared by the processes
+     * of a node and be used there by attachTableImage().
+     */
+    const void* tableImage() const
+    { return tablePool_.data(); }
+
+    /*!
+     * \brief Returns the size of the image returned by tableImage() in bytes.
+     */
+    size_t tableImageSize() const
+    { return tablePool_.size(); }
+
+    /*!
+     * \brief Evaluate the properties using the packed tables of an image which is
+     *        stored elsewhere.
+     *
+     * The image must have been produced by tableImage() of an object with the same
+     * number of regions. It is not copied and must thus stay valid as long as this
+     * object is used. Changing the tables detaches the object from the image.
+     */
+    void attachTableImage(const void* image, size_t size)
+    {
+        TablePool<Scalar> pool(numRegions(), numPooledProperties_);
+        pool.useExternalImage(image, size);
+        tablePool_ = pool;
     }
 
     /*!
@@ -207,6 +274,15 @@ public:
                                   const Evaluation& /*temperature*/,
                                   const Evaluation& pressure) const
     {
+        if (tablePool_.isFinalized()) {
+            const Evaluation& invBo =
+                tablePool_.oneD(regionIdx, invOilBPoolIdx_).eval(pressure, /*extrapolate=*/true);
+            const Evaluation& invMuoBo =
+                tablePool_.oneD(regionIdx, invOilBMuPoolIdx_).eval(pressure, /*extrapolate=*/true);
+
+            return invBo/invMuoBo;
+        }
+
         const Evaluation& invBo = inverseOilB_[regionIdx].eval(pressure, /*extrapolate=*/true);
         const Evaluation& invMuoBo = inverseOilBMu_[regionIdx].eval(pressure, /*extrapolate=*/true);
 
@@ -218,10 +294,54 @@ public:
      */
     template <class Evaluation>
     Evaluation inverseFormationVolumeFactor(unsigned regionIdx,
-                                            const Evaluation& /*temperature*/,
+                                            const Evaluation& temperature,
                                             const Evaluation& pressure,
                                             const Evaluation& /*Rs*/) const
-    { return inverseOilB_[regionIdx].eval(pressure, /*extrapolate=*/true); }
+    { return saturatedInverseFormationVolumeFactor(regionIdx, temperature, pressure); }
+
+    /*!
+     * \brief Returns the inverse formation volume factor [-] and the dynamic viscosity
+     *        [Pa s] of the fluid phase.
+     *
+     * The tables for \f$1/B_o\f$ and \f$1/(B_o \mu_o)\f$ are sampled at the same
+     * pressures, so the pressure segment is only looked up once.
+     */
+    template <class Evaluation>
+    void inverseFormationVolumeFactorAndViscosity(unsigned regionIdx,
+                                                  const Evaluation& temperature,
+                                                  const Evaluation& pressure,
+                                                  const Evaluation& Rs,
+                                                  Evaluation& invB,
+                                                  Evaluation& mu) const
+    { inverseFormationVolumeFactorAndViscosity(1, &regionIdx, &temperature, &pressure, &Rs, &invB, &mu); }
+
+    /*!
+     * \brief Computes the inverse formation volume factors and the viscosities of a
+     *        batch of values.
+     *
+     * All arrays must have numValues entries.
+     */
+    template <class Evaluation>
+    void inverseFormationVolumeFactorAndViscosity(size_t numValues,
+                                                  const unsigned* regionIdx,
+                                                  const Evaluation* /*temperature*/,
+                                                  const Evaluation* pressure,
+                                                  const Evaluation* /*Rs*/,
+                                                  Evaluation* invB,
+                                                  Evaluation* mu) const
+    {
+        if (tablePool_.isFinalized()) {
+            for (size_t i = 0; i < numValues; ++i)
+                invBAndMu_(tablePool_.oneD(regionIdx[i], invOilBPoolIdx_),
+                           tablePool_.oneD(regionIdx[i], invOilBMuPoolIdx_),
+                           pressure[i], invB[i], mu[i]);
+            return;
+        }
+
+        for (size_t i = 0; i < numValues; ++i)
+            invBAndMu_(inverseOilB_[regionIdx[i]], inverseOilBMu_[regionIdx[i]],
+                       pressure[i], invB[i], mu[i]);
+    }
 
     /*!
      * \brief Returns the formation volume factor [-] of saturated oil.
@@ -232,7 +352,12 @@ public:
     Evaluation saturatedInverseFormationVolumeFactor(unsigned regionIdx,
                                               const Evaluation& /*temperature*/,
                                               const Evaluation& pressure) const
-    { return inverseOilB_[regionIdx].eval(pressure, /*extrapolate=*/true); }
+    {
+        if (tablePool_.isFinalized())
+            return tablePool_.oneD(regionIdx, invOilBPoolIdx_).eval(pressure, /*extrapolate=*/true);
+
+        return inverseOilB_[regionIdx].eval(pressure, /*extrapolate=*/true);
+    }
 
     /*!
      * \brief Returns the gas dissolution factor \f$R_s\f$ [m^3/m^3] of the oil phase.
@@ -300,17 +425,54 @@ public:
 
     bool operator==(const DeadOilPvt<Scalar>& data) const
     {
-        return this->oilReferenceDensity() == data.oilReferenceDensity() &&
-               this->inverseOilB() == data.inverseOilB() &&
-               this->oilMu() == data.oilMu() &&
-               this->inverseOilBMu() == data.inverseOilBMu();
+        return oilReferenceDensity_ == data.oilReferenceDensity_ &&
+               inverseOilB_ == data.inverseOilB_ &&
+               oilMu_ == data.oilMu_ &&
+               inverseOilBMu_ == data.inverseOilBMu_;
+    }
+
+    template <class Serializer>
+    void serializeOp(Serializer& serializer)
+    {
+        serializer(oilReferenceDensity_);
+        serializer(inverseOilB_);
+        serializer(oilMu_);
+        serializer(inverseOilBMu_);
+
+        // the packed copies of the tables are not stored but recreated
+        bool packed = tablesPacked();
+        serializer(packed);
+        if (serializer.isLoading()) {
+            tablePool_ = TablePool<Scalar>();
+            if (packed)
+                packTables();
+        }
     }
 
 private:
+    template <class Table, class Evaluation>
+    static void invBAndMu_(const Table& invBTable,
+                           const Table& invBMuTable,
+                           const Evaluation& pressure,
+                           Evaluation& invB,
+                           Evaluation& mu)
+    {
+        size_t segIdx = invBTable.findSegmentIndex(pressure, /*extrapolate=*/true);
+        invB = invBTable.evalInSegment(pressure, segIdx);
+        mu = invB/invBMuTable.evalInSegment(pressure, segIdx);
+    }
+
+    enum {
+        invOilBPoolIdx_ = 0,
+        invOilBMuPoolIdx_ = 1,
+        numPooledProperties_ = 2
+    };
+
     std::vector<Scalar> oilReferenceDensity_;
     std::vector<TabulatedOneDFunction> inverseOilB_;
     std::vector<TabulatedOneDFunction> oilMu_;
     std::vector<TabulatedOneDFunction> inverseOilBMu_;
+    TablePool<Scalar> tablePool_;
 };
 
 } // namespace Opm
@@ -30,6 +30,7 @@
 #include <opm/material/Constants.hpp>
 
 #include <opm/material/common/Tabulated1DFunction.hpp>
+#include <opm/material/common/TablePool.hpp>
 
 #if HAVE_ECL_INPUT
 #include <opm/parser/eclipse/EclipseState/EclipseState.hpp>
@@ -122,6 +123,7 @@ public:
         inverseGasB_.resize(numRegions);
         inverseGasBMu_.resize(numRegions);
         gasMu_.resize(numRegions);
+        tablePool_ = TablePool<Scalar>();
     }
 
 
@@ -151,7 +153,10 @@ public:
      * This is a function of \f$(p_g)\f$...
      */
     void setGasViscosity(unsigned regionIdx, const TabulatedOneDFunction& mug)
-    { gasMu_[regionIdx] = mug; }
+    {
+        gasMu_[regionIdx] = mug;
+        tablePool_ = TablePool<Scalar>();
+    }
 
     /*!
      * \brief Initialize the function for the formation volume factor of dry gas
@@ -168,6 +173,7 @@ public:
 
         inverseGasB_[regionIdx].setContainerOfTuples(tmp);
         assert(inverseGasB_[regionIdx].monotonic());
+        tablePool_ = TablePool<Scalar>();
     }
 
     /*!
@@ -193,6 +199,66 @@ public:
 
             inverseGasBMu_[regionIdx].setXYContainers(pressureValues, invGasBMuValues);
         }
+
+        tablePool_ = TablePool<Scalar>();
+    }
+
+    /*!
+     * \brief Copy the tables of all regions into a single contiguous arena.
+     *
+     * This must be called after initEnd(). Afterwards, the properties are evaluated
+     * using the copies, which avoids scattered memory accesses if consecutively
+     * evaluated cells belong to different PVT regions. Changing the tables discards
+     * the copies.
+     */
+    void packTables()
+    {
+        size_t numRegions = inverseGasB_.size();
+        TablePool<Scalar> pool(numRegions, numPooledProperties_);
+        for (unsigned regionIdx = 0; regionIdx < numRegions; ++ regionIdx) {
+            pool.add(regionIdx, invGasBPoolIdx_, inverseGasB_[regionIdx]);
+            pool.add(regionIdx, invGasBMuPoolIdx_, inverseGasBMu_[regionIdx]);
+        }
+        pool.finalize();
+        tablePool_ = pool;
+    }
+
+    /*!
+     * \brief Returns true if the tables have been copied using packTables().
+     */
+    bool tablesPacked() const
+    { return tablePool_.isFinalized(); }
+
+    /*!
+     * \brief Returns the image which contains the packed tables.
+     *
+     * This is only valid after packTables() has been called. The image is position
+     * independent, i.e., it can be copied to memory which is shared by the processes
+     * of a node and be used there by attachTableImage().
+     */
+    const void* tableImage() const
+    { return tablePool_.data(); }
+
+    /*!
+     * \brief Returns the size of the image returned by tableImage() in bytes.
+     */
+    size_t tableImageSize() const
+    { return tablePool_.size(); }
+
+    /*!
+     * \brief Evaluate the properties using the packed tables of an image which is
+     *        stored elsewhere.
+     *
+     * The image must have been produced by tableImage() of an object with the same
+     * number of regions, typically by another process on the same node. It is not
+     * copied and must thus stay valid as long as this object is used. Changing the
+     * tables detaches the object from the image.
+     */
+    void attachTableImage(const void* image, size_t size)
+    {
+        TablePool<Scalar> pool(numRegions(), numPooledProperties_);
+        pool.useExternalImage(image, size);
+        tablePool_ = pool;
     }
 
     /*!
@@ -231,6 +297,15 @@ public:
                                   const Evaluation& /*temperature*/,
                                   const Evaluation& pressure) const
     {
+        if (tablePool_.isFinalized()) {
+            const Evaluation& invBg =
+                tablePool_.oneD(regionIdx, invGasBPoolIdx_).eval(pressure, /*extrapolate=*/true);
+            const Evaluation& invMugBg =
+                tablePool_.oneD(regionIdx, invGasBMuPoolIdx_).eval(pressure, /*extrapolate=*/true);
+
+            return invBg/invMugBg;
+        }
+
         const Evaluation& invBg = inverseGasB_[regionIdx].eval(pressure, /*extrapolate=*/true);
         const Evaluation& invMugBg = inverseGasBMu_[regionIdx].eval(pressure, /*extrapolate=*/true);
 
@@ -254,7 +329,57 @@ public:
     Evaluation saturatedInverseFormationVolumeFactor(unsigned regionIdx,
                                                      const Evaluation& /*temperature*/,
                                                      const Evaluation& pressure) const
-    { return inverseGasB_[regionIdx].eval(pressure, /*extrapolate=*/true); }
+    {
+        if (tablePool_.isFinalized())
+            return tablePool_.oneD(regionIdx, invGasBPoolIdx_).eval(pressure, /*extrapolate=*/true);
+
+        return inverseGasB_[regionIdx].eval(pressure, /*extrapolate=*/true);
+    }
+
+    /*!
+     * \brief Returns the inverse formation volume factor [-] and the dynamic viscosity
+     *        [Pa s] of the fluid phase.
+     *
+     * The tables for \f$1/B_g\f$ and \f$1/(B_g \mu_g)\f$ are sampled at the same
+     * pressures, so the pressure segment is only looked up once. The results are
+     * identical to the ones of inverseFormationVolumeFactor() and viscosity().
+     */
+    template <class Evaluation>
+    void inverseFormationVolumeFactorAndViscosity(unsigned regionIdx,
+                                                  const Evaluation& temperature,
+                                                  const Evaluation& pressure,
+                                                  const Evaluation& Rv,
+                                                  Evaluation& invB,
+                                                  Evaluation& mu) const
+    { inverseFormationVolumeFactorAndViscosity(1, &regionIdx, &temperature, &pressure, &Rv, &invB, &mu); }
+
+    /*!
+     * \brief Computes the inverse formation volume factors and the viscosities of a
+     *        batch of values.
+     *
+     * All arrays must have numValues entries.
+     */
+    template <class Evaluation>
+    void inverseFormationVolumeFactorAndViscosity(size_t numValues,
+                                                  const unsigned* regionIdx,
+                                                  const Evaluation* /*temperature*/,
+                                                  const Evaluation* pressure,
+                                                  const Evaluation* /*Rv*/,
+                                                  Evaluation* invB,
+                                                  Evaluation* mu) const
+    {
+        if (tablePool_.isFinalized()) {
+            for (size_t i = 0; i < numValues; ++i)
+                invBAndMu_(tablePool_.oneD(regionIdx[i], invGasBPoolIdx_),
+                           tablePool_.oneD(regionIdx[i], invGasBMuPoolIdx_),
+                           pressure[i], invB[i], mu[i]);
+            return;
+        }
+
+        for (size_t i = 0; i < numValues; ++i)
+            invBAndMu_(inverseGasB_[regionIdx[i]], inverseGasBMu_[regionIdx[i]],
+                       pressure[i], invB[i], mu[i]);
+    }
 
     /*!
      * \brief Returns the saturation pressure of the gas phase [Pa]
@@ -316,11 +441,48 @@ public:
                inverseGasBMu_ == data.inverseGasBMu_;
     }
 
+    template <class Serializer>
+    void serializeOp(Serializer& serializer)
+    {
+        serializer(gasReferenceDensity_);
+        serializer(inverseGasB_);
+        serializer(gasMu_);
+        serializer(inverseGasBMu_);
+
+        // the packed copies of the tables are not stored but recreated
+        bool packed = tablesPacked();
+        serializer(packed);
+        if (serializer.isLoading()) {
+            tablePool_ = TablePool<Scalar>();
+            if (packed)
+                packTables();
+        }
+    }
+
 private:
+    template <class Table, class Evaluation>
+    static void invBAndMu_(const Table& invBTable,
+                           const Table& invBMuTable,
+                           const Evaluation& pressure,
+                           Evaluation& invB,
+                           Evaluation& mu)
+    {
+        size_t segIdx = invBTable.findSegmentIndex(pressure, /*extrapolate=*/true);
+        invB = invBTable.evalInSegment(pressure, segIdx);
+        mu = invB/invBMuTable.evalInSegment(pressure, segIdx);
+    }
+
+    enum {
+        invGasBPoolIdx_ = 0,
+        invGasBMuPoolIdx_ = 1,
+        numPooledProperties_ = 2
+    };
+
     std::vector<Scalar> gasReferenceDensity_;
     std::vector<TabulatedOneDFunction> inverseGasB_;
     std::vector<TabulatedOneDFunction> gasMu_;
     std::vector<TabulatedOneDFunction> inverseGasBMu_;
+    TablePool<Scalar> tablePool_;
 };
 
 } // namespace Opm
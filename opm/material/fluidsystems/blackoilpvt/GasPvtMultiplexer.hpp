@@ -240,6 +240,44 @@ public:
                                                      const Evaluation& pressure) const
     { OPM_GAS_PVT_MULTIPLEXER_CALL(return pvtImpl.saturatedInverseFormationVolumeFactor(regionIdx, temperature, pressure)); return 0; }
 
+    /*!
+     * \brief Returns the inverse formation volume factor [-] and the dynamic viscosity
+     *        [Pa s] of the fluid phase.
+     *
+     * Compared to calling inverseFormationVolumeFactor() and viscosity(), this only
+     * dispatches on the PVT approach once. For thermal PVT, the temperature corrections
+     * are applied on top of a single evaluation of the isothermal quantities.
+     */
+    template <class Evaluation = Scalar>
+    void inverseFormationVolumeFactorAndViscosity(unsigned regionIdx,
+                                                  const Evaluation& temperature,
+                                                  const Evaluation& pressure,
+                                                  const Evaluation& Rv,
+                                                  Evaluation& invB,
+                                                  Evaluation& mu) const
+    {
+        OPM_GAS_PVT_MULTIPLEXER_CALL(invBAndMu_(pvtImpl, 1, &regionIdx, &temperature, &pressure, &Rv, &invB, &mu, /*preferFused=*/0));
+    }
+
+    /*!
+     * \brief Computes the inverse formation volume factors and the viscosities of a
+     *        batch of values.
+     *
+     * All arrays must have numValues entries.
+     */
+    template <class Evaluation = Scalar>
+    void inverseFormationVolumeFactorAndViscosity(size_t numValues,
+                                                  const unsigned* regionIdx,
+                                                  const Evaluation* temperature,
+                                                  const Evaluation* pressure,
+                                                  const Evaluation* Rv,
+                                                  Evaluation* invB,
+                                                  Evaluation* mu) const
+    {
+        OPM_GAS_PVT_MULTIPLEXER_CALL(invBAndMu_(pvtImpl, numValues, regionIdx, temperature, pressure, Rv, invB, mu, /*preferFused=*/0));
+    }
+
+
     /*!
      * \brief Returns the oil vaporization factor \f$R_v\f$ [m^3/m^3] of oil saturated gas.
      */
@@ -291,6 +329,69 @@ public:
     GasPvtApproach gasPvtApproach() const
     { return gasPvtApproach_; }
 
+    /*!
+     * \brief Returns true if the tables of the PVT approach can be packed into an image
+     *        which can be shared by the processes of a node.
+     *
+     * This is the case for dry and wet gas.
+     */
+    bool supportsTableImage() const
+    { return gasPvtApproach_ == DryGasPvt || gasPvtApproach_ == WetGasPvt; }
+
+    /*!
+     * \brief Copy the tables into a position independent image.
+     *
+     * The image is returned by tableImage() and is used to evaluate the properties
+     * afterwards. One process of a node typically copies it into a
+     * SharedMemorySegment, and the others use attachTableImage() to evaluate their
+     * properties using the segment.
+     */
+    void packTables()
+    {
+        checkTableImageSupport_();
+        if (gasPvtApproach_ == DryGasPvt)
+            getRealPvt<DryGasPvt>().packTables();
+        else
+            getRealPvt<WetGasPvt>().packTables();
+    }
+
+    /*!
+     * \brief Returns the image created by packTables().
+     */
+    const void* tableImage() const
+    {
+        checkTableImageSupport_();
+        if (gasPvtApproach_ == DryGasPvt)
+            return getRealPvt<DryGasPvt>().tableImage();
+        return getRealPvt<WetGasPvt>().tableImage();
+    }
+
+    /*!
+     * \brief Returns the size of the image created by packTables() in bytes.
+     */
+    size_t tableImageSize() const
+    {
+        checkTableImageSupport_();
+        if (gasPvtApproach_ == DryGasPvt)
+            return getRealPvt<DryGasPvt>().tableImageSize();
+        return getRealPvt<WetGasPvt>().tableImageSize();
+    }
+
+    /*!
+     * \brief Evaluate the properties using an image which was created by packTables()
+     *        of a multiplexer for the same deck.
+     *
+     * The image is not copied and must stay valid as long as this object is used.
+     */
+    void attachTableImage(const void* image, size_t size)
+    {
+        checkTableImageSupport_();
+        if (gasPvtApproach_ == DryGasPvt)
+            getRealPvt<DryGasPvt>().attachTableImage(image, size);
+        else
+            getRealPvt<WetGasPvt>().attachTableImage(image, size);
+    }
+
     // get the parameter object for the dry gas case
     template <GasPvtApproach approachV>
     typename std::enable_if<approachV == DryGasPvt, Opm::DryGasPvt<Scalar> >::type& getRealPvt()
@@ -375,6 +476,25 @@ public:
         }
     }
 
+    template <class Serializer>
+    void serializeOp(Serializer& serializer)
+    {
+        GasPvtApproach approach = gasPvtApproach_;
+        serializer(approach);
+        if (serializer.isLoading()) {
+            // the temporary takes over the current implementation object and disposes it
+            GasPvtMultiplexer<Scalar,enableThermal> oldPvt(gasPvtApproach_, realGasPvt_);
+            gasPvtApproach_ = NoGasPvt;
+            realGasPvt_ = nullptr;
+            if (approach != NoGasPvt)
+                setApproach(approach);
+        }
+
+        if (gasPvtApproach_ != NoGasPvt) {
+            OPM_GAS_PVT_MULTIPLEXER_CALL(serializer(pvtImpl));
+        }
+    }
+
     GasPvtMultiplexer<Scalar,enableThermal>& operator=(const GasPvtMultiplexer<Scalar,enableThermal>& data)
     {
         gasPvtApproach_ = data.gasPvtApproach_;
@@ -399,6 +519,44 @@ public:
     }
 
 private:
+    void checkTableImageSupport_() const
+    {
+        if (!supportsTableImage())
+            throw std::logic_error("The gas PVT approach does not support table images");
+    }
+
+    // use the fused method of the PVT implementation if it provides one ...
+    template <class PvtImpl, class Evaluation>
+    static auto invBAndMu_(const PvtImpl& pvtImpl,
+                           size_t numValues,
+                           const unsigned* regionIdx,
+                           const Evaluation* temperature,
+                           const Evaluation* pressure,
+                           const Evaluation* Rv,
+                           Evaluation* invB,
+                           Evaluation* mu,
+                           int /*preferFused*/)
+        -> decltype(pvtImpl.inverseFormationVolumeFactorAndViscosity(numValues, regionIdx, temperature, pressure, Rv, invB, mu))
+    { pvtImpl.inverseFormationVolumeFactorAndViscosity(numValues, regionIdx, temperature, pressure, Rv, invB, mu); }
+
+    // ... else compute both quantities separately
+    template <class PvtImpl, class Evaluation>
+    static void invBAndMu_(const PvtImpl& pvtImpl,
+                           size_t numValues,
+                           const unsigned* regionIdx,
+                           const Evaluation* temperature,
+                           const Evaluation* pressure,
+                           const Evaluation* Rv,
+                           Evaluation* invB,
+                           Evaluation* mu,
+                           long /*preferFused*/)
+    {
+        for (size_t i = 0; i < numValues; ++i) {
+            invB[i] = pvtImpl.inverseFormationVolumeFactor(regionIdx[i], temperature[i], pressure[i], Rv[i]);
+            mu[i] = pvtImpl.viscosity(regionIdx[i], temperature[i], pressure[i], Rv[i]);
+        }
+    }
+
     GasPvtApproach gasPvtApproach_;
     void* realGasPvt_;
 };
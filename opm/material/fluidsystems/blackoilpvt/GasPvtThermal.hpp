@@ -374,6 +374,62 @@ public:
     {
         return isothermalPvt_->diffusionCoefficient(temperature, pressure, compIdx);
     }
+
+    /*!
+     * \brief Returns the inverse formation volume factor [-] and the dynamic viscosity
+     *        [Pa s] of the fluid phase.
+     */
+    template <class Evaluation>
+    void inverseFormationVolumeFactorAndViscosity(unsigned regionIdx,
+                                                  const Evaluation& temperature,
+                                                  const Evaluation& pressure,
+                                                  const Evaluation& Rv,
+                                                  Evaluation& invB,
+                                                  Evaluation& mu) const
+    { inverseFormationVolumeFactorAndViscosity(1, &regionIdx, &temperature, &pressure, &Rv, &invB, &mu); }
+
+    /*!
+     * \brief Computes the inverse formation volume factors and the viscosities of a
+     *        batch of values.
+     *
+     * Unless the viscosity is given by GASVISCT, the isothermal quantities are
+     * evaluated for all values at once. All arrays must have numValues entries.
+     */
+    template <class Evaluation>
+    void inverseFormationVolumeFactorAndViscosity(size_t numValues,
+                                                  const unsigned* regionIdx,
+                                                  const Evaluation* temperature,
+                                                  const Evaluation* pressure,
+                                                  const Evaluation* Rv,
+                                                  Evaluation* invB,
+                                                  Evaluation* mu) const
+    {
+        if (!enableThermalViscosity()) {
+            // the isothermal quantities of the whole batch are computed using a single
+            // dispatch of the isothermal PVT multiplexer
+            isothermalPvt_->inverseFormationVolumeFactorAndViscosity(numValues, regionIdx, temperature,
+                                                                     pressure, Rv, invB, mu);
+        }
+
+        for (size_t i = 0; i < numValues; ++i) {
+            unsigned pvtRegionIdx = regionIdx[i];
+
+            // with thermal viscosity, the viscosity of gas only depends on temperature,
+            // so the isothermal viscosity is not required
+            if (enableThermalViscosity()) {
+                invB[i] = isothermalPvt_->inverseFormationVolumeFactor(pvtRegionIdx, temperature[i], pressure[i], Rv[i]);
+                mu[i] = gasvisctCurves_[pvtRegionIdx].eval(temperature[i]);
+            }
+
+            if (enableThermalDensity()) {
+                Scalar cT1 = gasdentCT1_[pvtRegionIdx];
+                Scalar cT2 = gasdentCT2_[pvtRegionIdx];
+                const Evaluation& Y = temperature[i] - gasdentRefTemp_[pvtRegionIdx];
+                invB[i] = invB[i]/(1 + (cT1 + cT2*Y)*Y);
+            }
+        }
+    }
+
     const IsothermalPvt* isoThermalPvt() const
     { return isothermalPvt_; }
 
@@ -417,6 +473,28 @@ public:
                 this->enableInternalEnergy() == data.enableInternalEnergy();
     }
 
+    template <class Serializer>
+    void serializeOp(Serializer& serializer)
+    {
+        bool hasIsothermalPvt = isothermalPvt_ != nullptr;
+        serializer(hasIsothermalPvt);
+        if (serializer.isLoading()) {
+            delete isothermalPvt_;
+            isothermalPvt_ = hasIsothermalPvt ? new IsothermalPvt : nullptr;
+        }
+        if (isothermalPvt_)
+            serializer(*isothermalPvt_);
+
+        serializer(gasvisctCurves_);
+        serializer(gasdentRefTemp_);
+        serializer(gasdentCT1_);
+        serializer(gasdentCT2_);
+        serializer(internalEnergyCurves_);
+        serializer(enableThermalDensity_);
+        serializer(enableThermalViscosity_);
+        serializer(enableInternalEnergy_);
+    }
+
     GasPvtThermal<Scalar>& operator=(const GasPvtThermal<Scalar>& data)
     {
         if (data.isothermalPvt_)
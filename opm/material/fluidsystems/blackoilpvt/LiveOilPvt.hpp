@@ -32,6 +32,8 @@
 #include <opm/material/common/MathToolbox.hpp>
 #include <opm/material/common/UniformXTabulated2DFunction.hpp>
 #include <opm/material/common/Tabulated1DFunction.hpp>
+#include <opm/material/common/LazyRegionInitializer.hpp>
+#include <opm/material/common/TablePool.hpp>
 
 #if HAVE_ECL_INPUT
 #include <opm/parser/eclipse/EclipseState/EclipseState.hpp>
@@ -89,8 +91,12 @@ public:
 #if HAVE_ECL_INPUT
     /*!
      * \brief Initialize the oil parameters via the data specified by the PVTO ECL keyword.
+     *
+     * If lazyInit is true, only the reference densities are set up immediately. The
+     * interpolation tables of a PVT region are then built when the region is used for
+     * the first time, which may happen concurrently from several threads.
      */
-    void initFromState(const EclipseState& eclState, const Schedule& schedule)
+    void initFromState(const EclipseState& eclState, const Schedule& schedule, bool lazyInit = false)
     {
         const auto& pvtoTables = eclState.getTableManager().getPvtoTables();
         const auto& densityTable = eclState.getTableManager().getDensityTable();
@@ -108,102 +114,115 @@ public:
             setReferenceDensities(regionIdx, rhoRefO, rhoRefG, rhoRefW);
         }
 
+        vapPar2_ = 0.0;
+        const auto& oilVap = schedule[0].oilvap();
+        if (oilVap.getType() == OilVaporizationProperties::OilVaporization::VAPPARS) {
+            vapPar2_ = oilVap.vap2();
+        }
+
+        if (lazyInit) {
+            // the tables of a region are only built when the region is used for the
+            // first time
+            pvtoTables_ = pvtoTables;
+            lazyRegions_.resize(numRegions);
+            return;
+        }
+
+        pvtoTables_.clear();
+        lazyRegions_.resize(0);
+
         // initialize the internal table objects
-        for (unsigned regionIdx = 0; regionIdx < numRegions; ++ regionIdx) {
-            const auto& pvtoTable = pvtoTables[regionIdx];
-
-            const auto& saturatedTable = pvtoTable.getSaturatedTable();
-            assert(saturatedTable.numRows() > 1);
-
-            auto& oilMu = oilMuTable_[regionIdx];
-            auto& satOilMu = saturatedOilMuTable_[regionIdx];
-            auto& invOilB = inverseOilBTable_[regionIdx];
-            auto& invSatOilB = inverseSaturatedOilBTable_[regionIdx];
-            auto& gasDissolutionFac = saturatedGasDissolutionFactorTable_[regionIdx];
-            std::vector<Scalar> invSatOilBArray;
-            std::vector<Scalar> satOilMuArray;
-
-            // extract the table for the gas dissolution and the oil formation volume factors
-            for (unsigned outerIdx = 0; outerIdx < saturatedTable.numRows(); ++ outerIdx) {
-                Scalar Rs    = saturatedTable.get("RS", outerIdx);
-                Scalar BoSat = saturatedTable.get("BO", outerIdx);
-                Scalar muoSat = saturatedTable.get("MU", outerIdx);
-
-                satOilMuArray.push_back(muoSat);
-                invSatOilBArray.push_back(1.0/BoSat);
-
-                invOilB.appendXPos(Rs);
-                oilMu.appendXPos(Rs);
-
-                assert(invOilB.numX() == outerIdx + 1);
-                assert(oilMu.numX() == outerIdx + 1);
-
-                const auto& underSaturatedTable = pvtoTable.getUnderSaturatedTable(outerIdx);
-                size_t numRows = underSaturatedTable.numRows();
-                for (unsigned innerIdx = 0; innerIdx < numRows; ++ innerIdx) {
-                    Scalar po = underSaturatedTable.get("P", innerIdx);
-                    Scalar Bo = underSaturatedTable.get("BO", innerIdx);
-                    Scalar muo = underSaturatedTable.get("MU", innerIdx);
-
-                    invOilB.appendSamplePoint(outerIdx, po, 1.0/Bo);
-                    oilMu.appendSamplePoint(outerIdx, po, muo);
-                }
-            }
+        for (unsigned regionIdx = 0; regionIdx < numRegions; ++ regionIdx)
+            initRegionFromPvto_(regionIdx, pvtoTables[regionIdx]);
 
-            // update the tables for the formation volume factor and for the gas
-            // dissolution factor of saturated oil
-            {
-                const auto& tmpPressureColumn = saturatedTable.getColumn("P");
-                const auto& tmpGasSolubilityColumn = saturatedTable.getColumn("RS");
+        initEnd();
+    }
 
-                invSatOilB.setXYContainers(tmpPressureColumn, invSatOilBArray);
-                satOilMu.setXYContainers(tmpPressureColumn, satOilMuArray);
-                gasDissolutionFac.setXYContainers(tmpPressureColumn, tmpGasSolubilityColumn);
-            }
+private:
+    void initRegionFromPvto_(unsigned regionIdx, const PvtoTable& pvtoTable)
+    {
+        const auto& saturatedTable = pvtoTable.getSaturatedTable();
+        assert(saturatedTable.numRows() > 1);
+
+        auto& oilMu = oilMuTable_[regionIdx];
+        auto& satOilMu = saturatedOilMuTable_[regionIdx];
+        auto& invOilB = inverseOilBTable_[regionIdx];
+        auto& invSatOilB = inverseSaturatedOilBTable_[regionIdx];
+        auto& gasDissolutionFac = saturatedGasDissolutionFactorTable_[regionIdx];
+        std::vector<Scalar> invSatOilBArray;
+        std::vector<Scalar> satOilMuArray;
+
+        // extract the table for the gas dissolution and the oil formation volume factors
+        for (unsigned outerIdx = 0; outerIdx < saturatedTable.numRows(); ++ outerIdx) {
+            Scalar Rs    = saturatedTable.get("RS", outerIdx);
+            Scalar BoSat = saturatedTable.get("BO", outerIdx);
+            Scalar muoSat = saturatedTable.get("MU", outerIdx);
+
+            satOilMuArray.push_back(muoSat);
+            invSatOilBArray.push_back(1.0/BoSat);
+
+            invOilB.appendXPos(Rs);
+            oilMu.appendXPos(Rs);
+
+            assert(invOilB.numX() == outerIdx + 1);
+            assert(oilMu.numX() == outerIdx + 1);
+
+            const auto& underSaturatedTable = pvtoTable.getUnderSaturatedTable(outerIdx);
+            size_t numRows = underSaturatedTable.numRows();
+            for (unsigned innerIdx = 0; innerIdx < numRows; ++ innerIdx) {
+                Scalar po = underSaturatedTable.get("P", innerIdx);
+                Scalar Bo = underSaturatedTable.get("BO", innerIdx);
+                Scalar muo = underSaturatedTable.get("MU", innerIdx);
 
-            updateSaturationPressure_(regionIdx);
-            // make sure to have at least two sample points per Rs value
-            for (unsigned xIdx = 0; xIdx < invOilB.numX(); ++xIdx) {
-                // a single sample point is definitely needed
-                assert(invOilB.numY(xIdx) > 0);
-
-                // everything is fine if the current table has two or more sampling points
-                // for a given mole fraction
-                if (invOilB.numY(xIdx) > 1)
-                    continue;
-
-                // find the master table which will be used as a template to extend the
-                // current line. We define master table as the first table which has values
-                // for undersaturated oil...
-                size_t masterTableIdx = xIdx + 1;
-                for (; masterTableIdx < saturatedTable.numRows(); ++masterTableIdx)
-                {
-                    if (pvtoTable.getUnderSaturatedTable(masterTableIdx).numRows() > 1)
-                        break;
-                }
-
-                if (masterTableIdx >= saturatedTable.numRows())
-                    throw std::runtime_error("PVTO tables are invalid: The last table must exhibit at least one "
-                                             "entry for undersaturated oil!");
-
-                // extend the current table using the master table.
-                extendPvtoTable_(regionIdx,
-                                 xIdx,
-                                 pvtoTable.getUnderSaturatedTable(xIdx),
-                                 pvtoTable.getUnderSaturatedTable(masterTableIdx));
+                invOilB.appendSamplePoint(outerIdx, po, 1.0/Bo);
+                oilMu.appendSamplePoint(outerIdx, po, muo);
             }
         }
 
-        vapPar2_ = 0.0;
-        const auto& oilVap = schedule[0].oilvap();
-        if (oilVap.getType() == OilVaporizationProperties::OilVaporization::VAPPARS) {
-            vapPar2_ = oilVap.vap2();
+        // update the tables for the formation volume factor and for the gas
+        // dissolution factor of saturated oil
+        {
+            const auto& tmpPressureColumn = saturatedTable.getColumn("P");
+            const auto& tmpGasSolubilityColumn = saturatedTable.getColumn("RS");
+
+            invSatOilB.setXYContainers(tmpPressureColumn, invSatOilBArray);
+            satOilMu.setXYContainers(tmpPressureColumn, satOilMuArray);
+            gasDissolutionFac.setXYContainers(tmpPressureColumn, tmpGasSolubilityColumn);
         }
 
-        initEnd();
+        updateSaturationPressure_(regionIdx);
+        // make sure to have at least two sample points per Rs value
+        for (unsigned xIdx = 0; xIdx < invOilB.numX(); ++xIdx) {
+            // a single sample point is definitely needed
+            assert(invOilB.numY(xIdx) > 0);
+
+            // everything is fine if the current table has two or more sampling points
+            // for a given mole fraction
+            if (invOilB.numY(xIdx) > 1)
+                continue;
+
+            // find the master table which will be used as a template to extend the
+            // current line. We define master table as the first table which has values
+            // for undersaturated oil...
+            size_t masterTableIdx = xIdx + 1;
+            for (; masterTableIdx < saturatedTable.numRows(); ++masterTableIdx)
+            {
+                if (pvtoTable.getUnderSaturatedTable(masterTableIdx).numRows() > 1)
+                    break;
+            }
+
+            if (masterTableIdx >= saturatedTable.numRows())
+                throw std::runtime_error("PVTO tables are invalid: The last table must exhibit at least one "
+                                         "entry for undersaturated oil!");
+
+            // extend the current table using the master table.
+            extendPvtoTable_(regionIdx,
+                             xIdx,
+                             pvtoTable.getUnderSaturatedTable(xIdx),
+                             pvtoTable.getUnderSaturatedTable(masterTableIdx));
+        }
     }
 
-private:
     void extendPvtoTable_(unsigned regionIdx,
                           unsigned xIdx,
                           const SimpleTable& curTable,
@@ -270,6 +289,7 @@ public:
         saturatedOilMuTable_.resize(numRegions);
         saturatedGasDissolutionFactorTable_.resize(numRegions);
         saturationPressure_.resize(numRegions);
+        tablePool_ = TablePool<Scalar>();
     }
 
     /*!
@@ -290,7 +310,10 @@ public:
      * \param samplePoints A container of (x,y) values.
      */
     void setSaturatedOilGasDissolutionFactor(unsigned regionIdx, const SamplingPoints& samplePoints)
-    { saturatedGasDissolutionFactorTable_[regionIdx].setContainerOfTuples(samplePoints); }
+    {
+        saturatedGasDissolutionFactorTable_[regionIdx].setContainerOfTuples(samplePoints);
+        tablePool_ = TablePool<Scalar>();
+    }
 
     /*!
      * \brief Initialize the function for the oil formation volume factor
@@ -303,6 +326,8 @@ public:
      */
     void setSaturatedOilFormationVolumeFactor(unsigned regionIdx, const SamplingPoints& samplePoints)
     {
+        tablePool_ = TablePool<Scalar>();
+
         Scalar T = 273.15 + 15.56; // [K]
         auto& invOilB = inverseOilBTable_[regionIdx];
 
@@ -338,7 +363,10 @@ public:
      * and not the other way around.
      */
     void setInverseOilFormationVolumeFactor(unsigned regionIdx, const TabulatedTwoDFunction& invBo)
-    { inverseOilBTable_[regionIdx] = invBo; }
+    {
+        inverseOilBTable_[regionIdx] = invBo;
+        tablePool_ = TablePool<Scalar>();
+    }
 
     /*!
      * \brief Initialize the viscosity of the oil phase.
@@ -346,7 +374,10 @@ public:
      * This is a function of \f$(R_s, p_o)\f$...
      */
     void setOilViscosity(unsigned regionIdx, const TabulatedTwoDFunction& muo)
-    { oilMuTable_[regionIdx] = muo; }
+    {
+        oilMuTable_[regionIdx] = muo;
+        tablePool_ = TablePool<Scalar>();
+    }
 
     /*!
      * \brief Initialize the phase viscosity for gas saturated oil
@@ -357,6 +388,8 @@ public:
      */
     void setSaturatedOilViscosity(unsigned regionIdx, const SamplingPoints& samplePoints)
     {
+        tablePool_ = TablePool<Scalar>();
+
         Scalar T = 273.15 + 15.56; // [K]
 
         // update the table for the saturated oil
@@ -385,48 +418,81 @@ public:
      */
     void initEnd()
     {
+        tablePool_ = TablePool<Scalar>();
+
+        // if the tables are initialized lazily, the final functions of each region
+        // are calculated when the region is built
+        if (lazyRegions_.isLazy())
+            return;
+
         // calculate the final 2D functions which are used for interpolation.
         size_t numRegions = oilMuTable_.size();
-        for (unsigned regionIdx = 0; regionIdx < numRegions; ++ regionIdx) {
-            // calculate the table which stores the inverse of the product of the oil
-            // formation volume factor and the oil viscosity
-            const auto& oilMu = oilMuTable_[regionIdx];
-            const auto& satOilMu = saturatedOilMuTable_[regionIdx];
-            const auto& invOilB = inverseOilBTable_[regionIdx];
-            assert(oilMu.numX() == invOilB.numX());
-
-            auto& invOilBMu = inverseOilBMuTable_[regionIdx];
-            auto& invSatOilB = inverseSaturatedOilBTable_[regionIdx];
-            auto& invSatOilBMu = inverseSaturatedOilBMuTable_[regionIdx];
-
-            std::vector<Scalar> satPressuresArray;
-            std::vector<Scalar> invSatOilBArray;
-            std::vector<Scalar> invSatOilBMuArray;
-            for (unsigned rsIdx = 0; rsIdx < oilMu.numX(); ++rsIdx) {
-                invOilBMu.appendXPos(oilMu.xAt(rsIdx));
-
-                assert(oilMu.numY(rsIdx) == invOilB.numY(rsIdx));
-
-                size_t numPressures = oilMu.numY(rsIdx);
-                for (unsigned pIdx = 0; pIdx < numPressures; ++pIdx)
-                    invOilBMu.appendSamplePoint(rsIdx,
-                                                oilMu.yAt(rsIdx, pIdx),
-                                                invOilB.valueAt(rsIdx, pIdx)
-                                                / oilMu.valueAt(rsIdx, pIdx));
-
-                // the sampling points in UniformXTabulated2DFunction are always sorted
-                // in ascending order. Thus, the value for saturated oil is the first one
-                // (i.e., the one for the lowest pressure value)
-                satPressuresArray.push_back(oilMu.yAt(rsIdx, 0));
-                invSatOilBArray.push_back(invOilB.valueAt(rsIdx, 0));
-                invSatOilBMuArray.push_back(invSatOilBArray.back()/satOilMu.valueAt(rsIdx));
-            }
+        for (unsigned regionIdx = 0; regionIdx < numRegions; ++ regionIdx)
+            initEndRegion_(regionIdx);
+    }
 
-            invSatOilB.setXYContainers(satPressuresArray, invSatOilBArray);
-            invSatOilBMu.setXYContainers(satPressuresArray, invSatOilBMuArray);
+    /*!
+     * \brief Copy the tables of all regions into a single contiguous arena.
+     *
+     * This must be called after initEnd(). If the object was initialized lazily, the
+     * tables of all regions are built first. Afterwards, all properties are evaluated
+     * using the copies of the undersaturated and saturated tables. Changing the tables
+     * discards the copies.
+     */
+    void packTables()
+    {
+        ensureAllRegions_();
 
-            updateSaturationPressure_(regionIdx);
+        size_t numRegions = oilMuTable_.size();
+        TablePool<Scalar> pool(numRegions, numPooledProperties_);
+        for (unsigned regionIdx = 0; regionIdx < numRegions; ++ regionIdx) {
+            pool.add(regionIdx, invOilBPoolIdx_, inverseOilBTable_[regionIdx]);
+            pool.add(regionIdx, invOilBMuPoolIdx_, inverseOilBMuTable_[regionIdx]);
+            pool.add(regionIdx, invSatOilBPoolIdx_, inverseSaturatedOilBTable_[regionIdx]);
+            pool.add(regionIdx, invSatOilBMuPoolIdx_, inverseSaturatedOilBMuTable_[regionIdx]);
+            pool.add(regionIdx, satRsPoolIdx_, saturatedGasDissolutionFactorTable_[regionIdx]);
+            pool.add(regionIdx, satPressurePoolIdx_, saturationPressure_[regionIdx]);
         }
+        pool.finalize();
+        tablePool_ = pool;
+    }
+
+    /*!
+     * \brief Returns true if the tables have been copied using packTables().
+     */
+    bool tablesPacked() const
+    { return tablePool_.isFinalized(); }
+
+    /*!
+     * \brief Returns the image which contains the packed tables.
+     *
+     * This is only valid after packTables() has been called. Like the images of the
+     * other PVT classes, it can be placed in memory which is shared by the processes
+     * of a node and be used there by attachTableImage().
+     */
+    const void* tableImage() const
+    { return tablePool_.data(); }
+
+    /*!
+     * \brief Returns the size of the image returned by tableImage() in bytes.
+     */
+    size_t tableImageSize() const
+    { return tablePool_.size(); }
+
+    /*!
+     * \brief Evaluate the properties using the packed tables of an image which is
+     *        stored elsewhere.
+     *
+     * The image must have been produced by tableImage() of an object with the same
+     * number of regions. It is not copied and must thus stay valid as long as this
+     * object is used. A lazily initialized object does not build the tables of its
+     * regions for this. Changing the tables detaches the object from the image.
+     */
+    void attachTableImage(const void* image, size_t size)
+    {
+        TablePool<Scalar> pool(numRegions(), numPooledProperties_);
+        pool.useExternalImage(image, size);
+        tablePool_ = pool;
     }
 
     /*!
@@ -457,6 +523,17 @@ public:
                          const Evaluation& Rs) const
     {
         // ATTENTION: Rs is the first axis!
+        if (tablePool_.isFinalized()) {
+            const Evaluation& invBo =
+                tablePool_.twoD(regionIdx, invOilBPoolIdx_).eval(Rs, pressure, /*extrapolate=*/true);
+            const Evaluation& invMuoBo =
+                tablePool_.twoD(regionIdx, invOilBMuPoolIdx_).eval(Rs, pressure, /*extrapolate=*/true);
+
+            return invBo/invMuoBo;
+        }
+
+        ensureRegion_(regionIdx);
+
         const Evaluation& invBo = inverseOilBTable_[regionIdx].eval(Rs, pressure, /*extrapolate=*/true);
         const Evaluation& invMuoBo = inverseOilBMuTable_[regionIdx].eval(Rs, pressure, /*extrapolate=*/true);
 
@@ -471,6 +548,17 @@ public:
                                   const Evaluation& /*temperature*/,
                                   const Evaluation& pressure) const
     {
+        if (tablePool_.isFinalized()) {
+            const Evaluation& invBo =
+                tablePool_.oneD(regionIdx, invSatOilBPoolIdx_).eval(pressure, /*extrapolate=*/true);
+            const Evaluation& invMuoBo =
+                tablePool_.oneD(regionIdx, invSatOilBMuPoolIdx_).eval(pressure, /*extrapolate=*/true);
+
+            return invBo/invMuoBo;
+        }
+
+        ensureRegion_(regionIdx);
+
         // ATTENTION: Rs is the first axis!
         const Evaluation& invBo = inverseSaturatedOilBTable_[regionIdx].eval(pressure, /*extrapolate=*/true);
         const Evaluation& invMuoBo = inverseSaturatedOilBMuTable_[regionIdx].eval(pressure, /*extrapolate=*/true);
@@ -488,6 +576,10 @@ public:
                                             const Evaluation& Rs) const
     {
         // ATTENTION: Rs is represented by the _first_ axis!
+        if (tablePool_.isFinalized())
+            return tablePool_.twoD(regionIdx, invOilBPoolIdx_).eval(Rs, pressure, /*extrapolate=*/true);
+
+        ensureRegion_(regionIdx);
         return inverseOilBTable_[regionIdx].eval(Rs, pressure, /*extrapolate=*/true);
     }
 
@@ -499,6 +591,11 @@ public:
                                                      const Evaluation& /*temperature*/,
                                                      const Evaluation& pressure) const
     {
+        if (tablePool_.isFinalized())
+            return tablePool_.oneD(regionIdx, invSatOilBPoolIdx_).eval(pressure, /*extrapolate=*/true);
+
+        ensureRegion_(regionIdx);
+
         // ATTENTION: Rs is represented by the _first_ axis!
         return inverseSaturatedOilBTable_[regionIdx].eval(pressure, /*extrapolate=*/true);
     }
@@ -510,7 +607,13 @@ public:
     Evaluation saturatedGasDissolutionFactor(unsigned regionIdx,
                                              const Evaluation& /*temperature*/,
                                              const Evaluation& pressure) const
-    { return saturatedGasDissolutionFactorTable_[regionIdx].eval(pressure, /*extrapolate=*/true); }
+    {
+        if (tablePool_.isFinalized())
+            return tablePool_.oneD(regionIdx, satRsPoolIdx_).eval(pressure, /*extrapolate=*/true);
+
+        ensureRegion_(regionIdx);
+        return saturatedGasDissolutionFactorTable_[regionIdx].eval(pressure, /*extrapolate=*/true);
+    }
 
     /*!
      * \brief Returns the gas dissolution factor \f$R_s\f$ [m^3/m^3] of the oil phase.
@@ -521,13 +624,12 @@ public:
      */
     template <class Evaluation>
     Evaluation saturatedGasDissolutionFactor(unsigned regionIdx,
-                                             const Evaluation& /*temperature*/,
+                                             const Evaluation& temperature,
                                              const Evaluation& pressure,
                                              const Evaluation& oilSaturation,
                                              Evaluation maxOilSaturation) const
     {
-        Evaluation tmp =
-            saturatedGasDissolutionFactorTable_[regionIdx].eval(pressure, /*extrapolate=*/true);
+        Evaluation tmp = saturatedGasDissolutionFactor(regionIdx, temperature, pressure);
 
         // apply the vaporization parameters for the gas phase (cf. the Eclipse VAPPARS
         // keyword)
@@ -549,16 +651,198 @@ public:
      */
     template <class Evaluation>
     Evaluation saturationPressure(unsigned regionIdx,
-                                  const Evaluation& temperature OPM_UNUSED,
+                                  const Evaluation& /*temperature*/,
                                   const Evaluation& Rs) const
+    {
+        if (tablePool_.isFinalized())
+            return findSaturationPressure_(tablePool_.oneD(regionIdx, satRsPoolIdx_),
+                                           tablePool_.oneD(regionIdx, satPressurePoolIdx_),
+                                           Rs);
+
+        ensureRegion_(regionIdx);
+        return findSaturationPressure_(saturatedGasDissolutionFactorTable_[regionIdx],
+                                       saturationPressure_[regionIdx],
+                                       Rs);
+    }
+
+    template <class Evaluation>
+    Evaluation diffusionCoefficient(const Evaluation& /*temperature*/,
+                                    const Evaluation& /*pressure*/,
+                                    unsigned /*compIdx*/) const
+    {
+        throw std::runtime_error("Not implemented: The PVT model does not provide a diffusionCoefficient()");
+    }
+    const Scalar gasReferenceDensity(unsigned regionIdx) const
+    { return gasReferenceDensity_[regionIdx]; }
+
+    const Scalar oilReferenceDensity(unsigned regionIdx) const
+    { return oilReferenceDensity_[regionIdx]; }
+
+    const std::vector<TabulatedTwoDFunction>& inverseOilBTable() const
+    { ensureAllRegions_(); return inverseOilBTable_; }
+
+    const std::vector<TabulatedTwoDFunction>& oilMuTable() const
+    { ensureAllRegions_(); return oilMuTable_; }
+
+    const std::vector<TabulatedTwoDFunction>& inverseOilBMuTable() const
+    { ensureAllRegions_(); return inverseOilBMuTable_; }
+
+    const std::vector<TabulatedOneDFunction>& saturatedOilMuTable() const
+    { ensureAllRegions_(); return saturatedOilMuTable_; }
+
+    const std::vector<TabulatedOneDFunction>& inverseSaturatedOilBTable() const
+    { ensureAllRegions_(); return inverseSaturatedOilBTable_; }
+
+    const std::vector<TabulatedOneDFunction>& inverseSaturatedOilBMuTable() const
+    { ensureAllRegions_(); return inverseSaturatedOilBMuTable_; }
+
+    const std::vector<TabulatedOneDFunction>& saturatedGasDissolutionFactorTable() const
+    { ensureAllRegions_(); return saturatedGasDissolutionFactorTable_; }
+
+    const std::vector<TabulatedOneDFunction>& saturationPressure() const
+    { ensureAllRegions_(); return saturationPressure_; }
+
+    Scalar vapPar2() const
+    { return vapPar2_; }
+
+    /*!
+     * \brief Returns true iff the interpolation tables of a PVT region have been built.
+     *
+     * This is always the case unless the object was initialized lazily and the region
+     * has not been used yet.
+     */
+    bool regionIsInitialized(unsigned regionIdx) const
+    { return lazyRegions_.isInitialized(regionIdx); }
+
+    bool operator==(const LiveOilPvt<Scalar>& data) const
+    {
+        return this->gasReferenceDensity_ == data.gasReferenceDensity_ &&
+               this->oilReferenceDensity_ == data.oilReferenceDensity_ &&
+               this->inverseOilBTable() == data.inverseOilBTable() &&
+               this->oilMuTable() == data.oilMuTable() &&
+               this->inverseOilBMuTable() == data.inverseOilBMuTable() &&
+               this->saturatedOilMuTable() == data.saturatedOilMuTable() &&
+               this->inverseSaturatedOilBTable() == data.inverseSaturatedOilBTable() &&
+               this->inverseSaturatedOilBMuTable() == data.inverseSaturatedOilBMuTable() &&
+               this->saturatedGasDissolutionFactorTable() == data.saturatedGasDissolutionFactorTable() &&
+               this->vapPar2() == data.vapPar2();
+    }
+
+    template <class Serializer>
+    void serializeOp(Serializer& serializer)
+    {
+        // lazily initialized regions are completed before they are stored, and
+        // loaded objects are always complete
+        if (serializer.isLoading())
+            lazyRegions_.resize(0);
+        else
+            ensureAllRegions_();
+
+        serializer(gasReferenceDensity_);
+        serializer(oilReferenceDensity_);
+        serializer(inverseOilBTable_);
+        serializer(oilMuTable_);
+        serializer(inverseOilBMuTable_);
+        serializer(saturatedOilMuTable_);
+        serializer(inverseSaturatedOilBTable_);
+        serializer(inverseSaturatedOilBMuTable_);
+        serializer(saturatedGasDissolutionFactorTable_);
+        serializer(saturationPressure_);
+        serializer(vapPar2_);
+
+        // the packed copies of the tables are not stored but recreated
+        bool packed = tablesPacked();
+        serializer(packed);
+        if (serializer.isLoading()) {
+            tablePool_ = TablePool<Scalar>();
+            if (packed)
+                packTables();
+        }
+    }
+
+private:
+    void initEndRegion_(unsigned regionIdx)
+    {
+        // calculate the table which stores the inverse of the product of the oil
+        // formation volume factor and the oil viscosity
+        const auto& oilMu = oilMuTable_[regionIdx];
+        const auto& satOilMu = saturatedOilMuTable_[regionIdx];
+        const auto& invOilB = inverseOilBTable_[regionIdx];
+        assert(oilMu.numX() == invOilB.numX());
+
+        auto& invOilBMu = inverseOilBMuTable_[regionIdx];
+        auto& invSatOilB = inverseSaturatedOilBTable_[regionIdx];
+        auto& invSatOilBMu = inverseSaturatedOilBMuTable_[regionIdx];
+
+        std::vector<Scalar> satPressuresArray;
+        std::vector<Scalar> invSatOilBArray;
+        std::vector<Scalar> invSatOilBMuArray;
+        for (unsigned rsIdx = 0; rsIdx < oilMu.numX(); ++rsIdx) {
+            invOilBMu.appendXPos(oilMu.xAt(rsIdx));
+
+            assert(oilMu.numY(rsIdx) == invOilB.numY(rsIdx));
+
+            size_t numPressures = oilMu.numY(rsIdx);
+            for (unsigned pIdx = 0; pIdx < numPressures; ++pIdx)
+                invOilBMu.appendSamplePoint(rsIdx,
+                                            oilMu.yAt(rsIdx, pIdx),
+                                            invOilB.valueAt(rsIdx, pIdx)
+                                            / oilMu.valueAt(rsIdx, pIdx));
+
+            // the sampling points in UniformXTabulated2DFunction are always sorted
+            // in ascending order. Thus, the value for saturated oil is the first one
+            // (i.e., the one for the lowest pressure value)
+            satPressuresArray.push_back(oilMu.yAt(rsIdx, 0));
+            invSatOilBArray.push_back(invOilB.valueAt(rsIdx, 0));
+            invSatOilBMuArray.push_back(invSatOilBArray.back()/satOilMu.valueAt(rsIdx));
+        }
+
+        invSatOilB.setXYContainers(satPressuresArray, invSatOilBArray);
+        invSatOilBMu.setXYContainers(satPressuresArray, invSatOilBMuArray);
+
+        updateSaturationPressure_(regionIdx);
+    }
+
+    // build the tables of a region if this has not happened yet. this is a no-op
+    // unless the object was initialized lazily.
+#if HAVE_ECL_INPUT
+    void ensureRegion_(unsigned regionIdx) const
+    {
+        if (lazyRegions_.isInitialized(regionIdx))
+            return;
+
+        // the tables are logically part of the object even if they have not been
+        // built yet
+        LiveOilPvt* self = const_cast<LiveOilPvt*>(this);
+        lazyRegions_.ensure(regionIdx,
+                            [self](size_t rIdx)
+                            {
+                                self->initRegionFromPvto_(rIdx, self->pvtoTables_[rIdx]);
+                                self->initEndRegion_(rIdx);
+                            });
+    }
+#else
+    void ensureRegion_(unsigned /*regionIdx*/) const
+    { }
+#endif
+
+    void ensureAllRegions_() const
+    {
+        for (unsigned regionIdx = 0; regionIdx < lazyRegions_.size(); ++regionIdx)
+            ensureRegion_(regionIdx);
+    }
+
+    template <class Table, class Evaluation>
+    static Evaluation findSaturationPressure_(const Table& RsTable,
+                                              const Table& pSatTable,
+                                              const Evaluation& Rs)
     {
         typedef Opm::MathToolbox<Evaluation> Toolbox;
 
-        const auto& RsTable = saturatedGasDissolutionFactorTable_[regionIdx];
         const Scalar eps = std::numeric_limits<typename Toolbox::Scalar>::epsilon()*1e6;
 
         // use the saturation pressure function to get a pretty good initial value
-        Evaluation pSat = saturationPressure_[regionIdx].eval(Rs, /*extrapolate=*/true);
+        Evaluation pSat = pSatTable.eval(Rs, /*extrapolate=*/true);
 
         // Newton method to do the remaining work. If the initial
         // value is good, this should only take two to three
@@ -602,61 +886,6 @@ public:
         throw NumericalIssue(errlog.str());
     }
 
-    template <class Evaluation>
-    Evaluation diffusionCoefficient(const Evaluation& /*temperature*/,
-                                    const Evaluation& /*pressure*/,
-                                    unsigned /*compIdx*/) const
-    {
-        throw std::runtime_error("Not implemented: The PVT model does not provide a diffusionCoefficient()");
-    }
-    const Scalar gasReferenceDensity(unsigned regionIdx) const
-    { return gasReferenceDensity_[regionIdx]; }
-
-    const Scalar oilReferenceDensity(unsigned regionIdx) const
-    { return oilReferenceDensity_[regionIdx]; }
-
-    const std::vector<TabulatedTwoDFunction>& inverseOilBTable() const
-    { return inverseOilBTable_; }
-
-    const std::vector<TabulatedTwoDFunction>& oilMuTable() const
-    { return oilMuTable_; }
-
-    const std::vector<TabulatedTwoDFunction>& inverseOilBMuTable() const
-    { return inverseOilBMuTable_; }
-
-    const std::vector<TabulatedOneDFunction>& saturatedOilMuTable() const
-    { return saturatedOilMuTable_; }
-
-    const std::vector<TabulatedOneDFunction>& inverseSaturatedOilBTable() const
-    { return inverseSaturatedOilBTable_; }
-
-    const std::vector<TabulatedOneDFunction>& inverseSaturatedOilBMuTable() const
-    { return inverseSaturatedOilBMuTable_; }
-
-    const std::vector<TabulatedOneDFunction>& saturatedGasDissolutionFactorTable() const
-    { return saturatedGasDissolutionFactorTable_; }
-
-    const std::vector<TabulatedOneDFunction>& saturationPressure() const
-    { return saturationPressure_; }
-
-    Scalar vapPar2() const
-    { return vapPar2_; }
-
-    bool operator==(const LiveOilPvt<Scalar>& data) const
-    {
-        return this->gasReferenceDensity() == data.gasReferenceDensity() &&
-               this->oilReferenceDensity() == data.oilReferenceDensity() &&
-               this->inverseOilBTable() == data.inverseOilBTable() &&
-               this->oilMuTable() == data.oilMuTable() &&
-               this->inverseOilBMuTable() == data.inverseOilBMuTable() &&
-               this->saturatedOilMuTable() == data.saturatedOilMuTable() &&
-               this->inverseSaturatedOilBTable() == data.inverseSaturatedOilBTable() &&
-               this->inverseSaturatedOilBMuTable() == data.inverseSaturatedOilBMuTable() &&
-               this->saturatedGasDissolutionFactorTable() == data.saturatedGasDissolutionFactorTable() &&
-               this->vapPar2() == data.vapPar2();
-    }
-
-private:
     void updateSaturationPressure_(unsigned regionIdx)
     {
         typedef std::pair<Scalar, Scalar> Pair;
@@ -671,9 +900,7 @@ private:
         Scalar Rs = 0;
         for (size_t i=0; i <= n; ++ i) {
             Scalar pSat = gasDissolutionFac.xMin() + Scalar(i)*delta;
-            Rs = saturatedGasDissolutionFactor(regionIdx,
-                                               /*temperature=*/Scalar(1e30),
-                                               pSat);
+            Rs = gasDissolutionFac.eval(pSat, /*extrapolate=*/true);
 
             Pair val(Rs, pSat);
             pSatSamplePoints.push_back(val);
@@ -687,6 +914,16 @@ private:
         saturationPressure_[regionIdx].setContainerOfTuples(pSatSamplePoints);
     }
 
+    enum {
+        invOilBPoolIdx_ = 0,
+        invOilBMuPoolIdx_ = 1,
+        invSatOilBPoolIdx_ = 2,
+        invSatOilBMuPoolIdx_ = 3,
+        satRsPoolIdx_ = 4,
+        satPressurePoolIdx_ = 5,
+        numPooledProperties_ = 6
+    };
+
     std::vector<Scalar> gasReferenceDensity_;
     std::vector<Scalar> oilReferenceDensity_;
     std::vector<TabulatedTwoDFunction> inverseOilBTable_;
@@ -697,8 +934,14 @@ private:
     std::vector<TabulatedOneDFunction> inverseSaturatedOilBMuTable_;
     std::vector<TabulatedOneDFunction> saturatedGasDissolutionFactorTable_;
     std::vector<TabulatedOneDFunction> saturationPressure_;
+    TablePool<Scalar> tablePool_;
 
     Scalar vapPar2_;
+
+    LazyRegionInitializer lazyRegions_;
+#if HAVE_ECL_INPUT
+    std::vector<PvtoTable> pvtoTables_;
+#endif
 };
 
 } // namespace Opm
@@ -147,8 +147,10 @@ public:
      * \brief Initialize the parameters for water using an ECL state.
      *
      * This method assumes that the deck features valid DENSITY and PVTO/PVDO/PVCDO keywords.
+     * If lazyInit is true, the tables of PVTO based PVT regions are only built when
+     * the respective region is used for the first time.
      */
-    void initFromState(const EclipseState& eclState, const Schedule& schedule)
+    void initFromState(const EclipseState& eclState, const Schedule& schedule, bool lazyInit = false)
     {
         if (!eclState.runspec().phases().active(Phase::OIL))
             return;
@@ -165,7 +167,12 @@ public:
         else if (!eclState.getTableManager().getPvtoTables().empty())
             setApproach(LiveOilPvt);
 
-        OPM_OIL_PVT_MULTIPLEXER_CALL(pvtImpl.initFromState(eclState, schedule));
+        if (approach_ == LiveOilPvt)
+            getRealPvt<LiveOilPvt>().initFromState(eclState, schedule, lazyInit);
+        else if (approach_ == ThermalOilPvt)
+            getRealPvt<ThermalOilPvt>().initFromState(eclState, schedule, lazyInit);
+        else
+            OPM_OIL_PVT_MULTIPLEXER_CALL(pvtImpl.initFromState(eclState, schedule));
     }
 #endif // HAVE_ECL_INPUT
 
@@ -233,6 +240,43 @@ public:
                                                      const Evaluation& pressure) const
     { OPM_OIL_PVT_MULTIPLEXER_CALL(return pvtImpl.saturatedInverseFormationVolumeFactor(regionIdx, temperature, pressure)); return 0; }
 
+    /*!
+     * \brief Returns the inverse formation volume factor [-] and the dynamic viscosity
+     *        [Pa s] of the fluid phase.
+     *
+     * Compared to calling inverseFormationVolumeFactor() and viscosity(), this only
+     * dispatches on the PVT approach once. For thermal PVT, the temperature corrections
+     * are applied on top of a single evaluation of the isothermal quantities.
+     */
+    template <class Evaluation>
+    void inverseFormationVolumeFactorAndViscosity(unsigned regionIdx,
+                                                  const Evaluation& temperature,
+                                                  const Evaluation& pressure,
+                                                  const Evaluation& Rs,
+                                                  Evaluation& invB,
+                                                  Evaluation& mu) const
+    {
+        OPM_OIL_PVT_MULTIPLEXER_CALL(invBAndMu_(pvtImpl, 1, &regionIdx, &temperature, &pressure, &Rs, &invB, &mu, /*preferFused=*/0));
+    }
+
+    /*!
+     * \brief Computes the inverse formation volume factors and the viscosities of a
+     *        batch of values.
+     *
+     * All arrays must have numValues entries.
+     */
+    template <class Evaluation>
+    void inverseFormationVolumeFactorAndViscosity(size_t numValues,
+                                                  const unsigned* regionIdx,
+                                                  const Evaluation* temperature,
+                                                  const Evaluation* pressure,
+                                                  const Evaluation* Rs,
+                                                  Evaluation* invB,
+                                                  Evaluation* mu) const
+    {
+        OPM_OIL_PVT_MULTIPLEXER_CALL(invBAndMu_(pvtImpl, numValues, regionIdx, temperature, pressure, Rs, invB, mu, /*preferFused=*/0));
+    }
+
     /*!
      * \brief Returns the gas dissolution factor \f$R_s\f$ [m^3/m^3] of saturated oil.
      */
@@ -315,6 +359,66 @@ public:
     OilPvtApproach approach() const
     { return approach_; }
 
+    /*!
+     * \brief Returns true if the tables of the PVT approach can be packed into an image
+     *        which can be shared by the processes of a node.
+     *
+     * This is the case for live and dead oil.
+     */
+    bool supportsTableImage() const
+    { return approach_ == LiveOilPvt || approach_ == DeadOilPvt; }
+
+    /*!
+     * \brief Copy the tables into a position independent image.
+     *
+     * See GasPvtMultiplexer::packTables().
+     */
+    void packTables()
+    {
+        checkTableImageSupport_();
+        if (approach_ == LiveOilPvt)
+            getRealPvt<LiveOilPvt>().packTables();
+        else
+            getRealPvt<DeadOilPvt>().packTables();
+    }
+
+    /*!
+     * \brief Returns the image created by packTables().
+     */
+    const void* tableImage() const
+    {
+        checkTableImageSupport_();
+        if (approach_ == LiveOilPvt)
+            return getRealPvt<LiveOilPvt>().tableImage();
+        return getRealPvt<DeadOilPvt>().tableImage();
+    }
+
+    /*!
+     * \brief Returns the size of the image created by packTables() in bytes.
+     */
+    size_t tableImageSize() const
+    {
+        checkTableImageSupport_();
+        if (approach_ == LiveOilPvt)
+            return getRealPvt<LiveOilPvt>().tableImageSize();
+        return getRealPvt<DeadOilPvt>().tableImageSize();
+    }
+
+    /*!
+     * \brief Evaluate the properties using an image which was created by packTables()
+     *        of a multiplexer for the same deck.
+     *
+     * The image is not copied and must stay valid as long as this object is used.
+     */
+    void attachTableImage(const void* image, size_t size)
+    {
+        checkTableImageSupport_();
+        if (approach_ == LiveOilPvt)
+            getRealPvt<LiveOilPvt>().attachTableImage(image, size);
+        else
+            getRealPvt<DeadOilPvt>().attachTableImage(image, size);
+    }
+
     // get the concrete parameter object for the oil phase
     template <OilPvtApproach approachV>
     typename std::enable_if<approachV == LiveOilPvt, Opm::LiveOilPvt<Scalar> >::type& getRealPvt()
@@ -414,6 +518,25 @@ public:
         }
     }
 
+    template <class Serializer>
+    void serializeOp(Serializer& serializer)
+    {
+        OilPvtApproach approach = approach_;
+        serializer(approach);
+        if (serializer.isLoading()) {
+            // the temporary takes over the current implementation object and disposes it
+            OilPvtMultiplexer<Scalar,enableThermal> oldPvt(approach_, realOilPvt_);
+            approach_ = NoOilPvt;
+            realOilPvt_ = nullptr;
+            if (approach != NoOilPvt)
+                setApproach(approach);
+        }
+
+        if (approach_ != NoOilPvt) {
+            OPM_OIL_PVT_MULTIPLEXER_CALL(serializer(pvtImpl));
+        }
+    }
+
     OilPvtMultiplexer<Scalar,enableThermal>& operator=(const OilPvtMultiplexer<Scalar,enableThermal>& data)
     {
         approach_ = data.approach_;
@@ -441,6 +564,44 @@ public:
     }
 
 private:
+    void checkTableImageSupport_() const
+    {
+        if (!supportsTableImage())
+            throw std::logic_error("The oil PVT approach does not support table images");
+    }
+
+    // use the fused method of the PVT implementation if it provides one ...
+    template <class PvtImpl, class Evaluation>
+    static auto invBAndMu_(const PvtImpl& pvtImpl,
+                           size_t numValues,
+                           const unsigned* regionIdx,
+                           const Evaluation* temperature,
+                           const Evaluation* pressure,
+                           const Evaluation* Rs,
+                           Evaluation* invB,
+                           Evaluation* mu,
+                           int /*preferFused*/)
+        -> decltype(pvtImpl.inverseFormationVolumeFactorAndViscosity(numValues, regionIdx, temperature, pressure, Rs, invB, mu))
+    { pvtImpl.inverseFormationVolumeFactorAndViscosity(numValues, regionIdx, temperature, pressure, Rs, invB, mu); }
+
+    // ... else compute both quantities separately
+    template <class PvtImpl, class Evaluation>
+    static void invBAndMu_(const PvtImpl& pvtImpl,
+                           size_t numValues,
+                           const unsigned* regionIdx,
+                           const Evaluation* temperature,
+                           const Evaluation* pressure,
+                           const Evaluation* Rs,
+                           Evaluation* invB,
+                           Evaluation* mu,
+                           long /*preferFused*/)
+    {
+        for (size_t i = 0; i < numValues; ++i) {
+            invB[i] = pvtImpl.inverseFormationVolumeFactor(regionIdx[i], temperature[i], pressure[i], Rs[i]);
+            mu[i] = pvtImpl.viscosity(regionIdx[i], temperature[i], pressure[i], Rs[i]);
+        }
+    }
+
     OilPvtApproach approach_;
     void* realOilPvt_;
 };
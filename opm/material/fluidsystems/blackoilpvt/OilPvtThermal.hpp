@@ -101,13 +101,13 @@ public:
     /*!
      * \brief Implement the temperature part of the oil PVT properties.
      */
-    void initFromState(const EclipseState& eclState, const Schedule& schedule)
+    void initFromState(const EclipseState& eclState, const Schedule& schedule, bool lazyInit = false)
     {
         //////
         // initialize the isothermal part
         //////
         isothermalPvt_ = new IsothermalPvt;
-        isothermalPvt_->initFromState(eclState, schedule);
+        isothermalPvt_->initFromState(eclState, schedule, lazyInit);
 
         //////
         // initialize the thermal part
@@ -385,6 +385,61 @@ public:
         return isothermalPvt_->diffusionCoefficient(temperature, pressure, compIdx);
     }
 
+    /*!
+     * \brief Returns the inverse formation volume factor [-] and the dynamic viscosity
+     *        [Pa s] of the fluid phase.
+     */
+    template <class Evaluation>
+    void inverseFormationVolumeFactorAndViscosity(unsigned regionIdx,
+                                                  const Evaluation& temperature,
+                                                  const Evaluation& pressure,
+                                                  const Evaluation& Rs,
+                                                  Evaluation& invB,
+                                                  Evaluation& mu) const
+    { inverseFormationVolumeFactorAndViscosity(1, &regionIdx, &temperature, &pressure, &Rs, &invB, &mu); }
+
+    /*!
+     * \brief Computes the inverse formation volume factors and the viscosities of a
+     *        batch of values.
+     *
+     * The isothermal quantities are evaluated for all values at once and the
+     * temperature corrections are applied afterwards. All arrays must have numValues
+     * entries.
+     */
+    template <class Evaluation>
+    void inverseFormationVolumeFactorAndViscosity(size_t numValues,
+                                                  const unsigned* regionIdx,
+                                                  const Evaluation* temperature,
+                                                  const Evaluation* pressure,
+                                                  const Evaluation* Rs,
+                                                  Evaluation* invB,
+                                                  Evaluation* mu) const
+    {
+        // the isothermal quantities of the whole batch are computed using a single
+        // dispatch of the isothermal PVT multiplexer
+        isothermalPvt_->inverseFormationVolumeFactorAndViscosity(numValues, regionIdx, temperature,
+                                                                 pressure, Rs, invB, mu);
+
+        if (!enableThermalDensity() && !enableThermalViscosity())
+            return;
+
+        for (size_t i = 0; i < numValues; ++i) {
+            unsigned pvtRegionIdx = regionIdx[i];
+
+            if (enableThermalDensity()) {
+                Scalar cT1 = oildentCT1_[pvtRegionIdx];
+                Scalar cT2 = oildentCT2_[pvtRegionIdx];
+                const Evaluation& Y = temperature[i] - oildentRefTemp_[pvtRegionIdx];
+                invB[i] = invB[i]/(1 + (cT1 + cT2*Y)*Y);
+            }
+
+            if (enableThermalViscosity()) {
+                const auto& muOilvisct = oilvisctCurves_[pvtRegionIdx].eval(temperature[i]);
+                mu[i] = muOilvisct/viscRef_[pvtRegionIdx]*mu[i];
+            }
+        }
+    }
+
     const IsothermalPvt* isoThermalPvt() const
     { return isothermalPvt_; }
 
@@ -440,6 +495,31 @@ public:
                 this->enableInternalEnergy() == data.enableInternalEnergy();
     }
 
+    template <class Serializer>
+    void serializeOp(Serializer& serializer)
+    {
+        bool hasIsothermalPvt = isothermalPvt_ != nullptr;
+        serializer(hasIsothermalPvt);
+        if (serializer.isLoading()) {
+            delete isothermalPvt_;
+            isothermalPvt_ = hasIsothermalPvt ? new IsothermalPvt : nullptr;
+        }
+        if (isothermalPvt_)
+            serializer(*isothermalPvt_);
+
+        serializer(oilvisctCurves_);
+        serializer(viscrefPress_);
+        serializer(viscrefRs_);
+        serializer(viscRef_);
+        serializer(oildentRefTemp_);
+        serializer(oildentCT1_);
+        serializer(oildentCT2_);
+        serializer(internalEnergyCurves_);
+        serializer(enableThermalDensity_);
+        serializer(enableThermalViscosity_);
+        serializer(enableInternalEnergy_);
+    }
+
     OilPvtThermal<Scalar>& operator=(const OilPvtThermal<Scalar>& data)
     {
         if (data.isothermalPvt_)
@@ -180,7 +180,7 @@ public:
      */
     template <class Evaluation>
     Evaluation viscosity(unsigned regionIdx,
-                                  const Evaluation& temperature OPM_UNUSED,
+                                  const Evaluation& /*temperature*/,
                                   const Evaluation& pressure) const
     {
         const Evaluation& invBg = inverseSolventB_[regionIdx].eval(pressure, /*extrapolate=*/true);
@@ -208,10 +208,44 @@ public:
      */
     template <class Evaluation>
     Evaluation inverseFormationVolumeFactor(unsigned regionIdx,
-                                            const Evaluation& temperature OPM_UNUSED,
+                                            const Evaluation& /*temperature*/,
                                             const Evaluation& pressure) const
     { return inverseSolventB_[regionIdx].eval(pressure, /*extrapolate=*/true); }
 
+    /*!
+     * \brief Returns the inverse formation volume factor [-] and the dynamic viscosity
+     *        [Pa s] of the fluid phase.
+     *
+     * The tables for \f$1/B_s\f$ and \f$1/(B_s \mu_s)\f$ are sampled at the same
+     * pressures, so the pressure segment is only looked up once. The results are
+     * identical to the ones of inverseFormationVolumeFactor() and viscosity().
+     */
+    template <class Evaluation>
+    void inverseFormationVolumeFactorAndViscosity(unsigned regionIdx,
+                                                  const Evaluation& /*temperature*/,
+                                                  const Evaluation& pressure,
+                                                  Evaluation& invB,
+                                                  Evaluation& mu) const
+    { invBAndMu_(regionIdx, pressure, invB, mu); }
+
+    /*!
+     * \brief Computes the inverse formation volume factors and the viscosities of a
+     *        batch of values.
+     *
+     * All arrays must have numValues entries.
+     */
+    template <class Evaluation>
+    void inverseFormationVolumeFactorAndViscosity(size_t numValues,
+                                                  const unsigned* regionIdx,
+                                                  const Evaluation* /*temperature*/,
+                                                  const Evaluation* pressure,
+                                                  Evaluation* invB,
+                                                  Evaluation* mu) const
+    {
+        for (size_t i = 0; i < numValues; ++i)
+            invBAndMu_(regionIdx[i], pressure[i], invB[i], mu[i]);
+    }
+
     const std::vector<Scalar>& solventReferenceDensity() const
     { return solventReferenceDensity_; }
 
@@ -232,7 +266,28 @@ public:
                inverseSolventBMu_ == data.inverseSolventBMu_;
     }
 
+    template <class Serializer>
+    void serializeOp(Serializer& serializer)
+    {
+        serializer(solventReferenceDensity_);
+        serializer(inverseSolventB_);
+        serializer(solventMu_);
+        serializer(inverseSolventBMu_);
+    }
+
 private:
+    template <class Evaluation>
+    void invBAndMu_(unsigned regionIdx,
+                    const Evaluation& pressure,
+                    Evaluation& invB,
+                    Evaluation& mu) const
+    {
+        const auto& invBTable = inverseSolventB_[regionIdx];
+        size_t segIdx = invBTable.findSegmentIndex(pressure, /*extrapolate=*/true);
+        invB = invBTable.evalInSegment(pressure, segIdx);
+        mu = invB/inverseSolventBMu_[regionIdx].evalInSegment(pressure, segIdx);
+    }
+
     std::vector<Scalar> solventReferenceDensity_;
     std::vector<TabulatedOneDFunction> inverseSolventB_;
     std::vector<TabulatedOneDFunction> solventMu_;
@@ -182,6 +182,44 @@ public:
         return 0;
     }
 
+    /*!
+     * \brief Returns the inverse formation volume factor [-] and the dynamic viscosity
+     *        [Pa s] of the fluid phase.
+     *
+     * Compared to calling inverseFormationVolumeFactor() and viscosity(), this only
+     * dispatches on the PVT approach once. For thermal PVT, the temperature corrections
+     * are applied on top of a single evaluation of the isothermal quantities.
+     */
+    template <class Evaluation>
+    void inverseFormationVolumeFactorAndViscosity(unsigned regionIdx,
+                                                  const Evaluation& temperature,
+                                                  const Evaluation& pressure,
+                                                  const Evaluation& saltconcentration,
+                                                  Evaluation& invB,
+                                                  Evaluation& mu) const
+    {
+        OPM_WATER_PVT_MULTIPLEXER_CALL(invBAndMu_(pvtImpl, 1, &regionIdx, &temperature, &pressure, &saltconcentration, &invB, &mu, /*preferFused=*/0));
+    }
+
+    /*!
+     * \brief Computes the inverse formation volume factors and the viscosities of a
+     *        batch of values.
+     *
+     * All arrays must have numValues entries.
+     */
+    template <class Evaluation>
+    void inverseFormationVolumeFactorAndViscosity(size_t numValues,
+                                                  const unsigned* regionIdx,
+                                                  const Evaluation* temperature,
+                                                  const Evaluation* pressure,
+                                                  const Evaluation* saltconcentration,
+                                                  Evaluation* invB,
+                                                  Evaluation* mu) const
+    {
+        OPM_WATER_PVT_MULTIPLEXER_CALL(invBAndMu_(pvtImpl, numValues, regionIdx, temperature, pressure, saltconcentration, invB, mu, /*preferFused=*/0));
+    }
+
+
     void setApproach(WaterPvtApproach appr)
     {
         switch (appr) {
@@ -277,6 +315,25 @@ public:
         }
     }
 
+    template <class Serializer>
+    void serializeOp(Serializer& serializer)
+    {
+        WaterPvtApproach approach = approach_;
+        serializer(approach);
+        if (serializer.isLoading()) {
+            // the temporary takes over the current implementation object and disposes it
+            WaterPvtMultiplexer<Scalar,enableThermal,enableBrine> oldPvt(approach_, realWaterPvt_);
+            approach_ = NoWaterPvt;
+            realWaterPvt_ = nullptr;
+            if (approach != NoWaterPvt)
+                setApproach(approach);
+        }
+
+        if (approach_ != NoWaterPvt) {
+            OPM_WATER_PVT_MULTIPLEXER_CALL(serializer(pvtImpl));
+        }
+    }
+
     WaterPvtMultiplexer<Scalar,enableThermal,enableBrine>& operator=(const WaterPvtMultiplexer<Scalar,enableThermal,enableBrine>& data)
     {
         approach_ = data.approach_;
@@ -298,6 +355,38 @@ public:
     }
 
 private:
+    // use the fused method of the PVT implementation if it provides one ...
+    template <class PvtImpl, class Evaluation>
+    static auto invBAndMu_(const PvtImpl& pvtImpl,
+                           size_t numValues,
+                           const unsigned* regionIdx,
+                           const Evaluation* temperature,
+                           const Evaluation* pressure,
+                           const Evaluation* saltconcentration,
+                           Evaluation* invB,
+                           Evaluation* mu,
+                           int /*preferFused*/)
+        -> decltype(pvtImpl.inverseFormationVolumeFactorAndViscosity(numValues, regionIdx, temperature, pressure, saltconcentration, invB, mu))
+    { pvtImpl.inverseFormationVolumeFactorAndViscosity(numValues, regionIdx, temperature, pressure, saltconcentration, invB, mu); }
+
+    // ... else compute both quantities separately
+    template <class PvtImpl, class Evaluation>
+    static void invBAndMu_(const PvtImpl& pvtImpl,
+                           size_t numValues,
+                           const unsigned* regionIdx,
+                           const Evaluation* temperature,
+                           const Evaluation* pressure,
+                           const Evaluation* saltconcentration,
+                           Evaluation* invB,
+                           Evaluation* mu,
+                           long /*preferFused*/)
+    {
+        for (size_t i = 0; i < numValues; ++i) {
+            invB[i] = pvtImpl.inverseFormationVolumeFactor(regionIdx[i], temperature[i], pressure[i], saltconcentration[i]);
+            mu[i] = pvtImpl.viscosity(regionIdx[i], temperature[i], pressure[i], saltconcentration[i]);
+        }
+    }
+
     WaterPvtApproach approach_;
     void* realWaterPvt_;
 };
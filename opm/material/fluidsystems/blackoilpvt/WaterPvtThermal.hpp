@@ -302,6 +302,68 @@ public:
         return 1.0/(((1 - X)*(1 + cT1*Y + cT2*Y*Y))*BwRef);
     }
 
+    /*!
+     * \brief Returns the inverse formation volume factor [-] and the dynamic viscosity
+     *        [Pa s] of the fluid phase.
+     */
+    template <class Evaluation>
+    void inverseFormationVolumeFactorAndViscosity(unsigned regionIdx,
+                                                  const Evaluation& temperature,
+                                                  const Evaluation& pressure,
+                                                  const Evaluation& saltconcentration,
+                                                  Evaluation& invB,
+                                                  Evaluation& mu) const
+    { inverseFormationVolumeFactorAndViscosity(1, &regionIdx, &temperature, &pressure, &saltconcentration, &invB, &mu); }
+
+    /*!
+     * \brief Computes the inverse formation volume factors and the viscosities of a
+     *        batch of values.
+     *
+     * Unless the density is given by WATDENT, the isothermal quantities are evaluated
+     * for all values at once. All arrays must have numValues entries.
+     */
+    template <class Evaluation>
+    void inverseFormationVolumeFactorAndViscosity(size_t numValues,
+                                                  const unsigned* regionIdx,
+                                                  const Evaluation* temperature,
+                                                  const Evaluation* pressure,
+                                                  const Evaluation* saltconcentration,
+                                                  Evaluation* invB,
+                                                  Evaluation* mu) const
+    {
+        if (!enableThermalDensity()) {
+            // the isothermal quantities of the whole batch are computed using a single
+            // dispatch of the isothermal PVT multiplexer
+            isothermalPvt_->inverseFormationVolumeFactorAndViscosity(numValues, regionIdx, temperature,
+                                                                     pressure, saltconcentration, invB, mu);
+        }
+
+        for (size_t i = 0; i < numValues; ++i) {
+            unsigned pvtRegionIdx = regionIdx[i];
+
+            // with thermal density, the isothermal formation volume factor is not required
+            if (enableThermalDensity()) {
+                mu[i] = isothermalPvt_->viscosity(pvtRegionIdx, temperature[i], pressure[i], saltconcentration[i]);
+
+                Scalar BwRef = pvtwRefB_[pvtRegionIdx];
+                Scalar TRef = watdentRefTemp_[pvtRegionIdx];
+                const Evaluation& X = pvtwCompressibility_[pvtRegionIdx]*(pressure[i] - pvtwRefPress_[pvtRegionIdx]);
+                Scalar cT1 = watdentCT1_[pvtRegionIdx];
+                Scalar cT2 = watdentCT2_[pvtRegionIdx];
+                const Evaluation& Y = temperature[i] - TRef;
+                invB[i] = 1.0/(((1 - X)*(1 + cT1*Y + cT2*Y*Y))*BwRef);
+            }
+
+            if (enableThermalViscosity()) {
+                Scalar x = -pvtwViscosibility_[pvtRegionIdx]*(viscrefPress_[pvtRegionIdx] - pvtwRefPress_[pvtRegionIdx]);
+                Scalar muRef = pvtwViscosity_[pvtRegionIdx]/(1.0 + x + 0.5*x*x);
+
+                const auto& muWatvisct = watvisctCurves_[pvtRegionIdx].eval(temperature[i], true);
+                mu[i] = mu[i] * muWatvisct/muRef;
+            }
+        }
+    }
+
     const IsothermalPvt* isoThermalPvt() const
     { return isothermalPvt_; }
 
@@ -369,6 +431,34 @@ public:
                this->enableInternalEnergy() == data.enableInternalEnergy();
     }
 
+    template <class Serializer>
+    void serializeOp(Serializer& serializer)
+    {
+        bool hasIsothermalPvt = isothermalPvt_ != nullptr;
+        serializer(hasIsothermalPvt);
+        if (serializer.isLoading()) {
+            delete isothermalPvt_;
+            isothermalPvt_ = hasIsothermalPvt ? new IsothermalPvt : nullptr;
+        }
+        if (isothermalPvt_)
+            serializer(*isothermalPvt_);
+
+        serializer(viscrefPress_);
+        serializer(watdentRefTemp_);
+        serializer(watdentCT1_);
+        serializer(watdentCT2_);
+        serializer(pvtwRefPress_);
+        serializer(pvtwRefB_);
+        serializer(pvtwCompressibility_);
+        serializer(pvtwViscosity_);
+        serializer(pvtwViscosibility_);
+        serializer(watvisctCurves_);
+        serializer(internalEnergyCurves_);
+        serializer(enableThermalDensity_);
+        serializer(enableThermalViscosity_);
+        serializer(enableInternalEnergy_);
+    }
+
     WaterPvtThermal<Scalar>& operator=(const WaterPvtThermal<Scalar>& data)
     {
         if (data.isothermalPvt_)
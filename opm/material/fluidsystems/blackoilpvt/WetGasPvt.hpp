@@ -32,6 +32,7 @@
 #include <opm/material/common/OpmFinal.hpp>
 #include <opm/material/common/UniformXTabulated2DFunction.hpp>
 #include <opm/material/common/Tabulated1DFunction.hpp>
+#include <opm/material/common/TablePool.hpp>
 
 #if HAVE_ECL_INPUT
 #include <opm/parser/eclipse/EclipseState/EclipseState.hpp>
@@ -267,6 +268,7 @@ public:
         gasMu_.resize(numRegions, TabulatedTwoDFunction{TabulatedTwoDFunction::InterpolationPolicy::RightExtreme});
         saturatedOilVaporizationFactorTable_.resize(numRegions);
         saturationPressure_.resize(numRegions);
+        tablePool_ = TablePool<Scalar>();
     }
 
     /*!
@@ -287,7 +289,10 @@ public:
      * \param samplePoints A container of (x,y) values.
      */
     void setSaturatedGasOilVaporizationFactor(unsigned regionIdx, const SamplingPoints& samplePoints)
-    { saturatedOilVaporizationFactorTable_[regionIdx].setContainerOfTuples(samplePoints); }
+    {
+        saturatedOilVaporizationFactorTable_[regionIdx].setContainerOfTuples(samplePoints);
+        tablePool_ = TablePool<Scalar>();
+    }
 
     /*!
      * \brief Initialize the function for the gas formation volume factor
@@ -300,6 +305,8 @@ public:
      */
     void setSaturatedGasFormationVolumeFactor(unsigned regionIdx, const SamplingPoints& samplePoints)
     {
+        tablePool_ = TablePool<Scalar>();
+
         auto& invGasB = inverseGasB_[regionIdx];
 
         const auto& RvTable = saturatedOilVaporizationFactorTable_[regionIdx];
@@ -360,7 +367,10 @@ public:
      * and not the other way around.
      */
     void setInverseGasFormationVolumeFactor(unsigned regionIdx, const TabulatedTwoDFunction& invBg)
-    { inverseGasB_[regionIdx] = invBg; }
+    {
+        inverseGasB_[regionIdx] = invBg;
+        tablePool_ = TablePool<Scalar>();
+    }
 
     /*!
      * \brief Initialize the viscosity of the gas phase.
@@ -368,7 +378,10 @@ public:
      * This is a function of \f$(R_s, p_o)\f$...
      */
     void setGasViscosity(unsigned regionIdx, const TabulatedTwoDFunction& mug)
-    { gasMu_[regionIdx] = mug; }
+    {
+        gasMu_[regionIdx] = mug;
+        tablePool_ = TablePool<Scalar>();
+    }
 
     /*!
      * \brief Initialize the phase viscosity for oil saturated gas
@@ -379,6 +392,8 @@ public:
      */
     void setSaturatedGasViscosity(unsigned regionIdx, const SamplingPoints& samplePoints  )
     {
+        tablePool_ = TablePool<Scalar>();
+
         auto& oilVaporizationFac = saturatedOilVaporizationFactorTable_[regionIdx];
 
         Scalar RvMin = 0.0;
@@ -414,6 +429,8 @@ public:
      */
     void initEnd()
     {
+        tablePool_ = TablePool<Scalar>();
+
         // calculate the final 2D functions which are used for interpolation.
         size_t numRegions = gasMu_.size();
         for (unsigned regionIdx = 0; regionIdx < numRegions; ++ regionIdx) {
@@ -457,6 +474,67 @@ public:
         }
     }
 
+    /*!
+     * \brief Copy the tables of all regions into a single contiguous arena.
+     *
+     * This must be called after initEnd(). The two-dimensional tables of
+     * undersaturated gas are copied along with the curves of saturated gas, so all
+     * properties are evaluated using the copies afterwards. Changing the tables
+     * discards the copies.
+     */
+    void packTables()
+    {
+        size_t numRegions = gasMu_.size();
+        TablePool<Scalar> pool(numRegions, numPooledProperties_);
+        for (unsigned regionIdx = 0; regionIdx < numRegions; ++ regionIdx) {
+            pool.add(regionIdx, invGasBPoolIdx_, inverseGasB_[regionIdx]);
+            pool.add(regionIdx, invGasBMuPoolIdx_, inverseGasBMu_[regionIdx]);
+            pool.add(regionIdx, invSatGasBPoolIdx_, inverseSaturatedGasB_[regionIdx]);
+            pool.add(regionIdx, invSatGasBMuPoolIdx_, inverseSaturatedGasBMu_[regionIdx]);
+            pool.add(regionIdx, satRvPoolIdx_, saturatedOilVaporizationFactorTable_[regionIdx]);
+            pool.add(regionIdx, satPressurePoolIdx_, saturationPressure_[regionIdx]);
+        }
+        pool.finalize();
+        tablePool_ = pool;
+    }
+
+    /*!
+     * \brief Returns true if the tables have been copied using packTables().
+     */
+    bool tablesPacked() const
+    { return tablePool_.isFinalized(); }
+
+    /*!
+     * \brief Returns the image which contains the packed tables.
+     *
+     * This is only valid after packTables() has been called. The image does not contain
+     * any pointers, so it can be copied into memory which is shared by the processes of
+     * a node and be used there by attachTableImage().
+     */
+    const void* tableImage() const
+    { return tablePool_.data(); }
+
+    /*!
+     * \brief Returns the size of the image returned by tableImage() in bytes.
+     */
+    size_t tableImageSize() const
+    { return tablePool_.size(); }
+
+    /*!
+     * \brief Evaluate the properties using the packed tables of an image which is
+     *        stored elsewhere.
+     *
+     * The image must have been produced by tableImage() of an object with the same
+     * number of regions. It is not copied and must thus stay valid as long as this
+     * object is used. Changing the tables detaches the object from the image.
+     */
+    void attachTableImage(const void* image, size_t size)
+    {
+        TablePool<Scalar> pool(numRegions(), numPooledProperties_);
+        pool.useExternalImage(image, size);
+        tablePool_ = pool;
+    }
+
     /*!
      * \brief Return the number of PVT regions which are considered by this PVT-object.
      */
@@ -484,6 +562,15 @@ public:
                          const Evaluation& pressure,
                          const Evaluation& Rv) const
     {
+        if (tablePool_.isFinalized()) {
+            const Evaluation& invBg =
+                tablePool_.twoD(regionIdx, invGasBPoolIdx_).eval(pressure, Rv, /*extrapolate=*/true);
+            const Evaluation& invMugBg =
+                tablePool_.twoD(regionIdx, invGasBMuPoolIdx_).eval(pressure, Rv, /*extrapolate=*/true);
+
+            return invBg/invMugBg;
+        }
+
         const Evaluation& invBg = inverseGasB_[regionIdx].eval(pressure, Rv, /*extrapolate=*/true);
         const Evaluation& invMugBg = inverseGasBMu_[regionIdx].eval(pressure, Rv, /*extrapolate=*/true);
 
@@ -498,6 +585,15 @@ public:
                                   const Evaluation& /*temperature*/,
                                   const Evaluation& pressure) const
     {
+        if (tablePool_.isFinalized()) {
+            const Evaluation& invBg =
+                tablePool_.oneD(regionIdx, invSatGasBPoolIdx_).eval(pressure, /*extrapolate=*/true);
+            const Evaluation& invMugBg =
+                tablePool_.oneD(regionIdx, invSatGasBMuPoolIdx_).eval(pressure, /*extrapolate=*/true);
+
+            return invBg/invMugBg;
+        }
+
         const Evaluation& invBg = inverseSaturatedGasB_[regionIdx].eval(pressure, /*extrapolate=*/true);
         const Evaluation& invMugBg = inverseSaturatedGasBMu_[regionIdx].eval(pressure, /*extrapolate=*/true);
 
@@ -512,7 +608,12 @@ public:
                                             const Evaluation& /*temperature*/,
                                             const Evaluation& pressure,
                                             const Evaluation& Rv) const
-    { return inverseGasB_[regionIdx].eval(pressure, Rv, /*extrapolate=*/true); }
+    {
+        if (tablePool_.isFinalized())
+            return tablePool_.twoD(regionIdx, invGasBPoolIdx_).eval(pressure, Rv, /*extrapolate=*/true);
+
+        return inverseGasB_[regionIdx].eval(pressure, Rv, /*extrapolate=*/true);
+    }
 
     /*!
      * \brief Returns the formation volume factor [-] of oil saturated gas at a given pressure.
@@ -521,7 +622,12 @@ public:
     Evaluation saturatedInverseFormationVolumeFactor(unsigned regionIdx,
                                                      const Evaluation& /*temperature*/,
                                                      const Evaluation& pressure) const
-    { return inverseSaturatedGasB_[regionIdx].eval(pressure, /*extrapolate=*/true); }
+    {
+        if (tablePool_.isFinalized())
+            return tablePool_.oneD(regionIdx, invSatGasBPoolIdx_).eval(pressure, /*extrapolate=*/true);
+
+        return inverseSaturatedGasB_[regionIdx].eval(pressure, /*extrapolate=*/true);
+    }
 
     /*!
      * \brief Returns the oil vaporization factor \f$R_v\f$ [m^3/m^3] of the gas phase.
@@ -531,6 +637,9 @@ public:
                                               const Evaluation& /*temperature*/,
                                               const Evaluation& pressure) const
     {
+        if (tablePool_.isFinalized())
+            return tablePool_.oneD(regionIdx, satRvPoolIdx_).eval(pressure, /*extrapolate=*/true);
+
         return saturatedOilVaporizationFactorTable_[regionIdx].eval(pressure, /*extrapolate=*/true);
     }
 
@@ -543,13 +652,12 @@ public:
      */
     template <class Evaluation>
     Evaluation saturatedOilVaporizationFactor(unsigned regionIdx,
-                                              const Evaluation& /*temperature*/,
+                                              const Evaluation& temperature,
                                               const Evaluation& pressure,
                                               const Evaluation& oilSaturation,
                                               Evaluation maxOilSaturation) const
     {
-        Evaluation tmp =
-            saturatedOilVaporizationFactorTable_[regionIdx].eval(pressure, /*extrapolate=*/true);
+        Evaluation tmp = saturatedOilVaporizationFactor(regionIdx, temperature, pressure);
 
         // apply the vaporization parameters for the gas phase (cf. the Eclipse VAPPARS
         // keyword)
@@ -575,57 +683,17 @@ public:
      */
     template <class Evaluation>
     Evaluation saturationPressure(unsigned regionIdx,
-                                  const Evaluation& temperature OPM_UNUSED,
+                                  const Evaluation& /*temperature*/,
                                   const Evaluation& Rv) const
     {
-        typedef Opm::MathToolbox<Evaluation> Toolbox;
-
-        const auto& RvTable = saturatedOilVaporizationFactorTable_[regionIdx];
-        const Scalar eps = std::numeric_limits<typename Toolbox::Scalar>::epsilon()*1e6;
-
-        // use the tabulated saturation pressure function to get a pretty good initial value
-        Evaluation pSat = saturationPressure_[regionIdx].eval(Rv, /*extrapolate=*/true);
-
-        // Newton method to do the remaining work. If the initial
-        // value is good, this should only take two to three
-        // iterations...
-        bool onProbation = false;
-        for (unsigned i = 0; i < 20; ++i) {
-            const Evaluation& f = RvTable.eval(pSat, /*extrapolate=*/true) - Rv;
-            const Evaluation& fPrime = RvTable.evalDerivative(pSat, /*extrapolate=*/true);
-
-            // If the derivative is "zero" Newton will not converge,
-            // so simply return our initial guess.
-            if (std::abs(Opm::scalarValue(fPrime)) < 1.0e-30) {
-                return pSat;
-            }
-
-            const Evaluation& delta = f/fPrime;
-
-            pSat -= delta;
-
-            if (pSat < 0.0) {
-                // if the pressure is lower than 0 Pascals, we set it back to 0. if this
-                // happens twice, we give up and just return 0 Pa...
-                if (onProbation)
-                    return 0.0;
-
-                onProbation = true;
-                pSat = 0.0;
-            }
-
-            if (std::abs(Opm::scalarValue(delta)) < std::abs(Opm::scalarValue(pSat))*eps)
-                return pSat;
-        }
-
-        std::stringstream errlog;
-        errlog << "Finding saturation pressure did not converge:"
-               << " pSat = " << pSat
-               << ", Rv = " << Rv;
-#if HAVE_OPM_COMMON
-        OpmLog::debug("Wet gas saturation pressure", errlog.str());
-#endif
-        throw NumericalIssue(errlog.str());
+        if (tablePool_.isFinalized())
+            return findSaturationPressure_(tablePool_.oneD(regionIdx, satRvPoolIdx_),
+                                           tablePool_.oneD(regionIdx, satPressurePoolIdx_),
+                                           Rv);
+
+        return findSaturationPressure_(saturatedOilVaporizationFactorTable_[regionIdx],
+                                       saturationPressure_[regionIdx],
+                                       Rv);
     }
 
     template <class Evaluation>
@@ -676,8 +744,8 @@ public:
 
     bool operator==(const WetGasPvt<Scalar>& data) const
     {
-        return this->gasReferenceDensity() == data.gasReferenceDensity() &&
-               this->oilReferenceDensity() == data.oilReferenceDensity() &&
+        return gasReferenceDensity_ == data.gasReferenceDensity_ &&
+               oilReferenceDensity_ == data.oilReferenceDensity_ &&
                this->inverseGasB() == data.inverseGasB() &&
                this->inverseSaturatedGasB() == data.inverseSaturatedGasB() &&
                this->gasMu() == data.gasMu() &&
@@ -688,7 +756,85 @@ public:
                this->vapPar1() == data.vapPar1();
     }
 
+    template <class Serializer>
+    void serializeOp(Serializer& serializer)
+    {
+        serializer(gasReferenceDensity_);
+        serializer(oilReferenceDensity_);
+        serializer(inverseGasB_);
+        serializer(inverseSaturatedGasB_);
+        serializer(gasMu_);
+        serializer(inverseGasBMu_);
+        serializer(inverseSaturatedGasBMu_);
+        serializer(saturatedOilVaporizationFactorTable_);
+        serializer(saturationPressure_);
+        serializer(vapPar1_);
+
+        // the packed copies of the tables are not stored but recreated
+        bool packed = tablesPacked();
+        serializer(packed);
+        if (serializer.isLoading()) {
+            tablePool_ = TablePool<Scalar>();
+            if (packed)
+                packTables();
+        }
+    }
+
 private:
+    template <class Table, class Evaluation>
+    static Evaluation findSaturationPressure_(const Table& RvTable,
+                                              const Table& pSatTable,
+                                              const Evaluation& Rv)
+    {
+        typedef Opm::MathToolbox<Evaluation> Toolbox;
+
+        const Scalar eps = std::numeric_limits<typename Toolbox::Scalar>::epsilon()*1e6;
+
+        // use the tabulated saturation pressure function to get a pretty good initial value
+        Evaluation pSat = pSatTable.eval(Rv, /*extrapolate=*/true);
+
+        // Newton method to do the remaining work. If the initial
+        // value is good, this should only take two to three
+        // iterations...
+        bool onProbation = false;
+        for (unsigned i = 0; i < 20; ++i) {
+            const Evaluation& f = RvTable.eval(pSat, /*extrapolate=*/true) - Rv;
+            const Evaluation& fPrime = RvTable.evalDerivative(pSat, /*extrapolate=*/true);
+
+            // If the derivative is "zero" Newton will not converge,
+            // so simply return our initial guess.
+            if (std::abs(Opm::scalarValue(fPrime)) < 1.0e-30) {
+                return pSat;
+            }
+
+            const Evaluation& delta = f/fPrime;
+
+            pSat -= delta;
+
+            if (pSat < 0.0) {
+                // if the pressure is lower than 0 Pascals, we set it back to 0. if this
+                // happens twice, we give up and just return 0 Pa...
+                if (onProbation)
+                    return 0.0;
+
+                onProbation = true;
+                pSat = 0.0;
+            }
+
+            if (std::abs(Opm::scalarValue(delta)) < std::abs(Opm::scalarValue(pSat))*eps)
+                return pSat;
+        }
+
+        std::stringstream errlog;
+        errlog << "Finding saturation pressure did not converge:"
+               << " pSat = " << pSat
+               << ", Rv = " << Rv;
+#if HAVE_OPM_COMMON
+        OpmLog::debug("Wet gas saturation pressure", errlog.str());
+#endif
+        throw NumericalIssue(errlog.str());
+    }
+
     void updateSaturationPressure_(unsigned regionIdx)
     {
         typedef std::pair<Scalar, Scalar> Pair;
@@ -717,6 +863,16 @@ private:
         saturationPressure_[regionIdx].setContainerOfTuples(pSatSamplePoints);
     }
 
+    enum {
+        invGasBPoolIdx_ = 0,
+        invGasBMuPoolIdx_ = 1,
+        invSatGasBPoolIdx_ = 2,
+        invSatGasBMuPoolIdx_ = 3,
+        satRvPoolIdx_ = 4,
+        satPressurePoolIdx_ = 5,
+        numPooledProperties_ = 6
+    };
+
     std::vector<Scalar> gasReferenceDensity_;
     std::vector<Scalar> oilReferenceDensity_;
     std::vector<TabulatedTwoDFunction> inverseGasB_;
@@ -726,6 +882,7 @@ private:
     std::vector<TabulatedOneDFunction> inverseSaturatedGasBMu_;
     std::vector<TabulatedOneDFunction> saturatedOilVaporizationFactorTable_;
     std::vector<TabulatedOneDFunction> saturationPressure_;
+    TablePool<Scalar> tablePool_;
 
     Scalar vapPar1_;
 };
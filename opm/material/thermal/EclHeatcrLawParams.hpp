@@ -85,6 +85,17 @@ public:
     Scalar dRockHeatCapacity_dT() const
     { EnsureFinalized::check(); return dRockHeatCapacity_dT_; }
 
+    template <class Serializer>
+    void serializeOp(Serializer& serializer)
+    {
+        serializer(referenceTemperature_);
+        serializer(referenceRockHeatCapacity_);
+        serializer(dRockHeatCapacity_dT_);
+
+        if (serializer.isLoading())
+            EnsureFinalized::finalize();
+    }
+
 private:
     static Scalar referenceTemperature_;
 
@@ -126,6 +126,33 @@ public:
         return *static_cast<const SpecrockLawParams*>(realParams_);
     }
 
+    template <class Serializer>
+    void serializeOp(Serializer& serializer)
+    {
+        SolidEnergyApproach approach = solidEnergyApproach_;
+        serializer(approach);
+        if (serializer.isLoading()) {
+            destroy_();
+            if (approach != undefinedApproach)
+                setSolidEnergyApproach(approach);
+            EnsureFinalized::finalize();
+        }
+
+        switch (solidEnergyApproach()) {
+        case heatcrApproach:
+            serializer(getRealParams<heatcrApproach>());
+            break;
+
+        case specrockApproach:
+            serializer(getRealParams<specrockApproach>());
+            break;
+
+        case undefinedApproach:
+        case nullApproach:
+            break;
+        }
+    }
+
 private:
     void destroy_()
     {
@@ -94,6 +94,15 @@ public:
     const InternalEnergyFunction& internalEnergyFunction() const
     { EnsureFinalized::check(); return internalEnergyFunction_; }
 
+    template <class Serializer>
+    void serializeOp(Serializer& serializer)
+    {
+        serializer(internalEnergyFunction_);
+
+        if (serializer.isLoading())
+            EnsureFinalized::finalize();
+    }
+
 private:
     InternalEnergyFunction internalEnergyFunction_;
 };
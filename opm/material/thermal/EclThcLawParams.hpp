@@ -106,6 +106,19 @@ public:
     Scalar thcwater() const
     { EnsureFinalized::check(); return thcwater_; }
 
+    template <class Serializer>
+    void serializeOp(Serializer& serializer)
+    {
+        serializer(porosity_);
+        serializer(thcrock_);
+        serializer(thcoil_);
+        serializer(thcgas_);
+        serializer(thcwater_);
+
+        if (serializer.isLoading())
+            EnsureFinalized::finalize();
+    }
+
 private:
     Scalar porosity_;
     Scalar thcrock_;
@@ -70,6 +70,16 @@ public:
     Scalar dTotalThermalConductivity_dSg() const
     { EnsureFinalized::check(); return dTotalThermalConductivity_dSg_; }
 
+    template <class Serializer>
+    void serializeOp(Serializer& serializer)
+    {
+        serializer(referenceTotalThermalConductivity_);
+        serializer(dTotalThermalConductivity_dSg_);
+
+        if (serializer.isLoading())
+            EnsureFinalized::finalize();
+    }
+
 private:
     Scalar referenceTotalThermalConductivity_;
     Scalar dTotalThermalConductivity_dSg_;
@@ -126,6 +126,33 @@ public:
         return *static_cast<const ThcLawParams*>(realParams_);
     }
 
+    template <class Serializer>
+    void serializeOp(Serializer& serializer)
+    {
+        ThermalConductionApproach approach = thermalConductionApproach_;
+        serializer(approach);
+        if (serializer.isLoading()) {
+            destroy_();
+            if (approach != undefinedApproach)
+                setThermalConductionApproach(approach);
+            EnsureFinalized::finalize();
+        }
+
+        switch (thermalConductionApproach()) {
+        case thconrApproach:
+            serializer(getRealParams<thconrApproach>());
+            break;
+
+        case thcApproach:
+            serializer(getRealParams<thcApproach>());
+            break;
+
+        case undefinedApproach:
+        case nullApproach:
+            break;
+        }
+    }
+
 private:
     void destroy_()
     {
@@ -41,6 +41,9 @@
 #include <opm/parser/eclipse/EclipseState/Tables/TableManager.hpp>
 #include <opm/parser/eclipse/Deck/Deck.hpp>
 
+#include <stdexcept>
+#include <vector>
+
 namespace Opm {
 
 /*!
@@ -90,18 +93,54 @@ public:
             initNullCond_();
     }
 
+    /*!
+     * \brief Re-create the element specific parameter objects of the elements which are
+     *        owned by the calling thread.
+     *
+     * This allows to place the parameters on the NUMA node of the thread which uses
+     * them, see EclMaterialLawManager::firstTouchElementParams(). The parameters are
+     * only specific for each element if they are specified by the HEATCR, THCONR or
+     * THC* keywords, the other ones are not copied.
+     */
+    void firstTouchElementParams(const std::vector<unsigned>& elementOwner, unsigned ownerIdx)
+    {
+        if (solidEnergyApproach_ == SolidEnergyLawParams::heatcrApproach) {
+            if (elementOwner.size() != solidEnergyLawParams_.size())
+                throw std::runtime_error("The size of the partition does not match the number of elements.");
+
+            for (unsigned elemIdx = 0; elemIdx < elementOwner.size(); ++elemIdx) {
+                if (elementOwner[elemIdx] != ownerIdx)
+                    continue;
+
+                // setting the approach re-allocates the parameters of the law
+                auto& elemParams = solidEnergyLawParams_[elemIdx];
+                HeatcrLawParams realParams = elemParams.template getRealParams<SolidEnergyLawParams::heatcrApproach>();
+                elemParams.setSolidEnergyApproach(SolidEnergyLawParams::heatcrApproach);
+                elemParams.template getRealParams<SolidEnergyLawParams::heatcrApproach>() = realParams;
+                elemParams.finalize();
+            }
+        }
+
+        if (thermalConductivityApproach_ == ThermalConductionLawParams::thconrApproach)
+            firstTouchConductionParams_<ThermalConductionLawParams::thconrApproach,
+                                        typename ThermalConductionLawParams::ThconrLawParams>(elementOwner, ownerIdx);
+        else if (thermalConductivityApproach_ == ThermalConductionLawParams::thcApproach)
+            firstTouchConductionParams_<ThermalConductionLawParams::thcApproach,
+                                        typename ThermalConductionLawParams::ThcLawParams>(elementOwner, ownerIdx);
+    }
+
     const SolidEnergyLawParams& solidEnergyLawParams(unsigned elemIdx) const
     {
         switch (solidEnergyApproach_) {
         case SolidEnergyLawParams::heatcrApproach:
-            assert(0 <= elemIdx && elemIdx <  solidEnergyLawParams_.size());
+            assert(elemIdx < solidEnergyLawParams_.size());
             return solidEnergyLawParams_[elemIdx];
 
         case SolidEnergyLawParams::specrockApproach:
         {
-            assert(0 <= elemIdx && elemIdx <  elemToSatnumIdx_.size());
+            assert(elemIdx < elemToSatnumIdx_.size());
             unsigned satnumIdx = elemToSatnumIdx_[elemIdx];
-            assert(0 <= satnumIdx && satnumIdx <  solidEnergyLawParams_.size());
+            assert(satnumIdx < solidEnergyLawParams_.size());
             return solidEnergyLawParams_[satnumIdx];
         }
 
@@ -119,7 +158,7 @@ public:
         switch (thermalConductivityApproach_) {
         case ThermalConductionLawParams::thconrApproach:
         case ThermalConductionLawParams::thcApproach:
-            assert(0 <= elemIdx && elemIdx <  thermalConductionLawParams_.size());
+            assert(elemIdx < thermalConductionLawParams_.size());
             return thermalConductionLawParams_[elemIdx];
 
         case ThermalConductionLawParams::nullApproach:
@@ -131,6 +170,19 @@ public:
         }
     }
 
+    /*!
+     * \brief Store or load the parameters of all elements.
+     */
+    template <class Serializer>
+    void serializeOp(Serializer& serializer)
+    {
+        serializer(thermalConductivityApproach_);
+        serializer(solidEnergyApproach_);
+        serializer(elemToSatnumIdx_);
+        serializer(solidEnergyLawParams_);
+        serializer(thermalConductionLawParams_);
+    }
+
 private:
     /*!
      * \brief Initialize the parameters for the solid energy law using using HEATCR and friends.
@@ -301,6 +353,24 @@ private:
         thermalConductionLawParams_[0].finalize();
     }
 
+    template <typename ThermalConductionLawParams::ThermalConductionApproach approach, class RealParams>
+    void firstTouchConductionParams_(const std::vector<unsigned>& elementOwner, unsigned ownerIdx)
+    {
+        if (elementOwner.size() != thermalConductionLawParams_.size())
+            throw std::runtime_error("The size of the partition does not match the number of elements.");
+
+        for (unsigned elemIdx = 0; elemIdx < elementOwner.size(); ++elemIdx) {
+            if (elementOwner[elemIdx] != ownerIdx)
+                continue;
+
+            auto& elemParams = thermalConductionLawParams_[elemIdx];
+            RealParams realParams = elemParams.template getRealParams<approach>();
+            elemParams.setThermalConductionApproach(approach);
+            elemParams.template getRealParams<approach>() = realParams;
+            elemParams.finalize();
+        }
+    }
+
 private:
     typename ThermalConductionLawParams::ThermalConductionApproach thermalConductivityApproach_;
     typename SolidEnergyLawParams::SolidEnergyApproach solidEnergyApproach_;
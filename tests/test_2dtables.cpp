@@ -32,12 +32,25 @@
 #include <opm/material/common/UniformXTabulated2DFunction.hpp>
 #include <opm/material/common/UniformTabulated2DFunction.hpp>
 #include <opm/material/common/IntervalTabulated2DFunction.hpp>
+#include <opm/material/common/FlatTables.hpp>
+#include <opm/material/common/TablePool.hpp>
+#include <opm/material/common/SharedMemorySegment.hpp>
+#include <opm/material/common/Tabulated1DFunction.hpp>
+#include <opm/material/common/EvaluationStatus.hpp>
+#include <opm/material/densead/Evaluation.hpp>
 
 #include <dune/common/parallel/mpihelper.hh>
 
 #include <memory>
+#include <vector>
+#include <type_traits>
+#include <stdexcept>
 #include <cmath>
 #include <iostream>
+#include <string>
+#include <cstring>
+
+#include <unistd.h>
 
 template <class ScalarT>
 struct Test
@@ -387,6 +400,427 @@ struct Test
 
         return true;
     }
+
+    // make sure that the views on a flat table image yield exactly the same results as
+    // the original tables
+    template <class Fn>
+    bool compareWithFlatImage(const std::shared_ptr<Opm::UniformXTabulated2DFunction<Scalar> >& uXTable,
+                              Fn& f)
+    {
+        std::vector<Scalar> xValues, yValues;
+        for (int i = 0; i < 30; ++i) {
+            Scalar x = -2.0 + i*i*0.01;
+            xValues.push_back(x);
+            yValues.push_back(f(x, 0.5*x));
+        }
+        Opm::Tabulated1DFunction<Scalar> tab1D(xValues.size(), xValues, yValues);
+
+        Opm::FlatTableWriter<Scalar> writer;
+        size_t idx1D = writer.add(tab1D);
+        size_t idx2D = writer.add(*uXTable);
+
+        // use a buffer of 64 bit words to get a suitably aligned image
+        std::vector<uint64_t> buffer((writer.size() + 7)/8);
+        writer.writeTo(buffer.data());
+
+        Opm::FlatTableImage<Scalar> image(buffer.data(), writer.size());
+        if (image.numTables() != 2 || !image.isOneD(idx1D) || image.isOneD(idx2D)) {
+            std::cerr << "Wrong table directory of the flat image\n";
+            return false;
+        }
+
+        const auto& view1D = image.oneD(idx1D);
+        const auto& view2D = image.twoD(idx2D);
+        for (int i = 0; i <= 200; ++i) {
+            Scalar x = uXTable->xMin() + (uXTable->xMax() - uXTable->xMin())*i/200;
+            if (view1D.eval(x, /*extrapolate=*/true) != tab1D.eval(x, /*extrapolate=*/true)
+                || view1D.evalDerivative(x, /*extrapolate=*/true) != tab1D.evalDerivative(x, /*extrapolate=*/true))
+            {
+                std::cerr << "Flat 1D table differs from the original at x=" << x << "\n";
+                return false;
+            }
+
+            for (int j = 0; j <= 50; ++j) {
+                Scalar y = -5.0 + 10.0*j/50;
+                if (view2D.eval(x, y, /*extrapolate=*/true) != uXTable->eval(x, y, /*extrapolate=*/true)) {
+                    std::cerr << "Flat 2D table differs from the original at (" << x << ", " << y << ")\n";
+                    return false;
+                }
+            }
+        }
+
+        // images of a different floating point type must be rejected
+        typedef typename std::conditional<std::is_same<Scalar, float>::value, double, float>::type OtherScalar;
+        try {
+            Opm::FlatTableImage<OtherScalar> wrongImage(buffer.data(), writer.size());
+            std::cerr << "Flat table image with wrong scalar type was not rejected\n";
+            return false;
+        }
+        catch (const std::runtime_error&) {
+        }
+
+        return true;
+    }
+
+    // make sure that the tables of a pool are cache line aligned, are addressed by
+    // their region and property and survive copying the pool
+    template <class Fn>
+    bool checkTablePool(const std::shared_ptr<Opm::UniformXTabulated2DFunction<Scalar> >& uXTable,
+                        Fn& f)
+    {
+        typedef Opm::TablePool<Scalar> Pool;
+
+        const unsigned numRegions = 3;
+        std::vector<Opm::Tabulated1DFunction<Scalar> > tabs1D;
+        for (unsigned regionIdx = 0; regionIdx < numRegions; ++regionIdx) {
+            std::vector<Scalar> xValues, yValues;
+            for (unsigned i = 0; i < 7 + 5*regionIdx; ++i) {
+                Scalar x = -2.0 + i*0.3;
+                xValues.push_back(x);
+                yValues.push_back(f(x, Scalar(regionIdx)));
+            }
+            tabs1D.emplace_back(xValues, yValues);
+        }
+
+        // property 0 is one-dimensional, property 1 is only given for region 1
+        Pool pool(numRegions, /*numProperties=*/2);
+        for (unsigned regionIdx = 0; regionIdx < numRegions; ++regionIdx)
+            pool.add(regionIdx, 0, tabs1D[regionIdx]);
+        pool.add(1, 1, *uXTable);
+        pool.finalize();
+
+        if (!pool.contains(1, 1) || pool.contains(0, 1) || pool.contains(numRegions, 0)) {
+            std::cerr << "Wrong slots of the table pool\n";
+            return false;
+        }
+
+        try {
+            pool.add(0, 1, tabs1D[0]);
+            std::cerr << "Adding a table to a finalized pool was not rejected\n";
+            return false;
+        }
+        catch (const std::logic_error&) {
+        }
+
+        Pool copiedPool(pool);
+        for (const Pool* p : { &pool, &copiedPool }) {
+            if (reinterpret_cast<uintptr_t>(p->data()) % Pool::alignment != 0) {
+                std::cerr << "Table pool is not aligned\n";
+                return false;
+            }
+
+            for (unsigned regionIdx = 0; regionIdx < numRegions; ++regionIdx) {
+                const auto& view = p->oneD(regionIdx, 0);
+                for (int i = 0; i <= 100; ++i) {
+                    Scalar x = -3.0 + i*0.06;
+                    if (view.eval(x, /*extrapolate=*/true) != tabs1D[regionIdx].eval(x, /*extrapolate=*/true)) {
+                        std::cerr << "Pooled table of region " << regionIdx << " differs at x=" << x << "\n";
+                        return false;
+                    }
+                }
+            }
+
+            const auto& view2D = p->twoD(1, 1);
+            for (int i = 0; i <= 50; ++i) {
+                Scalar x = uXTable->xMin() + (uXTable->xMax() - uXTable->xMin())*i/50;
+                Scalar y = -5.0 + 0.2*i;
+                if (view2D.eval(x, y, /*extrapolate=*/true) != uXTable->eval(x, y, /*extrapolate=*/true)) {
+                    std::cerr << "Pooled 2D table differs at (" << x << ", " << y << ")\n";
+                    return false;
+                }
+            }
+        }
+
+        return true;
+    }
+
+    // make sure that the image of a table pool can be placed in a shared memory segment
+    // which is mapped a second time and used by another pool without copying it
+    template <class Fn>
+    bool checkSharedMemorySegment(const std::shared_ptr<Opm::UniformXTabulated2DFunction<Scalar> >& uXTable,
+                                  Fn& f)
+    {
+        typedef Opm::TablePool<Scalar> Pool;
+
+        if (!Opm::SharedMemorySegment::isSupported())
+            return true;
+
+        std::vector<Scalar> xValues, yValues;
+        for (int i = 0; i < 11; ++i) {
+            Scalar x = -2.0 + i*0.4;
+            xValues.push_back(x);
+            yValues.push_back(f(x, 0.5));
+        }
+        Opm::Tabulated1DFunction<Scalar> tab1D(xValues, yValues);
+
+        // a table for every slot, in the order of the slots
+        Pool pool(/*numRegions=*/1, /*numProperties=*/2);
+        pool.add(0, 0, tab1D);
+        pool.add(0, 1, *uXTable);
+        pool.finalize();
+
+        // the name must be unique for the process and the scalar type
+        const std::string name =
+            "/opm-test-2dtables-"+std::to_string(getpid())+"-"+std::to_string(sizeof(Scalar));
+
+        Opm::SharedMemorySegment writer;
+        writer.create(name, pool.size());
+        if (!writer.isOpen() || !writer.isWritable() || writer.size() != pool.size()) {
+            std::cerr << "Wrong state of a created shared memory segment\n";
+            return false;
+        }
+        std::memcpy(writer.writableData(), pool.data(), pool.size());
+
+        try {
+            Opm::SharedMemorySegment duplicate;
+            duplicate.create(name, pool.size());
+            std::cerr << "Creating an existing shared memory segment was not rejected\n";
+            return false;
+        }
+        catch (const std::runtime_error&) {
+        }
+
+        Opm::SharedMemorySegment reader;
+        reader.open(name);
+        if (!reader.isOpen() || reader.isWritable() || reader.size() != pool.size()
+            || reader.data() == writer.data()
+            || std::memcmp(reader.data(), pool.data(), pool.size()) != 0)
+        {
+            std::cerr << "Second mapping of a shared memory segment differs from the first one\n";
+            return false;
+        }
+
+        try {
+            reader.writableData();
+            std::cerr << "Writing to a read-only shared memory segment was not rejected\n";
+            return false;
+        }
+        catch (const std::logic_error&) {
+        }
+
+        // the name can be removed once all processes have mapped the segment
+        Opm::SharedMemorySegment::unlink(name);
+        try {
+            Opm::SharedMemorySegment unlinked;
+            unlinked.open(name);
+            std::cerr << "Opening an unlinked shared memory segment was not rejected\n";
+            return false;
+        }
+        catch (const std::runtime_error&) {
+        }
+
+        writer.close();
+        if (writer.isOpen()) {
+            std::cerr << "Closed shared memory segment is still open\n";
+            return false;
+        }
+
+        Pool sharedPool(/*numRegions=*/1, /*numProperties=*/2);
+        sharedPool.useExternalImage(reader.data(), reader.size());
+        Pool copiedSharedPool(sharedPool);
+        for (const Pool* p : { &sharedPool, &copiedSharedPool }) {
+            if (!p->isExternal() || p->data() != reader.data()) {
+                std::cerr << "Pool does not use the shared memory segment\n";
+                return false;
+            }
+
+            for (int i = 0; i <= 50; ++i) {
+                Scalar x = uXTable->xMin() + (uXTable->xMax() - uXTable->xMin())*i/50;
+                Scalar y = -5.0 + 0.2*i;
+                if (p->oneD(0, 0).eval(x, /*extrapolate=*/true) != tab1D.eval(x, /*extrapolate=*/true)
+                    || p->twoD(0, 1).eval(x, y, /*extrapolate=*/true) != uXTable->eval(x, y, /*extrapolate=*/true))
+                {
+                    std::cerr << "Table in shared memory differs at (" << x << ", " << y << ")\n";
+                    return false;
+                }
+            }
+        }
+
+        // images which do not match the layout of the pool must be rejected
+        try {
+            Pool wrongPool(/*numRegions=*/2, /*numProperties=*/2);
+            wrongPool.useExternalImage(reader.data(), reader.size());
+            std::cerr << "Table image with the wrong layout was not rejected\n";
+            return false;
+        }
+        catch (const std::runtime_error&) {
+        }
+
+        return true;
+    }
+
+    // make sure that precomputing the slopes and intercepts of a 1D table does not
+    // change its values beyond round-off and keeps the derivatives exact
+    template <class Fn>
+    bool compareWithCompiled(Fn& f, Scalar tolerance)
+    {
+        typedef Opm::DenseAd::Evaluation<Scalar, 1> Evaluation;
+
+        std::vector<Scalar> xValues, yValues;
+        for (int i = 0; i < 30; ++i) {
+            Scalar x = -2.0 + i*i*0.01;
+            xValues.push_back(x);
+            yValues.push_back(f(x, 0.5*x));
+        }
+        Opm::Tabulated1DFunction<Scalar> tab1D(xValues.size(), xValues, yValues);
+        Opm::Tabulated1DFunction<Scalar> compiledTab1D(tab1D);
+        compiledTab1D.compile();
+        if (tab1D.isCompiled() || !compiledTab1D.isCompiled()) {
+            std::cerr << "Wrong compilation state of a 1D table\n";
+            return false;
+        }
+
+        for (int i = 0; i <= 200; ++i) {
+            Scalar x = -3.0 + 11.0*i/200;
+            const Evaluation& xEval = Evaluation::createVariable(x, 0);
+            const Evaluation& y = tab1D.eval(xEval, /*extrapolate=*/true);
+            const Evaluation& yCompiled = compiledTab1D.eval(xEval, /*extrapolate=*/true);
+            Scalar scale = std::max(Scalar(1.0), std::abs(y.value()));
+            if (std::abs(y.value() - yCompiled.value()) > tolerance*scale
+                || std::abs(y.derivative(0) - yCompiled.derivative(0)) > tolerance*std::max(Scalar(1.0), std::abs(y.derivative(0)))
+                || std::abs(tab1D.evalDerivative(x, /*extrapolate=*/true)
+                            - compiledTab1D.evalDerivative(x, /*extrapolate=*/true)) > tolerance*std::max(Scalar(1.0), std::abs(y.derivative(0))))
+            {
+                std::cerr << "Compiled 1D table differs from the original at x=" << x << "\n";
+                return false;
+            }
+        }
+
+        // setting new sampling points discards the compiled form
+        compiledTab1D.setXYContainers(xValues, yValues);
+        if (compiledTab1D.isCompiled()) {
+            std::cerr << "Compiled form of a 1D table was not discarded\n";
+            return false;
+        }
+
+        // tables without any segment cannot be compiled
+        Opm::Tabulated1DFunction<Scalar> emptyTab1D;
+        emptyTab1D.compile();
+        if (emptyTab1D.isCompiled()) {
+            std::cerr << "An empty 1D table was compiled\n";
+            return false;
+        }
+
+        // a step is represented by a zero-width segment which must not spoil the
+        // coefficients of the compiled table
+        std::vector<Scalar> xStep = { 0.0, 1.0, 1.0, 2.0 };
+        std::vector<Scalar> yStep = { 0.0, 1.0, 3.0, 4.0 };
+        Opm::Tabulated1DFunction<Scalar> stepTab1D(xStep.size(), xStep, yStep);
+        Opm::Tabulated1DFunction<Scalar> compiledStepTab1D(stepTab1D);
+        compiledStepTab1D.compile();
+        for (int i = 0; i <= 20; ++i) {
+            Scalar x = 0.1*i;
+            Scalar y = stepTab1D.eval(x);
+            Scalar yCompiled = compiledStepTab1D.eval(x);
+            if (!std::isfinite(yCompiled)
+                || std::abs(y - yCompiled) > tolerance*std::max(Scalar(1.0), std::abs(y)))
+            {
+                std::cerr << "Compiled 1D table with a zero-width segment differs from "
+                          << "the original at x=" << x << "\n";
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    // make sure that the non-throwing evaluation methods record the range violations
+    // and extrapolate or clamp like their throwing counterparts
+    template <class Fn>
+    bool checkNoThrowEval(Fn& f)
+    {
+        typedef Opm::EvaluationStatus<Scalar> Status;
+
+        std::vector<Scalar> xValues, yValues;
+        for (int i = 0; i < 30; ++i) {
+            Scalar x = -2.0 + i*0.1;
+            xValues.push_back(x);
+            yValues.push_back(f(x, 0.5*x));
+        }
+        Opm::Tabulated1DFunction<Scalar> tab1D(xValues, yValues);
+
+        auto uXTab = createUniformXTabulatedFunction(f);
+
+        // the same table as createIntervalTabulated2DFunction() but without
+        // extrapolation
+        auto extrapolatingTab = createIntervalTabulated2DFunction(f);
+        Opm::IntervalTabulated2DFunction<Scalar> intervalTab(extrapolatingTab->xPos(),
+                                                             extrapolatingTab->yPos(),
+                                                             extrapolatingTab->samples(),
+                                                             /*xExtrapolate=*/false,
+                                                             /*yExtrapolate=*/false);
+
+        Status extrapolateStatus(Status::OutOfRangePolicy::Extrapolate, /*maxRecorded=*/2);
+        Status clampStatus(Status::OutOfRangePolicy::Clamp);
+
+        unsigned numOutside = 0;
+        for (int i = 0; i <= 20; ++i) {
+            Scalar x = -4.0 + 8.0*i/20;
+            Scalar y = -1.0 + 2.0*i/20;
+            extrapolateStatus.setElementIndex(i);
+            clampStatus.setElementIndex(i);
+
+            bool inside1D = tab1D.applies(x);
+            Scalar x1DClamped = std::min(std::max(x, tab1D.xMin()), tab1D.xMax());
+            if (tab1D.eval(x, extrapolateStatus, /*tableId=*/1) != tab1D.eval(x, /*extrapolate=*/true)
+                || tab1D.eval(x, clampStatus, /*tableId=*/1) != tab1D.eval(x1DClamped))
+            {
+                std::cerr << "Non-throwing evaluation of a 1D table is wrong at x=" << x << "\n";
+                return false;
+            }
+
+            bool inside2D = intervalTab.applies(x, y);
+            Scalar xClamped = std::min(std::max(x, intervalTab.xMin()), intervalTab.xMax());
+            Scalar yClamped = std::min(std::max(y, intervalTab.yMin()), intervalTab.yMax());
+            if (intervalTab.eval(x, y, extrapolateStatus, /*tableId=*/2) != extrapolatingTab->eval(x, y)
+                || intervalTab.eval(x, y, clampStatus, /*tableId=*/2) != intervalTab.eval(xClamped, yClamped))
+            {
+                std::cerr << "Non-throwing evaluation of an interval 2D table is wrong at ("
+                          << x << ", " << y << ")\n";
+                return false;
+            }
+
+            // the y range of all columns of the table is the same
+            bool insideUX = uXTab->xMin() <= x && x <= uXTab->xMax()
+                && uXTab->yMin(0) <= y && y <= uXTab->yMax(0);
+            Scalar xUXClamped = std::min(std::max(x, uXTab->xMin()), uXTab->xMax());
+            Scalar yUXClamped = std::min(std::max(y, uXTab->yMin(0)), uXTab->yMax(0));
+            if (uXTab->eval(x, y, extrapolateStatus, /*tableId=*/3) != uXTab->eval(x, y, /*extrapolate=*/true)
+                || uXTab->eval(x, y, clampStatus, /*tableId=*/3) != uXTab->eval(xUXClamped, yUXClamped))
+            {
+                std::cerr << "Non-throwing evaluation of a uniform-X 2D table is wrong at ("
+                          << x << ", " << y << ")\n";
+                return false;
+            }
+
+            numOutside += !inside1D + !inside2D + !insideUX;
+        }
+
+        if (numOutside == 0
+            || extrapolateStatus.numViolations() != numOutside
+            || clampStatus.numViolations() != numOutside
+            || extrapolateStatus.violations().size() != 2
+            || extrapolateStatus.violations()[0].elementIdx != 0
+            || extrapolateStatus.violations()[0].tableId != 1)
+        {
+            std::cerr << "Range violations were not recorded correctly\n";
+            return false;
+        }
+
+        // the errors are reported once for all evaluations
+        try {
+            extrapolateStatus.throwIfFailed("test tables");
+            std::cerr << "Recorded range violations were not reported\n";
+            return false;
+        }
+        catch (const Opm::NumericalIssue&) {
+        }
+
+        extrapolateStatus.clear();
+        extrapolateStatus.throwIfFailed("test tables");
+
+        return true;
+    }
 };
 
 
@@ -416,6 +850,16 @@ inline int testAll(const typename TestType::Scalar tolerance = 1e-6)
                                          TestType::testFn3,
                                          /*tolerance=*/1e-2))
         return 1;
+    if (!test.compareWithFlatImage(uniformXTab, TestType::testFn3))
+        return 1;
+    if (!test.compareWithCompiled(TestType::testFn3, 100*tolerance))
+        return 1;
+    if (!test.checkTablePool(uniformXTab, TestType::testFn3))
+        return 1;
+    if (!test.checkSharedMemorySegment(uniformXTab, TestType::testFn3))
+        return 1;
+    if (!test.checkNoThrowEval(TestType::testFn1))
+        return 1;
 
     {
         using ScalarType = typename TestType::Scalar;
@@ -42,6 +42,7 @@
 
 #include <opm/material/densead/Evaluation.hpp>
 #include <opm/material/densead/Math.hpp>
+#include <opm/material/common/EvaluationStatus.hpp>
 
 #include <opm/parser/eclipse/Parser/Parser.hpp>
 #include <opm/parser/eclipse/Deck/Deck.hpp>
@@ -50,6 +51,10 @@
 
 #include <dune/common/parallel/mpihelper.hh>
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
 // values of strings based on the first SPE1 test case of opm-data.  note that in the
 // real world it does not make much sense to specify a fluid phase using more than a
 // single keyword, but for a unit test, this saves a lot of boiler-plate code.
@@ -163,6 +168,195 @@ void ensurePvtApi(const BrinePvt& brinePvt, const Co2Pvt& co2Pvt)
     }
 }
 
+template <class Scalar>
+inline void testSolubilityTable()
+{
+    typedef Opm::BrineCo2Pvt<Scalar> BrinePvt;
+    typedef typename BrinePvt::CO2 CO2;
+    typedef Opm::DenseAd::Evaluation<Scalar, 2> Evaluation;
+
+    const Scalar tolerance = 1e-3;
+
+    // the exact correlation is used unless tabulation is requested explicitly
+    BrinePvt defaultPvt({1000.0}, {1.8}, {0.1});
+    defaultPvt.initEnd();
+    if (defaultPvt.solubilityTable(/*regionIdx=*/0).isInitialized())
+        throw std::logic_error("The solubility of CO2 in brine must not be tabulated by default");
+
+    BrinePvt exactPvt({1000.0}, {1.8}, {0.1});
+    exactPvt.setSolubilityTabulation(/*tolerance=*/0.0);
+    exactPvt.initEnd();
+
+    BrinePvt tabulatedPvt({1000.0}, {1.8}, {0.1});
+    tabulatedPvt.setSolubilityTabulation(tolerance);
+    tabulatedPvt.initEnd();
+
+    if (!tabulatedPvt.solubilityTable(/*regionIdx=*/0).isInitialized())
+        throw std::logic_error("The solubility of CO2 in brine has not been tabulated");
+
+    unsigned n = 20;
+    for (unsigned i = 0; i <= n; ++i) {
+        Scalar T = CO2::minTabulatedTemperature()
+            + Scalar(i)/n*(CO2::maxTabulatedTemperature() - CO2::minTabulatedTemperature());
+        for (unsigned j = 0; j <= n; ++j) {
+            Scalar p = CO2::minTabulatedPressure()
+                + Scalar(j)/n*(CO2::maxTabulatedPressure() - CO2::minTabulatedPressure());
+
+            Scalar rsExact = exactPvt.saturatedGasDissolutionFactor(/*regionIdx=*/0, T, p);
+            Scalar rsTabulated = tabulatedPvt.saturatedGasDissolutionFactor(/*regionIdx=*/0, T, p);
+            if (std::abs(rsTabulated - rsExact) > 10*tolerance*std::max(std::abs(rsExact), Scalar(1.0)))
+                throw std::logic_error("Tabulated and exact gas dissolution factors differ: "
+                                       +std::to_string(rsTabulated)+" != "+std::to_string(rsExact));
+
+            // the value must not depend on whether derivatives are computed
+            const Evaluation& rsEval =
+                tabulatedPvt.saturatedGasDissolutionFactor(/*regionIdx=*/0,
+                                                           Evaluation::createVariable(T, 0),
+                                                           Evaluation::createVariable(p, 1));
+            if (std::abs(rsEval.value() - rsTabulated) > 1e-6*std::max(std::abs(rsTabulated), Scalar(1.0)))
+                throw std::logic_error("Value of the tabulated gas dissolution factor depends on the evaluation type");
+        }
+    }
+
+    // the derivatives must be those of the interpolant. within a cell of the table,
+    // the interpolant is linear in the temperature and in the logarithm of the
+    // pressure, so they are compared with central differences of the tabulated
+    // values around the centers of the cells.
+    const auto& table = tabulatedPvt.solubilityTable(/*regionIdx=*/0);
+    unsigned nT = table.numTemperatureSamples();
+    unsigned nP = table.numPressureSamples();
+    Scalar TMin = CO2::minTabulatedTemperature();
+    Scalar lnPMin = std::log(CO2::minTabulatedPressure());
+    Scalar dT = (CO2::maxTabulatedTemperature() - TMin)/(nT - 1);
+    Scalar dLnP = (std::log(CO2::maxTabulatedPressure()) - lnPMin)/(nP - 1);
+    Scalar hT = dT/4;
+    Scalar hLnP = dLnP/4;
+    auto rsTabulated = [&tabulatedPvt](Scalar T, Scalar lnP) {
+        return tabulatedPvt.saturatedGasDissolutionFactor(/*regionIdx=*/0, T, Scalar(std::exp(lnP)));
+    };
+
+    unsigned strideT = std::max(1u, (nT - 1)/n);
+    unsigned strideP = std::max(1u, (nP - 1)/n);
+    for (unsigned i = 0; i + 1 < nT; i += strideT) {
+        Scalar T = TMin + (i + Scalar(0.5))*dT;
+        for (unsigned j = 0; j + 1 < nP; j += strideP) {
+            Scalar lnP = lnPMin + (j + Scalar(0.5))*dLnP;
+            Scalar p = std::exp(lnP);
+
+            const Evaluation& rsEval =
+                tabulatedPvt.saturatedGasDissolutionFactor(/*regionIdx=*/0,
+                                                           Evaluation::createVariable(T, 0),
+                                                           Evaluation::createVariable(p, 1));
+            Scalar drsdT = (rsTabulated(T + hT, lnP) - rsTabulated(T - hT, lnP))/(2*hT);
+            Scalar drsdp = (rsTabulated(T, lnP + hLnP) - rsTabulated(T, lnP - hLnP))/(2*hLnP)/p;
+
+            // the differences suffer from the roundoff of the tabulated values
+            Scalar noise = 100*std::numeric_limits<Scalar>::epsilon()*std::max(std::abs(rsEval.value()), Scalar(1.0));
+            if (std::abs(rsEval.derivative(0) - drsdT) > 1e-2*std::abs(drsdT) + noise/hT)
+                throw std::logic_error("Wrong temperature derivative of the tabulated gas dissolution factor: "
+                                       +std::to_string(rsEval.derivative(0))+" != "+std::to_string(drsdT));
+            if (std::abs(rsEval.derivative(1) - drsdp) > 1e-2*std::abs(drsdp) + noise/(hLnP*p))
+                throw std::logic_error("Wrong pressure derivative of the tabulated gas dissolution factor: "
+                                       +std::to_string(rsEval.derivative(1))+" != "+std::to_string(drsdp));
+        }
+    }
+}
+
+// the non-throwing density evaluation must record the temperatures and pressures
+// outside of the valid range instead of throwing
+template <class Scalar>
+inline void testNoThrowDensity()
+{
+    typedef Opm::BrineCo2Pvt<Scalar> BrinePvt;
+    typedef Opm::EvaluationStatus<Scalar> Status;
+
+    BrinePvt brinePvt({1000.0}, {1.8}, {0.1});
+    brinePvt.initEnd();
+
+    const Scalar Rs = 10.0;
+    const Scalar T[] = { 300.0, 260.0, 350.0 };
+    const Scalar p[] = { 1e7, 1e7, 2e8 };
+
+    Status extrapolateStatus(Status::OutOfRangePolicy::Extrapolate);
+    Status clampStatus(Status::OutOfRangePolicy::Clamp);
+    for (unsigned elemIdx = 0; elemIdx < 3; ++elemIdx) {
+        extrapolateStatus.setElementIndex(elemIdx);
+        clampStatus.setElementIndex(elemIdx);
+        Scalar b = brinePvt.inverseFormationVolumeFactor(/*regionIdx=*/0, T[elemIdx], p[elemIdx], Rs, extrapolateStatus);
+        Scalar bClamped = brinePvt.inverseFormationVolumeFactor(/*regionIdx=*/0, T[elemIdx], p[elemIdx], Rs, clampStatus);
+
+        Scalar TValid = std::max(T[elemIdx], Scalar(273.15));
+        Scalar pValid = std::min(p[elemIdx], Scalar(100e6));
+        if (!std::isfinite(b))
+            throw std::logic_error("Extrapolated brine density is not finite");
+        if (elemIdx == 0 && b != brinePvt.inverseFormationVolumeFactor(/*regionIdx=*/0, T[elemIdx], p[elemIdx], Rs))
+            throw std::logic_error("Non-throwing brine density differs within the valid range");
+        Status boundaryStatus;
+        if (elemIdx > 0
+            && (bClamped != brinePvt.inverseFormationVolumeFactor(/*regionIdx=*/0, TValid, pValid, Rs, boundaryStatus)
+                || !boundaryStatus.ok()))
+            throw std::logic_error("Clamped brine density differs from the one at the range boundary");
+    }
+
+    if (extrapolateStatus.numViolations() != 2
+        || clampStatus.numViolations() != 2
+        || extrapolateStatus.violations()[0].elementIdx != 1
+        || extrapolateStatus.violations()[1].elementIdx != 2)
+        throw std::logic_error("Range violations of the brine density were not recorded");
+}
+
+// the solubility of CO2 must not throw for the non-throwing evaluation of the
+// saturated brine density but report the range violation in the status object
+// and use the solubility at the closest point of the CO2 tables
+template <class Scalar>
+inline void testNoThrowSaturatedDensity()
+{
+    typedef Opm::BrineCo2Pvt<Scalar> BrinePvt;
+    typedef typename BrinePvt::CO2 CO2;
+    typedef Opm::EvaluationStatus<Scalar> Status;
+
+    BrinePvt brinePvt({1000.0}, {1.8}, {0.1});
+    brinePvt.initEnd();
+
+    const Scalar T[] = { 300.0, 300.0, 2*CO2::maxTabulatedTemperature() };
+    const Scalar p[] = { 1e7, 2*CO2::maxTabulatedPressure(), 1e7 };
+
+    Status status(Status::OutOfRangePolicy::Clamp);
+    for (unsigned elemIdx = 0; elemIdx < 3; ++elemIdx) {
+        status.setElementIndex(elemIdx);
+        Scalar b = brinePvt.saturatedInverseFormationVolumeFactor(/*regionIdx=*/0, T[elemIdx], p[elemIdx], status);
+        if (!std::isfinite(b))
+            throw std::logic_error("Saturated brine density outside of the range of the CO2 tables is not finite");
+        if (elemIdx == 0
+            && (!status.ok()
+                || b != brinePvt.saturatedInverseFormationVolumeFactor(/*regionIdx=*/0, T[elemIdx], p[elemIdx])))
+            throw std::logic_error("Non-throwing saturated brine density differs within the valid range");
+
+        Status rsStatus(Status::OutOfRangePolicy::Clamp);
+        const Scalar TClamped = std::min(std::max(T[elemIdx], CO2::minTabulatedTemperature()),
+                                         CO2::maxTabulatedTemperature());
+        const Scalar pClamped = std::min(std::max(p[elemIdx], CO2::minTabulatedPressure()),
+                                         CO2::maxTabulatedPressure());
+        const Scalar Rs = brinePvt.saturatedGasDissolutionFactor(/*regionIdx=*/0, T[elemIdx], p[elemIdx], rsStatus);
+        if (Rs <= 0.0
+            || Rs != brinePvt.saturatedGasDissolutionFactor(/*regionIdx=*/0, TClamped, pClamped))
+            throw std::logic_error("The CO2 solubility outside of the range of the CO2 tables "
+                                   "is not the one at the closest valid point");
+        if (rsStatus.ok() != (elemIdx == 0))
+            throw std::logic_error("Range violations of the CO2 solubility were not recorded");
+
+        Status densityStatus(Status::OutOfRangePolicy::Clamp);
+        if (b != brinePvt.inverseFormationVolumeFactor(/*regionIdx=*/0, T[elemIdx], p[elemIdx], Rs, densityStatus))
+            throw std::logic_error("Saturated brine density does not use the clamped CO2 solubility");
+    }
+
+    if (status.ok()
+        || status.violations().front().elementIdx != 1
+        || status.violations().back().elementIdx != 2
+        || status.violations().front().tableId != 0)
+        throw std::logic_error("Failed evaluations of the CO2 solubility were not recorded");
+}
+
 template <class Scalar>
 inline void testAll()
 {
@@ -182,6 +376,10 @@ inline void testAll()
     typedef Opm::DenseAd::Evaluation<Scalar, 1> FooEval;
     ensurePvtApi<Scalar>(brinePvt, co2Pvt);
     ensurePvtApi<FooEval>(brinePvt, co2Pvt);
+
+    testSolubilityTable<Scalar>();
+    testNoThrowDensity<Scalar>();
+    testNoThrowSaturatedDensity<Scalar>();
 }
 
 
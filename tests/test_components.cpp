@@ -63,6 +63,8 @@ namespace ComponentsTest {
 
 #include <dune/common/parallel/mpihelper.hh>
 
+#include <type_traits>
+
 template <class Scalar, class Evaluation>
 void testSimpleH2O()
 {
@@ -93,6 +95,59 @@ void testSimpleH2O()
     }
 }
 
+template <class Scalar, class Evaluation>
+void testH2OProperties()
+{
+    // make sure that the fused evaluation of the IAPWS equations yields the
+    // same as the individual methods of the H2O component
+    typedef Opm::H2O<Scalar> H2O;
+
+    // below the vapor pressure (liquid) or above it (gas) the individual
+    // methods regularize using finite differences, which are not meaningful
+    // with single precision
+    bool checkRegularized = std::is_same<Scalar, double>::value;
+    Scalar tol = std::is_same<Scalar, double>::value ? 1e-8 : 1e-4;
+    Scalar tolRegularized = 1e-5;
+
+    auto check = [](const Evaluation& fused, const Evaluation& individual, Scalar tol, const char* what) {
+        Scalar delta = std::abs(Opm::scalarValue(fused) - Opm::scalarValue(individual));
+        if (delta > tol*std::abs(Opm::scalarValue(individual)))
+            throw std::logic_error(std::string("oops: the fused IAPWS evaluation of the ")+what
+                                   +" deviates from the individual one");
+    };
+
+    for (int iT = 0; iT < 30; ++iT) {
+        Evaluation T = 280.0 + 10.0*iT;
+        Scalar pv = Opm::scalarValue(H2O::vaporPressure(T));
+        for (int iP = 0; iP < 28; ++iP) {
+            Evaluation p = 1e3*std::pow(1.5, iP);
+            Evaluation rho, h, u, cp;
+
+            bool isRegularized = p < pv;
+            if (!isRegularized || checkRegularized) {
+                Scalar t = isRegularized ? tolRegularized : tol;
+                H2O::liquidProperties(T, p, rho, h, u, cp);
+                check(rho, H2O::liquidDensity(T, p), t, "liquid density");
+                check(h, H2O::liquidEnthalpy(T, p), t, "liquid enthalpy");
+                check(cp, H2O::liquidHeatCapacity(T, p), t, "liquid heat capacity");
+                if (!isRegularized)
+                    check(u, H2O::liquidInternalEnergy(T, p), t, "liquid internal energy");
+            }
+
+            isRegularized = p > pv;
+            if (!isRegularized || checkRegularized) {
+                Scalar t = isRegularized ? tolRegularized : tol;
+                H2O::gasProperties(T, p, rho, h, u, cp);
+                check(rho, H2O::gasDensity(T, p), t, "gas density");
+                check(h, H2O::gasEnthalpy(T, p), t, "gas enthalpy");
+                check(cp, H2O::gasHeatCapacity(T, p), t, "gas heat capacity");
+                if (!isRegularized)
+                    check(u, H2O::gasInternalEnergy(T, p), t, "gas internal energy");
+            }
+        }
+    }
+}
+
 template <class Scalar, class Evaluation>
 void testAllComponents()
 {
@@ -123,6 +178,8 @@ inline void testAll()
     testAllComponents<Scalar, Scalar>();
     testAllComponents<Scalar, Evaluation>();
     testSimpleH2O<Scalar, Evaluation>();
+    testH2OProperties<Scalar, Scalar>();
+    testH2OProperties<Scalar, Evaluation>();
 
 }
 
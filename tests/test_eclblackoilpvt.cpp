@@ -54,6 +54,9 @@
 
 #include <dune/common/parallel/mpihelper.hh>
 
+#include <atomic>
+#include <thread>
+
 // values of strings based on the first SPE1 test case of opm-data.  note that in the
 // real world it does not make much sense to specify a fluid phase using more than a
 // single keyword, but for a unit test, this saves a lot of boiler-plate code.
@@ -132,6 +135,66 @@ static const char* deckString1 =
     "/\n"
     "\n";
 
+// a deck with three PVTO regions for the tests of lazily initialized live oil
+static const char* pvtoDeckString =
+    "RUNSPEC\n"
+    "\n"
+    "DIMENS\n"
+    "   1 1 1 /\n"
+    "\n"
+    "TABDIMS\n"
+    " * 3 /\n"
+    "\n"
+    "OIL\n"
+    "GAS\n"
+    "\n"
+    "DISGAS\n"
+    "\n"
+    "METRIC\n"
+    "\n"
+    "GRID\n"
+    "\n"
+    "DX\n"
+    "   1000 /\n"
+    "DY\n"
+    "   1000 /\n"
+    "DZ\n"
+    "   20 /\n"
+    "\n"
+    "TOPS\n"
+    "   1234 /\n"
+    "\n"
+    "PORO\n"
+    "   0.15 /\n"
+    "PROPS\n"
+    "\n"
+    "DENSITY\n"
+    "      859.5  1033.0    0.854  /\n"
+    "      860.04 1033.0    0.853  /\n"
+    "      861.2  1033.0    0.852  /\n"
+    "\n"
+    "PVTO\n"
+    "-- PVT region 1 --\n"
+    "-- RS      PRESSURE   BO      VISCOSITY\n"
+    "   20.0    40.0       1.10    1.20\n"
+    "           80.0       1.08    1.25 /\n"
+    "   50.0    100.0      1.18    1.00\n"
+    "           150.0      1.15    1.05 /\n"
+    "/\n"
+    "-- PVT region 2 --\n"
+    "   25.0    45.0       1.12    1.10\n"
+    "           90.0       1.10    1.15 /\n"
+    "   60.0    110.0      1.20    0.90\n"
+    "           160.0      1.17    0.95 /\n"
+    "/\n"
+    "-- PVT region 3 --\n"
+    "   30.0    50.0       1.14    1.00\n"
+    "           95.0       1.12    1.05 /\n"
+    "   70.0    120.0      1.22    0.80\n"
+    "           170.0      1.19    0.85 /\n"
+    "/\n"
+    "\n";
+
 template <class Evaluation, class OilPvt, class GasPvt, class WaterPvt>
 void ensurePvtApi(const OilPvt& oilPvt, const GasPvt& gasPvt, const WaterPvt& waterPvt)
 {
@@ -221,6 +284,104 @@ void ensurePvtApi(const OilPvt& oilPvt, const GasPvt& gasPvt, const WaterPvt& wa
     }
 }
 
+// check that lazily initialized live oil yields the same results as eagerly
+// initialized one, that it only builds the tables of the PVT regions which are actually
+// used and that a region can be initialized concurrently by several threads
+template <class Scalar>
+void testLazyLiveOilPvt()
+{
+    Opm::Parser parser;
+    auto python = std::make_shared<Opm::Python>();
+
+    auto deck = parser.parseString(pvtoDeckString);
+    Opm::EclipseState eclState(deck);
+    Opm::Schedule schedule(deck, eclState, python);
+
+    Opm::LiveOilPvt<Scalar> eagerPvt;
+    eagerPvt.initFromState(eclState, schedule);
+
+    Opm::LiveOilPvt<Scalar> lazyPvt;
+    lazyPvt.initFromState(eclState, schedule, /*lazyInit=*/true);
+
+    for (unsigned regionIdx = 0; regionIdx < 3; ++regionIdx) {
+        if (!eagerPvt.regionIsInitialized(regionIdx))
+            throw std::logic_error("Eagerly initialized live oil must build the tables of all regions");
+        if (lazyPvt.regionIsInitialized(regionIdx))
+            throw std::logic_error("Lazily initialized live oil must not build any tables up front");
+    }
+
+    const Scalar T = 273.15 + 50.0;
+    const Scalar p = 120e5;
+    const Scalar Rs = 40.0;
+
+    // all threads start using the first region at the same time
+    const unsigned numThreads = 8;
+    std::vector<Scalar> invB(numThreads);
+    std::vector<Scalar> mu(numThreads);
+    std::atomic<unsigned> numStarted(0);
+    std::vector<std::thread> threads;
+    for (unsigned threadIdx = 0; threadIdx < numThreads; ++threadIdx) {
+        threads.emplace_back([&, threadIdx]()
+                             {
+                                 ++numStarted;
+                                 while (numStarted < numThreads)
+                                     std::this_thread::yield();
+
+                                 invB[threadIdx] = lazyPvt.inverseFormationVolumeFactor(/*regionIdx=*/0, T, p, Rs);
+                                 mu[threadIdx] = lazyPvt.viscosity(/*regionIdx=*/0, T, p, Rs);
+                             });
+    }
+    for (auto& thread : threads)
+        thread.join();
+
+    const Scalar eagerInvB = eagerPvt.inverseFormationVolumeFactor(/*regionIdx=*/0, T, p, Rs);
+    const Scalar eagerMu = eagerPvt.viscosity(/*regionIdx=*/0, T, p, Rs);
+    for (unsigned threadIdx = 0; threadIdx < numThreads; ++threadIdx)
+        if (invB[threadIdx] != eagerInvB || mu[threadIdx] != eagerMu)
+            throw std::logic_error("Concurrently initialized live oil differs from eagerly initialized one");
+
+    // the saturated quantities of the third region
+    if (lazyPvt.saturatedInverseFormationVolumeFactor(/*regionIdx=*/2, T, p)
+        != eagerPvt.saturatedInverseFormationVolumeFactor(/*regionIdx=*/2, T, p)
+        || lazyPvt.saturatedViscosity(/*regionIdx=*/2, T, p)
+        != eagerPvt.saturatedViscosity(/*regionIdx=*/2, T, p)
+        || lazyPvt.saturatedGasDissolutionFactor(/*regionIdx=*/2, T, p)
+        != eagerPvt.saturatedGasDissolutionFactor(/*regionIdx=*/2, T, p)
+        || lazyPvt.saturationPressure(/*regionIdx=*/2, T, Rs)
+        != eagerPvt.saturationPressure(/*regionIdx=*/2, T, Rs))
+        throw std::logic_error("Lazily initialized live oil differs from eagerly initialized one");
+
+    if (!lazyPvt.regionIsInitialized(0)
+        || lazyPvt.regionIsInitialized(1)
+        || !lazyPvt.regionIsInitialized(2))
+        throw std::logic_error("Lazily initialized live oil must only build the tables of the used regions");
+
+    // accessing the tables of all regions completes the object
+    if (!(lazyPvt == eagerPvt))
+        throw std::logic_error("Completed lazily initialized live oil differs from eagerly initialized one");
+
+    if (!lazyPvt.regionIsInitialized(1))
+        throw std::logic_error("Accessing the tables of lazily initialized live oil must build all regions");
+
+    // a lazily initialized object which uses the packed tables of another one does not
+    // need to build its own tables
+    eagerPvt.packTables();
+    Opm::LiveOilPvt<Scalar> attachedPvt;
+    attachedPvt.initFromState(eclState, schedule, /*lazyInit=*/true);
+    attachedPvt.attachTableImage(eagerPvt.tableImage(), eagerPvt.tableImageSize());
+    for (unsigned regionIdx = 0; regionIdx < 3; ++regionIdx) {
+        if (attachedPvt.inverseFormationVolumeFactor(regionIdx, T, p, Rs)
+            != eagerPvt.inverseFormationVolumeFactor(regionIdx, T, p, Rs)
+            || attachedPvt.viscosity(regionIdx, T, p, Rs)
+            != eagerPvt.viscosity(regionIdx, T, p, Rs)
+            || attachedPvt.saturationPressure(regionIdx, T, Rs)
+            != eagerPvt.saturationPressure(regionIdx, T, Rs))
+            throw std::logic_error("Live oil attached to packed tables differs from the original");
+        if (attachedPvt.regionIsInitialized(regionIdx))
+            throw std::logic_error("Live oil attached to packed tables must not build its own tables");
+    }
+}
+
 template <class Scalar>
 inline void testAll()
 {
@@ -284,6 +445,8 @@ inline void testAll()
     typedef Opm::DenseAd::Evaluation<Scalar, 1> FooEval;
     ensurePvtApi<Scalar>(oilPvt, gasPvt, waterPvt);
     ensurePvtApi<FooEval>(oilPvt, gasPvt, waterPvt);
+
+    testLazyLiveOilPvt<Scalar>();
 }
 
 
@@ -35,6 +35,9 @@
 #endif
 
 #include <opm/material/fluidmatrixinteractions/EclMaterialLawManager.hpp>
+#include <opm/material/thermal/EclThermalLawManager.hpp>
+#include <opm/material/fluidsystems/BlackOilFluidSystem.hpp>
+#include <opm/material/common/BinarySerializer.hpp>
 #include <opm/material/fluidstates/SimpleModularFluidState.hpp>
 
 #include <opm/parser/eclipse/Parser/Parser.hpp>
@@ -44,6 +47,10 @@
 
 #include <dune/common/parallel/mpihelper.hh>
 
+#include <algorithm>
+#include <thread>
+#include <type_traits>
+
 // values of strings taken from the SPE1 test case1 of opm-data
 static const char* fam1DeckString =
     "RUNSPEC\n"
@@ -114,6 +121,136 @@ static const char* fam1DeckString =
     "0.85   0.98    0.000   0\n"
     "0.88   0.984   0.000   0 /\n";
 
+// a deck with a non-vanishing oil-water capillary pressure for the tests of SWATINIT
+static const char* swatinitDeckString =
+    "RUNSPEC\n"
+    "\n"
+    "DIMENS\n"
+    "   3 1 1 /\n"
+    "\n"
+    "TABDIMS\n"
+    "/\n"
+    "\n"
+    "OIL\n"
+    "GAS\n"
+    "WATER\n"
+    "\n"
+    "DISGAS\n"
+    "\n"
+    "FIELD\n"
+    "\n"
+    "GRID\n"
+    "\n"
+    "DX\n"
+    "   3*1000 /\n"
+    "DY\n"
+    "   3*1000 /\n"
+    "DZ\n"
+    "   3*20 /\n"
+    "\n"
+    "TOPS\n"
+    "   3*8325 /\n"
+    "\n"
+    "PORO\n"
+    "  3*0.15 /\n"
+    "PROPS\n"
+    "\n"
+    "SWOF\n"
+    "0.12   0               1       4.0\n"
+    "0.24   0.000000186     0.997   3.0\n"
+    "0.36   7.43801652892562E-007   0.7     2.0\n"
+    "0.48   1.67355371900826E-006   0.2     1.5\n"
+    "0.6    2.97520661157025E-006   0.021   1.0\n"
+    "0.72   4.64876033057851E-006   0.001   0.5\n"
+    "0.84   6.69421487603306E-006   0       0.2\n"
+    "1      0.984           0       0 /\n"
+    "\n"
+    "\n"
+    "SGOF\n"
+    "0  0   1   0\n"
+    "0.001  0   1   0\n"
+    "0.02   0   0.997   0\n"
+    "0.05   0.005   0.980   0\n"
+    "0.12   0.025   0.700   0\n"
+    "0.2    0.075   0.350   0\n"
+    "0.25   0.125   0.200   0\n"
+    "0.3    0.190   0.090   0\n"
+    "0.4    0.410   0.021   0\n"
+    "0.45   0.60    0.010   0\n"
+    "0.5    0.72    0.001   0\n"
+    "0.6    0.87    0.0001  0\n"
+    "0.7    0.94    0.000   0\n"
+    "0.85   0.98    0.000   0\n"
+    "0.88   0.984   0.000   0 /\n";
+
+// a deck with three saturation regions of which the second one is not used by any
+// element
+static const char* satnumDeckString =
+    "RUNSPEC\n"
+    "\n"
+    "DIMENS\n"
+    "   3 1 1 /\n"
+    "\n"
+    "TABDIMS\n"
+    "   3 /\n"
+    "\n"
+    "OIL\n"
+    "GAS\n"
+    "WATER\n"
+    "\n"
+    "DISGAS\n"
+    "\n"
+    "FIELD\n"
+    "\n"
+    "GRID\n"
+    "\n"
+    "DX\n"
+    "   3*1000 /\n"
+    "DY\n"
+    "   3*1000 /\n"
+    "DZ\n"
+    "   3*20 /\n"
+    "\n"
+    "TOPS\n"
+    "   3*8325 /\n"
+    "\n"
+    "PORO\n"
+    "  3*0.15 /\n"
+    "PROPS\n"
+    "\n"
+    "SWOF\n"
+    "0.1    0       1       2.0\n"
+    "0.4    0.1     0.5     1.0\n"
+    "0.7    0.4     0.1     0.5\n"
+    "1      1       0       0 /\n"
+    "0.2    0       1       3.0\n"
+    "0.5    0.15    0.4     1.5\n"
+    "0.8    0.5     0.05    0.2\n"
+    "1      1       0       0 /\n"
+    "0.15   0       1       1.0\n"
+    "0.45   0.2     0.6     0.6\n"
+    "0.75   0.6     0.2     0.3\n"
+    "1      1       0       0 /\n"
+    "\n"
+    "SGOF\n"
+    "0      0       1       0\n"
+    "0.3    0.1     0.5     0\n"
+    "0.6    0.4     0.1     0\n"
+    "0.9    0.9     0       0 /\n"
+    "0      0       1       0\n"
+    "0.3    0.15    0.4     0\n"
+    "0.6    0.5     0.05    0\n"
+    "0.8    0.8     0       0 /\n"
+    "0      0       1       0\n"
+    "0.25   0.1     0.6     0\n"
+    "0.5    0.3     0.2     0\n"
+    "0.85   0.85    0       0 /\n"
+    "\n"
+    "REGIONS\n"
+    "\n"
+    "SATNUM\n"
+    "   1 3 1 /\n";
+
 static const char* fam2DeckString =
     "RUNSPEC\n"
     "\n"
@@ -290,6 +427,134 @@ static const char* hysterDeckString =
     "0.85   0.98    0.000   0\n"
     "0.88   0.984   0.000   0 /\n";
 
+// the same as hysterDeckString, but the upper half of the elements uses different
+// imbibition curves
+static const char* hysterImbnumDeckString =
+    "RUNSPEC\n"
+    "\n"
+    "DIMENS\n"
+    "   10 10 3 /\n"
+    "\n"
+    "TABDIMS\n"
+    "2 /\n"
+    "\n"
+    "OIL\n"
+    "GAS\n"
+    "WATER\n"
+    "\n"
+    "DISGAS\n"
+    "\n"
+    "FIELD\n"
+    "\n"
+    "GRID\n"
+    "\n"
+    "DX\n"
+    "       300*1000 /\n"
+    "DY\n"
+    "   300*1000 /\n"
+    "DZ\n"
+    "   100*20 100*30 100*50 /\n"
+    "\n"
+    "TOPS\n"
+    "   100*8325 /\n"
+    "PORO\n"
+    "  300*0.15 /\n"
+    "\n"
+    "\n"
+    "EHYSTR\n"
+    "0.1   0  0.1 1* KR /\n"
+    "\n"
+    "SATOPTS\n"
+    "HYSTER /\n"
+    "\n"
+    "PROPS\n"
+    "\n"
+    "SWOF\n"
+    "0.12   0               1   0\n"
+    "0.18   4.64876033057851E-008   1   0\n"
+    "0.24   0.000000186     0.997   0\n"
+    "0.3    4.18388429752066E-007   0.98    0\n"
+    "0.36   7.43801652892562E-007   0.7 0\n"
+    "0.42   1.16219008264463E-006   0.35    0\n"
+    "0.48   1.67355371900826E-006   0.2 0\n"
+    "0.54   2.27789256198347E-006   0.09    0\n"
+    "0.6    2.97520661157025E-006   0.021   0\n"
+    "0.66   3.7654958677686E-006    0.01    0\n"
+    "0.72   4.64876033057851E-006   0.001   0\n"
+    "0.78   0.000005625     0.0001  0\n"
+    "0.84   6.69421487603306E-006   0   0\n"
+    "0.91   8.05914256198347E-006   0   0\n"
+    "1      0.984           0   0 /\n"
+    "0.12   0       1       0\n"
+    "0.3    0.01    0.7     0\n"
+    "0.6    0.1     0.15    0\n"
+    "0.8    0.3     0       0\n"
+    "1      1       0       0 /\n"
+    "\n"
+    "\n"
+    "SGOF\n"
+    "0  0   1   0\n"
+    "0.001  0   1   0\n"
+    "0.02   0   0.997   0\n"
+    "0.05   0.005   0.980   0\n"
+    "0.12   0.025   0.700   0\n"
+    "0.2    0.075   0.350   0\n"
+    "0.25   0.125   0.200   0\n"
+    "0.3    0.190   0.090   0\n"
+    "0.4    0.410   0.021   0\n"
+    "0.45   0.60    0.010   0\n"
+    "0.5    0.72    0.001   0\n"
+    "0.6    0.87    0.0001  0\n"
+    "0.7    0.94    0.000   0\n"
+    "0.85   0.98    0.000   0\n"
+    "0.88   0.984   0.000   0 /\n"
+    "0      0       1       0\n"
+    "0.1    0       0.8     0\n"
+    "0.4    0.2     0.1     0\n"
+    "0.88   0.9     0       0 /\n"
+    "\n"
+    "REGIONS\n"
+    "\n"
+    "IMBNUM\n"
+    "   150*1 150*2 /\n";
+
+static const char* thermalDeckString =
+    "RUNSPEC\n"
+    "\n"
+    "DIMENS\n"
+    "   3 3 1 /\n"
+    "\n"
+    "OIL\n"
+    "GAS\n"
+    "WATER\n"
+    "\n"
+    "THERMAL\n"
+    "\n"
+    "GRID\n"
+    "\n"
+    "DX\n"
+    "   9*1000 /\n"
+    "DY\n"
+    "   9*1000 /\n"
+    "DZ\n"
+    "   9*20 /\n"
+    "\n"
+    "TOPS\n"
+    "   9*8325 /\n"
+    "PORO\n"
+    "   9*0.15 /\n"
+    "\n"
+    "THCONR\n"
+    "   1.1 1.2 1.3 1.4 1.5 1.6 1.7 1.8 1.9 /\n"
+    "\n"
+    "PROPS\n"
+    "\n"
+    "HEATCR\n"
+    "   2.1e3 2.2e3 2.3e3 2.4e3 2.5e3 2.6e3 2.7e3 2.8e3 2.9e3 /\n"
+    "\n"
+    "HEATCRT\n"
+    "   9*1.0 /\n";
+
 static const char* fam1DeckStringGasOil =
     "RUNSPEC\n"
     "\n"
@@ -411,6 +676,224 @@ static const char* fam2DeckStringGasOil =
     "0.999  1       \n"
     "1.0    1       \n /\n";
 
+// make sure that a material law manager which uses the policies that are selected for
+// a deck produces the same results as one which queries the configuration at runtime
+template <class MaterialTraits, class FluidState, class StaticManager>
+void checkStaticPolicyManager(const Opm::EclipseState& eclState, size_t numElems)
+{
+    typedef typename MaterialTraits::Scalar Scalar;
+    typedef Opm::EclMaterialLawManager<MaterialTraits> DynamicManager;
+    typedef typename DynamicManager::MaterialLaw DynamicLaw;
+    typedef typename StaticManager::MaterialLaw StaticLaw;
+    enum { numPhases = MaterialTraits::numPhases };
+    enum { waterPhaseIdx = MaterialTraits::wettingPhaseIdx };
+    enum { oilPhaseIdx = MaterialTraits::nonWettingPhaseIdx };
+    enum { gasPhaseIdx = MaterialTraits::gasPhaseIdx };
+
+    DynamicManager dynamicManager;
+    dynamicManager.initFromState(eclState);
+    dynamicManager.initParamsForElements(eclState, numElems);
+
+    StaticManager staticManager;
+    staticManager.initFromState(eclState);
+    staticManager.initParamsForElements(eclState, numElems);
+
+    for (unsigned elemIdx = 0; elemIdx < numElems; ++ elemIdx) {
+        if (dynamicManager.enableHysteresis()) {
+            // move away from the main drainage curves
+            FluidState fs;
+            fs.setSaturation(waterPhaseIdx, Scalar(0.3));
+            fs.setSaturation(gasPhaseIdx, Scalar(0.2));
+            fs.setSaturation(oilPhaseIdx, Scalar(0.5));
+            dynamicManager.updateHysteresis(fs, elemIdx);
+            staticManager.updateHysteresis(fs, elemIdx);
+        }
+
+        for (int i = 0; i <= 10; ++ i) {
+            FluidState fs;
+            fs.setSaturation(waterPhaseIdx, Scalar(0.8*i/10));
+            fs.setSaturation(gasPhaseIdx, Scalar(0.2*(10 - i)/10));
+            fs.setSaturation(oilPhaseIdx, 1 - fs.saturation(waterPhaseIdx) - fs.saturation(gasPhaseIdx));
+
+            Scalar pcDyn[numPhases], pcStat[numPhases];
+            Scalar krDyn[numPhases], krStat[numPhases];
+            DynamicLaw::capillaryPressures(pcDyn, dynamicManager.materialLawParams(elemIdx), fs);
+            StaticLaw::capillaryPressures(pcStat, staticManager.materialLawParams(elemIdx), fs);
+            DynamicLaw::relativePermeabilities(krDyn, dynamicManager.materialLawParams(elemIdx), fs);
+            StaticLaw::relativePermeabilities(krStat, staticManager.materialLawParams(elemIdx), fs);
+
+            for (unsigned phaseIdx = 0; phaseIdx < numPhases; ++ phaseIdx)
+                if (pcDyn[phaseIdx] != pcStat[phaseIdx] || krDyn[phaseIdx] != krStat[phaseIdx])
+                    throw std::logic_error("The policy selected for the deck is inconsistent "
+                                           "with the dynamic one");
+        }
+    }
+}
+
+template <class MaterialTraits, class FluidState>
+struct EpsPolicyManagerChecker
+{
+    template <class EpsPolicy>
+    void operator()(const EpsPolicy&)
+    {
+        typedef Opm::EclMaterialLawManager<MaterialTraits, EpsPolicy> StaticManager;
+
+        selectedStaticPolicy = !std::is_same<EpsPolicy, Opm::EclEpsDynamicPolicy>::value;
+        checkStaticPolicyManager<MaterialTraits, FluidState, StaticManager>(*eclState, numElems);
+    }
+
+    const Opm::EclipseState* eclState;
+    size_t numElems;
+    bool selectedStaticPolicy = false;
+};
+
+template <class MaterialTraits, class FluidState>
+struct HysteresisPolicyManagerChecker
+{
+    template <class HysteresisPolicy>
+    void operator()(const HysteresisPolicy&)
+    {
+        typedef Opm::EclMaterialLawManager<MaterialTraits,
+                                           Opm::EclEpsDynamicPolicy,
+                                           HysteresisPolicy> StaticManager;
+
+        selectedStaticPolicy = !std::is_same<HysteresisPolicy, Opm::EclHysteresisDynamicPolicy>::value;
+        checkStaticPolicyManager<MaterialTraits, FluidState, StaticManager>(*eclState, numElems);
+    }
+
+    const Opm::EclipseState* eclState;
+    size_t numElems;
+    bool selectedStaticPolicy = false;
+};
+
+// the parameters of the elements which are re-created by the threads that own them
+// must be the same as the ones which were created serially
+template <class MaterialTraits, class FluidState>
+void testFirstTouch(const Opm::Parser& parser)
+{
+    typedef typename MaterialTraits::Scalar Scalar;
+    typedef Opm::EclMaterialLawManager<MaterialTraits> MaterialLawManager;
+    typedef typename MaterialLawManager::MaterialLaw MaterialLaw;
+    typedef Opm::BlackOilFluidSystem<Scalar> FluidSystem;
+    typedef Opm::EclThermalLawManager<Scalar, FluidSystem> ThermalLawManager;
+
+    enum { numPhases = 3 };
+    enum { waterPhaseIdx = MaterialTraits::wettingPhaseIdx };
+    enum { oilPhaseIdx = MaterialTraits::nonWettingPhaseIdx };
+    enum { gasPhaseIdx = MaterialTraits::gasPhaseIdx };
+    const unsigned numThreads = 3;
+
+    // assign the elements round robin to the threads and let each thread re-create
+    // the parameters of its elements
+    auto firstTouch = [numThreads](auto& manager, size_t numElems) {
+        std::vector<unsigned> elementOwner(numElems);
+        for (unsigned elemIdx = 0; elemIdx < numElems; ++ elemIdx)
+            elementOwner[elemIdx] = elemIdx % numThreads;
+
+        std::vector<std::thread> threads;
+        for (unsigned threadIdx = 0; threadIdx < numThreads; ++ threadIdx)
+            threads.emplace_back([&manager, &elementOwner, threadIdx]() {
+                manager.firstTouchElementParams(elementOwner, threadIdx);
+            });
+        for (auto& thread : threads)
+            thread.join();
+    };
+
+    auto updateHysteresis = [](MaterialLawManager& manager, size_t numElems, Scalar Sw) {
+        for (unsigned elemIdx = 0; elemIdx < numElems; ++ elemIdx) {
+            FluidState fs;
+            fs.setSaturation(waterPhaseIdx, Sw);
+            fs.setSaturation(oilPhaseIdx, 1 - Sw - 0.1);
+            fs.setSaturation(gasPhaseIdx, 0.1);
+            manager.updateHysteresis(fs, elemIdx);
+        }
+    };
+
+    auto compareMaterialParams = [](const MaterialLawManager& serialManager,
+                                    const MaterialLawManager& touchedManager,
+                                    size_t numElems) {
+        for (unsigned elemIdx = 0; elemIdx < numElems; ++ elemIdx) {
+            const auto& serialParams = serialManager.materialLawParams(elemIdx);
+            const auto& touchedParams = touchedManager.materialLawParams(elemIdx);
+            if (Opm::serializeToBuffer(serialParams) != Opm::serializeToBuffer(touchedParams))
+                throw std::logic_error("The material parameters of element "+std::to_string(elemIdx)
+                                       +" were changed by the first-touch initialization");
+
+            for (int i = 0; i <= 10; ++ i) {
+                FluidState fs;
+                fs.setSaturation(waterPhaseIdx, Scalar(i)/10);
+                fs.setSaturation(oilPhaseIdx, 1 - Scalar(i)/10);
+                fs.setSaturation(gasPhaseIdx, 0);
+
+                Scalar pc[numPhases], pcTouched[numPhases];
+                Scalar kr[numPhases], krTouched[numPhases];
+                MaterialLaw::capillaryPressures(pc, serialParams, fs);
+                MaterialLaw::capillaryPressures(pcTouched, touchedParams, fs);
+                MaterialLaw::relativePermeabilities(kr, serialParams, fs);
+                MaterialLaw::relativePermeabilities(krTouched, touchedParams, fs);
+                for (unsigned phaseIdx = 0; phaseIdx < numPhases; ++ phaseIdx)
+                    if (pc[phaseIdx] != pcTouched[phaseIdx] || kr[phaseIdx] != krTouched[phaseIdx])
+                        throw std::logic_error("The material laws of element "+std::to_string(elemIdx)
+                                               +" were changed by the first-touch initialization");
+            }
+        }
+    };
+
+    // material laws including hysteresis: the copied elements must keep their
+    // hysteresis state and continue to update it like the original ones
+    {
+        const auto deck = parser.parseString(hysterDeckString);
+        const Opm::EclipseState eclState(deck);
+        size_t n = eclState.getInputGrid().getCartesianSize();
+
+        MaterialLawManager serialManager;
+        serialManager.initFromState(eclState);
+        serialManager.initParamsForElements(eclState, n);
+
+        MaterialLawManager touchedManager;
+        touchedManager.initFromState(eclState);
+        touchedManager.initParamsForElements(eclState, n);
+
+        updateHysteresis(serialManager, n, 0.3);
+        updateHysteresis(touchedManager, n, 0.3);
+
+        firstTouch(touchedManager, n);
+        compareMaterialParams(serialManager, touchedManager, n);
+
+        updateHysteresis(serialManager, n, 0.5);
+        updateHysteresis(touchedManager, n, 0.5);
+        compareMaterialParams(serialManager, touchedManager, n);
+    }
+
+    // element specific thermal parameters
+    {
+        const auto deck = parser.parseString(thermalDeckString);
+        const Opm::EclipseState eclState(deck);
+        size_t n = eclState.getInputGrid().getCartesianSize();
+
+        ThermalLawManager serialManager;
+        serialManager.initParamsForElements(eclState, n);
+
+        ThermalLawManager touchedManager;
+        touchedManager.initParamsForElements(eclState, n);
+        firstTouch(touchedManager, n);
+
+        for (unsigned elemIdx = 0; elemIdx < n; ++ elemIdx) {
+            if (Opm::serializeToBuffer(serialManager.solidEnergyLawParams(elemIdx))
+                != Opm::serializeToBuffer(touchedManager.solidEnergyLawParams(elemIdx))
+                || Opm::serializeToBuffer(serialManager.thermalConductionLawParams(elemIdx))
+                != Opm::serializeToBuffer(touchedManager.thermalConductionLawParams(elemIdx)))
+                throw std::logic_error("The thermal parameters of element "+std::to_string(elemIdx)
+                                       +" were changed by the first-touch initialization");
+        }
+
+        // the parameters must have been given by the deck for each element
+        if (Opm::serializeToBuffer(touchedManager.solidEnergyLawParams(0))
+            == Opm::serializeToBuffer(touchedManager.solidEnergyLawParams(1)))
+            throw std::logic_error("The thermal parameters are not element specific");
+    }
+}
+
 template <class Scalar>
 inline void testAll()
 {
@@ -438,6 +921,8 @@ inline void testAll()
 
     Opm::Parser parser;
 
+    testFirstTouch<MaterialTraits, FluidState>(parser);
+
     {
         typedef Opm::EclMaterialLawManager<MaterialTraits> MaterialLawManager;
         typedef typename MaterialLawManager::MaterialLaw MaterialLaw;
@@ -458,6 +943,209 @@ inline void testAll()
         if (materialLawManager.enableHysteresis())
             throw std::logic_error("Discrepancy between the deck and the EclMaterialLawManager");
 
+        // the deck does not specify cell specific end points and uses a single
+        // saturation region, so all elements must share the gas-oil and the oil-water
+        // records
+        if (materialLawManager.numUniqueScaledEpsPoints() != 2)
+            throw std::logic_error("Scaled end points which are identical were not shared");
+
+        // a manager which is loaded from its binary representation must yield the same
+        // results and share the same records as the original one
+        {
+            const auto& buffer = Opm::serializeToBuffer(materialLawManager);
+            MaterialLawManager loadedManager;
+            Opm::deserializeFromBuffer(loadedManager, buffer.data(), buffer.size());
+
+            if (loadedManager.numUniqueScaledEpsPoints() != 2
+                || &loadedManager.oilWaterScaledEpsInfoDrainage(0) != &loadedManager.oilWaterScaledEpsInfoDrainage(n - 1))
+                throw std::logic_error("Shared records were not restored by deserialization");
+
+            for (unsigned elemIdx = 0; elemIdx < n; ++ elemIdx) {
+                for (int i = 0; i <= 10; ++ i) {
+                    FluidState fs;
+                    fs.setSaturation(waterPhaseIdx, Scalar(i)/10);
+                    fs.setSaturation(oilPhaseIdx, 1 - Scalar(i)/10);
+                    fs.setSaturation(gasPhaseIdx, 0);
+
+                    Scalar pc[numPhases], pcLoaded[numPhases];
+                    Scalar kr[numPhases], krLoaded[numPhases];
+                    MaterialLaw::capillaryPressures(pc, materialLawManager.materialLawParams(elemIdx), fs);
+                    MaterialLaw::capillaryPressures(pcLoaded, loadedManager.materialLawParams(elemIdx), fs);
+                    MaterialLaw::relativePermeabilities(kr, materialLawManager.materialLawParams(elemIdx), fs);
+                    MaterialLaw::relativePermeabilities(krLoaded, loadedManager.materialLawParams(elemIdx), fs);
+
+                    for (unsigned phaseIdx = 0; phaseIdx < numPhases; ++ phaseIdx)
+                        if (pc[phaseIdx] != pcLoaded[phaseIdx] || kr[phaseIdx] != krLoaded[phaseIdx])
+                            throw std::logic_error("Deserialized material law manager differs from the original one");
+                }
+            }
+        }
+
+        // SWATINIT must only give the elements for which it modifies the end points
+        // their own copy, all other elements must continue to share theirs
+        {
+            const auto swatinitDeck = parser.parseString(swatinitDeckString);
+            const Opm::EclipseState swatinitEclState(swatinitDeck);
+
+            MaterialLawManager swatinitManager;
+            swatinitManager.initFromState(swatinitEclState);
+            swatinitManager.initParamsForElements(swatinitEclState, /*numElems=*/3);
+
+            if (swatinitManager.numUniqueScaledEpsPoints() != 2)
+                throw std::logic_error("Scaled end points which are identical were not shared");
+
+            const auto* sharedInfo = &swatinitManager.oilWaterScaledEpsInfoDrainage(0);
+            const auto* sharedPoints = &swatinitManager.sharedOilWaterScaledEpsPointsDrainage(0);
+            const Scalar origMaxPcow = sharedInfo->maxPcow;
+
+            // a negative capillary pressure does not modify any end points
+            swatinitManager.applySwatinit(/*elemIdx=*/0, /*pcow=*/-1.0, /*Sw=*/0.5);
+            for (unsigned elemIdx = 0; elemIdx < 3; ++ elemIdx)
+                if (&swatinitManager.oilWaterScaledEpsInfoDrainage(elemIdx) != sharedInfo
+                    || &swatinitManager.sharedOilWaterScaledEpsPointsDrainage(elemIdx) != sharedPoints)
+                    throw std::logic_error("SWATINIT copied end points which it did not modify");
+
+            // a capillary pressure which differs from the one of the table scales the
+            // maximum capillary pressure of the element
+            swatinitManager.applySwatinit(/*elemIdx=*/1, /*pcow=*/1e6, /*Sw=*/0.5);
+            if (&swatinitManager.oilWaterScaledEpsInfoDrainage(1) == sharedInfo
+                || &swatinitManager.sharedOilWaterScaledEpsPointsDrainage(1) == sharedPoints)
+                throw std::logic_error("SWATINIT modified end points which are shared");
+
+            if (swatinitManager.oilWaterScaledEpsInfoDrainage(1).maxPcow == origMaxPcow)
+                throw std::logic_error("SWATINIT did not scale the maximum capillary pressure");
+
+            for (unsigned elemIdx : {0u, 2u}) {
+                if (&swatinitManager.oilWaterScaledEpsInfoDrainage(elemIdx) != sharedInfo
+                    || &swatinitManager.sharedOilWaterScaledEpsPointsDrainage(elemIdx) != sharedPoints)
+                    throw std::logic_error("Elements which are not affected by SWATINIT do not share their end points anymore");
+
+                if (swatinitManager.oilWaterScaledEpsInfoDrainage(elemIdx).maxPcow != origMaxPcow)
+                    throw std::logic_error("SWATINIT modified the end points of other elements");
+            }
+
+            // the mutable accessor must give an element its own copy of the end points
+            // once, and subsequent calls must not copy them again
+            const Scalar origMaxPcnw = sharedPoints->maxPcnw();
+            auto& ownPoints = swatinitManager.oilWaterScaledEpsPointsDrainage(/*elemIdx=*/2);
+            if (&ownPoints == sharedPoints
+                || &swatinitManager.sharedOilWaterScaledEpsPointsDrainage(2) != &ownPoints
+                || &swatinitManager.oilWaterScaledEpsPointsDrainage(2) != &ownPoints)
+                throw std::logic_error("The mutable accessor does not give an element its own end points");
+
+            ownPoints.setMaxPcnw(origMaxPcnw + 1.0);
+            if (swatinitManager.sharedOilWaterScaledEpsPointsDrainage(0).maxPcnw() != origMaxPcnw
+                || swatinitManager.sharedOilWaterScaledEpsPointsDrainage(2).maxPcnw() != origMaxPcnw + 1.0)
+                throw std::logic_error("Modifying the end points of an element affected other elements");
+        }
+
+        // if the saturation function tables are read lazily, the tables of unused
+        // saturation regions must not be read, but all elements must exhibit the same
+        // material laws as with eagerly read tables
+        {
+            const auto satnumDeck = parser.parseString(satnumDeckString);
+            const Opm::EclipseState satnumEclState(satnumDeck);
+
+            MaterialLawManager eagerManager;
+            eagerManager.initFromState(satnumEclState);
+            eagerManager.initParamsForElements(satnumEclState, /*numElems=*/3);
+
+            MaterialLawManager lazyManager;
+            lazyManager.initFromState(satnumEclState);
+            lazyManager.initParamsForElements(satnumEclState, /*numElems=*/3, /*lazyTables=*/true);
+
+            for (unsigned satRegionIdx = 0; satRegionIdx < 3; ++ satRegionIdx) {
+                if (!eagerManager.satRegionIsInitialized(satRegionIdx))
+                    throw std::logic_error("Saturation region "+std::to_string(satRegionIdx)
+                                           +" was not read eagerly");
+
+                bool isUsed = satRegionIdx != 1;
+                if (lazyManager.satRegionIsInitialized(satRegionIdx) != isUsed)
+                    throw std::logic_error("Saturation region "+std::to_string(satRegionIdx)
+                                           +" was read lazily iff it is unused");
+            }
+
+            for (unsigned elemIdx = 0; elemIdx < 3; ++ elemIdx) {
+                if (lazyManager.satnumRegionIdx(elemIdx) != eagerManager.satnumRegionIdx(elemIdx))
+                    throw std::logic_error("The saturation regions of lazily and eagerly initialized managers differ");
+
+                for (int i = 0; i <= 10; ++ i) {
+                    for (int j = 0; j <= 10 - i; ++ j) {
+                        FluidState fs;
+                        fs.setSaturation(waterPhaseIdx, Scalar(i)/10);
+                        fs.setSaturation(gasPhaseIdx, Scalar(j)/10);
+                        fs.setSaturation(oilPhaseIdx, 1 - Scalar(i + j)/10);
+
+                        Scalar pcEager[numPhases], pcLazy[numPhases];
+                        Scalar krEager[numPhases], krLazy[numPhases];
+                        MaterialLaw::capillaryPressures(pcEager, eagerManager.materialLawParams(elemIdx), fs);
+                        MaterialLaw::capillaryPressures(pcLazy, lazyManager.materialLawParams(elemIdx), fs);
+                        MaterialLaw::relativePermeabilities(krEager, eagerManager.materialLawParams(elemIdx), fs);
+                        MaterialLaw::relativePermeabilities(krLazy, lazyManager.materialLawParams(elemIdx), fs);
+
+                        for (unsigned phaseIdx = 0; phaseIdx < numPhases; ++ phaseIdx)
+                            if (pcEager[phaseIdx] != pcLazy[phaseIdx] || krEager[phaseIdx] != krLazy[phaseIdx])
+                                throw std::logic_error("Lazily and eagerly initialized material law managers differ");
+                    }
+                }
+            }
+        }
+
+        // the manager must work with the most specialized endpoint scaling policy which
+        // is compatible with a deck and refuse to work with an incompatible one
+        for (const char* deckString : {fam1DeckString, hysterDeckString}) {
+            const auto policyDeck = parser.parseString(deckString);
+            const Opm::EclipseState policyEclState(policyDeck);
+
+            EpsPolicyManagerChecker<MaterialTraits, FluidState> checker;
+            checker.eclState = &policyEclState;
+            checker.numElems = n;
+            Opm::eclMaterialLawVisitEpsPolicy(policyEclState, checker);
+            if (!checker.selectedStaticPolicy)
+                throw std::logic_error("No static endpoint scaling policy was selected for a deck without end point scaling");
+
+            typedef Opm::EclEpsStaticPolicy<Opm::EclEpsSatScalingType::TwoPoint, false> IncompatiblePolicy;
+            Opm::EclMaterialLawManager<MaterialTraits, IncompatiblePolicy> incompatibleManager;
+            bool threw = false;
+            try {
+                incompatibleManager.initFromState(policyEclState);
+            }
+            catch (const std::runtime_error&) {
+                threw = true;
+            }
+            if (!threw)
+                throw std::logic_error("An incompatible endpoint scaling policy was accepted");
+        }
+
+        // the same applies to the hysteresis policy
+        for (const char* deckString : {fam1DeckString, hysterDeckString}) {
+            const auto policyDeck = parser.parseString(deckString);
+            const Opm::EclipseState policyEclState(policyDeck);
+
+            HysteresisPolicyManagerChecker<MaterialTraits, FluidState> checker;
+            checker.eclState = &policyEclState;
+            checker.numElems = n;
+            Opm::eclMaterialLawVisitHysteresisPolicy(policyEclState, checker);
+            if (!checker.selectedStaticPolicy)
+                throw std::logic_error("No static hysteresis policy was selected for a deck");
+
+            // the hysteresis deck uses Carlson's model with the drainage curve for the
+            // wetting phase
+            typedef Opm::EclHysteresisStaticPolicy<Opm::EclKrHysteresisType::CarlsonImbibitionKrw> IncompatiblePolicy;
+            Opm::EclMaterialLawManager<MaterialTraits,
+                                       Opm::EclEpsDynamicPolicy,
+                                       IncompatiblePolicy> incompatibleManager;
+            bool threw = false;
+            try {
+                incompatibleManager.initFromState(policyEclState);
+            }
+            catch (const std::runtime_error&) {
+                threw = true;
+            }
+            if (!threw)
+                throw std::logic_error("An incompatible hysteresis policy was accepted");
+        }
+
         {
             const auto fam2Deck = parser.parseString(fam2DeckString);
             const Opm::EclipseState fam2EclState(fam2Deck);
@@ -561,6 +1249,77 @@ inline void testAll()
                     }
                 }
             }
+
+            // the bulk update must agree with the flat hysteresis state and the
+            // state must be restorable
+            {
+                if (hysterMaterialLawManager.hysteresisState().size()
+                    != MaterialLawManager::numHysteresisStateValues*n)
+                    throw std::logic_error("Wrong size of the flat hysteresis state");
+
+                const std::vector<Scalar> savedState = hysterMaterialLawManager.hysteresisState();
+
+                std::vector<FluidState> fluidStates(n);
+                for (unsigned elemIdx = 0; elemIdx < n; ++ elemIdx) {
+                    fluidStates[elemIdx].setSaturation(waterPhaseIdx, 0.2);
+                    fluidStates[elemIdx].setSaturation(oilPhaseIdx, 0.7);
+                    fluidStates[elemIdx].setSaturation(gasPhaseIdx, 0.1);
+                }
+                // the imbibition curves are the drainage curves, so the hysteresis does
+                // not have any effect
+                if (hysterMaterialLawManager.updateHysteresisAll(fluidStates) != 0)
+                    throw std::logic_error("The bulk update visited elements without hysteresis");
+
+                for (unsigned elemIdx = 0; elemIdx < n; ++ elemIdx) {
+                    Scalar pcSwMdc, krnSwMdc;
+                    hysterMaterialLawManager.oilWaterHysteresisParams(pcSwMdc, krnSwMdc, elemIdx);
+                    const Scalar* state =
+                        &hysterMaterialLawManager.hysteresisState()[MaterialLawManager::numHysteresisStateValues*elemIdx];
+                    if (state[0] != pcSwMdc || state[1] != krnSwMdc)
+                        throw std::logic_error("Flat hysteresis state is out of sync");
+                }
+
+                hysterMaterialLawManager.setHysteresisState(savedState);
+                if (hysterMaterialLawManager.hysteresisState() != savedState)
+                    throw std::logic_error("Restoring the hysteresis state failed");
+            }
+
+            // only the elements whose imbibition curves differ from the drainage ones
+            // must be visited by the bulk update
+            {
+                const auto imbnumDeck = parser.parseString(hysterImbnumDeckString);
+                const Opm::EclipseState imbnumEclState(imbnumDeck);
+
+                Opm::EclMaterialLawManager<MaterialTraits> imbnumMaterialLawManager;
+                imbnumMaterialLawManager.initFromState(imbnumEclState);
+                imbnumMaterialLawManager.initParamsForElements(imbnumEclState, n);
+
+                const std::vector<Scalar> savedState = imbnumMaterialLawManager.hysteresisState();
+
+                std::vector<FluidState> fluidStates(n);
+                for (unsigned elemIdx = 0; elemIdx < n; ++ elemIdx) {
+                    fluidStates[elemIdx].setSaturation(waterPhaseIdx, 0.2);
+                    fluidStates[elemIdx].setSaturation(oilPhaseIdx, 0.7);
+                    fluidStates[elemIdx].setSaturation(gasPhaseIdx, 0.1);
+                }
+                if (imbnumMaterialLawManager.updateHysteresisAll(fluidStates) != n/2)
+                    throw std::logic_error("The bulk update did not visit the elements with hysteresis");
+
+                for (unsigned elemIdx = 0; elemIdx < n; ++ elemIdx) {
+                    const Scalar* state =
+                        &imbnumMaterialLawManager.hysteresisState()[MaterialLawManager::numHysteresisStateValues*elemIdx];
+                    bool changed = !std::equal(state,
+                                               state + MaterialLawManager::numHysteresisStateValues,
+                                               &savedState[MaterialLawManager::numHysteresisStateValues*elemIdx]);
+                    if (changed != (elemIdx >= n/2))
+                        throw std::logic_error("The bulk update changed the wrong elements");
+
+                    Scalar pcSwMdc, krnSwMdc;
+                    imbnumMaterialLawManager.oilWaterHysteresisParams(pcSwMdc, krnSwMdc, elemIdx);
+                    if (state[0] != pcSwMdc || state[1] != krnSwMdc)
+                        throw std::logic_error("Flat hysteresis state is out of sync");
+                }
+            }
         }
 
         // Gas oil
@@ -0,0 +1,207 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+// vi: set et ts=4 sw=4 sts=4:
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+
+  Consult the COPYING file in the top-level source directory of this
+  module for the precise wording of the license and the list of
+  copyright holders.
+*/
+/*!
+ * \file
+ *
+ * \brief This is the unit test for the memory mapped FileBackedArray class.
+ *
+ * It creates a file, reopens it, streams it block-wise and checks that the errors are
+ * reported.
+ */
+#include "config.h"
+
+#include <opm/material/common/FileBackedArray.hpp>
+
+#include <stdexcept>
+#include <string>
+#include <cstdio>
+#include <cstddef>
+
+#include <unistd.h>
+
+struct Record
+{
+    double value;
+    unsigned index;
+};
+
+// make sure that calling a functor throws a given type of exception
+template <class Exception, class Functor>
+void checkThrows(const char* what, Functor&& functor)
+{
+    bool hasThrown = false;
+    try {
+        functor();
+    }
+    catch (const Exception&) {
+        hasThrown = true;
+    }
+    if (!hasThrown)
+        throw std::logic_error(std::string(what)+" did not throw");
+}
+
+void testCreateAndReopen(const std::string& fileName)
+{
+    const size_t numElements = 100000;
+
+    {
+        Opm::FileBackedArray<Record> array;
+        array.create(fileName, numElements);
+        if (!array.isOpen() || !array.isWritable() || array.size() != numElements)
+            throw std::logic_error("Wrong state of a newly created array");
+
+        Record* data = array.writableData();
+        for (size_t i = 0; i < numElements; ++i) {
+            if (data[i].value != 0.0 || data[i].index != 0)
+                throw std::logic_error("A newly created array is not zero initialized");
+            data[i].value = 0.5*i;
+            data[i].index = static_cast<unsigned>(i);
+        }
+        array.flush();
+    }
+
+    Opm::FileBackedArray<Record> array;
+    array.open(fileName);
+    if (!array.isOpen() || array.isWritable() || array.size() != numElements)
+        throw std::logic_error("Wrong state of a reopened array");
+
+    for (size_t i = 0; i < numElements; ++i)
+        if (array[i].value != 0.5*i || array[i].index != i)
+            throw std::logic_error("The objects of a reopened array differ from the written ones");
+
+    array.close();
+    if (array.isOpen() || array.size() != 0)
+        throw std::logic_error("Wrong state of a closed array");
+
+    // empty files cannot be mapped, but they are valid arrays
+    array.create(fileName, 0);
+    array.close();
+    array.open(fileName);
+    if (array.size() != 0)
+        throw std::logic_error("Wrong size of an empty array");
+}
+
+void testSweep(const std::string& fileName)
+{
+    const size_t numElements = 123457;
+    const size_t blockSize = 4096;
+
+    // the blocks must cover the array exactly once and in order. the objects which
+    // are modified within a block must survive its eviction
+    {
+        Opm::FileBackedArray<double> array;
+        array.create(fileName, numElements);
+        double* data = array.writableData();
+
+        size_t nextIdx = 0;
+        array.sweep(blockSize, [&nextIdx, data, blockSize, numElements](size_t beginIdx, size_t endIdx) {
+            if (beginIdx != nextIdx
+                || endIdx <= beginIdx
+                || endIdx - beginIdx > blockSize
+                || (endIdx - beginIdx < blockSize && endIdx != numElements))
+                throw std::logic_error("Wrong block of the sweep");
+
+            for (size_t i = beginIdx; i < endIdx; ++i)
+                data[i] = static_cast<double>(i);
+            nextIdx = endIdx;
+        });
+        if (nextIdx != numElements)
+            throw std::logic_error("The sweep did not cover the whole array");
+
+        for (size_t i = 0; i < numElements; ++i)
+            if (data[i] != static_cast<double>(i))
+                throw std::logic_error("Evicting a block lost modified objects");
+    }
+
+    Opm::FileBackedArray<double> array;
+    array.open(fileName);
+    double sum = 0.0;
+    array.sweep(blockSize, [&array, &sum](size_t beginIdx, size_t endIdx) {
+        for (size_t i = beginIdx; i < endIdx; ++i)
+            sum += array[i];
+    });
+    if (sum != 0.5*static_cast<double>(numElements)*static_cast<double>(numElements - 1))
+        throw std::logic_error("Streaming a reopened array gives wrong objects");
+
+    // prefetching and evicting ranges which exceed the array are harmless
+    array.prefetch(numElements - 10, 2*numElements);
+    array.evict(numElements/2, 2*numElements);
+    array.evict(numElements, numElements + 1);
+    if (array[numElements - 1] != static_cast<double>(numElements - 1))
+        throw std::logic_error("Evicting a range lost objects");
+}
+
+void testErrors(const std::string& fileName)
+{
+    Opm::FileBackedArray<double> array;
+
+    checkThrows<std::runtime_error>("Opening a file which does not exist", [&array]() {
+        array.open("this/directory/does/not/exist/array.dat");
+    });
+    checkThrows<std::runtime_error>("Creating a file in a directory which does not exist", [&array]() {
+        array.create("this/directory/does/not/exist/array.dat", 10);
+    });
+    if (array.isOpen())
+        throw std::logic_error("A failed operation left the array open");
+
+    // the size of the file must be a multiple of the size of the objects
+    {
+        Opm::FileBackedArray<char> charArray;
+        charArray.create(fileName, sizeof(double) + 1);
+    }
+    checkThrows<std::runtime_error>("Opening a file of the wrong size", [&array, &fileName]() {
+        array.open(fileName);
+    });
+
+    array.create(fileName, 10);
+    array.close();
+    array.open(fileName);
+    checkThrows<std::logic_error>("Writing to a read-only array", [&array]() {
+        array.writableData();
+    });
+    checkThrows<std::logic_error>("Sweeping with an empty block size", [&array]() {
+        array.sweep(0, [](size_t, size_t) {});
+    });
+}
+
+int main()
+{
+    // memory mapped files are not supported everywhere
+    if (!Opm::FileBackedArray<double>::isSupported())
+        return 0;
+
+    const std::string fileName = "test_filebackedarray_"+std::to_string(getpid())+".dat";
+
+    try {
+        testCreateAndReopen(fileName);
+        testSweep(fileName);
+        testErrors(fileName);
+    }
+    catch (...) {
+        std::remove(fileName.c_str());
+        throw;
+    }
+    std::remove(fileName.c_str());
+
+    return 0;
+}
@@ -71,6 +71,11 @@
 
 #include <dune/common/parallel/mpihelper.hh>
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+
 // this function makes sure that a capillary pressure law adheres to
 // the generic programming interface for such laws. This API _must_ be
 // implemented by all capillary pressure laws. If there are no _very_
@@ -257,6 +262,497 @@ void testThreePhaseSatApi()
 {
 }
 
+// make sure that all endpoint scaling policies which are compatible with a
+// configuration produce the same results as the policy which queries the configuration
+// at runtime
+template <class Scalar, class TwoPhaseTraits>
+struct EclEpsPolicyChecker
+{
+    typedef Opm::BrooksCorey<TwoPhaseTraits> RawMaterialLaw;
+    typedef Opm::EclEpsTwoPhaseLawParams<RawMaterialLaw> Params;
+
+    template <class Policy>
+    void operator()(const Policy&)
+    {
+        typedef Opm::EclEpsTwoPhaseLaw<RawMaterialLaw> DynamicLaw;
+        typedef Opm::EclEpsTwoPhaseLaw<RawMaterialLaw, Params, Policy> StaticLaw;
+
+        if (!Policy::isCompatible(params->config()))
+            throw std::logic_error("Selected an incompatible endpoint scaling policy");
+
+        // stay within the scaled saturation range so that the unscaled saturations
+        // are valid for the Brooks-Corey law
+        for (int i = 20; i <= 80; ++i) {
+            Scalar Sw = Scalar(i)/100;
+            Scalar pcDyn = DynamicLaw::twoPhaseSatPcnw(*params, Sw);
+            Scalar pcStat = StaticLaw::twoPhaseSatPcnw(*params, Sw);
+            Scalar krwDyn = DynamicLaw::twoPhaseSatKrw(*params, Sw);
+            Scalar krwStat = StaticLaw::twoPhaseSatKrw(*params, Sw);
+            Scalar krnDyn = DynamicLaw::twoPhaseSatKrn(*params, Sw);
+            Scalar krnStat = StaticLaw::twoPhaseSatKrn(*params, Sw);
+
+            if (pcDyn != pcStat || krwDyn != krwStat || krnDyn != krnStat)
+                throw std::logic_error("Static endpoint scaling policy is inconsistent "
+                                       "with the dynamic one");
+        }
+    }
+
+    template <Opm::EclEpsSatScalingType satScalingType, bool enableVerticalScaling>
+    void checkIfCompatible()
+    {
+        typedef Opm::EclEpsStaticPolicy<satScalingType, enableVerticalScaling> Policy;
+        if (!Policy::isCompatible(params->config()))
+            return;
+
+        (*this)(Policy());
+        ++ numCompatible;
+    }
+
+    const Params* params;
+    int numCompatible = 0;
+};
+
+template <class Scalar, class TwoPhaseTraits>
+void testEclEpsPolicies()
+{
+    typedef EclEpsPolicyChecker<Scalar, TwoPhaseTraits> Checker;
+    typedef typename Checker::RawMaterialLaw::Params RawParams;
+    typedef typename Checker::Params::ScalingPoints ScalingPoints;
+
+    auto rawParams = std::make_shared<RawParams>();
+    rawParams->setEntryPressure(1e4);
+    rawParams->setLambda(2.0);
+    rawParams->finalize();
+
+    auto unscaledPoints = std::make_shared<ScalingPoints>();
+    auto scaledPoints = std::make_shared<ScalingPoints>();
+    for (unsigned pointIdx = 0; pointIdx < 3; ++pointIdx) {
+        unscaledPoints->setSaturationPcPoint(pointIdx, Scalar(0.1 + 0.4*pointIdx));
+        unscaledPoints->setSaturationKrwPoint(pointIdx, Scalar(0.1 + 0.4*pointIdx));
+        unscaledPoints->setSaturationKrnPoint(pointIdx, Scalar(0.1 + 0.4*pointIdx));
+        scaledPoints->setSaturationPcPoint(pointIdx, Scalar(0.2 + 0.3*pointIdx));
+        scaledPoints->setSaturationKrwPoint(pointIdx, Scalar(0.2 + 0.3*pointIdx));
+        scaledPoints->setSaturationKrnPoint(pointIdx, Scalar(0.15 + 0.35*pointIdx));
+    }
+    unscaledPoints->setMaxPcnw(1e5);
+    unscaledPoints->setMaxKrw(1.0);
+    unscaledPoints->setMaxKrn(1.0);
+    scaledPoints->setMaxPcnw(2e5);
+    scaledPoints->setMaxKrw(0.8);
+    scaledPoints->setMaxKrn(0.9);
+
+    for (int cfgIdx = 0; cfgIdx < 8; ++cfgIdx) {
+        auto config = std::make_shared<Opm::EclEpsConfig>();
+        config->setEnableSatScaling((cfgIdx & 1) != 0);
+        config->setEnableThreePointKrSatScaling((cfgIdx & 2) != 0);
+        config->setEnablePcScaling((cfgIdx & 4) != 0);
+        config->setEnableKrwScaling((cfgIdx & 4) != 0);
+        config->setEnableKrnScaling((cfgIdx & 4) != 0);
+
+        typename Checker::Params params;
+        params.setConfig(config);
+        params.setUnscaledPoints(unscaledPoints);
+        params.setScaledPoints(scaledPoints);
+        params.setEffectiveLawParams(rawParams);
+        params.finalize();
+
+        Checker checker;
+        checker.params = &params;
+        Opm::eclEpsVisitPolicy(*config, checker);
+
+        checker.template checkIfCompatible<Opm::EclEpsSatScalingType::None, false>();
+        checker.template checkIfCompatible<Opm::EclEpsSatScalingType::None, true>();
+        checker.template checkIfCompatible<Opm::EclEpsSatScalingType::TwoPoint, false>();
+        checker.template checkIfCompatible<Opm::EclEpsSatScalingType::TwoPoint, true>();
+        checker.template checkIfCompatible<Opm::EclEpsSatScalingType::ThreePoint, false>();
+        checker.template checkIfCompatible<Opm::EclEpsSatScalingType::ThreePoint, true>();
+
+        // every configuration is supported by a static policy and the policies with
+        // vertical scaling also cover the configurations without it
+        int expectedNumCompatible = (cfgIdx & 4) ? 1 : 2;
+        if (checker.numCompatible != expectedNumCompatible)
+            throw std::logic_error("Unexpected number of compatible endpoint scaling policies");
+    }
+}
+
+// make sure that the hysteresis policy which is selected for a configuration produces
+// the same results as the policy which queries the configuration at runtime
+template <class Scalar, class TwoPhaseTraits>
+struct EclHysteresisPolicyChecker
+{
+    typedef Opm::BrooksCorey<TwoPhaseTraits> RawMaterialLaw;
+    typedef Opm::EclHysteresisTwoPhaseLawParams<RawMaterialLaw> Params;
+
+    template <class Policy>
+    void operator()(const Policy&)
+    {
+        typedef Opm::EclHysteresisTwoPhaseLaw<RawMaterialLaw> DynamicLaw;
+        typedef Opm::EclHysteresisTwoPhaseLaw<RawMaterialLaw, Params, Policy> StaticLaw;
+
+        if (!Policy::isCompatible(params->config()))
+            throw std::logic_error("Selected an incompatible hysteresis policy");
+
+        for (int i = 5; i <= 95; ++i) {
+            Scalar Sw = Scalar(i)/100;
+            Scalar krwDyn = DynamicLaw::twoPhaseSatKrw(*params, Sw);
+            Scalar krwStat = StaticLaw::twoPhaseSatKrw(*params, Sw);
+            Scalar krnDyn = DynamicLaw::twoPhaseSatKrn(*params, Sw);
+            Scalar krnStat = StaticLaw::twoPhaseSatKrn(*params, Sw);
+            Scalar pcDyn = DynamicLaw::twoPhaseSatPcnw(*params, Sw);
+            Scalar pcStat = StaticLaw::twoPhaseSatPcnw(*params, Sw);
+
+            if (krwDyn != krwStat || krnDyn != krnStat || pcDyn != pcStat)
+                throw std::logic_error("Static hysteresis policy is inconsistent "
+                                       "with the dynamic one");
+        }
+    }
+
+    template <Opm::EclKrHysteresisType krHysteresisType>
+    void checkIfCompatible()
+    {
+        typedef Opm::EclHysteresisStaticPolicy<krHysteresisType> Policy;
+        if (!Policy::isCompatible(params->config()))
+            return;
+
+        (*this)(Policy());
+        ++ numCompatible;
+    }
+
+    const Params* params;
+    int numCompatible = 0;
+};
+
+template <class Scalar, class TwoPhaseTraits>
+void testEclHysteresisPolicies()
+{
+    typedef EclHysteresisPolicyChecker<Scalar, TwoPhaseTraits> Checker;
+    typedef typename Checker::RawMaterialLaw::Params RawParams;
+
+    auto drainageParams = std::make_shared<RawParams>();
+    drainageParams->setEntryPressure(1e4);
+    drainageParams->setLambda(2.0);
+    drainageParams->finalize();
+
+    auto imbibitionParams = std::make_shared<RawParams>();
+    imbibitionParams->setEntryPressure(5e3);
+    imbibitionParams->setLambda(3.0);
+    imbibitionParams->finalize();
+
+    Opm::EclEpsScalingPointsInfo<Scalar> info;
+    for (int krModel = -1; krModel <= 1; ++krModel) {
+        for (int enableHysteresis = 0; enableHysteresis < 2; ++enableHysteresis) {
+            auto config = std::make_shared<Opm::EclHysteresisConfig>();
+            config->setEnableHysteresis(enableHysteresis != 0);
+            config->setKrHysteresisModel(krModel);
+
+            typename Checker::Params params;
+            params.setConfig(config);
+            params.setDrainageParams(drainageParams, info, Opm::EclOilWaterSystem);
+            params.setImbibitionParams(imbibitionParams, info, Opm::EclOilWaterSystem);
+            // move away from the drainage curve of the non-wetting phase
+            params.setKrnSwMdc(0.4);
+            params.finalize();
+
+            Checker checker;
+            checker.params = &params;
+            Opm::eclHysteresisVisitPolicy(*config, checker);
+
+            checker.template checkIfCompatible<Opm::EclKrHysteresisType::None>();
+            checker.template checkIfCompatible<Opm::EclKrHysteresisType::Carlson>();
+            checker.template checkIfCompatible<Opm::EclKrHysteresisType::CarlsonImbibitionKrw>();
+
+            // every configuration is supported by exactly one static policy
+            if (checker.numCompatible != 1)
+                throw std::logic_error("Unexpected number of compatible hysteresis policies");
+        }
+    }
+}
+
+template <class Scalar, class TwoPhaseTraits, class FluidState>
+void testParkerLenhardArena()
+{
+    typedef Opm::ParkerLenhard<TwoPhaseTraits> MaterialLaw;
+    typedef typename MaterialLaw::Params Params;
+    typedef typename Params::VanGenuchtenParams VanGenuchtenParams;
+    typedef typename Params::ScanningCurveArena Arena;
+
+    VanGenuchtenParams micParams;
+    micParams.setVgAlpha(1.0/5e2);
+    micParams.setVgN(3.0);
+    micParams.finalize();
+
+    VanGenuchtenParams mdcParams;
+    mdcParams.setVgAlpha(1.0/1e3);
+    mdcParams.setVgN(3.0);
+    mdcParams.finalize();
+
+    // the first two parameter objects must behave identically, the third one
+    // has room for only a single scanning curve besides the main drainage curve
+    // and must report that it cannot follow the history
+    Arena arena(/*numSlices=*/2, /*maxCurves=*/Params::defaultMaxScanningCurves);
+    Arena smallArena(/*numSlices=*/1, /*maxCurves=*/2);
+    Params params[3];
+    for (unsigned i = 0; i < 3; ++i) {
+        params[i].setMicParams(&micParams);
+        params[i].setMdcParams(&mdcParams);
+        params[i].setSwr(0.1);
+        params[i].setSnr(0.1);
+        params[i].finalize();
+    }
+    params[1].setScanningCurveStorage(arena, 1);
+    params[2].setScanningCurveStorage(smallArena, 0);
+    for (unsigned i = 0; i < 3; ++i)
+        MaterialLaw::reset(params[i]);
+
+    // a sequence of saturation reversals of decreasing amplitude
+    static const Scalar reversalSw[] = { 1.0, 0.3, 0.8, 0.4, 0.7, 0.45, 0.65, 0.5 };
+    FluidState fs;
+    bool smallArenaExhausted = false;
+    for (unsigned revIdx = 1; revIdx < sizeof(reversalSw)/sizeof(reversalSw[0]); ++revIdx) {
+        for (int stepIdx = 1; stepIdx <= 10; ++stepIdx) {
+            Scalar Sw =
+                reversalSw[revIdx - 1]
+                + (reversalSw[revIdx] - reversalSw[revIdx - 1])*stepIdx/10;
+            fs.setSaturation(TwoPhaseTraits::wettingPhaseIdx, Sw);
+            fs.setSaturation(TwoPhaseTraits::nonWettingPhaseIdx, 1 - Sw);
+
+            MaterialLaw::update(params[0], fs);
+            MaterialLaw::update(params[1], fs);
+            if (!smallArenaExhausted) {
+                try {
+                    MaterialLaw::update(params[2], fs);
+                }
+                catch (const std::runtime_error&) {
+                    smallArenaExhausted = true;
+                }
+            }
+
+            Scalar pc0 = MaterialLaw::twoPhaseSatPcnw(params[0], Sw);
+            Scalar pc1 = MaterialLaw::twoPhaseSatPcnw(params[1], Sw);
+            Scalar pc2 = MaterialLaw::twoPhaseSatPcnw(params[2], Sw);
+            if (pc0 != pc1)
+                throw std::logic_error("The Parker-Lenhard hysteresis depends on the "
+                                       "storage of the scanning curves");
+            if (!std::isfinite(pc2) || params[2].csc()->loopNum() >= 2)
+                throw std::logic_error("The capacity of the scanning curve storage "
+                                       "was exceeded");
+        }
+    }
+
+    if (params[0].csc()->loopNum() < 2)
+        throw std::logic_error("The Parker-Lenhard test did not produce any "
+                               "secondary scanning curves");
+    if (!smallArenaExhausted)
+        throw std::logic_error("Exceeding the capacity of a scanning curve arena "
+                               "was not reported");
+}
+
+// make sure that the storage for the scanning curves grows if the hysteresis
+// history contains more reversals than the initial capacity
+template <class Scalar, class TwoPhaseTraits, class FluidState>
+void testParkerLenhardManyReversals()
+{
+    typedef Opm::ParkerLenhard<TwoPhaseTraits> MaterialLaw;
+    typedef typename MaterialLaw::Params Params;
+    typedef typename Params::VanGenuchtenParams VanGenuchtenParams;
+
+    VanGenuchtenParams micParams;
+    micParams.setVgAlpha(1.0/5e2);
+    micParams.setVgN(3.0);
+    micParams.finalize();
+
+    VanGenuchtenParams mdcParams;
+    mdcParams.setVgAlpha(1.0/1e3);
+    mdcParams.setVgN(3.0);
+    mdcParams.finalize();
+
+    // the first object starts with the default capacity and needs to grow,
+    // the second one is large enough from the beginning
+    const unsigned numReversals = 2*Params::defaultMaxScanningCurves;
+    Params params[2];
+    params[1].setMaxScanningCurves(numReversals + 2);
+    for (unsigned i = 0; i < 2; ++i) {
+        params[i].setMicParams(&micParams);
+        params[i].setMdcParams(&mdcParams);
+        params[i].setSwr(0.1);
+        params[i].setSnr(0.1);
+        params[i].finalize();
+        MaterialLaw::reset(params[i]);
+    }
+
+    // reversals of slowly decreasing amplitude around Sw = 0.55 which all
+    // remain in the history
+    FluidState fs;
+    Scalar prevSw = 1.0;
+    Scalar amplitude = 0.4;
+    for (unsigned revIdx = 0; revIdx < numReversals; ++revIdx) {
+        const Scalar reversalSw = (revIdx%2 == 0) ? 0.55 - amplitude : 0.55 + amplitude;
+        amplitude *= 0.95;
+        for (int stepIdx = 1; stepIdx <= 5; ++stepIdx) {
+            Scalar Sw = prevSw + (reversalSw - prevSw)*stepIdx/5;
+            fs.setSaturation(TwoPhaseTraits::wettingPhaseIdx, Sw);
+            fs.setSaturation(TwoPhaseTraits::nonWettingPhaseIdx, 1 - Sw);
+
+            MaterialLaw::update(params[0], fs);
+            MaterialLaw::update(params[1], fs);
+
+            Scalar pc0 = MaterialLaw::twoPhaseSatPcnw(params[0], Sw);
+            Scalar pc1 = MaterialLaw::twoPhaseSatPcnw(params[1], Sw);
+            if (!std::isfinite(pc0) || pc0 != pc1)
+                throw std::logic_error("Growing the scanning curve storage changes the "
+                                       "Parker-Lenhard hysteresis");
+        }
+        prevSw = reversalSw;
+    }
+
+    if (params[0].csc()->loopNum() <= static_cast<int>(Params::defaultMaxScanningCurves))
+        throw std::logic_error("The Parker-Lenhard test did not produce more scanning "
+                               "curves than the default capacity");
+    if (params[0].maxScanningCurves() <= Params::defaultMaxScanningCurves)
+        throw std::logic_error("The scanning curve storage did not grow");
+    if (params[1].maxScanningCurves() != numReversals + 2)
+        throw std::logic_error("The scanning curve storage grew although it was "
+                               "large enough");
+}
+
+// make sure that evaluating all saturation functions at once yields the same results
+// as evaluating them one by one
+template <class Scalar, class TwoPhaseTraits, class ThreePhaseTraits, class ThreePhaseFluidState>
+void testTwoPhaseSatAll()
+{
+    typedef Opm::PiecewiseLinearTwoPhaseMaterial<TwoPhaseTraits> TwoPhaseLaw;
+    typedef typename TwoPhaseLaw::Params TwoPhaseParams;
+    typedef typename TwoPhaseParams::ValueVector ValueVector;
+    typedef typename ThreePhaseFluidState::Scalar Evaluation;
+
+    const ValueVector SwValues = { 0.0, 0.2, 0.5, 0.8, 1.0 };
+    const ValueVector SwPcValues = { 0.0, 0.3, 0.6, 1.0 };
+    const ValueVector pcValues = { 3e5, 1e5, 2e4, 1e3, 0.0 };
+    const ValueVector krwValues = { 0.0, 0.05, 0.3, 0.7, 1.0 };
+    const ValueVector krnValues = { 1.0, 0.6, 0.2, 0.02, 0.0 };
+
+    auto sharedParams = std::make_shared<TwoPhaseParams>();
+    sharedParams->setPcnwSamples(SwValues, pcValues);
+    sharedParams->setKrwSamples(SwValues, krwValues);
+    sharedParams->setKrnSamples(SwValues, krnValues);
+    sharedParams->finalize();
+    if (!sharedParams->sharedSwSamples())
+        throw std::logic_error("Identical saturation samples are not detected as shared");
+
+    auto separateParams = std::make_shared<TwoPhaseParams>();
+    separateParams->setPcnwSamples(SwPcValues, ValueVector{ 3e5, 5e4, 5e3, 0.0 });
+    separateParams->setKrwSamples(SwValues, krwValues);
+    separateParams->setKrnSamples(SwValues, krnValues);
+    separateParams->finalize();
+    if (separateParams->sharedSwSamples())
+        throw std::logic_error("Different saturation samples are detected as shared");
+
+    for (const auto* params : { sharedParams.get(), separateParams.get() }) {
+        for (int i = -5; i <= 105; ++i) {
+            Evaluation Sw = Evaluation::createVariable(Scalar(i)/100, 0);
+            Evaluation krw, krn, pcnw;
+            TwoPhaseLaw::twoPhaseSatAll(*params, Sw, krw, krn, pcnw);
+
+            if (krw != TwoPhaseLaw::twoPhaseSatKrw(*params, Sw)
+                || krn != TwoPhaseLaw::twoPhaseSatKrn(*params, Sw)
+                || pcnw != TwoPhaseLaw::twoPhaseSatPcnw(*params, Sw))
+                throw std::logic_error("Fused evaluation of the saturation functions is "
+                                       "inconsistent with the separate one");
+        }
+    }
+
+    // precomputing the slopes and intercepts of the segments must only change the
+    // results by round-off
+    for (const auto* params : { sharedParams.get(), separateParams.get() }) {
+        TwoPhaseParams compiledParams(*params);
+        compiledParams.compile();
+        if (params->isCompiled() || !compiledParams.isCompiled())
+            throw std::logic_error("Wrong compilation state of the piecewise linear curves");
+
+        for (int i = -5; i <= 105; ++i) {
+            Evaluation Sw = Evaluation::createVariable(Scalar(i)/100, 0);
+            Evaluation krw, krn, pcnw;
+            TwoPhaseLaw::twoPhaseSatAll(compiledParams, Sw, krw, krn, pcnw);
+
+            if (krw != TwoPhaseLaw::twoPhaseSatKrw(compiledParams, Sw)
+                || krn != TwoPhaseLaw::twoPhaseSatKrn(compiledParams, Sw)
+                || pcnw != TwoPhaseLaw::twoPhaseSatPcnw(compiledParams, Sw))
+                throw std::logic_error("Fused evaluation of the compiled saturation functions "
+                                       "is inconsistent with the separate one");
+
+            const Evaluation& pcnwRef = TwoPhaseLaw::twoPhaseSatPcnw(*params, Sw);
+            const Evaluation& krwRef = TwoPhaseLaw::twoPhaseSatKrw(*params, Sw);
+            const Scalar tol = 1e3*std::numeric_limits<Scalar>::epsilon();
+            if (std::abs(Opm::scalarValue(krw) - Opm::scalarValue(krwRef)) > tol
+                || std::abs(krw.derivative(0) - krwRef.derivative(0)) > tol*std::max(Scalar(1.0), std::abs(krwRef.derivative(0)))
+                || std::abs(Opm::scalarValue(pcnw) - Opm::scalarValue(pcnwRef)) > tol*3e5)
+                throw std::logic_error("Compiled saturation functions deviate from the "
+                                       "original ones");
+        }
+    }
+
+    // the three-phase laws must not change their relative permeabilities by
+    // evaluating the two-phase curves at once
+    typedef Opm::EclDefaultMaterial<ThreePhaseTraits, TwoPhaseLaw, TwoPhaseLaw> DefaultLaw;
+    typedef Opm::EclStone1Material<ThreePhaseTraits, TwoPhaseLaw, TwoPhaseLaw> Stone1Law;
+    typedef Opm::EclStone2Material<ThreePhaseTraits, TwoPhaseLaw, TwoPhaseLaw> Stone2Law;
+
+    typename DefaultLaw::Params defaultParams;
+    defaultParams.setGasOilParams(sharedParams);
+    defaultParams.setOilWaterParams(sharedParams);
+    defaultParams.setSwl(0.2);
+    defaultParams.finalize();
+
+    typename Stone1Law::Params stone1Params;
+    stone1Params.setGasOilParams(sharedParams);
+    stone1Params.setOilWaterParams(sharedParams);
+    stone1Params.setSwl(0.2);
+    stone1Params.setEta(1.0);
+    stone1Params.finalize();
+
+    typename Stone2Law::Params stone2Params;
+    stone2Params.setGasOilParams(sharedParams);
+    stone2Params.setOilWaterParams(sharedParams);
+    stone2Params.setSwl(0.2);
+    stone2Params.finalize();
+
+    enum { waterPhaseIdx = ThreePhaseTraits::wettingPhaseIdx };
+    enum { oilPhaseIdx = ThreePhaseTraits::nonWettingPhaseIdx };
+    enum { gasPhaseIdx = ThreePhaseTraits::gasPhaseIdx };
+
+    ThreePhaseFluidState fs;
+    for (int i = 0; i <= 10; ++i) {
+        for (int j = 0; i + j <= 10; ++j) {
+            fs.setSaturation(waterPhaseIdx, Evaluation::createVariable(Scalar(i)/10, 0));
+            // without gas, the gas saturation is not a primary variable
+            if (j == 0)
+                fs.setSaturation(gasPhaseIdx, Evaluation(0.0));
+            else
+                fs.setSaturation(gasPhaseIdx, Evaluation::createVariable(Scalar(j)/10, 1));
+            fs.setSaturation(oilPhaseIdx, 1.0 - fs.saturation(waterPhaseIdx) - fs.saturation(gasPhaseIdx));
+
+            std::array<Evaluation, 3> kr;
+            DefaultLaw::relativePermeabilities(kr, defaultParams, fs);
+            if (kr[waterPhaseIdx] != DefaultLaw::template krw<ThreePhaseFluidState, Evaluation>(defaultParams, fs)
+                || kr[oilPhaseIdx] != DefaultLaw::template krn<ThreePhaseFluidState, Evaluation>(defaultParams, fs)
+                || kr[gasPhaseIdx] != DefaultLaw::template krg<ThreePhaseFluidState, Evaluation>(defaultParams, fs))
+                throw std::logic_error("Fused relative permeabilities of EclDefaultMaterial are "
+                                       "inconsistent with the separate ones");
+
+            Stone1Law::relativePermeabilities(kr, stone1Params, fs);
+            if (std::abs(Opm::scalarValue(kr[oilPhaseIdx])
+                         - Opm::scalarValue(Stone1Law::template krn<ThreePhaseFluidState, Evaluation>(stone1Params, fs))) > 1e-5)
+                throw std::logic_error("Fused relative permeabilities of EclStone1Material are "
+                                       "inconsistent with the separate ones");
+
+            Stone2Law::relativePermeabilities(kr, stone2Params, fs);
+            if (kr[oilPhaseIdx] != Stone2Law::template krn<ThreePhaseFluidState, Evaluation>(stone2Params, fs))
+                throw std::logic_error("Fused relative permeabilities of EclStone2Material are "
+                                       "inconsistent with the separate ones");
+        }
+    }
+}
+
 template <class Scalar>
 inline void testAll()
 {
@@ -378,12 +874,17 @@ inline void testAll()
         testGenericApi<MaterialLaw, TwoPhaseFluidState>();
         testTwoPhaseApi<MaterialLaw, TwoPhaseFluidState>();
         testTwoPhaseSatApi<MaterialLaw, TwoPhaseFluidState>();
+
+        testParkerLenhardArena<Scalar, TwoPhaseTraits, TwoPhaseFluidState>();
+        testParkerLenhardManyReversals<Scalar, TwoPhaseTraits, TwoPhaseFluidState>();
     }
     {
         typedef Opm::PiecewiseLinearTwoPhaseMaterial<TwoPhaseTraits> MaterialLaw;
         testGenericApi<MaterialLaw, TwoPhaseFluidState>();
         testTwoPhaseApi<MaterialLaw, TwoPhaseFluidState>();
         testTwoPhaseSatApi<MaterialLaw, TwoPhaseFluidState>();
+
+        testTwoPhaseSatAll<Scalar, TwoPhaseTraits, ThreePhaseTraits, ThreePhaseFluidState>();
     }
     {
         typedef Opm::SplineTwoPhaseMaterial<TwoPhaseTraits> MaterialLaw;
@@ -416,6 +917,17 @@ inline void testAll()
         testGenericApi<MaterialLaw, TwoPhaseFluidState>();
         testTwoPhaseApi<MaterialLaw, TwoPhaseFluidState>();
         testTwoPhaseSatApi<MaterialLaw, TwoPhaseFluidState>();
+
+        typedef Opm::EclEpsStaticPolicy<Opm::EclEpsSatScalingType::ThreePoint,
+                                        /*enableVerticalScaling=*/true> StaticPolicy;
+        typedef Opm::EclEpsTwoPhaseLaw<RawMaterialLaw,
+                                       Opm::EclEpsTwoPhaseLawParams<RawMaterialLaw>,
+                                       StaticPolicy> StaticPolicyMaterialLaw;
+        testGenericApi<StaticPolicyMaterialLaw, TwoPhaseFluidState>();
+        testTwoPhaseApi<StaticPolicyMaterialLaw, TwoPhaseFluidState>();
+        testTwoPhaseSatApi<StaticPolicyMaterialLaw, TwoPhaseFluidState>();
+
+        testEclEpsPolicies<Scalar, TwoPhaseTraits>();
     }
     {
         typedef Opm::BrooksCorey<TwoPhaseTraits> RawMaterialLaw;
@@ -423,6 +935,11 @@ inline void testAll()
         testGenericApi<MaterialLaw, TwoPhaseFluidState>();
         testTwoPhaseApi<MaterialLaw, TwoPhaseFluidState>();
         testTwoPhaseSatApi<MaterialLaw, TwoPhaseFluidState>();
+
+        // the imbibition curve is found by numerically inverting the Brooks-Corey
+        // law, which requires double precision
+        if (std::is_same<Scalar, double>::value)
+            testEclHysteresisPolicies<Scalar, TwoPhaseTraits>();
     }
 }
 
@@ -36,6 +36,9 @@
 #include <opm/material/fluidsystems/SinglePhaseFluidSystem.hpp>
 #include <opm/material/fluidsystems/TwoPhaseImmiscibleFluidSystem.hpp>
 #include <opm/material/fluidsystems/BlackOilFluidSystem.hpp>
+#include <opm/material/fluidsystems/blackoilpvt/SolventPvt.hpp>
+#include <opm/material/common/BinarySerializer.hpp>
+#include <opm/material/common/SharedMemorySegment.hpp>
 #include <opm/material/fluidsystems/BrineCO2FluidSystem.hpp>
 #include <opm/material/fluidsystems/H2ON2FluidSystem.hpp>
 #include <opm/material/fluidsystems/H2ON2LiquidPhaseFluidSystem.hpp>
@@ -62,6 +65,12 @@
 
 #include <dune/common/parallel/mpihelper.hh>
 
+#include <atomic>
+#include <thread>
+#include <cstring>
+
+#include <unistd.h>
+
 // check that the blackoil fluid system implements all non-standard functions
 template <class Evaluation, class FluidSystem>
 void ensureBlackoilApi()
@@ -160,6 +169,199 @@ void ensureBlackoilApi()
     }
 }
 
+// check that several instances of the blackoil fluid system can be used independently
+template <class Scalar>
+void testBlackoilInstances()
+{
+    typedef Opm::BlackOilFluidSystem<Scalar> FluidSystem;
+    typedef typename FluidSystem::Instance Instance;
+    typedef typename FluidSystem::ScopedInstance ScopedInstance;
+
+    FluidSystem::initBegin(/*numPvtRegions=*/1);
+    FluidSystem::setReferenceDensities(/*oil=*/600.0, /*water=*/1000.0, /*gas=*/1.0, /*regionIdx=*/0);
+    FluidSystem::initEnd();
+
+    // a copy of the active instance which is subsequently modified
+    Instance realization(FluidSystem::activeInstance());
+    {
+        ScopedInstance scope(realization);
+        if (FluidSystem::referenceDensity(FluidSystem::oilPhaseIdx, 0) != 600.0)
+            throw std::logic_error("Copied fluid system instance has wrong reference density");
+
+        FluidSystem::initBegin(/*numPvtRegions=*/2);
+        FluidSystem::setEnableVaporizedOil(true);
+        FluidSystem::setReferenceDensities(/*oil=*/800.0, /*water=*/1000.0, /*gas=*/1.0, /*regionIdx=*/0);
+        FluidSystem::setReferenceDensities(/*oil=*/850.0, /*water=*/1000.0, /*gas=*/1.0, /*regionIdx=*/1);
+        FluidSystem::initEnd();
+
+        if (FluidSystem::numRegions() != 2 || !FluidSystem::enableVaporizedOil())
+            throw std::logic_error("Fluid system instance was not initialized");
+    }
+
+    // the original instance must not be affected
+    if (FluidSystem::numRegions() != 1
+        || FluidSystem::enableVaporizedOil()
+        || FluidSystem::referenceDensity(FluidSystem::oilPhaseIdx, 0) != 600.0)
+        throw std::logic_error("Modifying a fluid system instance changed the default one");
+
+    ScopedInstance scope(realization);
+    if (FluidSystem::referenceDensity(FluidSystem::oilPhaseIdx, 1) != 850.0)
+        throw std::logic_error("Re-activating a fluid system instance failed");
+}
+
+// check that an initialized fluid system instance survives a round trip through its
+// binary representation
+template <class Scalar>
+void testBlackoilSerialization()
+{
+    typedef Opm::BlackOilFluidSystem<Scalar> FluidSystem;
+    typedef typename FluidSystem::Instance Instance;
+    typedef typename FluidSystem::ScopedInstance ScopedInstance;
+    typedef typename FluidSystem::GasPvt GasPvt;
+    typedef Opm::Tabulated1DFunction<Scalar> TabulatedFunction;
+
+    std::vector<Scalar> p = { 1e5, 1e6, 1e7 };
+    std::vector<TabulatedFunction> invB = { TabulatedFunction(p, std::vector<Scalar>{ 1.0, 10.0, 100.0 }) };
+    std::vector<TabulatedFunction> mu = { TabulatedFunction(p, std::vector<Scalar>{ 1e-5, 1.1e-5, 1.5e-5 }) };
+    std::vector<TabulatedFunction> invBMu = { TabulatedFunction(p, std::vector<Scalar>{ 1e5, 9e5, 6e6 }) };
+    auto* dryGasPvt = new Opm::DryGasPvt<Scalar>(std::vector<Scalar>{ 1.0 }, invB, mu, invBMu);
+
+    Instance original;
+    ScopedInstance scope(original);
+    FluidSystem::initBegin(/*numPvtRegions=*/1);
+    FluidSystem::setReferenceDensities(/*oil=*/600.0, /*water=*/1000.0, /*gas=*/1.2, /*regionIdx=*/0);
+    FluidSystem::setGasPvt(std::make_shared<GasPvt>(GasPvt::DryGasPvt, dryGasPvt));
+    FluidSystem::initEnd();
+
+    const auto& buffer = Opm::serializeToBuffer(original);
+
+    Instance loaded;
+    Opm::deserializeFromBuffer(loaded, buffer.data(), buffer.size());
+
+    const GasPvt& origGasPvt = FluidSystem::gasPvt();
+    Scalar origMu = origGasPvt.viscosity(/*regionIdx=*/0, Scalar(300.0), Scalar(5e6), Scalar(0.0));
+
+    // evaluating the tables from their contiguous copies must not change the results
+    Opm::DryGasPvt<Scalar> packedDryGasPvt(*dryGasPvt);
+    packedDryGasPvt.packTables();
+    if (!packedDryGasPvt.tablesPacked()
+        || packedDryGasPvt.viscosity(/*regionIdx=*/0, Scalar(300.0), Scalar(5e6), Scalar(0.0)) != origMu
+        || packedDryGasPvt.inverseFormationVolumeFactor(/*regionIdx=*/0, Scalar(300.0), Scalar(5e6), Scalar(0.0))
+           != dryGasPvt->inverseFormationVolumeFactor(/*regionIdx=*/0, Scalar(300.0), Scalar(5e6), Scalar(0.0)))
+        throw std::logic_error("Packed dry gas PVT tables give different results");
+
+    const auto& packedBuffer = Opm::serializeToBuffer(packedDryGasPvt);
+    Opm::DryGasPvt<Scalar> loadedDryGasPvt;
+    Opm::deserializeFromBuffer(loadedDryGasPvt, packedBuffer.data(), packedBuffer.size());
+    if (!loadedDryGasPvt.tablesPacked()
+        || loadedDryGasPvt.viscosity(/*regionIdx=*/0, Scalar(300.0), Scalar(5e6), Scalar(0.0)) != origMu)
+        throw std::logic_error("Packed dry gas PVT tables did not survive serialization");
+
+    ScopedInstance loadedScope(loaded);
+    if (&FluidSystem::gasPvt() == &origGasPvt
+        || !(FluidSystem::gasPvt() == origGasPvt)
+        || FluidSystem::gasPvt().viscosity(/*regionIdx=*/0, Scalar(300.0), Scalar(5e6), Scalar(0.0)) != origMu
+        || FluidSystem::referenceDensity(FluidSystem::gasPhaseIdx, 0) != Scalar(1.2)
+        || !FluidSystem::phaseIsActive(FluidSystem::gasPhaseIdx))
+        throw std::logic_error("Deserialized fluid system differs from the original one");
+
+    // the data must not be accepted by an object of a different type
+    Opm::GasPvtMultiplexer<Scalar> otherType;
+    try {
+        Opm::deserializeFromBuffer(otherType, buffer.data(), buffer.size());
+        throw std::logic_error("Serialized data was loaded into an object of a different type");
+    }
+    catch (const std::runtime_error&) {
+    }
+}
+
+// check that two instances of the blackoil fluid system can be initialized and used
+// concurrently by separate threads
+template <class Scalar>
+void testBlackoilInstanceThreads()
+{
+    typedef Opm::BlackOilFluidSystem<Scalar> FluidSystem;
+    typedef typename FluidSystem::Instance Instance;
+    typedef typename FluidSystem::ScopedInstance ScopedInstance;
+
+    FluidSystem::initBegin(/*numPvtRegions=*/1);
+    FluidSystem::setReferenceDensities(/*oil=*/600.0, /*water=*/1000.0, /*gas=*/1.0, /*regionIdx=*/0);
+    FluidSystem::initEnd();
+
+    Instance instances[2];
+    const Scalar rhoOil[2] = { 700.0, 900.0 };
+    const Scalar rhoGas[2] = { 1.5, 2.5 };
+    const Scalar surfacePressure[2] = { 1.0e5, 2.0e5 };
+    const Scalar surfaceTemperature[2] = { 288.0, 293.0 };
+    std::atomic<int> numInitialized(0);
+    std::atomic<bool> failed(false);
+
+    auto runRealization = [&](unsigned idx) {
+        ScopedInstance scope(instances[idx]);
+        FluidSystem::initBegin(/*numPvtRegions=*/1);
+        FluidSystem::setSurfaceConditions(surfacePressure[idx], surfaceTemperature[idx]);
+        FluidSystem::setReferenceDensities(rhoOil[idx], /*water=*/1000.0, rhoGas[idx], /*regionIdx=*/0);
+        FluidSystem::initEnd();
+
+        // use the instances only after both of them have been initialized
+        ++ numInitialized;
+        while (numInitialized < 2)
+            std::this_thread::yield();
+
+        // the molar mass of the gas component depends on the surface conditions
+        const Scalar gasMolarMass =
+            Opm::Constants<Scalar>::R*surfaceTemperature[idx]*rhoGas[idx]/surfacePressure[idx];
+        for (int i = 0; i < 1000; ++i) {
+            if (FluidSystem::referenceDensity(FluidSystem::oilPhaseIdx, 0) != rhoOil[idx]
+                || FluidSystem::activeInstance().surfacePressure() != surfacePressure[idx]
+                || FluidSystem::activeInstance().surfaceTemperature() != surfaceTemperature[idx]
+                || FluidSystem::molarMass(FluidSystem::gasCompIdx, 0) != gasMolarMass)
+                failed = true;
+        }
+
+        // the static attributes always refer to the global instance
+        if (FluidSystem::surfacePressure != 1.01325e5)
+            failed = true;
+
+        // threads which are started by this one use the global instance unless the
+        // instance is activated explicitly
+        std::thread defaultThread([&]() {
+            if (FluidSystem::referenceDensity(FluidSystem::oilPhaseIdx, 0) != 600.0
+                || &FluidSystem::activeInstance() == &instances[idx]
+                || FluidSystem::activeInstance().surfacePressure() != 1.01325e5)
+                failed = true;
+        });
+        defaultThread.join();
+
+        Instance& instance = FluidSystem::activeInstance();
+        std::thread propagatedThread([&]() {
+            ScopedInstance workerScope(instance);
+            if (FluidSystem::referenceDensity(FluidSystem::oilPhaseIdx, 0) != rhoOil[idx])
+                failed = true;
+        });
+        propagatedThread.join();
+    };
+
+    std::thread thread0(runRealization, 0u);
+    std::thread thread1(runRealization, 1u);
+    thread0.join();
+    thread1.join();
+
+    if (failed)
+        throw std::logic_error("Fluid system instances which are used by separate threads interfere");
+
+    if (FluidSystem::referenceDensity(FluidSystem::oilPhaseIdx, 0) != 600.0
+        || FluidSystem::surfacePressure != 1.01325e5
+        || FluidSystem::surfaceTemperature != Scalar(273.15 + 15.56))
+        throw std::logic_error("Initializing fluid system instances on other threads changed the global one");
+
+    // assigning to the static attributes modifies the global instance as before
+    FluidSystem::surfacePressure = 1.1e5;
+    if (FluidSystem::activeInstance().surfacePressure() != Scalar(1.1e5))
+        throw std::logic_error("The static surface pressure does not refer to the global instance");
+    FluidSystem::setSurfaceConditions(/*pressure=*/1.01325e5, /*temperature=*/273.15 + 15.56);
+}
+
 // check the API of all fluid states
 template <class Scalar>
 void testAllFluidStates()
@@ -284,6 +486,543 @@ void testAllFluidSystems()
         checkFluidSystem<Scalar, FluidSystem, FluidStateEval, LhsEval>(); }
 }
 
+// check that the fused and batched evaluation of the PVT classes yields the same results
+// as evaluating each quantity separately. the pressures are multiplied by
+// pressureFactor, i.e., they depend on a primary variable if the factor is not
+// constant. (the last argument, i.e., Rs, Rv or the salt concentration, is zero.)
+template <class Evaluation, class Pvt>
+void checkFusedPvt(const Pvt& pvt, const Evaluation& pressureFactor, const char* name)
+{
+    const size_t numValues = 20;
+    std::vector<unsigned> regionIdx(numValues);
+    std::vector<Evaluation> temperature(numValues);
+    std::vector<Evaluation> pressure(numValues);
+    std::vector<Evaluation> Rv(numValues, Evaluation(0.0));
+    for (size_t i = 0; i < numValues; ++i) {
+        regionIdx[i] = i % 2;
+        temperature[i] = 290.0 + 5.0*i;
+        // the range of the tables is left on both sides
+        pressure[i] = pressureFactor*(5e4 + i*i*3e4);
+    }
+
+    std::vector<Evaluation> invB(numValues);
+    std::vector<Evaluation> mu(numValues);
+    pvt.inverseFormationVolumeFactorAndViscosity(numValues, regionIdx.data(), temperature.data(),
+                                                 pressure.data(), Rv.data(), invB.data(), mu.data());
+    for (size_t i = 0; i < numValues; ++i) {
+        Evaluation singleInvB;
+        Evaluation singleMu;
+        pvt.inverseFormationVolumeFactorAndViscosity(regionIdx[i], temperature[i], pressure[i], Rv[i],
+                                                     singleInvB, singleMu);
+        if (invB[i] != pvt.inverseFormationVolumeFactor(regionIdx[i], temperature[i], pressure[i], Rv[i])
+            || mu[i] != pvt.viscosity(regionIdx[i], temperature[i], pressure[i], Rv[i])
+            || singleInvB != invB[i]
+            || singleMu != mu[i])
+            throw std::logic_error(std::string("Fused evaluation of ")+name+" gives different results");
+    }
+}
+
+// the solvent PVT does not take the oil vaporization factor
+template <class Scalar>
+struct SolventPvtAdapter
+{
+    template <class Evaluation>
+    Evaluation inverseFormationVolumeFactor(unsigned regionIdx, const Evaluation& T,
+                                            const Evaluation& p, const Evaluation&) const
+    { return pvt.inverseFormationVolumeFactor(regionIdx, T, p); }
+
+    template <class Evaluation>
+    Evaluation viscosity(unsigned regionIdx, const Evaluation& T,
+                         const Evaluation& p, const Evaluation&) const
+    { return pvt.viscosity(regionIdx, T, p); }
+
+    template <class Evaluation>
+    void inverseFormationVolumeFactorAndViscosity(unsigned regionIdx, const Evaluation& T,
+                                                  const Evaluation& p, const Evaluation&,
+                                                  Evaluation& invB, Evaluation& mu) const
+    { pvt.inverseFormationVolumeFactorAndViscosity(regionIdx, T, p, invB, mu); }
+
+    template <class Evaluation>
+    void inverseFormationVolumeFactorAndViscosity(size_t numValues, const unsigned* regionIdx,
+                                                  const Evaluation* T, const Evaluation* p,
+                                                  const Evaluation*, Evaluation* invB,
+                                                  Evaluation* mu) const
+    { pvt.inverseFormationVolumeFactorAndViscosity(numValues, regionIdx, T, p, invB, mu); }
+
+    Opm::SolventPvt<Scalar> pvt;
+};
+
+template <class Scalar>
+void testFusedGasPvt()
+{
+    typedef Opm::DenseAd::Evaluation<Scalar, 3> Evaluation;
+    typedef Opm::Tabulated1DFunction<Scalar> TabulatedFunction;
+
+    std::vector<Scalar> p = { 1e5, 1e6, 5e6, 1e7 };
+    std::vector<TabulatedFunction> invB = {
+        TabulatedFunction(p, std::vector<Scalar>{ 1.0, 10.0, 45.0, 100.0 }),
+        TabulatedFunction(p, std::vector<Scalar>{ 1.1, 11.0, 47.0, 104.0 })
+    };
+    std::vector<TabulatedFunction> mu = {
+        TabulatedFunction(p, std::vector<Scalar>{ 1e-5, 1.1e-5, 1.3e-5, 1.5e-5 }),
+        TabulatedFunction(p, std::vector<Scalar>{ 1.2e-5, 1.3e-5, 1.4e-5, 1.7e-5 })
+    };
+    std::vector<Scalar> rhoRef = { 1.0, 1.1 };
+    Scalar one = 1.0;
+    const Evaluation& variable = Evaluation::createVariable(1.0, /*varPos=*/0);
+
+    // the tables for 1/(B mu) are recomputed by initEnd()
+    Opm::DryGasPvt<Scalar> dryGasPvt(rhoRef, invB, mu, invB);
+    dryGasPvt.initEnd();
+    checkFusedPvt(dryGasPvt, one, "DryGasPvt");
+    checkFusedPvt(dryGasPvt, variable, "DryGasPvt");
+
+    dryGasPvt.packTables();
+    checkFusedPvt(dryGasPvt, one, "packed DryGasPvt");
+    checkFusedPvt(dryGasPvt, variable, "packed DryGasPvt");
+
+    Opm::GasPvtMultiplexer<Scalar> gasPvt(Opm::GasPvtMultiplexer<Scalar>::DryGasPvt,
+                                          new Opm::DryGasPvt<Scalar>(dryGasPvt));
+    checkFusedPvt(gasPvt, variable, "GasPvtMultiplexer");
+
+    SolventPvtAdapter<Scalar> solventPvt;
+    solventPvt.pvt = Opm::SolventPvt<Scalar>(rhoRef, invB, mu, invB);
+    solventPvt.pvt.initEnd();
+    checkFusedPvt(solventPvt, one, "SolventPvt");
+    checkFusedPvt(solventPvt, variable, "SolventPvt");
+}
+
+// pack the tables of a gas PVT object, place them in memory which is shared between
+// processes and use them from there by another PVT object of the same kind
+template <class Scalar, class RealPvt>
+void checkSharedGasPvt(typename Opm::GasPvtMultiplexer<Scalar>::GasPvtApproach approach,
+                       const RealPvt& realPvt,
+                       Scalar RvMax,
+                       Opm::SharedMemorySegment& reader,
+                       const std::string& pvtName)
+{
+    typedef Opm::GasPvtMultiplexer<Scalar> GasPvt;
+
+    // the process which creates the segment
+    GasPvt packedPvt(approach, new RealPvt(realPvt));
+    if (!packedPvt.supportsTableImage())
+        throw std::logic_error(pvtName+" must support table images");
+    packedPvt.packTables();
+
+    const std::string name =
+        "/opm-test-fluidsystems-"+std::to_string(getpid())+"-"+std::to_string(sizeof(Scalar));
+    Opm::SharedMemorySegment writer;
+    writer.create(name, packedPvt.tableImageSize());
+    std::memcpy(writer.writableData(), packedPvt.tableImage(), packedPvt.tableImageSize());
+
+    // the other processes of the node
+    reader.open(name);
+    Opm::SharedMemorySegment::unlink(name);
+
+    GasPvt sharedPvt(approach, new RealPvt(realPvt));
+    sharedPvt.attachTableImage(reader.data(), reader.size());
+    if (sharedPvt.tableImage() != reader.data())
+        throw std::logic_error("The "+pvtName+" PVT does not use the shared memory segment");
+
+    for (unsigned regionIdx = 0; regionIdx < 2; ++regionIdx) {
+        for (int i = 0; i <= 100; ++i) {
+            Scalar T = 300.0;
+            Scalar pressure = 5e4 + i*1e5;
+            Scalar Rv = RvMax*(i % 10)/10;
+            if (sharedPvt.inverseFormationVolumeFactor(regionIdx, T, pressure, Rv)
+                != realPvt.inverseFormationVolumeFactor(regionIdx, T, pressure, Rv)
+                || sharedPvt.viscosity(regionIdx, T, pressure, Rv)
+                != realPvt.viscosity(regionIdx, T, pressure, Rv)
+                || sharedPvt.saturatedInverseFormationVolumeFactor(regionIdx, T, pressure)
+                != realPvt.saturatedInverseFormationVolumeFactor(regionIdx, T, pressure)
+                || sharedPvt.saturatedViscosity(regionIdx, T, pressure)
+                != realPvt.saturatedViscosity(regionIdx, T, pressure)
+                || sharedPvt.saturatedOilVaporizationFactor(regionIdx, T, pressure)
+                != realPvt.saturatedOilVaporizationFactor(regionIdx, T, pressure))
+                throw std::logic_error("The "+pvtName+" PVT using shared tables gives different results");
+
+            if (Rv > 0.0 && sharedPvt.saturationPressure(regionIdx, T, Rv)
+                != realPvt.saturationPressure(regionIdx, T, Rv))
+                throw std::logic_error("The "+pvtName+" PVT using shared tables gives a different "
+                                       "saturation pressure");
+        }
+    }
+    checkFusedPvt(sharedPvt, Scalar(1.0), ("GasPvtMultiplexer with shared "+pvtName+" tables").c_str());
+}
+
+template <class Scalar>
+void testSharedGasPvtTables()
+{
+    typedef Opm::Tabulated1DFunction<Scalar> TabulatedFunction;
+    typedef Opm::UniformXTabulated2DFunction<Scalar> TabulatedTwoDFunction;
+    typedef Opm::GasPvtMultiplexer<Scalar> GasPvt;
+
+    if (!Opm::SharedMemorySegment::isSupported())
+        return;
+
+    std::vector<Scalar> p = { 1e5, 1e6, 5e6, 1e7 };
+    std::vector<TabulatedFunction> invB = {
+        TabulatedFunction(p, std::vector<Scalar>{ 1.0, 10.0, 45.0, 100.0 }),
+        TabulatedFunction(p, std::vector<Scalar>{ 1.1, 11.0, 47.0, 104.0 })
+    };
+    std::vector<TabulatedFunction> mu = {
+        TabulatedFunction(p, std::vector<Scalar>{ 1e-5, 1.1e-5, 1.3e-5, 1.5e-5 }),
+        TabulatedFunction(p, std::vector<Scalar>{ 1.2e-5, 1.3e-5, 1.4e-5, 1.7e-5 })
+    };
+    std::vector<Scalar> rhoRef = { 1.0, 1.1 };
+
+    Opm::DryGasPvt<Scalar> dryGasPvt(rhoRef, invB, mu, invB);
+    dryGasPvt.initEnd();
+
+    Opm::SharedMemorySegment reader;
+    checkSharedGasPvt(GasPvt::DryGasPvt, dryGasPvt, Scalar(0.0), reader, "dry gas");
+
+    // wet gas: the undersaturated tables are sampled at the pressures of the saturated
+    // curve and at three oil vaporization factors up to the saturated one
+    std::vector<Scalar> RvSat = { 1e-6, 1e-5, 5e-5, 1e-4 };
+    Opm::WetGasPvt<Scalar> wetGasPvt;
+    wetGasPvt.setNumRegions(2);
+    for (unsigned regionIdx = 0; regionIdx < 2; ++regionIdx) {
+        wetGasPvt.setReferenceDensities(regionIdx, 800.0, rhoRef[regionIdx], 1000.0);
+
+        std::vector<std::pair<Scalar, Scalar> > RvSamples;
+        TabulatedTwoDFunction invBg(TabulatedTwoDFunction::InterpolationPolicy::RightExtreme);
+        TabulatedTwoDFunction mug(TabulatedTwoDFunction::InterpolationPolicy::RightExtreme);
+        for (unsigned pIdx = 0; pIdx < p.size(); ++pIdx) {
+            RvSamples.emplace_back(p[pIdx], RvSat[pIdx]*(1 + regionIdx));
+            invBg.appendXPos(p[pIdx]);
+            mug.appendXPos(p[pIdx]);
+            for (unsigned j = 0; j < 3; ++j) {
+                Scalar Rv = RvSamples.back().second*j/2;
+                invBg.appendSamplePoint(pIdx, Rv, invB[regionIdx].valueAt(pIdx)*(1 - 1e3*Rv));
+                mug.appendSamplePoint(pIdx, Rv, mu[regionIdx].valueAt(pIdx)*(1 + 1e3*Rv));
+            }
+        }
+        wetGasPvt.setSaturatedGasOilVaporizationFactor(regionIdx, RvSamples);
+        wetGasPvt.setInverseGasFormationVolumeFactor(regionIdx, invBg);
+        wetGasPvt.setGasViscosity(regionIdx, mug);
+    }
+    wetGasPvt.initEnd();
+
+    Opm::SharedMemorySegment wetGasReader;
+    checkSharedGasPvt(GasPvt::WetGasPvt, wetGasPvt, RvSat.back(), wetGasReader, "wet gas");
+
+    // packing the tables again must give the same image, and changing the tables must
+    // detach the object from it
+    Opm::WetGasPvt<Scalar> repackedPvt(wetGasPvt);
+    repackedPvt.packTables();
+    if (repackedPvt.tableImageSize() != wetGasReader.size()
+        || std::memcmp(repackedPvt.tableImage(), wetGasReader.data(), wetGasReader.size()) != 0)
+        throw std::logic_error("Packing the wet gas tables is not reproducible");
+    repackedPvt.setGasViscosity(0, wetGasPvt.gasMu()[0]);
+    if (repackedPvt.tablesPacked())
+        throw std::logic_error("Changing the wet gas tables must discard the packed copies");
+
+    // an image which does not fit the number of regions must be rejected
+    Opm::DryGasPvt<Scalar> oneRegionPvt(std::vector<Scalar>{ 1.0 },
+                                        std::vector<TabulatedFunction>{ invB[0] },
+                                        std::vector<TabulatedFunction>{ mu[0] },
+                                        std::vector<TabulatedFunction>{ invB[0] });
+    oneRegionPvt.initEnd();
+    bool rejected = false;
+    try {
+        oneRegionPvt.attachTableImage(reader.data(), reader.size());
+    }
+    catch (const std::runtime_error&) {
+        rejected = true;
+    }
+    if (!rejected)
+        throw std::logic_error("A table image for a different number of regions was not rejected");
+
+    // the other gas PVT approaches do not support table images
+    GasPvt thermalGasPvt(GasPvt::ThermalGasPvt, new Opm::GasPvtThermal<Scalar>);
+    rejected = false;
+    try {
+        thermalGasPvt.packTables();
+    }
+    catch (const std::logic_error&) {
+        rejected = true;
+    }
+    if (thermalGasPvt.supportsTableImage() || !rejected)
+        throw std::logic_error("Thermal gas must not support table images");
+}
+
+// the same for the oil PVT. live oil packs its 2D tables along with the curves of
+// saturated oil
+template <class Scalar>
+void testSharedOilPvtTables()
+{
+    typedef std::vector<std::pair<Scalar, Scalar> > SamplingPoints;
+    typedef Opm::OilPvtMultiplexer<Scalar> OilPvt;
+
+    if (!Opm::SharedMemorySegment::isSupported())
+        return;
+
+    Opm::LiveOilPvt<Scalar> liveOilPvt;
+    liveOilPvt.setNumRegions(2);
+    for (unsigned regionIdx = 0; regionIdx < 2; ++regionIdx) {
+        Scalar f = 1.0 + 0.1*regionIdx;
+        liveOilPvt.setReferenceDensities(regionIdx, 800.0*f, 1.0*f, 1000.0);
+        liveOilPvt.setSaturatedOilGasDissolutionFactor(regionIdx,
+            SamplingPoints{ {1e5, 1.0*f}, {1e6, 10.0*f}, {5e6, 45.0*f}, {1e7, 80.0*f} });
+        liveOilPvt.setSaturatedOilFormationVolumeFactor(regionIdx,
+            SamplingPoints{ {1e5, 1.05}, {1e6, 1.1*f}, {5e6, 1.2*f}, {1e7, 1.3*f} });
+        liveOilPvt.setSaturatedOilViscosity(regionIdx,
+            SamplingPoints{ {1e5, 2e-3}, {1e6, 1.5e-3*f}, {5e6, 1.2e-3*f}, {1e7, 1e-3*f} });
+    }
+    liveOilPvt.initEnd();
+
+    OilPvt packedPvt;
+    packedPvt.setApproach(OilPvt::LiveOilPvt);
+    packedPvt.template getRealPvt<OilPvt::LiveOilPvt>() = liveOilPvt;
+    if (!packedPvt.supportsTableImage())
+        throw std::logic_error("Live oil must support table images");
+    packedPvt.packTables();
+
+    const std::string name =
+        "/opm-test-fluidsystems-oil-"+std::to_string(getpid())+"-"+std::to_string(sizeof(Scalar));
+    Opm::SharedMemorySegment writer;
+    writer.create(name, packedPvt.tableImageSize());
+    std::memcpy(writer.writableData(), packedPvt.tableImage(), packedPvt.tableImageSize());
+
+    Opm::SharedMemorySegment reader;
+    reader.open(name);
+    Opm::SharedMemorySegment::unlink(name);
+
+    OilPvt sharedPvt;
+    sharedPvt.setApproach(OilPvt::LiveOilPvt);
+    sharedPvt.template getRealPvt<OilPvt::LiveOilPvt>() = liveOilPvt;
+    sharedPvt.attachTableImage(reader.data(), reader.size());
+    if (sharedPvt.tableImage() != reader.data())
+        throw std::logic_error("The live oil PVT does not use the shared memory segment");
+
+    Scalar T = 300.0;
+    for (unsigned regionIdx = 0; regionIdx < 2; ++regionIdx) {
+        for (int i = 0; i <= 100; ++i) {
+            Scalar pressure = 5e4 + i*1.5e5;
+            Scalar Rs = 1.0 + (i % 10)*8.0;
+            if (sharedPvt.inverseFormationVolumeFactor(regionIdx, T, pressure, Rs)
+                != liveOilPvt.inverseFormationVolumeFactor(regionIdx, T, pressure, Rs)
+                || sharedPvt.viscosity(regionIdx, T, pressure, Rs)
+                != liveOilPvt.viscosity(regionIdx, T, pressure, Rs)
+                || sharedPvt.saturatedInverseFormationVolumeFactor(regionIdx, T, pressure)
+                != liveOilPvt.saturatedInverseFormationVolumeFactor(regionIdx, T, pressure)
+                || sharedPvt.saturatedViscosity(regionIdx, T, pressure)
+                != liveOilPvt.saturatedViscosity(regionIdx, T, pressure)
+                || sharedPvt.saturatedGasDissolutionFactor(regionIdx, T, pressure)
+                != liveOilPvt.saturatedGasDissolutionFactor(regionIdx, T, pressure)
+                || sharedPvt.saturationPressure(regionIdx, T, Rs)
+                != liveOilPvt.saturationPressure(regionIdx, T, Rs))
+                throw std::logic_error("The live oil PVT using shared tables gives different results");
+        }
+    }
+    checkFusedPvt(sharedPvt, Scalar(1.0), "OilPvtMultiplexer with shared live oil tables");
+
+    // a setter detaches the object from the image
+    Opm::LiveOilPvt<Scalar>& realSharedPvt = sharedPvt.template getRealPvt<OilPvt::LiveOilPvt>();
+    realSharedPvt.setOilViscosity(0, liveOilPvt.oilMuTable()[0]);
+    if (realSharedPvt.tablesPacked())
+        throw std::logic_error("Changing the live oil tables must discard the packed copies");
+
+    // dead oil is supported through the multiplexer as well, the other approaches are not
+    OilPvt deadOilPvt;
+    deadOilPvt.setApproach(OilPvt::DeadOilPvt);
+    OilPvt constCompOilPvt;
+    constCompOilPvt.setApproach(OilPvt::ConstantCompressibilityOilPvt);
+    bool rejected = false;
+    try {
+        constCompOilPvt.packTables();
+    }
+    catch (const std::logic_error&) {
+        rejected = true;
+    }
+    if (!deadOilPvt.supportsTableImage() || constCompOilPvt.supportsTableImage() || !rejected)
+        throw std::logic_error("Wrong table image support of the oil PVT approaches");
+}
+
+template <class Scalar>
+void testFusedThermalPvt()
+{
+    typedef Opm::DenseAd::Evaluation<Scalar, 3> Evaluation;
+    typedef Opm::Tabulated1DFunction<Scalar> TabulatedFunction;
+    typedef typename Opm::OilPvtThermal<Scalar>::IsothermalPvt IsothermalOilPvt;
+    typedef typename Opm::GasPvtThermal<Scalar>::IsothermalPvt IsothermalGasPvt;
+    typedef typename Opm::WaterPvtThermal<Scalar>::IsothermalPvt IsothermalWaterPvt;
+    typedef Opm::OilPvtMultiplexer<Scalar> OilPvt;
+    typedef Opm::GasPvtMultiplexer<Scalar> GasPvt;
+    typedef Opm::WaterPvtMultiplexer<Scalar> WaterPvt;
+
+    std::vector<Scalar> p = { 1e5, 1e6, 5e6, 1e7 };
+    std::vector<TabulatedFunction> invBo = {
+        TabulatedFunction(p, std::vector<Scalar>{ 1/1.05, 1/1.04, 1/1.03, 1/1.01 }),
+        TabulatedFunction(p, std::vector<Scalar>{ 1/1.10, 1/1.08, 1/1.05, 1/1.02 })
+    };
+    std::vector<TabulatedFunction> muo = {
+        TabulatedFunction(p, std::vector<Scalar>{ 1.0e-3, 1.1e-3, 1.3e-3, 1.5e-3 }),
+        TabulatedFunction(p, std::vector<Scalar>{ 1.2e-3, 1.3e-3, 1.4e-3, 1.7e-3 })
+    };
+    std::vector<TabulatedFunction> invBg = {
+        TabulatedFunction(p, std::vector<Scalar>{ 1.0, 10.0, 45.0, 100.0 }),
+        TabulatedFunction(p, std::vector<Scalar>{ 1.1, 11.0, 47.0, 104.0 })
+    };
+    std::vector<TabulatedFunction> mug = {
+        TabulatedFunction(p, std::vector<Scalar>{ 1e-5, 1.1e-5, 1.3e-5, 1.5e-5 }),
+        TabulatedFunction(p, std::vector<Scalar>{ 1.2e-5, 1.3e-5, 1.4e-5, 1.7e-5 })
+    };
+    std::vector<Scalar> T = { 273.15, 320.0, 400.0 };
+    std::vector<TabulatedFunction> viscosityCurves = {
+        TabulatedFunction(T, std::vector<Scalar>{ 2.0e-3, 1.0e-3, 0.5e-3 }),
+        TabulatedFunction(T, std::vector<Scalar>{ 2.5e-3, 1.2e-3, 0.6e-3 })
+    };
+    std::vector<TabulatedFunction> noCurves(2);
+    std::vector<Scalar> rhoRef = { 800.0, 850.0 };
+    std::vector<Scalar> refTemp = { 293.15, 303.15 };
+    std::vector<Scalar> cT1 = { 1e-4, 2e-4 };
+    std::vector<Scalar> cT2 = { 1e-7, 2e-7 };
+    std::vector<Scalar> refPress = { 1e5, 2e5 };
+    std::vector<Scalar> refB = { 1.01, 1.02 };
+    std::vector<Scalar> compressibility = { 4e-10, 5e-10 };
+    std::vector<Scalar> viscosity = { 1.0e-3, 1.1e-3 };
+    std::vector<Scalar> viscosibility = { 1e-9, 2e-9 };
+    std::vector<Scalar> viscRef = { 1.1e-3, 1.3e-3 };
+    std::vector<Scalar> zero = { 0.0, 0.0 };
+    Scalar one = 1.0;
+    const Evaluation& variable = Evaluation::createVariable(1.0, /*varPos=*/0);
+
+    Opm::DeadOilPvt<Scalar> deadOilPvt(rhoRef, invBo, muo, invBo);
+    deadOilPvt.initEnd();
+    checkFusedPvt(deadOilPvt, one, "DeadOilPvt");
+    checkFusedPvt(deadOilPvt, variable, "DeadOilPvt");
+
+    Opm::DeadOilPvt<Scalar> packedDeadOilPvt(deadOilPvt);
+    packedDeadOilPvt.packTables();
+    if (!packedDeadOilPvt.tablesPacked() || deadOilPvt.tablesPacked())
+        throw std::logic_error("Wrong packing state of the dead oil PVT");
+    checkFusedPvt(packedDeadOilPvt, one, "packed DeadOilPvt");
+    checkFusedPvt(packedDeadOilPvt, variable, "packed DeadOilPvt");
+    for (unsigned regionIdx = 0; regionIdx < 2; ++regionIdx) {
+        for (Scalar pressure : { Scalar(5e4), Scalar(3e6), Scalar(2e7) }) {
+            if (packedDeadOilPvt.inverseFormationVolumeFactor(regionIdx, one, pressure, one)
+                != deadOilPvt.inverseFormationVolumeFactor(regionIdx, one, pressure, one)
+                || packedDeadOilPvt.viscosity(regionIdx, one, pressure, one)
+                != deadOilPvt.viscosity(regionIdx, one, pressure, one))
+                throw std::logic_error("The packed tables of the dead oil PVT give different results");
+        }
+    }
+
+    // the isothermal part of the water PVT
+    Opm::ConstantCompressibilityWaterPvt<Scalar> waterPvt;
+    waterPvt.setNumRegions(2);
+    for (unsigned regionIdx = 0; regionIdx < 2; ++regionIdx) {
+        waterPvt.setReferenceDensities(regionIdx, rhoRef[regionIdx], 1.0, 1000.0);
+        waterPvt.setReferencePressure(regionIdx, refPress[regionIdx]);
+        waterPvt.setReferenceFormationVolumeFactor(regionIdx, refB[regionIdx]);
+        waterPvt.setCompressibility(regionIdx, compressibility[regionIdx]);
+        waterPvt.setViscosity(regionIdx, viscosity[regionIdx], viscosibility[regionIdx]);
+    }
+    checkFusedPvt(waterPvt, one, "ConstantCompressibilityWaterPvt");
+    checkFusedPvt(waterPvt, variable, "ConstantCompressibilityWaterPvt");
+
+    Opm::DryGasPvt<Scalar> dryGasPvt(rhoRef, invBg, mug, invBg);
+    dryGasPvt.initEnd();
+
+    // all combinations of thermal density and viscosity are checked because the
+    // thermal PVT classes only evaluate the isothermal quantities which are required
+    for (int thermalIdx = 0; thermalIdx < 4; ++ thermalIdx) {
+        bool enableThermalDensity = thermalIdx & 1;
+        bool enableThermalViscosity = thermalIdx & 2;
+
+        auto* isothermalOilPvt =
+            new IsothermalOilPvt(IsothermalOilPvt::DeadOilPvt, new Opm::DeadOilPvt<Scalar>(deadOilPvt));
+        auto* oilPvtThermal =
+            new Opm::OilPvtThermal<Scalar>(isothermalOilPvt, viscosityCurves, refPress, zero, viscRef,
+                                           refTemp, cT1, cT2, noCurves, enableThermalDensity,
+                                           enableThermalViscosity, /*enableInternalEnergy=*/false);
+        OilPvt oilPvt(OilPvt::ThermalOilPvt, oilPvtThermal);
+        checkFusedPvt(*oilPvtThermal, one, "OilPvtThermal");
+        checkFusedPvt(*oilPvtThermal, variable, "OilPvtThermal");
+        checkFusedPvt(oilPvt, variable, "thermal OilPvtMultiplexer");
+
+        auto* isothermalGasPvt =
+            new IsothermalGasPvt(IsothermalGasPvt::DryGasPvt, new Opm::DryGasPvt<Scalar>(dryGasPvt));
+        auto* gasPvtThermal =
+            new Opm::GasPvtThermal<Scalar>(isothermalGasPvt, viscosityCurves, refTemp, cT1, cT2,
+                                           noCurves, enableThermalDensity, enableThermalViscosity,
+                                           /*enableInternalEnergy=*/false);
+        GasPvt gasPvt(GasPvt::ThermalGasPvt, gasPvtThermal);
+        checkFusedPvt(*gasPvtThermal, one, "GasPvtThermal");
+        checkFusedPvt(*gasPvtThermal, variable, "GasPvtThermal");
+        checkFusedPvt(gasPvt, variable, "thermal GasPvtMultiplexer");
+
+        auto* isothermalWaterPvt =
+            new IsothermalWaterPvt(IsothermalWaterPvt::ConstantCompressibilityWaterPvt,
+                                   new Opm::ConstantCompressibilityWaterPvt<Scalar>(waterPvt));
+        auto* waterPvtThermal =
+            new Opm::WaterPvtThermal<Scalar>(isothermalWaterPvt, refPress, refTemp, cT1, cT2,
+                                             refPress, refB, compressibility, viscosity,
+                                             viscosibility, viscosityCurves, noCurves,
+                                             enableThermalDensity, enableThermalViscosity,
+                                             /*enableInternalEnergy=*/false);
+        WaterPvt thermalWaterPvt(WaterPvt::ThermalWaterPvt, waterPvtThermal);
+        checkFusedPvt(*waterPvtThermal, one, "WaterPvtThermal");
+        checkFusedPvt(*waterPvtThermal, variable, "WaterPvtThermal");
+        checkFusedPvt(thermalWaterPvt, variable, "thermal WaterPvtMultiplexer");
+    }
+}
+
+// the H2O-air fluid system only tabulates the quantities of water which it uses
+template <class Scalar>
+void testH2OAirTabulation()
+{
+    typedef Opm::TabulatedComponent<Scalar, Opm::H2O<Scalar> > TabulatedH2O;
+    typedef Opm::H2OAirFluidSystem<Scalar, TabulatedH2O> FluidSystem;
+    typedef Opm::H2OAirFluidSystem<Scalar, Opm::H2O<Scalar> > RawFluidSystem;
+
+    Scalar tempMin = 280.0;
+    Scalar tempMax = 400.0;
+    Scalar pMin = 1e5;
+    Scalar pMax = 10e6;
+    Scalar tol = 1e-3;
+    Scalar err = FluidSystem::initWithTolerance(tempMin, tempMax, pMin, pMax, tol);
+    if (err > tol)
+        throw std::logic_error("Tabulation of water does not meet the requested tolerance");
+
+    unsigned properties = TabulatedH2O::tabulatedProperties();
+    if (!(properties & TabulatedH2O::LiquidDensity)
+        || !(properties & TabulatedH2O::GasViscosity)
+        || !(properties & TabulatedH2O::LiquidEnthalpy))
+        throw std::logic_error("The H2O-air fluid system does not tabulate a required quantity of water");
+    if (properties & (TabulatedH2O::LiquidHeatCapacity
+                      | TabulatedH2O::GasHeatCapacity
+                      | TabulatedH2O::LiquidPressure
+                      | TabulatedH2O::GasPressure))
+        throw std::logic_error("The H2O-air fluid system tabulates an unused quantity of water");
+
+    Opm::CompositionalFluidState<Scalar, FluidSystem> fs;
+    typename FluidSystem::template ParameterCache<Scalar> paramCache;
+    typename RawFluidSystem::template ParameterCache<Scalar> rawParamCache;
+    for (unsigned i = 0; i < 10; ++i) {
+        Scalar T = tempMin + (tempMax - tempMin)*Scalar(i)/10;
+        Scalar p = pMin + (pMax - pMin)*Scalar(i)/10;
+        for (unsigned phaseIdx = 0; phaseIdx < FluidSystem::numPhases; ++phaseIdx) {
+            fs.setTemperature(T);
+            fs.setPressure(phaseIdx, p);
+            fs.setMoleFraction(phaseIdx, FluidSystem::H2OIdx, 0.5);
+            fs.setMoleFraction(phaseIdx, FluidSystem::AirIdx, 0.5);
+        }
+
+        for (unsigned phaseIdx = 0; phaseIdx < FluidSystem::numPhases; ++phaseIdx) {
+            Scalar rho = FluidSystem::density(fs, paramCache, phaseIdx);
+            Scalar rhoRaw = RawFluidSystem::density(fs, rawParamCache, phaseIdx);
+            Scalar mu = FluidSystem::viscosity(fs, paramCache, phaseIdx);
+            Scalar muRaw = RawFluidSystem::viscosity(fs, rawParamCache, phaseIdx);
+            if (std::abs(rho - rhoRaw) > 10*tol*std::abs(rhoRaw)
+                || std::abs(mu - muRaw) > 10*tol*std::abs(muRaw))
+                throw std::logic_error("The tabulated H2O-air fluid system deviates from the raw one");
+        }
+    }
+}
+
 template <class Scalar>
 inline void testAll()
 {
@@ -299,6 +1038,15 @@ inline void testAll()
     testAllFluidSystems<Scalar, /*FluidStateEval=*/Scalar, /*LhsEval=*/Scalar>();
     testAllFluidSystems<Scalar, /*FluidStateEval=*/Evaluation, /*LhsEval=*/Evaluation>();
     testAllFluidSystems<Scalar, /*FluidStateEval=*/Evaluation, /*LhsEval=*/Scalar>();
+
+    testBlackoilInstances<Scalar>();
+    testBlackoilInstanceThreads<Scalar>();
+    testBlackoilSerialization<Scalar>();
+    testFusedGasPvt<Scalar>();
+    testFusedThermalPvt<Scalar>();
+    testSharedGasPvtTables<Scalar>();
+    testSharedOilPvtTables<Scalar>();
+    testH2OAirTabulation<Scalar>();
 }
 
 int main(int argc, char **argv)
@@ -29,7 +29,9 @@
 #include "config.h"
 
 #include <opm/material/densead/Evaluation.hpp>
+#include <opm/material/common/PolynomialUtils.hpp>
 #include <opm/material/constraintsolvers/ComputeFromReferencePhase.hpp>
+#include <opm/material/constraintsolvers/CompositionFromFugacities.hpp>
 #include <opm/material/constraintsolvers/NcpFlash.hpp>
 #include <opm/material/fluidstates/CompositionalFluidState.hpp>
 #include <opm/material/fluidsystems/Spe5FluidSystem.hpp>
@@ -38,6 +40,11 @@
 
 #include <dune/common/parallel/mpihelper.hh>
 
+#include <vector>
+#include <stdexcept>
+#include <limits>
+#include <cmath>
+
 template <class FluidSystem, class FluidState>
 void createSurfaceGasFluidSystem(FluidState& gasFluidState)
 {
@@ -289,6 +296,179 @@ void printResult(const RawTable& rawTable,
     std::cout << "};\n";
 }
 
+// compare the batched composition solver with the one for single fluid states
+template <class Scalar, class FluidSystem, class FluidState>
+void testBatchedCompositionFromFugacities(const FluidState& refFluidState)
+{
+    enum {
+        gasPhaseIdx = FluidSystem::gasPhaseIdx,
+        oilPhaseIdx = FluidSystem::oilPhaseIdx,
+        numComponents = FluidSystem::numComponents
+    };
+
+    typedef Opm::DenseAd::Evaluation<Scalar, 1> Evaluation;
+    typedef Opm::CompositionalFluidState<Evaluation, FluidSystem> EvalFluidState;
+
+    typedef Opm::CompositionFromFugacities<Scalar, FluidSystem> ScalarSolver;
+    typedef Opm::CompositionFromFugacities<Scalar, FluidSystem, Evaluation> EvalSolver;
+
+    typedef typename FluidSystem::template ParameterCache<Scalar> ParameterCache;
+    typedef typename FluidSystem::template ParameterCache<Evaluation> EvalParameterCache;
+
+    // the gas composition which is in equilibrium with the reservoir oil for
+    // slightly different gas pressures
+    const unsigned numStates = 8;
+    std::vector<FluidState> singleStates(numStates, refFluidState);
+    std::vector<ParameterCache> singleCaches(numStates);
+    std::vector<FluidState> batchStates(numStates, refFluidState);
+    std::vector<ParameterCache> batchCaches(numStates);
+    std::vector<EvalFluidState> evalStates(numStates);
+    std::vector<EvalParameterCache> evalCaches(numStates);
+    std::vector<typename ScalarSolver::ComponentVector> targetFugs(numStates);
+    std::vector<typename EvalSolver::ComponentVector> evalTargetFugs(numStates);
+    for (unsigned stateIdx = 0; stateIdx < numStates; ++stateIdx) {
+        Scalar p = refFluidState.pressure(gasPhaseIdx)*(1.0 + 0.01*stateIdx);
+        for (unsigned compIdx = 0; compIdx < numComponents; ++compIdx) {
+            targetFugs[stateIdx][compIdx] = refFluidState.fugacity(oilPhaseIdx, compIdx);
+            evalTargetFugs[stateIdx][compIdx] = refFluidState.fugacity(oilPhaseIdx, compIdx);
+        }
+
+        singleStates[stateIdx].setPressure(gasPhaseIdx, p);
+        ScalarSolver::solve(singleStates[stateIdx], singleCaches[stateIdx], gasPhaseIdx, targetFugs[stateIdx]);
+
+        batchStates[stateIdx].setPressure(gasPhaseIdx, p);
+
+        EvalFluidState& evalState = evalStates[stateIdx];
+        evalState.setTemperature(refFluidState.temperature(gasPhaseIdx));
+        evalState.setPressure(gasPhaseIdx, Evaluation::createVariable(p, 0));
+        for (unsigned compIdx = 0; compIdx < numComponents; ++compIdx)
+            evalState.setMoleFraction(gasPhaseIdx, compIdx, refFluidState.moleFraction(gasPhaseIdx, compIdx));
+    }
+
+    ScalarSolver::solveBatch(numStates, batchStates.data(), batchCaches.data(), gasPhaseIdx, targetFugs.data());
+    EvalSolver::solveBatch(numStates, evalStates.data(), evalCaches.data(), gasPhaseIdx, evalTargetFugs.data());
+
+    for (unsigned stateIdx = 0; stateIdx < numStates; ++stateIdx) {
+        const FluidState& fsSingle = singleStates[stateIdx];
+        const FluidState& fsBatch = batchStates[stateIdx];
+        const EvalFluidState& fsEval = evalStates[stateIdx];
+
+        for (unsigned compIdx = 0; compIdx < numComponents; ++compIdx) {
+            Scalar x = fsSingle.moleFraction(gasPhaseIdx, compIdx);
+            if (std::abs(fsBatch.moleFraction(gasPhaseIdx, compIdx) - x) > 1e-8
+                || std::abs(fsEval.moleFraction(gasPhaseIdx, compIdx).value() - x) > 1e-8)
+                throw std::logic_error("Batched composition solver deviates from the single one");
+        }
+
+        Scalar rho = fsSingle.density(gasPhaseIdx);
+        if (std::abs(fsBatch.density(gasPhaseIdx) - rho) > 1e-6*rho
+            || std::abs(fsEval.density(gasPhaseIdx).value() - rho) > 1e-6*rho)
+            throw std::logic_error("Batched composition solver yields a wrong density");
+    }
+
+    // check the derivatives w.r.t. pressure using central differences of the
+    // scalar results. these are only accurate up to the tolerance of the
+    // Newton method, so the derivatives only agree approximately
+    const Scalar p = refFluidState.pressure(gasPhaseIdx);
+    const Scalar h = 1e-4*p;
+    FluidState fsPlus(refFluidState), fsMinus(refFluidState);
+    ParameterCache paramCache;
+    fsPlus.setPressure(gasPhaseIdx, p + h);
+    ScalarSolver::solve(fsPlus, paramCache, gasPhaseIdx, targetFugs[0]);
+    fsMinus.setPressure(gasPhaseIdx, p - h);
+    ScalarSolver::solve(fsMinus, paramCache, gasPhaseIdx, targetFugs[0]);
+    for (unsigned compIdx = 0; compIdx < numComponents; ++compIdx) {
+        Scalar dxdp = (fsPlus.moleFraction(gasPhaseIdx, compIdx) - fsMinus.moleFraction(gasPhaseIdx, compIdx))/(2*h);
+        Scalar dxdpEval = evalStates[0].moleFraction(gasPhaseIdx, compIdx).derivative(0);
+        if (std::abs(dxdp - dxdpEval) > 1e-3*std::abs(dxdp) + 1e-14)
+            throw std::logic_error("Batched composition solver yields wrong derivatives");
+    }
+}
+
+// compare the batched inversion of cubic polynomials with the one for single
+// polynomials. the coefficients are constructed from known roots.
+template <class Scalar>
+void testCubicPolynomials()
+{
+    typedef Opm::DenseAd::Evaluation<Scalar, 1> Evaluation;
+
+    const unsigned numPolys = 100;
+    std::vector<Scalar> a(numPolys), b(numPolys), c(numPolys), d(numPolys);
+    std::vector<Evaluation> aEval(numPolys), bEval(numPolys), cEval(numPolys), dEval(numPolys);
+    std::vector<Scalar> refRoot(numPolys);
+    std::vector<unsigned> refNumSol(numPolys);
+    for (unsigned polyIdx = 0; polyIdx < numPolys; ++polyIdx) {
+        // the derivatives are taken w.r.t. the first root
+        Evaluation r0 = Evaluation::createVariable(-1.0 + 0.05*polyIdx, 0);
+        Scalar scale = 0.5 + 0.01*polyIdx;
+        Evaluation p, q;
+        if (polyIdx % 2 == 0) {
+            // three real roots: (x - r0)*(x - r1)*(x - r2)
+            Scalar r1 = 2.0 + 0.03*polyIdx;
+            Scalar r2 = -3.0 - 0.02*polyIdx;
+            p = -(r1 + r2);
+            q = r1*r2;
+            refNumSol[polyIdx] = 3;
+        }
+        else {
+            // a single real root: (x - r0)*(x^2 + x + 1 + polyIdx/10)
+            p = 1.0;
+            q = 1.0 + 0.1*polyIdx;
+            refNumSol[polyIdx] = 1;
+        }
+        refRoot[polyIdx] = r0.value();
+
+        aEval[polyIdx] = scale;
+        bEval[polyIdx] = scale*(p - r0);
+        cEval[polyIdx] = scale*(q - r0*p);
+        dEval[polyIdx] = -scale*r0*q;
+
+        a[polyIdx] = aEval[polyIdx].value();
+        b[polyIdx] = bEval[polyIdx].value();
+        c[polyIdx] = cEval[polyIdx].value();
+        d[polyIdx] = dEval[polyIdx].value();
+    }
+
+    std::vector<Scalar> sol(3*numPolys);
+    std::vector<Evaluation> evalSol(3*numPolys);
+    std::vector<unsigned> numSol(numPolys), evalNumSol(numPolys);
+    Opm::invertCubicPolynomials(numPolys, a.data(), b.data(), c.data(), d.data(),
+                                sol.data(), numSol.data());
+    Opm::invertCubicPolynomials(numPolys, aEval.data(), bEval.data(), cEval.data(), dEval.data(),
+                                evalSol.data(), evalNumSol.data());
+
+    const Scalar tol = 1e3*std::numeric_limits<Scalar>::epsilon();
+    for (unsigned polyIdx = 0; polyIdx < numPolys; ++polyIdx) {
+        Scalar singleSol[3];
+        unsigned singleNumSol =
+            Opm::invertCubicPolynomial(singleSol, a[polyIdx], b[polyIdx], c[polyIdx], d[polyIdx]);
+        if (numSol[polyIdx] != refNumSol[polyIdx]
+            || singleNumSol != numSol[polyIdx]
+            || evalNumSol[polyIdx] != numSol[polyIdx])
+            throw std::logic_error("Batched cubic inversion yields a wrong number of roots");
+
+        bool foundRoot = false;
+        for (unsigned i = 0; i < numSol[polyIdx]; ++i) {
+            Scalar x = sol[3*polyIdx + i];
+            const Evaluation& xEval = evalSol[3*polyIdx + i];
+            if (std::abs(x - singleSol[i]) > tol*(1 + std::abs(x))
+                || std::abs(xEval.value() - x) > tol*(1 + std::abs(x)))
+                throw std::logic_error("Batched cubic inversion deviates from the single one");
+            if (i > 0 && x < sol[3*polyIdx + i - 1])
+                throw std::logic_error("Batched cubic inversion yields unsorted roots");
+
+            // only the first root depends on the variable
+            bool isFirstRoot = std::abs(x - refRoot[polyIdx]) < tol*(1 + std::abs(x));
+            foundRoot = foundRoot || isFirstRoot;
+            Scalar refDeriv = isFirstRoot ? 1.0 : 0.0;
+            if (std::abs(xEval.derivative(0) - refDeriv) > 1e2*tol)
+                throw std::logic_error("Batched cubic inversion yields wrong derivatives");
+        }
+        if (!foundRoot)
+            throw std::logic_error("Batched cubic inversion misses a root");
+    }
+}
+
 template <class Scalar>
 inline void testAll()
 {
@@ -387,6 +567,8 @@ inline void testAll()
                 /*setViscosity=*/false,
                 /*setEnthalpy=*/false);
 
+    testBatchedCompositionFromFugacities<Scalar, FluidSystem>(fluidState);
+
     ////////////
     // Calculate the total molarities of the components
     ////////////
@@ -481,6 +663,8 @@ int main(int argc, char **argv)
 {
     Dune::MPIHelper::instance(argc, argv);
 
+    testCubicPolynomials<double>();
+    testCubicPolynomials<float>();
     testAll<double>();
 
     // the Peng-Robinson test currently does not work with single-precision floating
@@ -43,6 +43,7 @@ gnuplot> plot "spline.csv" using 1:2 w l ti "Curve", \
 #include <dune/common/parallel/mpihelper.hh>
 
 #include <array>
+#include <vector>
 
 template <class Spline>
 void testCommon(const Spline& sp,
@@ -186,6 +187,94 @@ void testMonotonic(const Spline& sp,
     }
 }
 
+template <class Spline>
+void testBatch(const Spline& sp)
+{
+    // make sure that the batched evaluation yields the same as the one for
+    // individual positions
+    const size_t np = 50;
+    std::vector<double> xval(np), yval(np), dval(np);
+    double xMin = sp.xAt(0);
+    double xMax = sp.xAt(sp.numSamples() - 1);
+    for (size_t i = 0; i < np; ++i)
+        xval[i] = xMin + (xMax - xMin)*i/(np - 1);
+
+    sp.evalBatch(np, xval.data(), yval.data());
+    sp.evalDerivativeBatch(np, xval.data(), dval.data());
+    for (size_t i = 0; i < np; ++i) {
+        if (yval[i] != sp.eval(xval[i]))
+            throw std::runtime_error("Batched evaluation of spline differs at x="+std::to_string(xval[i]));
+        if (dval[i] != sp.evalDerivative(xval[i]))
+            throw std::runtime_error("Batched evaluation of spline derivative differs at x="+std::to_string(xval[i]));
+    }
+
+    // the range check must be done for the whole batch
+    xval[np/2] = xMax + 1.0;
+    bool hasThrown = false;
+    try {
+        sp.evalBatch(np, xval.data(), yval.data());
+    }
+    catch (const Opm::NumericalIssue&) {
+        hasThrown = true;
+    }
+    if (!hasThrown)
+        throw std::runtime_error("Batched evaluation of spline outside of its range did not throw");
+}
+
+template <class Spline>
+void testBatchedConstruction(typename Spline::SplineType splineType)
+{
+    // make sure that splines constructed in a batch are the same as the ones
+    // constructed individually
+    const size_t numSplines = 7;
+    const size_t nSamples = 6;
+    std::vector<double> x(numSplines*nSamples), y(numSplines*nSamples);
+    std::vector<double> m0(numSplines), m1(numSplines);
+    for (size_t k = 0; k < numSplines; ++k) {
+        for (size_t i = 0; i < nSamples; ++i) {
+            x[k*nSamples + i] = i + 0.1*k*i*i;
+            y[k*nSamples + i] = std::sin(1.0 + k + 0.7*i);
+        }
+        // periodic splines need the same value at both ends
+        y[k*nSamples + nSamples - 1] = y[k*nSamples];
+        m0[k] = 1.0 - 0.3*k;
+        m1[k] = 0.2*k;
+    }
+
+    std::vector<Spline> batch(numSplines);
+    bool isFull = (splineType == Spline::Full);
+    if (isFull)
+        Spline::setXYArraysBatch(numSplines, batch.data(), nSamples, x, y, m0, m1);
+    else
+        Spline::setXYArraysBatch(numSplines, batch.data(), nSamples, x, y, splineType);
+
+    for (size_t k = 0; k < numSplines; ++k) {
+        Spline sp;
+        if (isFull)
+            sp.setXYArrays(nSamples, &x[k*nSamples], &y[k*nSamples], m0[k], m1[k]);
+        else
+            sp.setXYArrays(nSamples, &x[k*nSamples], &y[k*nSamples], splineType);
+
+        double xMax = x[k*nSamples + nSamples - 1];
+        for (size_t i = 0; i <= 100; ++i) {
+            double xi = xMax*i/100;
+            double delta = std::abs(batch[k].eval(xi) - sp.eval(xi));
+            double deltaDeriv = std::abs(batch[k].evalDerivative(xi) - sp.evalDerivative(xi));
+            if (delta > 1e-10 || deltaDeriv > 1e-10)
+                throw std::runtime_error("Spline "+std::to_string(k)+" of type "+std::to_string(int(splineType))
+                                         +" constructed as part of a batch differs at x="+std::to_string(xi));
+        }
+
+        // the first two derivatives of periodic splines must be the same at
+        // both ends
+        if (splineType == Spline::Periodic) {
+            if (std::abs(sp.evalDerivative(0.0) - sp.evalDerivative(xMax)) > 1e-8
+                || std::abs(sp.evalSecondDerivative(0.0) - sp.evalSecondDerivative(xMax)) > 1e-8)
+                throw std::runtime_error("Periodic spline "+std::to_string(k)+" is not periodic");
+        }
+    }
+}
+
 // function prototype to prevent some compilers producing a warning
 void testAll();
 void testAll()
@@ -242,6 +331,28 @@ void testAll()
     { Opm::Spline<double> sp; sp.setArrayOfPoints(5,points); testNatural(sp, x, y); };
     { Opm::Spline<double> sp; sp.setContainerOfPoints(pointVec); testNatural(sp, x, y); };
     { Opm::Spline<double> sp; sp.setContainerOfTuples(pointsInitList); testNatural(sp, x, y); };
+
+    /////////
+    // test the compiled form of splines
+    /////////
+    double xUniform[] = { 0, 2.5, 5, 7.5, 10 };
+    { Opm::Spline<double> sp(5, x, y); testBatch(sp);
+        if (sp.hasUniformKnots())
+            throw std::runtime_error("Spline with non-equidistant sampling points claims to have uniform knots");
+    };
+    { Opm::Spline<double> sp(5, xUniform, y); testNatural(sp, xUniform, y); testBatch(sp);
+        if (!sp.hasUniformKnots())
+            throw std::runtime_error("Spline with equidistant sampling points does not use uniform knots");
+    };
+    { Opm::Spline<double> sp(5, xUniform, y, Opm::Spline<double>::Monotonic); testMonotonic(sp, xUniform, y); testBatch(sp); };
+
+    /////////
+    // test batched construction of splines
+    /////////
+    testBatchedConstruction<Opm::Spline<double> >(Opm::Spline<double>::Full);
+    testBatchedConstruction<Opm::Spline<double> >(Opm::Spline<double>::Natural);
+    testBatchedConstruction<Opm::Spline<double> >(Opm::Spline<double>::Periodic);
+    testBatchedConstruction<Opm::Spline<double> >(Opm::Spline<double>::Monotonic);
 }
 
 // function prototype to prevent some compilers producing a warning
@@ -32,7 +32,11 @@
 #include "config.h"
 
 #include <opm/material/components/H2O.hpp>
+#include <opm/material/components/Air.hpp>
+#include <opm/material/components/N2.hpp>
+#include <opm/material/components/Brine.hpp>
 #include <opm/material/components/TabulatedComponent.hpp>
+#include <opm/material/densead/Evaluation.hpp>
 
 #include <dune/common/parallel/mpihelper.hh>
 
@@ -119,12 +123,90 @@ inline void testAll()
         std::cout << "\nsuccess\n";
 }
 
+// tabulate components which do not provide all quantities, check the
+// adaptive resolution and the derivatives of the interpolated values
+template <class Scalar>
+inline void testGenericComponents()
+{
+    typedef Opm::Air<Scalar> Air;
+    typedef Opm::N2<Scalar> N2;
+    typedef Opm::Brine<Scalar, Opm::H2O<Scalar> > Brine;
+    typedef Opm::TabulatedComponent<Scalar, Air, /*useVaporPressure=*/false> TabulatedAir;
+    typedef Opm::TabulatedComponent<Scalar, N2, /*useVaporPressure=*/false> TabulatedN2;
+    typedef Opm::TabulatedComponent<Scalar, Brine, /*useVaporPressure=*/false> TabulatedBrine;
+    typedef Opm::DenseAd::Evaluation<Scalar, 2> Evaluation;
+
+    Scalar tempMin = 280.0;
+    Scalar tempMax = 400.0;
+    Scalar pMin = 1e5;
+    Scalar pMax = 50e6;
+
+    Scalar tol = 1e-4;
+    Scalar err =
+        TabulatedAir::initWithTolerance(tempMin, tempMax, pMin, pMax, tol,
+                                        TabulatedAir::GasProperties);
+    if (err > tol)
+        throw std::logic_error("Tabulation of air does not meet the requested tolerance");
+
+    TabulatedN2::init(tempMin, tempMax, 50, pMin, pMax, 50,
+                      TabulatedN2::GasDensity | TabulatedN2::GasViscosity);
+    if (TabulatedN2::tabulatedProperties() != (TabulatedN2::GasDensity | TabulatedN2::GasViscosity))
+        throw std::logic_error("Unexpected set of tabulated quantities");
+
+    Brine::salinity = 0.1;
+    err = TabulatedBrine::initWithTolerance(tempMin, tempMax, pMin, pMax, 1e-3,
+                                            TabulatedBrine::LiquidDensity
+                                            | TabulatedBrine::LiquidEnthalpy);
+    if (err > 1e-3)
+        throw std::logic_error("Tabulation of brine does not meet the requested tolerance");
+
+    success = true;
+    for (unsigned i = 0; i < 37; ++i) {
+        Scalar T = tempMin + (tempMax - tempMin)*Scalar(i)/37;
+        for (unsigned j = 0; j < 41; ++j) {
+            Scalar p = pMin + (pMax - pMin)*Scalar(j)/41;
+
+            isSame("Air::gasDensity", TabulatedAir::gasDensity(T, p), Air::gasDensity(T, p), Scalar(1e-3));
+            isSame("Air::gasEnthalpy", TabulatedAir::gasEnthalpy(T, p), Air::gasEnthalpy(T, p), Scalar(1e-3));
+            isSame("Air::gasViscosity", TabulatedAir::gasViscosity(T, p), Air::gasViscosity(T, p), Scalar(1e-3));
+            isSame("N2::gasDensity", TabulatedN2::gasDensity(T, p), N2::gasDensity(T, p), Scalar(1e-3));
+            // not tabulated, so this must be exact
+            isSame("N2::gasEnthalpy", TabulatedN2::gasEnthalpy(T, p), N2::gasEnthalpy(T, p), Scalar(0.0));
+            isSame("Brine::liquidDensity", TabulatedBrine::liquidDensity(T, p), Brine::liquidDensity(T, p), Scalar(1e-3));
+
+            // the derivatives of the interpolated quantities must be the ones
+            // of the interpolating function
+            Evaluation TEval = Evaluation::createVariable(T, 0);
+            Evaluation pEval = Evaluation::createVariable(p, 1);
+            const Evaluation& rho = TabulatedAir::gasDensity(TEval, pEval);
+            Scalar hT = (tempMax - tempMin)*1e-5;
+            Scalar hp = (pMax - pMin)*1e-5;
+            Scalar drhodT = (TabulatedAir::gasDensity(T + hT, p) - TabulatedAir::gasDensity(T - hT, p))/(2*hT);
+            Scalar drhodp = (TabulatedAir::gasDensity(T, p + hp) - TabulatedAir::gasDensity(T, p - hp))/(2*hp);
+            isSame("Air::gasDensity (value)", rho.value(), TabulatedAir::gasDensity(T, p), Scalar(1e-6));
+            isSame("Air::gasDensity (dT)", rho.derivative(0), drhodT, Scalar(1e-2));
+            isSame("Air::gasDensity (dp)", rho.derivative(1), drhodp, Scalar(1e-2));
+        }
+    }
+
+    // the liquid pressure is not provided by the raw air component
+    bool hasThrown = false;
+    try { TabulatedAir::liquidPressure(Scalar(300.0), Scalar(1000.0)); }
+    catch (const std::runtime_error&) { hasThrown = true; }
+    if (!hasThrown)
+        throw std::logic_error("TabulatedAir::liquidPressure() should throw");
+
+    if (!success)
+        throw std::logic_error("Tabulation of generic components failed");
+}
+
 int main(int argc, char **argv)
 {
     Dune::MPIHelper::instance(argc, argv);
 
     testAll<double>();
     testAll<float>();
+    testGenericComponents<double>();
 
     return 0;
 }